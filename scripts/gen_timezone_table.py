@@ -0,0 +1,386 @@
+"""
+src/TimeZoneTable.cpp を生成する。
+
+Web画面のタイムゾーンの選択肢（webpack/src/infra/timezone.json, timezoneArea.json）を
+tzdata（zoneinfo）のタイムゾーンに対応させ、各タイムゾーンの今の規則（TZifファイルの
+末尾にある POSIX の TZ）を TimeZoneRule の表にする。同じ規則は1つにまとめる。
+
+ビルドからは呼ばない。生成したファイルはリポジトリに登録し、ビルドはそれを使う。
+tzdata の版を TZDATA_VERSION に固定し、ホストの zoneinfo が違う版なら生成しない。
+tzdata を更新するときは TZDATA_VERSION を変えて手動で実行し、生成したファイルも一緒に登録する:
+
+    python3 scripts/gen_timezone_table.py [zoneinfoのディレクトリ]
+
+ホストの zoneinfo が違う版のときは、pip の tzdata（2025b は tzdata==2025.2）の
+zoneinfo ディレクトリを指定する。
+"""
+import json
+import os
+import re
+import sys
+
+# Web画面の表示名 → tzdata の名前（「地域/表示名」のままでは見つからないもの）
+ALIASES = {
+    ("Africa", "Porto_Novo"): "Africa/Porto-Novo",
+    ("America", "Blanc_Sablon"): "America/Blanc-Sablon",
+    ("America", "Indiana_Knox"): "America/Indiana/Knox",
+    ("America", "Montevido"): "America/Montevideo",
+    ("Antarctica", "CaseyStation"): "Antarctica/Casey",
+    ("Antarctica", "DavisStation"): "Antarctica/Davis",
+    ("Antarctica", "MawsonStation"): "Antarctica/Mawson",
+    ("Antarctica", "McMurdoStation"): "Antarctica/McMurdo",
+    ("Antarctica", "PalmerStation"): "Antarctica/Palmer",
+    ("Antarctica", "RotheraResearchStation"): "Antarctica/Rothera",
+    ("Antarctica", "ShowaStation"): "Antarctica/Syowa",
+    ("Antarctica", "VostokStation"): "Antarctica/Vostok",
+    ("Asia", "Beijing"): "Asia/Shanghai",
+    ("Asia", "Osaka"): "Asia/Tokyo",
+    ("Asia", "Sapporo"): "Asia/Tokyo",
+    ("Asia", "Yekaterinbufg"): "Asia/Yekaterinburg",
+    ("Pacific", "Pago_pago"): "Pacific/Pago_Pago",
+}
+TZDATA_VERSION = "2025b"   # 生成に使う tzdata の版（src/TimeZoneTable.cpp に記録される）
+GMT_AREA = "AreaGMT"   # UTCからの差だけの選択肢（Pr.35 と同じ並び）
+NO_GMT = 0xFF
+
+
+def log(message):
+    print("gen_timezone_table: " + message)
+
+
+def load_json(path, key):
+    with open(path, encoding="utf-8-sig") as f:   # timezone.json は BOM 付き
+        return json.load(f)[key]
+
+
+def find_zoneinfo(explicit=None):
+    """zoneinfo のディレクトリと tzdata の版を探す"""
+    candidates = [explicit, os.environ.get("TZDIR")]
+    try:
+        import zoneinfo
+        candidates += list(zoneinfo.TZPATH)
+    except ImportError:
+        pass
+    try:
+        import tzdata   # pip の tzdata（Windows など）
+        candidates.append(os.path.join(os.path.dirname(tzdata.__file__), "zoneinfo"))
+    except ImportError:
+        pass
+    for path in candidates:
+        if path and os.path.isfile(os.path.join(path, "Asia", "Tokyo")):
+            return path, tzdata_version(path)
+    return None, None
+
+
+def tzdata_version(path):
+    for name in ("tzdata.zi", "+VERSION"):
+        try:
+            with open(os.path.join(path, name)) as f:
+                line = f.readline().strip()
+            return line.replace("# version", "").strip()
+        except OSError:
+            pass
+    try:
+        import tzdata
+        return tzdata.IANA_VERSION
+    except (ImportError, AttributeError):
+        return "unknown"
+
+
+def footer(path):
+    """TZif（version 2以降）の末尾の POSIX TZ"""
+    with open(path, "rb") as f:
+        data = f.read()
+    if not data.startswith(b"TZif") or data[4:5] in (b"\0", b""):
+        raise ValueError(path + ": TZif version 2 以降ではない")
+    return data.rstrip(b"\n").rsplit(b"\n", 1)[1].decode("ascii")
+
+
+def parse_hms(text):
+    m = re.fullmatch(r"([+-]?)(\d{1,3})(?::(\d{2}))?(?::(\d{2}))?", text)
+    if not m:
+        raise ValueError("時刻が読めない: " + text)
+    seconds = int(m.group(2)) * 3600 + int(m.group(3) or 0) * 60 + int(m.group(4) or 0)
+    return -seconds if m.group(1) == "-" else seconds
+
+
+def parse_posix_tz(tz):
+    """POSIX の TZ を (標準時の差, 夏時間の差, 始まり, 終わり) にする（差は東が正[s]）"""
+    name = r"(?:<[^>]+>|[A-Za-z]{3,})"
+    offset = r"[+-]?\d{1,2}(?::\d{2}){0,2}"
+    m = re.fullmatch(r"%s(%s)(?:%s(%s)?,([^,]+),([^,]+))?" % (name, offset, name, offset), tz)
+    if not m:
+        raise ValueError("TZ が読めない: " + tz)
+    std = -parse_hms(m.group(1))
+    if m.group(3) is None:
+        return (std, std, (0, 0, 0, 0), (0, 0, 0, 0))     # 夏時間なし
+    dst = -parse_hms(m.group(2)) if m.group(2) else std + 3600
+    return (std, dst, parse_rule(m.group(3)), parse_rule(m.group(4)))
+
+
+def parse_rule(text):
+    m = re.fullmatch(r"M(\d{1,2})\.(\d)\.(\d)(?:/(.+))?", text)
+    if not m:
+        raise ValueError("Mm.w.d 以外の切り替え日時には対応していない: " + text)
+    time = parse_hms(m.group(4)) if m.group(4) else 7200
+    return (int(m.group(1)), int(m.group(2)), int(m.group(3)), time)
+
+
+def gmt_minutes(tz):
+    """timezone.json の "GMT+09:00"（POSIX と同じく符号が逆）を東が正の分にする"""
+    m = re.fullmatch(r"GMT([+-])(\d\d):(\d\d)", tz)
+    minutes = int(m.group(2)) * 60 + int(m.group(3))
+    return -minutes if m.group(1) == "+" else minutes
+
+
+def fixed_rule(minutes):
+    return (minutes * 60, minutes * 60, (0, 0, 0, 0), (0, 0, 0, 0))
+
+
+def posix_fixed(minutes):
+    """UTCからの差だけの POSIX TZ（tzdata と同じ "<+0930>-9:30" の形）"""
+    sign = "-" if minutes < 0 else "+"
+    hours, rest = divmod(abs(minutes), 60)
+    label = "%s%02d%s" % (sign, hours, "%02d" % rest if rest else "")
+    return "<%s>%s%d%s" % (label, "" if minutes < 0 else "-", hours, ":%02d" % rest if rest else "")
+
+
+def utc_label(seconds):
+    minutes = seconds // 60
+    return "UTC%s%02d:%02d" % ("-" if minutes < 0 else "+", abs(minutes) // 60, abs(minutes) % 60)
+
+
+def tzdata_name(area, title):
+    name = title.replace("this.tz", "")
+    if name.endswith("Summer"):     # 夏時間の選択肢も同じタイムゾーン（切り替えは規則で行う）
+        name = name[:-len("Summer")]
+    return ALIASES.get((area, name), area + "/" + name)
+
+
+def c_array_name(area):
+    if area == GMT_AREA:
+        return "GMT_ZONES"
+    return re.sub(r"(?<!^)([A-Z])", r"_\1", area).upper() + "_ZONES"
+
+
+def generate(project_dir, zoneinfo_dir, version):
+    infra = os.path.join(project_dir, "webpack", "src", "infra")
+    zones = load_json(os.path.join(infra, "timezone.json"), "timezoneList")
+    areas = load_json(os.path.join(infra, "timezoneArea.json"), "timezoneAreaList")
+    gmt_zones = [z for z in zones if z["AREA"] == GMT_AREA]
+    gmt_index = {gmt_minutes(z["TZ"]): i for i, z in enumerate(gmt_zones)}
+
+    # 規則を集める（同じ規則は1つにまとめ、最初に現れた TZ を名前にする）
+    rules = {}
+    entries = {}
+    for z in zones:
+        if z["AREA"] == GMT_AREA:
+            continue
+        name = tzdata_name(z["AREA"], z["TITLE"])
+        tz = footer(os.path.join(zoneinfo_dir, name))
+        rule = parse_posix_tz(tz)
+        if rule[0] % 60 or rule[1] % 60 or rule[2][3] % 60 or rule[3][3] % 60:
+            raise ValueError(name + ": 分の境界でない差・切り替えには対応していない: " + tz)
+        rules.setdefault(rule, tz)
+        entries[z["ID"]] = (rule, name)
+    for z in gmt_zones:
+        rules.setdefault(fixed_rule(gmt_minutes(z["TZ"])), posix_fixed(gmt_minutes(z["TZ"])))
+
+    ordered = sorted(rules)     # 標準時の差（西から東）の順
+    if len(ordered) >= NO_GMT:
+        raise ValueError("規則が多すぎる: %d" % len(ordered))
+    number = {rule: i for i, rule in enumerate(ordered)}
+
+    out = []
+    out.append("""/**
+ * @file TimeZoneTable.cpp
+ * @brief Web画面で選べるタイムゾーンの表
+ * @details
+ * scripts/gen_timezone_table.py が生成する（直接編集しない）。tzdata %s
+ * webpack/src/infra/timezone.json・timezoneArea.json と同じ並びにする（Pr.33/34 はこの並びの番号）。
+ * 各タイムゾーンは tzdata の今の規則（TZifファイルの末尾の POSIX TZ）の番号を持ち、同じ規則は共有する。
+ * 「～Summer」の選択肢も同じタイムゾーンとし、夏時間は規則で切り替える。
+ * 表はすべて constexpr で、フラッシュに置かれる。
+ */
+#include "TimeZoneTable.h"
+
+namespace {
+
+// 規則（標準時のUTCからの差の順）
+constexpr TimeZoneRule RULES[] = {""" % version)
+    for i, rule in enumerate(ordered):
+        std, dst, start, end = rule
+        out.append("  {%6d, %6d, {%2d, %d, %d, %6d}, {%2d, %d, %d, %6d}},   // %2d: %s"
+                   % ((std, dst) + start + end + (i, rules[rule])))
+    out.append("};")
+    out.append("")
+    out.append("// 規則の POSIX TZ（ログ用）")
+    out.append("constexpr const char* RULE_NAMES[] = {")
+    for rule in ordered:
+        out.append('  "%s",' % rules[rule])
+    out.append("};")
+    out.append("")
+    out.append("// Pr.35 の値 → RULES の番号（UTCからの差だけ）")
+    out.append("constexpr uint8_t GMT_ZONES[] = {")
+    for i, z in enumerate(gmt_zones):
+        out.append("  %2d,   // %2d: %s" % (number[fixed_rule(gmt_minutes(z["TZ"]))], i, utc_label(gmt_minutes(z["TZ"]) * 60)))
+    out.append("};")
+    out.append("""
+constexpr uint8_t NO_GMT = TimeZoneTable::NO_GMT;
+
+struct Zone {
+  uint8_t rule;     // RULES の番号
+  uint8_t gmt;      // Web画面が一緒に送る Pr.35 の値（Pr.35 にない差は NO_GMT）
+};""")
+    for area in areas:
+        if area["AREA"] == GMT_AREA:
+            continue
+        out.append("")
+        out.append("// %s（Pr.34 の値 - 1 の順）" % area["AREA"])
+        out.append("constexpr Zone %s[] = {" % c_array_name(area["AREA"]))
+        for z in zones:
+            if z["AREA"] != area["AREA"]:
+                continue
+            rule, name = entries[z["ID"]]
+            gmt = gmt_index.get(gmt_minutes(z["TZ"]), NO_GMT)
+            out.append("  {%2d, %s},   // %s %s (%s)" % (number[rule], "%2d" % gmt if gmt != NO_GMT else "NO_GMT",
+                                                    z["ID"], z["TITLE"].replace("this.tz", ""), name))
+        out.append("};")
+    out.append("""
+// AreaGMT は Pr.35 と同じ並び
+constexpr Zone AREA_GMT_ZONES[] = {""")
+    for i, z in enumerate(gmt_zones):
+        out.append("  {%2d, %2d},   // %s" % (number[fixed_rule(gmt_minutes(z["TZ"]))], i, z["ID"]))
+    out.append("""};
+
+struct Area {
+  const char* name;         // 地域名
+  const Zone* zones;        // タイムゾーンの並び
+  uint8_t count;            // タイムゾーンの数
+};
+
+// Pr.33 の値 → 地域
+constexpr Area AREAS[] = {""")
+    for area in areas:
+        array = "AREA_GMT_ZONES" if area["AREA"] == GMT_AREA else c_array_name(area["AREA"])
+        out.append('  {"%s", %s, sizeof(%s) / sizeof(Zone)},' % (area["AREA"], array, array))
+    out.append("};")
+    out.append(TAIL)
+    return "\n".join(out) + "\n", len(ordered), len(entries)
+
+
+TAIL = """
+constexpr uint8_t RULE_COUNT = sizeof(RULES) / sizeof(RULES[0]);
+static_assert(sizeof(RULE_NAMES) / sizeof(RULE_NAMES[0]) == RULE_COUNT, "規則の名前の数");
+static_assert(sizeof(GMT_ZONES) == TimeZoneTable::GMT_COUNT, "Pr.35 の選択肢の数");
+static_assert(sizeof(AREAS) / sizeof(AREAS[0]) == TimeZoneTable::AREA_COUNT, "Pr.33 の選択肢の数");
+
+// Pr.33/34 のタイムゾーン（未選択・範囲外なら nullptr）
+const Zone* findZone(uint8_t areaId, uint8_t zoneId) {
+  if ((areaId >= TimeZoneTable::AREA_COUNT) || (zoneId == 0) || (zoneId > AREAS[areaId].count)) {
+    return nullptr;
+  }
+  return &AREAS[areaId].zones[zoneId - 1];
+}
+
+}  // namespace
+
+constexpr uint8_t TimeZoneTable::AREA_COUNT;
+constexpr uint8_t TimeZoneTable::GMT_COUNT;
+constexpr uint8_t TimeZoneTable::NO_GMT;
+
+/**
+ * @brief Pr.35（UTCからの差の選択肢）の規則
+ * @param index Pr.35 の値
+ * @return 規則（範囲外なら nullptr）
+ */
+const TimeZoneRule* TimeZoneTable::fromGmtIndex(uint8_t index) {
+  if (index >= GMT_COUNT) {
+    return nullptr;
+  }
+  return &RULES[GMT_ZONES[index]];
+}
+
+/**
+ * @brief Pr.33/34（地域とタイムゾーン）の規則
+ * @param areaId Pr.33 の値
+ * @param zoneId Pr.34 の値（1から。0は未選択）
+ * @return 規則（未選択・範囲外なら nullptr）
+ */
+const TimeZoneRule* TimeZoneTable::fromZoneId(uint8_t areaId, uint8_t zoneId) {
+  const Zone* zone = findZone(areaId, zoneId);
+  return zone ? &RULES[zone->rule] : nullptr;
+}
+
+/**
+ * @brief Web画面が Pr.33/34 と一緒に送る Pr.35 の値
+ * @param areaId Pr.33 の値
+ * @param zoneId Pr.34 の値
+ * @return Pr.35 の値（Pr.35 にない差・未選択・範囲外なら NO_GMT）
+ */
+uint8_t TimeZoneTable::gmtIndexOf(uint8_t areaId, uint8_t zoneId) {
+  const Zone* zone = findZone(areaId, zoneId);
+  if (!zone) {
+    return NO_GMT;
+  }
+  return zone->gmt;
+}
+
+/**
+ * @brief 地域のタイムゾーンの数
+ * @param areaId Pr.33 の値
+ * @return タイムゾーンの数（範囲外なら 0）
+ */
+uint8_t TimeZoneTable::zoneCount(uint8_t areaId) {
+  return (areaId < AREA_COUNT) ? AREAS[areaId].count : 0;
+}
+
+/**
+ * @brief 地域名
+ * @param areaId Pr.33 の値
+ * @return 地域名（範囲外なら ""）
+ */
+const char* TimeZoneTable::areaName(uint8_t areaId) {
+  return (areaId < AREA_COUNT) ? AREAS[areaId].name : "";
+}
+
+/**
+ * @brief 規則の POSIX TZ
+ * @param rule fromGmtIndex() / fromZoneId() が返した規則
+ * @return POSIX TZ（"CET-1CEST,M3.5.0,M10.5.0/3" など。表にない規則なら ""）
+ */
+const char* TimeZoneTable::posixTz(const TimeZoneRule* rule) {
+  for (uint8_t i = 0; i < RULE_COUNT; ++i) {
+    if (rule == &RULES[i]) {
+      return RULE_NAMES[i];
+    }
+  }
+  return "";
+}"""
+
+
+def main(project_dir, zoneinfo_dir=None):
+    target = os.path.join(project_dir, "src", "TimeZoneTable.cpp")
+    zoneinfo_dir, version = find_zoneinfo(zoneinfo_dir)
+    if not zoneinfo_dir:
+        log("tzdata が見つからない（zoneinfo のディレクトリを指定する）")
+        return 1
+    if version != TZDATA_VERSION:
+        log("tzdata %s が必要（%s は %s）" % (TZDATA_VERSION, zoneinfo_dir, version))
+        return 1
+    text, rule_count, zone_count = generate(project_dir, zoneinfo_dir, version)
+    try:
+        with open(target, encoding="utf-8") as f:
+            if f.read() == text:
+                log("tzdata %s: 変更なし" % version)
+                return 0
+    except OSError:
+        pass
+    with open(target, "w", encoding="utf-8", newline="\n") as f:
+        f.write(text)
+    log("tzdata %s: %d zones, %d rules -> %s" % (version, zone_count, rule_count, os.path.relpath(target, project_dir)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(os.path.dirname(os.path.dirname(os.path.abspath(__file__))), sys.argv[1] if len(sys.argv) > 1 else None))
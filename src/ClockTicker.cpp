@@ -0,0 +1,210 @@
+/**
+ * @file ClockTicker.cpp
+ * @brief 秒の境界にそろえた時刻の刻み
+ * @details
+ * 時刻は再同期のときに TimeSource から読み、秒未満の値から次の秒の境界を求める。
+ * あいだの秒は境界ごとに1秒ずつ足すだけで、秒が59から0に戻るとき（分が変わるとき）だけ
+ * Converter で変換し直す。夏時間の切り替えやタイムゾーンの変更も、このときに反映される。
+ */
+#include "ClockTicker.h"
+
+/**
+ * @brief 時刻を読んで刻みを始める
+ * @param source 現在時刻を読む関数
+ * @param converter UNIX時間を表示する時刻に変換する関数（nullptrならUTC）
+ * @param nowUs 現在のmicros()
+ * @details 最初は時刻の秒未満から求めた境界で刻む。
+ */
+void ClockTicker::begin(const TimeSource& source, const Converter& converter, uint32_t nowUs) {
+  this->source = source;
+  this->converter = converter;
+  synced = false;
+  resyncRequested.store(false, std::memory_order_relaxed);
+  external = false;
+  sourceReads = 0;
+  nextUs = nowUs;
+  step(nowUs);
+}
+
+/**
+ * @brief 秒の境界を過ぎていれば時刻を進める
+ * @param nowUs 現在のmicros()
+ * @return 変わった欄（FIELD_*）。境界の前、または外部の境界で刻んでいるときは0
+ * @details 境界の前は比較1回で戻る。
+ */
+uint8_t ClockTicker::update(uint32_t nowUs) {
+  if (external || (static_cast<int32_t>(nowUs - nextUs) < 0)) {
+    return 0;
+  }
+  return step(nowUs);
+}
+
+/**
+ * @brief 外部の秒の境界で時刻を進める
+ * @param boundaryUs 秒の境界のmicros()（nowUs 以前）
+ * @param nowUs 現在のmicros()
+ * @return 変わった欄（FIELD_*）
+ * @details 外部の境界で刻んでいないときは何もしない。
+ */
+uint8_t ClockTicker::tick(uint32_t boundaryUs, uint32_t nowUs) {
+  if (!external) {
+    return 0;
+  }
+  nextUs = boundaryUs;
+  return step(nowUs);
+}
+
+/**
+ * @brief 外部の秒の境界で刻む
+ * @param enable true: tick() で刻む、false: 時刻の秒未満から求めた境界で刻む
+ * @details 切り替えたあとの最初の境界で時刻を読み直すため、秒が二重に進んだり飛んだりしない。
+ */
+void ClockTicker::setExternalTick(bool enable) {
+  if (external != enable) {
+    external = enable;
+    resyncRequested.store(true, std::memory_order_relaxed);
+  }
+}
+
+/**
+ * @brief 境界（nextUs）を過ぎたので時刻を進める
+ * @param nowUs 現在のmicros()
+ * @return 変わった欄（FIELD_*）
+ * @details
+ * 再同期の時期であれば時刻を読み直し、読めなければ1秒進めて次の秒で読み直す。
+ * 呼び出しが1秒以上遅れた場合は、遅れた秒数をまとめて進める。
+ */
+uint8_t ClockTicker::step(uint32_t nowUs) {
+  uint8_t changed = 0;
+  bool read = false;
+  if (!synced || resyncRequested.load(std::memory_order_acquire) || (sinceSync + 1u >= RESYNC_INTERVAL_S)) {   // この境界で間隔に達する
+    read = resync(nowUs, changed);
+    if (!read && !synced) {
+      nextUs = nowUs + RETRY_US;    // 最初の時刻が読めるまで待つ
+      return 0;
+    }
+  }
+  if (!read) {
+    uint32_t seconds = 1 + (nowUs - nextUs) / SECOND_US;
+    nextUs += seconds * SECOND_US;
+    changed = advance(seconds);
+  }
+
+  if ((changed != 0) && tickCallback) {
+    tickCallback(local, changed);
+  }
+  return changed;
+}
+
+/**
+ * @brief 次の秒の境界まで
+ * @param nowUs 現在のmicros()
+ * @return 次の秒の境界までの時間[us]（過ぎていれば0）
+ */
+uint32_t ClockTicker::untilNextUs(uint32_t nowUs) const {
+  int32_t remain = static_cast<int32_t>(nextUs - nowUs);
+  return remain > 0 ? static_cast<uint32_t>(remain) : 0;
+}
+
+/**
+ * @brief "HH?MM?SS" の変わった欄だけを書き換える
+ * @param hms 時の先頭（区切り文字は書き換えない）
+ * @param t 時刻
+ * @param changed 書き換える欄（FIELD_*）
+ */
+void ClockTicker::formatHms(char* hms, const struct tm& t, uint8_t changed) {
+  if (changed & FIELD_HOUR) putTwoDigits(hms, t.tm_hour);
+  if (changed & FIELD_MIN) putTwoDigits(hms + 3, t.tm_min);
+  if (changed & FIELD_SEC) putTwoDigits(hms + 6, t.tm_sec);
+}
+
+/**
+ * @brief 時刻を読み直す
+ * @param nowUs 現在のmicros()
+ * @param changed 変わった欄の格納先
+ * @return true 読めた
+ * @details
+ * 秒未満の値から次の秒の境界を求め直すため、刻みの位相もここで合う。
+ * 外部の境界で刻んでいるときは、境界（nextUs）でのシステム時刻に最も近い秒を境界の時刻とする。
+ */
+bool ClockTicker::resync(uint32_t nowUs, uint8_t& changed) {
+  time_t readEpoch = 0;
+  uint32_t subUs = 0;
+  bool requested = resyncRequested.exchange(false, std::memory_order_acq_rel);  // 読んでいるあいだの要求は次の境界で扱う
+  sourceReads++;
+  if (!source || !source(readEpoch, subUs)) {
+    if (requested) {
+      resyncRequested.store(true, std::memory_order_relaxed);
+    }
+    return false;
+  }
+  if (subUs >= SECOND_US) {
+    subUs = SECOND_US - 1;
+  }
+  if (external) {
+    int64_t atBoundaryUs = static_cast<int64_t>(subUs) - static_cast<int64_t>(nowUs - nextUs) + SECOND_US / 2;
+    readEpoch += static_cast<time_t>(atBoundaryUs >= 0 ? atBoundaryUs / SECOND_US
+                                                      : -((-atBoundaryUs + SECOND_US - 1) / SECOND_US));
+    nextUs += SECOND_US;
+  } else {
+    nextUs = nowUs + (SECOND_US - subUs);
+  }
+  sinceSync = 0;
+
+  bool first = !synced;
+  synced = true;
+  epoch = readEpoch;
+  changed = convert();
+  if (first) {
+    changed = FIELD_ALL;
+  }
+  return true;
+}
+
+/**
+ * @brief 時刻を進める
+ * @param seconds 進める秒数
+ * @return 変わった欄（FIELD_*）
+ * @details 秒だけが変わる場合は変換しない。
+ */
+uint8_t ClockTicker::advance(uint32_t seconds) {
+  epoch += seconds;
+  sinceSync = static_cast<uint16_t>((sinceSync + seconds < RESYNC_INTERVAL_S) ? sinceSync + seconds : RESYNC_INTERVAL_S);
+  if ((seconds == 1) && (local.tm_sec < 59)) {
+    local.tm_sec++;
+    return FIELD_SEC;
+  }
+  return convert();
+}
+
+/**
+ * @brief epoch を変換して変わった欄を求める
+ * @return 変わった欄（FIELD_*）
+ */
+uint8_t ClockTicker::convert(void) {
+  struct tm next = {};
+  if (converter) {
+    converter(epoch, next);
+  } else {
+    gmtime_r(&epoch, &next);
+  }
+  uint8_t changed = 0;
+  if (next.tm_sec != local.tm_sec) changed |= FIELD_SEC;
+  if (next.tm_min != local.tm_min) changed |= FIELD_MIN;
+  if (next.tm_hour != local.tm_hour) changed |= FIELD_HOUR;
+  if ((next.tm_mday != local.tm_mday) || (next.tm_mon != local.tm_mon) || (next.tm_year != local.tm_year)) {
+    changed |= FIELD_DATE;
+  }
+  local = next;
+  return changed;
+}
+
+/**
+ * @brief 2桁の数字を書き込む（終端文字は書かない）
+ * @param dst 書き込み先
+ * @param value 0～99
+ */
+void ClockTicker::putTwoDigits(char* dst, int value) {
+  dst[0] = static_cast<char>('0' + (value / 10) % 10);
+  dst[1] = static_cast<char>('0' + value % 10);
+}
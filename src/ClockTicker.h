@@ -0,0 +1,68 @@
+#pragma once
+
+#include <stdint.h>
+#include <time.h>
+#include <atomic>
+#include <functional>
+
+/**
+ * @brief 秒の境界にそろえた時刻の刻み
+ * - 時刻の読み込み（TimeSource）は再同期のときだけ行い、あいだは秒の境界ごとに1秒ずつ進める
+ * - 次の秒の境界をマイクロ秒で求めておくため、update() は時刻の比較1回で済む
+ * - 変わった欄（秒・分・時・日付）をビットで返し、表示側は変わった欄だけを書き換える
+ *
+ * 使い方：begin() のあと、ループから update() を呼ぶ。秒が変わったときだけ onTick() のコールバックが呼ばれる。
+ * 外部の秒の境界（RTCのSQWなど）で刻む場合は、setExternalTick(true) にして境界ごとに tick() を呼ぶ。
+ */
+class ClockTicker {
+public:
+  using TimeSource = std::function<bool(time_t& epoch, uint32_t& subUs)>;   // 現在時刻（UNIX時間と秒未満[us]）を読む
+  using Converter = std::function<void(time_t epoch, struct tm& out)>;      // UNIX時間を表示する時刻に変換する
+  using TickCallback = std::function<void(const struct tm& local, uint8_t changed)>;  // 秒が変わった
+
+  static constexpr uint32_t SECOND_US = 1000000UL;      // 1秒[us]
+  static constexpr uint16_t RESYNC_INTERVAL_S = 60;     // 時刻を読み直す間隔[s]
+  static constexpr uint32_t RETRY_US = 100000UL;        // 時刻が読めなかったときに読み直すまで[us]
+
+  static constexpr uint8_t FIELD_SEC = 0x01;    // 秒が変わった
+  static constexpr uint8_t FIELD_MIN = 0x02;    // 分が変わった
+  static constexpr uint8_t FIELD_HOUR = 0x04;   // 時が変わった
+  static constexpr uint8_t FIELD_DATE = 0x08;   // 日付が変わった
+  static constexpr uint8_t FIELD_ALL = 0x0F;
+
+  void begin(const TimeSource& source, const Converter& converter, uint32_t nowUs);  // 時刻を読んで刻みを始める
+  uint8_t update(uint32_t nowUs);               // 秒の境界を過ぎていれば時刻を進める（変わった欄を返す）
+  uint8_t tick(uint32_t boundaryUs, uint32_t nowUs);  // 外部の秒の境界で時刻を進める（変わった欄を返す）
+  void setExternalTick(bool enable);            // 外部の秒の境界で刻む（update() では進めない）
+  bool isExternalTick(void) const { return external; }
+  void requestResync(void) { resyncRequested.store(true, std::memory_order_release); }  // 次の秒の境界で時刻を読み直す（SNTP同期など。別のタスクからも可）
+  void onTick(const TickCallback& callback) { tickCallback = callback; }
+
+  bool isSynced(void) const { return synced; }                  // 時刻を読めている
+  time_t getEpoch(void) const { return epoch; }                 // 表示中の時刻（UNIX時間）
+  const struct tm& getLocal(void) const { return local; }       // 表示中の時刻
+  uint32_t untilNextUs(uint32_t nowUs) const;                   // 次の秒の境界まで[us]
+  uint32_t getSourceReads(void) const { return sourceReads; }   // 時刻を読んだ回数
+
+  static void formatHms(char* hms, const struct tm& t, uint8_t changed);  // "HH?MM?SS" の変わった欄だけを書き換える
+
+private:
+  TimeSource source;
+  Converter converter;
+  TickCallback tickCallback;
+
+  bool synced = false;            // 時刻を読めている
+  std::atomic<bool> resyncRequested{false};   // 次の境界で読み直す
+  bool external = false;          // 外部の秒の境界で刻む
+  time_t epoch = 0;               // 表示中の時刻
+  struct tm local = {};           // epoch を変換した時刻
+  uint32_t nextUs = 0;            // 次の秒の境界（micros()の値）
+  uint16_t sinceSync = 0;         // 読み直してからの秒数
+  uint32_t sourceReads = 0;       // 時刻を読んだ回数
+
+  uint8_t step(uint32_t nowUs);       // 境界（nextUs）を過ぎたので時刻を進める
+  bool resync(uint32_t nowUs, uint8_t& changed);  // 時刻を読み直す
+  uint8_t advance(uint32_t seconds);  // 時刻を進める
+  uint8_t convert(void);              // epoch を変換して変わった欄を求める
+  static void putTwoDigits(char* dst, int value);
+};
@@ -1,10 +1,27 @@
 #pragma once
 
+#include "I2CDeviceRegistry.h"
+
 #define SDA_PIN 13
 #define SCL_PIN 15
 #define I2C_FREQ 400000
 
 #define IR_RECEIVE_PIN 9
 
+#define RTC_SQW_PIN 8   // RTC（DS3231/DS1307）の1Hz矩形波出力（オープンドレイン）。配線しない場合は -1
+
+#define VFD_DIN_PIN   4   // VFDドライバ：シリアルデータ
+#define VFD_CLK_PIN   5   // VFDドライバ：シフトクロック
+#define VFD_LOAD_PIN  6   // VFDドライバ：ラッチ
+#define VFD_BLANK_PIN 7   // VFDドライバ：ブランク（High：全消灯）
+#define VFD_SHIFT_BITS 20 // VFDドライバのシフトレジスタのビット数（MAX6921）
+
 #define EEPROM_MAX_ADDRESS 0x0FFF   // EEPROM 24LC32の最大アドレス
 //#define EEPROM_MAX_ADDRESS 0x1FFF   // EEPROM 24LC64の最大アドレス
+#define EEPROM_PAGE_SIZE   (I2CDeviceRegistry::find(I2CADR_EEPROM)->pageSize)  // EEPROMのページサイズ（デバイスの表から取得）
+#define EEPROM_FLUSH_DELAY_MS 500   // 最後の書き込みからEEPROMへ書き戻すまでの時間[ms]
+
+#define PARAM_JOURNAL_ENABLE 0      // パラメータをジャーナル形式（追記・ウェアレベリング）で保存する（1:有効）
+#define PARAM_JOURNAL_START 0x0400  // パラメータジャーナル領域の開始アドレス
+#define PARAM_JOURNAL_END   0x0800  // パラメータジャーナル領域の終了アドレス（この手前まで使用）
+#define I2C_CLOCK_TABLE_ADDR 0x0800 // デバイスごとのSCL周波数の保存先（1ページ）
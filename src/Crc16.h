@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief CRC-16/CCITT-FALSE（多項式0x1021、初期値0xFFFF）を計算する
+ * @param data 対象データ
+ * @param len データ長
+ * @return CRC値
+ * EEPROMに保存するレコードの破損検出に使用する。
+ */
+inline uint16_t crc16Ccitt(const uint8_t *data, size_t len)
+{
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 0; i < len; ++i) {
+    crc ^= (uint16_t)data[i] << 8;
+    for (uint8_t bit = 0; bit < 8; ++bit) {
+      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+  }
+  return crc;
+}
@@ -1,3 +1,4 @@
+#include <string>
 #include "DisplayManager.h"
 #include "Config.h"
 
@@ -8,17 +9,45 @@ DisplayManager::DisplayManager(I2CBusManager* busManager)
 }
 
 void DisplayManager::begin(void) {
+  oledReady();   // 接続されていればM5UnitOLEDを初期化
 
-  if(i2cBus->isM5oledConnected()){
-    m5oledManager.begin();  // M5UnitOLEDの初期化
+  return;
+}
+
+/**
+ * @brief 積めなかったOLEDの送信を積み直す
+ * キューが満杯で送信を積めなかったときは、描画がなくてもここで積み直す。
+ */
+void DisplayManager::update(void) {
+  if (oledConnected && oledInitialized) {
+    m5oledManager.update();
   }
+}
 
-  return;
+/**
+ * @brief M5UnitOLEDが使えるか
+ * @return true: 接続済みで初期化済み
+ * 接続状態の世代番号が変わったときだけ判定し直す。
+ * 起動後に接続されたOLEDは、ここで初期化してから使う。
+ */
+bool DisplayManager::oledReady(void) {
+  uint32_t generation = i2cBus->getPresenceGeneration();
+  if (!presenceChecked || generation != presenceGeneration) {
+    presenceChecked = true;
+    presenceGeneration = generation;
+    bool connected = i2cBus->isM5oledConnected();
+    if (connected && !oledInitialized) {
+      m5oledManager.begin();  // M5UnitOLEDの初期化
+      oledInitialized = true;
+    }
+    oledConnected = connected;
+  }
+  return oledConnected && oledInitialized;
 }
 
 void DisplayManager::showMessage(const char* message) {
 
-  if(i2cBus->isM5oledConnected()){
+  if(oledReady()){
     m5oledManager.showMessage(0, 10, message);  // M5UnitOLEDにメッセージを表示
   }
 
@@ -29,13 +58,28 @@ void DisplayManager::showTime(int hour, int minute, int second, int position, co
   char timeStr[16];
   snprintf(timeStr, sizeof(timeStr), "%s:%02d:%02d:%02d", header, hour, minute, second);
 
-  if(i2cBus->isM5oledConnected()){
+  if(oledReady()){
     m5oledManager.showMessage(0, position, timeStr);
   }
 
   return;
 }
 
+/**
+ * @brief 位置を指定して文字列を表示
+ * @param positionX X座標[ドット]
+ * @param positionY Y座標[ドット]
+ * @param text 文字列
+ * 行の一部（変わった欄だけ）を書き換えるときに使う。
+ */
+void DisplayManager::showText(uint8_t positionX, uint8_t positionY, const char* text) {
+  if(oledReady()){
+    m5oledManager.showMessage(positionX, positionY, text);
+  }
+
+  return;
+}
+
 /**
  * @brief M5UnitOLEDの管理クラスのコンストラクタ
  */
@@ -47,29 +91,104 @@ M5oledManager::M5oledManager(I2CBusManager* busManager)
 
 /**
  * @brief M5UnitOLEDの初期化
+ * 初期化後のパネルの内容はわからないため、フレームバッファ全体を送り直す。
  */
 void M5oledManager::begin(void) {
   std::lock_guard<std::recursive_mutex> lock(i2cBus->getMutex());
   
-  oled.init(SDA_PIN, SCL_PIN, I2C_FREQ);  // SDA,SCL必須
-  oled.setRotation(1);            // テキストの表示方向を縦方向に設定
-  oled.setTextSize(1);
-  oled.setCursor(0, 0);           // テキストのカーソル位置を左上に設定。
-  oled.startWrite();
-  oled.print("hello OLED!!");
-  oled.endWrite();
+  oled.init(SDA_PIN, SCL_PIN, i2cBus->getClock(I2CADR_M5OLED));  // SDA,SCL必須（周波数は調整済みの値）
+  i2cBus->invalidateClock();      // LovyanGFXがポートを設定し直したため、次のWireのトランザクションで周波数を設定する
+  oled.setRotation(1);            // 横向き（OledFrameBuffer::WIDTH×HEIGHT）
+  frame.clear();
+  frame.drawText(0, 0, "hello OLED!!");
+  frame.invalidate();
+  while (flushNextPage()) {       // 初期化中は全ページをその場で送る
+  }
 }
 
 /**
  * @brief M5UnitOLEDにメッセージを表示
- * @param positionX X座標 (0-63)
- * @param positionY Y座標 (0-31)
+ * @param positionX X座標[ドット]
+ * @param positionY Y座標[ドット]（8の倍数でなくてもよい）
  * @param message メッセージ
+ * フレームバッファに描くだけで、送信はI2CBusManager::update()で実行される。
+ * 同じ内容を描いても送信は発生しない。
  */
 void M5oledManager::showMessage(uint8_t positionX, uint8_t positionY, const char* message) {
-  std::lock_guard<std::recursive_mutex> lock(i2cBus->getMutex());
+  frame.drawText(positionX, positionY, message ? message : "");
+  requestFlush();
+}
+
+/**
+ * @brief 積めなかった送信を積み直す
+ */
+void M5oledManager::update(void) {
+  if (flushPending && !flushQueued) {
+    requestFlush();
+  }
+}
+
+/**
+ * @brief 変わった範囲の送信をキューに積む
+ * 描画を何回しても、キューに積む送信は1件にまとめる。
+ * キューが満杯で積めなかったときは、update()で積み直す。
+ */
+void M5oledManager::requestFlush(void) {
+  flushPending = true;
+  if (flushQueued) {
+    return;
+  }
+  // 送信は優先度の低い処理としてキューに積み、RTCやEEPROMのアクセスを待たせない
+  flushQueued = i2cBus->submit(I2CPriority::Bulk, [this]() {
+    flushQueued = false;
+    if (flushNextPage()) {
+      requestFlush();             // 次のページは別の処理として積む
+    }
+    return true;
+  });
+}
 
-  oled.setCursor(positionX, positionY);
-  oled.print(message);
+/**
+ * @brief 変わった範囲のあるページを1つOLEDへ送る
+ * @return true 1ページ送った（残りがあるかもしれない）、false 送る範囲がない
+ * @details 送る前に範囲を送ったことにして内容を写し取るため、送っている間に描いた内容は次の送信で送られる。
+ * 1回の呼び出しは1ページ分で、その間はバスを占有する。
+ */
+bool M5oledManager::flushNextPage(void) {
+  OledSpan spans[OledFrameBuffer::MAX_SPANS];
+  uint8_t sent[OledFrameBuffer::WIDTH];
+  for (uint8_t n = 0; n < OledFrameBuffer::PAGES; ++n) {
+    uint8_t page = (nextPage + n) % OledFrameBuffer::PAGES;
+    size_t count = frame.takeDirty(page, spans, OledFrameBuffer::MAX_SPANS, sent);
+    if (count == 0) {
+      continue;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      pushSpan(spans[i], sent);
+    }
+    nextPage = (page + 1) % OledFrameBuffer::PAGES;
+    return true;
+  }
+  flushPending = false;
+  return false;
+}
+
+/**
+ * @brief 範囲をOLEDへ送る
+ * @param span 範囲（1ページ内の連続した列）
+ * @param data ページの内容（span の列を使う）
+ * @details LovyanGFXの内部バッファへ書き、endWrite()で書き換えた範囲だけがOLEDへ送られる。
+ * 送信はLovyanGFXのドライバが初期化時の周波数で行い、Wireの周波数はこの後のトランザクションで設定し直される。
+ */
+void M5oledManager::pushSpan(const OledSpan& span, const uint8_t* data) {
+  I2CTransaction transaction(*i2cBus, I2CADR_M5OLED);   // 範囲1つ分の占有時間を計測
+  int32_t top = span.page * 8;
+  oled.startWrite();
+  for (uint8_t x = span.x0; x <= span.x1; ++x) {
+    for (uint8_t bit = 0; bit < 8; ++bit) {
+      oled.writePixel(x, top + bit, ((data[x] >> bit) & 0x01) ? TFT_WHITE : TFT_BLACK);
+    }
+  }
   oled.endWrite();
-}
\ No newline at end of file
+  transaction.addBytes(OledFrameBuffer::spanBytes(span));
+}
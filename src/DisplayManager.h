@@ -3,9 +3,12 @@
 #include <M5UnitOLED.h>
 #include <M5Unified.h>
 #include "I2CBusManager.h"
+#include "OledFrameBuffer.h"
 
 /**
  * @brief M5UnitOLEDの管理クラス
+ * 文字はフレームバッファに描き、前回送った内容から変わった列だけをOLEDへ送る。
+ * 送信は1ページ（縦8ドット）ずつ1件の処理としてI2Cのキューに積むため、ページの間にRTCなどの処理が入れる。
  */
 class M5oledManager {
 public:
@@ -13,10 +16,19 @@ public:
 
   void begin(void); // M5UnitOLEDの初期化
   void showMessage(uint8_t positionX = 0, uint8_t positionY = 0, const char* message = nullptr);  // M5UnitOLEDにメッセージを表示
+  void update(void);  // 積めなかった送信を積み直す（メインループから呼ぶ）
 
 private:
   I2CBusManager* i2cBus;
   M5UnitOLED oled;
+  OledFrameBuffer frame;          // 表示内容（オフスクリーン）
+  bool flushQueued = false;       // 送信処理をキューに積んだ
+  bool flushPending = false;      // 送っていない範囲があるかもしれない
+  uint8_t nextPage = 0;           // 次に送るページ
+
+  void requestFlush(void);        // 変わった範囲の送信をキューに積む
+  bool flushNextPage(void);       // 変わった範囲のあるページを1つOLEDへ送る
+  void pushSpan(const OledSpan& span, const uint8_t* data);  // 範囲をOLEDへ送る
 };
 
 
@@ -28,11 +40,20 @@ public:
   DisplayManager(I2CBusManager* busManager);
   ~DisplayManager() = default;
   void begin(void);
+  void update(void);              // 積めなかったOLEDの送信を積み直す（メインループから呼ぶ）
 
   void showMessage(const char* message);
   void showTime(int hour, int minute, int second, int position = 0, const char* header = "");
+  void showText(uint8_t positionX, uint8_t positionY, const char* text);  // 位置を指定して文字列を表示
+  bool isReady(void) { return oledReady(); }                             // OLEDに表示できるか
 
 private:
   I2CBusManager* i2cBus = nullptr;
   M5oledManager m5oledManager;  // M5UnitOLEDの管理クラス
+
+  bool presenceChecked = false;     // 接続状態を判定済み
+  uint32_t presenceGeneration = 0;  // 判定したときの接続状態の世代番号
+  bool oledConnected = false;       // M5UnitOLEDが接続されている
+  bool oledInitialized = false;     // M5UnitOLEDを初期化済み
+  bool oledReady(void);             // M5UnitOLEDが使えるか
 };
@@ -1,6 +1,6 @@
-#include <sstream>
-#include <iomanip>
+#include <algorithm>
 #include <cstring>
+#include <cstdint>
 #include "Config.h"
 #include "EepromManager.h"
 
@@ -8,6 +8,11 @@ EepromManager::EepromManager(I2CBusManager *busManager)
   : i2cBus(busManager)  // I2CBusManagerの参照を設定
   , rawAccessor(busManager)  // EepromRawAccessorを初期化
 {
+  memset(shadow, 0xFF, sizeof(shadow));    // 未読み込み時は消去状態とみなす
+  memset(dirtyStart, 0, sizeof(dirtyStart));
+  memset(dirtyEnd, 0, sizeof(dirtyEnd));
+  memset(writeFailed, 0, sizeof(writeFailed));
+  memset(pageLoaded, true, sizeof(pageLoaded));   // begin()の前は消去状態のEEPROMとして読み書きできる
 }
 
 /**
@@ -16,11 +21,43 @@ EepromManager::EepromManager(I2CBusManager *busManager)
  * この関数は、I2Cバスを初期化し、EEPROMの低レベルアクセスを行うEepromRawAccessorを初期化します。
  * i2cBusはI2CBusManagerのインスタンスを参照し、EEPROMへのアクセスを排他制御するためのミューテックスを使用します。
  * この関数は、EEPROMの初期化を行い、I2Cバスの設定を行います。
+ * 初期化後、EEPROM全体を連続読み込みでRAMシャドウへ読み込む。以降の読み込みはRAMから行う。
+ * LOAD_RETRIES回試しても読み込めなかったページは、シャドウの内容が正しくないため、読み書きとも失敗を返す
+ * （EEPROMの内容を、読めなかったシャドウの内容で上書きしない）。
  */
 void EepromManager::begin(void) {
   std::lock_guard<std::recursive_mutex> lock(i2cBus->getMutex());
+  std::lock_guard<std::recursive_mutex> eepromLock(getMutex());
 
   rawAccessor.begin();  // EepromRawAccessorを初期化
+
+  loadFailed = false;
+  for (uint16_t address = 0; address < SHADOW_SIZE; address += LOAD_CHUNK_SIZE) {
+    uint8_t len = std::min<uint16_t>(LOAD_CHUNK_SIZE, SHADOW_SIZE - address);
+    bool loaded = false;
+    for (uint8_t attempt = 0; (attempt < LOAD_RETRIES) && !loaded; ++attempt) {
+      loaded = rawAccessor.sequentialRead(address, &shadow[address], len);   // EEPROM全体をシャドウへ読み込む
+    }
+    if (!loaded) {
+      memset(&shadow[address], 0xFF, len);
+      loadFailed = true;
+    }
+    for (uint16_t page = address / EEPROM_PAGE_SIZE; page <= (address + len - 1) / EEPROM_PAGE_SIZE; ++page) {
+      pageLoaded[page] = loaded;
+    }
+  }
+  memset(dirtyStart, 0, sizeof(dirtyStart));
+  memset(dirtyEnd, 0, sizeof(dirtyEnd));
+  dirtyPageCount = 0;
+}
+
+/**
+ * @brief 起動時にEEPROM全体をシャドウへ読み込めたか
+ * @return true すべて読み込めた、false 読み込めなかったページがある（そのページは読み書きできない）
+ */
+bool EepromManager::isLoaded(void) {
+  std::lock_guard<std::recursive_mutex> lock(getMutex());
+  return !loadFailed;
 }
 
 /**
@@ -31,35 +68,36 @@ std::recursive_mutex& EepromManager::getMutex() {
   return eepromMutex;  // EEPROM専用のミューテックスを返す
 }
 
-#ifdef DELETE
 /**
- * @brief バイト単位でデータを書き込む
+ * @brief 複数バイトのデータを書き込む
  * @param address 書き込み開始アドレス
  * @param data 書き込むデータのポインタ
  * @param len 書き込むデータの長さ
  * @return true 成功、false 失敗
+ * RAMシャドウを更新し、値が変化したページを未書き込みとして記録する。
+ * EEPROMへの書き込みはupdate()またはflush()で行う。
  */
-bool EepromManager::writeBytes(int address, const void* data, size_t len) {
+bool EepromManager::writeBytes(uint16_t address, const uint8_t *data, uint16_t len) {
   std::lock_guard<std::recursive_mutex> lock(getMutex());
-  if (address < 0 || address + len > EEPROM_MAX_ADDRESS) {
+  if (address + len > EEPROM_MAX_ADDRESS) {
     return false;  // 範囲外アクセスを防止
   }
-  return rawAccessor.writeBytes(address, data, len);  // データ書き込み
+  return storeShadow(address, data, len);
 }
-#endif
 
 /**
  * @brief データを1バイト書き込む
  * @param address 書き込みアドレス
  * @param data 書き込むデータ
  * @return true 成功、false 失敗
+ * RAMシャドウを更新し、EEPROMへの書き込みはupdate()またはflush()で行う。
  */
 bool EepromManager::writeByte(uint16_t address, const uint8_t data) {
   std::lock_guard<std::recursive_mutex> lock(getMutex());
   if (address >= EEPROM_MAX_ADDRESS) {
     return false;  // 範囲外アクセスを防止
   }
-  return rawAccessor.writeByte(address, data);  // 単一バイトのデータ書き込み
+  return storeShadow(address, &data, 1);
 }
 
 #ifdef DELETE
@@ -84,73 +122,548 @@ bool EepromManager::readBytes(int address, void* data, size_t len) {
  * @param address 読み出しアドレス
  * @param data 読み出したデータを格納するポインタ
  * @return true 成功、false 失敗
+ * RAMシャドウから読み出すため、I2Cバスへのアクセスは発生しない。
  */
 bool EepromManager::readByte(uint16_t address, uint8_t *data) {
   std::lock_guard<std::recursive_mutex> lock(getMutex());
-  if (address >= EEPROM_MAX_ADDRESS) {
-    return false;  // 範囲外アクセスを防止
+  if (address >= EEPROM_MAX_ADDRESS || !isRangeLoaded(address, 1)) {
+    return false;  // 範囲外アクセス・読み込めなかったページ
   }
-  
-  return rawAccessor.readByte(address, data);
+  *data = shadow[address];
+  return true;
 }
 
 /**
- * @brief i2c EEPROMから複数バイト読み込み
+ * @brief 複数バイト読み込み
  * @param address 読み込み開始アドレス
  * @param data 読み込んだデータを格納するバッファ
  * @param len 読み込むデータの長さ
  * @return true 成功、false 失敗
+ * RAMシャドウから読み出すため、I2Cバスへのアクセスは発生しない。
  */
 bool EepromManager::readMultipleBytes(int address, uint8_t *data, size_t len) {
   std::lock_guard<std::recursive_mutex> lock(getMutex());
-  return rawAccessor.sequentialRead( address, data, len);
+  if (address < 0 || address + len > SHADOW_SIZE || !isRangeLoaded(address, len)) {
+    return false;  // 範囲外アクセス・読み込めなかったページ
+  }
+  memcpy(data, &shadow[address], len);
+  return true;
 }
 
 /**
  * @brief EEPROMデータをダンプする
  * @param address 開始アドレス
- * @param len ダンプするデータの長さ（デフォルトは16バイト）
- * @return ダンプ結果の文字列
+ * @param len ダンプするデータの長さ
+ * @param sink 1行ごとに呼ばれる出力先（行の文字列、文字数）
+ * @param yieldFn 1行（32バイト）ごとに呼ばれる待ち処理（nullptrなら待たない）
+ * @return true 成功、false 引数不正または読み込み失敗あり
+ *  固定長の行バッファへ16進数を直接書き込み、ヒープを使わずに1行ずつsinkへ渡す。
+ *  32バイトごとに1回でまとめて読み込み、ミューテックスはその間だけ保持する。
+ *  yieldFnの呼び出し中はミューテックスを解放しているため、他のタスクはEEPROMを使える。
  */
-std::string EepromManager::dumpEepromData(uint16_t address, uint16_t len)
+bool EepromManager::dumpEepromData(uint16_t address, uint16_t len, const DumpSink& sink, const DumpYield& yieldFn)
 {
-  std::ostringstream oss;
-  uint16_t startADR = address;
-  uint16_t endADR = std::min<uint16_t>(address + len - 1, EEPROM_MAX_ADDRESS);
-  uint8_t datasq[16];
-  char ascii[17]; // 16文字+終端
-  ascii[16] = '\0';
+  if (!sink || len == 0 || address >= SHADOW_SIZE) {
+    return false;
+  }
 
-  std::lock_guard<std::recursive_mutex> lock(getMutex());
+  uint16_t endADR = std::min<uint32_t>((uint32_t)address + len, SHADOW_SIZE);  // 終端（この手前まで）
+  bool ok = true;
+
+  for (uint16_t rowADR = address; rowADR < endADR; ) {
+    bool readOk;
+    rowADR = dumpEepromRow(address, rowADR, endADR, sink, readOk);
+    ok = ok && readOk;
+
+    if (yieldFn && rowADR < endADR) {
+      yieldFn();    // 表示やWiFiの処理を止めないよう行ごとに他の処理へ譲る
+    }
+  }
+  return ok;
+}
 
-  for (uint16_t ADR = startADR; ADR <= endADR; ADR += 16) {
-    size_t bytesToRead = std::min<size_t>(16, endADR - ADR + 1);
-    memset(datasq, 0, sizeof(datasq));
-    memset(ascii, ' ', 16);
+/**
+ * @brief EEPROMデータを32バイト分ダンプする
+ * @param origin ダンプ全体の開始アドレス（ここから0x100ごとにヘッダを出力する）
+ * @param address 今回の開始アドレス
+ * @param endAddress ダンプ全体の終端（この手前まで、読み込み可能な範囲で打ち切る）
+ * @param sink 1行ごとに呼ばれる出力先（行の文字列、文字数）
+ * @param readOk 読み込みに成功したかの格納先
+ * @return 次に出力するアドレス（endAddress以上なら終了）
+ *  呼び出し元のループ1回につき1回ずつ呼び出せば、待ち処理なしでダンプを分割できる。
+ */
+uint16_t EepromManager::dumpEepromRow(uint16_t origin, uint16_t address, uint16_t endAddress, const DumpSink& sink, bool& readOk)
+{
+  static const char HEADER[] = "\nADDR  0  1  2  3  4  5  6  7  8  9  A  B  C  D  E  F  ASCII CHARACTER\n";
+  if (endAddress > SHADOW_SIZE) {
+    endAddress = SHADOW_SIZE;
+  }
+  if (!sink || address >= endAddress) {
+    readOk = false;
+    return endAddress;
+  }
+
+  uint16_t rowLen = endAddress - address;
+  if (rowLen > DUMP_ROW_SIZE) rowLen = DUMP_ROW_SIZE;
+  uint8_t row[DUMP_ROW_SIZE];
+  char line[DUMP_LINE_SIZE];
+  readOk = readMultipleBytes(address, row, rowLen);   // 1行分をまとめて読み込む
 
-    if (!readMultipleBytes(ADR, datasq, bytesToRead)) {
-      oss << std::setw(4) << std::setfill('0') << std::hex << ADR << "  <Read Error>\n";
-      continue;
+  for (uint16_t offset = 0; offset < rowLen; offset += DUMP_BYTES_PER_LINE) {
+    uint16_t ADR = address + offset;
+    if ((uint16_t)(ADR - origin) % 0x100 == 0) {
+      sink(HEADER, sizeof(HEADER) - 1);
     }
+    size_t n = readOk ? formatDumpLine(line, ADR, &row[offset], std::min<uint16_t>(DUMP_BYTES_PER_LINE, rowLen - offset))
+                      : formatDumpLine(line, ADR, nullptr, 0);
+    sink(line, n);
+  }
+  return address + rowLen;
+}
+
+/**
+ * @brief ダンプ1行分を整形する
+ * @param line 出力先（DUMP_LINE_SIZEバイト以上）
+ * @param address 行の先頭アドレス
+ * @param data 行のデータ（nullptrなら読み込みエラー行）
+ * @param len データのバイト数（16以下、不足分は空白で埋める）
+ * @return 行の文字数（改行を含む、終端文字は含まない）
+ */
+size_t EepromManager::formatDumpLine(char *line, uint16_t address, const uint8_t *data, size_t len)
+{
+  static const char HEX_DIGITS[] = "0123456789abcdef";
+  size_t pos = 0;
+  line[pos++] = HEX_DIGITS[(address >> 12) & 0x0F];
+  line[pos++] = HEX_DIGITS[(address >> 8) & 0x0F];
+  line[pos++] = HEX_DIGITS[(address >> 4) & 0x0F];
+  line[pos++] = HEX_DIGITS[address & 0x0F];
 
-    if ((ADR & 0x00FF) == (startADR % 0x100)) {
-      oss << "\nADDR  0  1  2  3  4  5  6  7  8  9  A  B  C  D  E  F  ASCII CHARACTER\n";
+  if (data == nullptr) {
+    static const char READ_ERROR[] = "  <Read Error>\n";
+    memcpy(&line[pos], READ_ERROR, sizeof(READ_ERROR) - 1);
+    return pos + sizeof(READ_ERROR) - 1;
+  }
+
+  line[pos++] = ' ';
+  char *ascii = &line[pos + 3 * DUMP_BYTES_PER_LINE + 1];
+  for (size_t j = 0; j < DUMP_BYTES_PER_LINE; ++j) {
+    if (j < len) {
+      line[pos++] = ' ';
+      line[pos++] = HEX_DIGITS[data[j] >> 4];
+      line[pos++] = HEX_DIGITS[data[j] & 0x0F];
+      ascii[j] = (data[j] >= 0x20 && data[j] < 0x7F) ? (char)data[j] : '.';
+    } else {
+      line[pos++] = ' ';
+      line[pos++] = ' ';
+      line[pos++] = ' ';
+      ascii[j] = ' ';
     }
+  }
+  line[pos++] = ' ';
+  pos += DUMP_BYTES_PER_LINE;
+  line[pos++] = '\n';
+  return pos;
+}
 
-    oss << std::setw(4) << std::setfill('0') << std::hex << ADR << " ";
-    for (size_t j = 0; j < 16; ++j) {
-      if (j < bytesToRead) {
-        oss << " " << std::setw(2) << std::setfill('0') << std::hex << (int)datasq[j];
-        ascii[j] = (datasq[j] >= 0x20 && datasq[j] < 0x7F) ? datasq[j] : '.';
-      } else {
-        oss << "   ";
-        ascii[j] = ' ';
+/**
+ * @brief RAMシャドウを更新し、値が変化した範囲を未書き込みとして記録する
+ * @param address 書き込み開始アドレス
+ * @param data 書き込むデータ
+ * @param len 書き込むデータの長さ
+ * @return true 成功、false トランザクションで変更できるページ数を超えた、または起動時に読み込めなかったページ
+ * 同じ値の書き込みはEEPROMへ書き込まない。
+ */
+bool EepromManager::storeShadow(uint16_t address, const uint8_t *data, uint16_t len) {
+  if (!isRangeLoaded(address, len)) {
+    return false;
+  }
+  if (txnDepth > 0 && !saveTxnPages(address, len)) {
+    return false;
+  }
+  for (uint16_t i = 0; i < len; ++i) {
+    if (shadow[address + i] != data[i]) {
+      shadow[address + i] = data[i];
+      markDirty(address + i);
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief 1バイト分の未書き込み範囲を記録する
+ * @param address 変化したアドレス
+ * ページごとに未書き込み範囲（先頭・終端オフセット）を広げて記録する。
+ */
+void EepromManager::markDirty(uint16_t address) {
+  uint16_t page = address / EEPROM_PAGE_SIZE;
+  uint8_t offset = address % EEPROM_PAGE_SIZE;
+
+  if (dirtyEnd[page] == 0) {
+    dirtyStart[page] = offset;
+    dirtyEnd[page] = offset + 1;
+    dirtyPageCount++;
+  } else {
+    dirtyStart[page] = std::min<uint8_t>(dirtyStart[page], offset);
+    dirtyEnd[page] = std::max<uint8_t>(dirtyEnd[page], offset + 1);
+  }
+  writePending = true;   // 書き戻し遅延の計測をやり直す
+}
+
+/**
+ * @brief 次の未書き込みページの書き込みを開始する
+ * @return true 書き込み開始、false 未書き込みページなし、または送信失敗
+ * 書き込み開始時にシャドウの内容を送信するため、書き込みサイクル中に
+ * 同じページが更新された場合は、再び未書き込みとして記録される。
+ * 送信に失敗した範囲は completeWrite() で未書き込みに戻す。
+ */
+bool EepromManager::startNextPage(void) {
+  if (dirtyPageCount == 0) {
+    return false;
+  }
+
+  uint16_t page = nextFlushPage;
+  while (dirtyEnd[page] == 0) {
+    page = (page + 1) % PAGE_COUNT;
+  }
+  nextFlushPage = (page + 1) % PAGE_COUNT;
+
+  activeAddress = page * EEPROM_PAGE_SIZE + dirtyStart[page];
+  activeLen = dirtyEnd[page] - dirtyStart[page];
+  dirtyEnd[page] = 0;
+  dirtyPageCount--;
+
+  if (!rawAccessor.startPageWrite(activeAddress, &shadow[activeAddress], activeLen)) {
+    completeWrite(false);   // 送信失敗
+    return false;
+  }
+  writeActive = true;
+  return true;
+}
+
+/**
+ * @brief 書き戻しを1ステップ進める
+ * @param nowMs 現在時刻[ms]
+ * メインループから周期的に呼び出す。最後の書き込みから遅延時間が経過したら、
+ * 未書き込みのページを1ページずつ書き込む。1回の呼び出しで行うバスアクセスは、
+ * ページ書き込みの送信、またはACKポーリング1回のどちらかのみで、書き込みサイクルの完了は待たない。
+ * 書き込みに失敗したページは未書き込みのまま残し、失敗のたびに倍になる間隔（RETRY_MIN_MS～RETRY_MAX_MS）で再試行する。
+ */
+void EepromManager::update(uint32_t nowMs) {
+  std::lock_guard<std::recursive_mutex> lock(getMutex());
+
+  if (writeActive) {
+    WriteCycleState state = rawAccessor.pollWriteComplete();   // ACKポーリング
+    if (state != WriteCycleState::InProgress) {
+      completeWrite(state == WriteCycleState::Complete);
+    }
+    return;
+  }
+
+  if (dirtyPageCount == 0 || txnDepth > 0) {
+    return;   // トランザクション中は確定するまで書き戻さない
+  }
+  if (writePending) {
+    writePending = false;
+    lastWriteMs = nowMs;    // 書き込みを検出した時刻から遅延時間を計測
+  }
+  if (nowMs - lastWriteMs < flushDelayMs) {
+    return;   // 連続した書き込みがまとまるまで待つ
+  }
+  if (retryPending) {
+    retryPending = false;
+    retryFromMs = nowMs;    // 失敗を検出した時刻から再試行までの時間を計測
+  }
+  if (nowMs - retryFromMs < retryDelayMs) {
+    return;   // 書き込みに失敗したあとは、間隔を空けて再試行する
+  }
+  if (!rawAccessor.usesWriteCycle()) {
+    flush();  // ESP32のEEPROMは書き込みサイクルがないため、全ページを1回のcommitで書き込む
+    return;
+  }
+  startNextPage();
+}
+
+/**
+ * @brief 書き込み完了処理
+ * @param success 書き込み成否
+ * @details 失敗した範囲は未書き込みに戻し、そのページが書き込めるまで状態をErrorのままにする。
+ */
+void EepromManager::completeWrite(bool success) {
+  writeActive = false;
+  lastWriteFailed = !success;
+
+  uint16_t page = activeAddress / EEPROM_PAGE_SIZE;
+  if (success) {
+    if (writeFailed[page]) {
+      writeFailed[page] = false;      // 失敗したページが書き込めた
+      failedPageCount--;
+      if (failedPageCount == 0) {
+        retryDelayMs = 0;
       }
     }
-    oss << " ";
-    oss.write(ascii, 16);
-    oss << "\n";
+  } else {
+    restoreDirty(activeAddress, activeLen);
+    if (!writeFailed[page]) {
+      writeFailed[page] = true;
+      failedPageCount++;
+    }
+    retryDelayMs = (retryDelayMs == 0) ? RETRY_MIN_MS
+                 : (retryDelayMs < RETRY_MAX_MS / 2) ? retryDelayMs * 2 : RETRY_MAX_MS;
+    retryPending = true;
+  }
+
+  if (writeCompleteCallback) {
+    writeCompleteCallback(activeAddress, activeLen, success);   // 完了通知
+  }
+}
+
+/**
+ * @brief 書き込めなかった範囲を未書き込みに戻す
+ * @param address 先頭アドレス
+ * @param len バイト数（1ページ内）
+ * @details 書き込みサイクル中に同じページが更新されていれば、その範囲と合わせる。
+ * トランザクション中に退避したページなら、破棄で戻す内容にも未書き込みとして残す。
+ */
+void EepromManager::restoreDirty(uint16_t address, uint8_t len) {
+  if (len == 0) {
+    return;
+  }
+  uint16_t page = address / EEPROM_PAGE_SIZE;
+  uint8_t start = address % EEPROM_PAGE_SIZE;
+  uint8_t end = start + len;
+
+  if (dirtyEnd[page] == 0) {
+    dirtyStart[page] = start;
+    dirtyEnd[page] = end;
+    dirtyPageCount++;
+  } else {
+    dirtyStart[page] = std::min<uint8_t>(dirtyStart[page], start);
+    dirtyEnd[page] = std::max<uint8_t>(dirtyEnd[page], end);
+  }
+
+  for (uint8_t i = 0; i < txnPageCount; ++i) {
+    TxnPage& saved = txnPages[i];
+    if (saved.page == page) {
+      saved.dirtyStart = (saved.dirtyEnd == 0) ? start : std::min<uint8_t>(saved.dirtyStart, start);
+      saved.dirtyEnd = std::max<uint8_t>(saved.dirtyEnd, end);
+    }
+  }
+}
+
+/**
+ * @brief 未書き込みのページをすべてEEPROMへ書き込む
+ * @return true すべて成功、false 失敗あり
+ * 再起動の前に呼び出す（SystemControllerがesp_restart()のシャットダウンハンドラに登録している）。
+ * 電源断では呼ばれないため、最後の書き込みからEEPROM_FLUSH_DELAY_MS以内の内容は失われる。
+ * 遅延時間に関係なく即座に書き込み、書き込みサイクルはACKポーリングで待つ。
+ * ESP32のEEPROMでは全ページを1回のcommitで確定する。トランザクション中は書き込まずにfalseを返す。
+ * 書き込めなかったページは未書き込みのまま残り、update()で再試行する。
+ */
+bool EepromManager::flush(void) {
+  std::lock_guard<std::recursive_mutex> lock(getMutex());
+  bool ok = true;
+
+  if (txnDepth > 0) {
+    return false;   // 未確定の内容は書き込まない
+  }
+  if (writeActive) {
+    completeWrite(rawAccessor.waitWriteComplete());
+    ok = !lastWriteFailed;
+  }
+  rawAccessor.beginBatch();
+  uint16_t attempts = dirtyPageCount;     // 書き込めなかったページは未書き込みに戻るため、1ページ1回まで
+  while ((dirtyPageCount > 0) && (attempts-- > 0)) {
+    if (startNextPage()) {
+      completeWrite(rawAccessor.waitWriteComplete());
+    }
+    ok = ok && !lastWriteFailed;
+  }
+  ok = rawAccessor.commitBatch() && ok;
+  writePending = false;
+  return ok;
+}
+
+/**
+ * @brief トランザクションを開始する
+ * @return true 成功、false 入れ子が深すぎる
+ * commitTransaction()またはabortTransaction()までEEPROMのミューテックスを保持し、
+ * 書き戻しを停止する。入れ子にした場合は、最も外側の確定で確定する。
+ */
+bool EepromManager::beginTransaction(void) {
+  getMutex().lock();
+  if (txnDepth == UINT8_MAX) {
+    getMutex().unlock();
+    return false;
+  }
+  txnDepth++;
+  return true;
+}
+
+/**
+ * @brief トランザクションを確定する
+ * @return true 成功、false トランザクション中でない
+ * 変更したページは通常の書き戻しの対象となり、遅延時間経過後にページ単位で書き込まれる。
+ * ESP32のEEPROMでは、変更したページをまとめて1回のcommitで確定する。
+ */
+bool EepromManager::commitTransaction(void) {
+  std::lock_guard<std::recursive_mutex> lock(getMutex());
+  if (txnDepth == 0) {
+    return false;
+  }
+  txnDepth--;
+  if (txnDepth == 0) {
+    txnPageCount = 0;   // 退避した内容を破棄
+  }
+  getMutex().unlock();  // beginTransaction()で取得した分を解放
+  return true;
+}
+
+/**
+ * @brief トランザクションを破棄し、開始時点の内容に戻す
+ * 入れ子の場合も、最も外側のトランザクションごと破棄する。
+ */
+void EepromManager::abortTransaction(void) {
+  std::lock_guard<std::recursive_mutex> lock(getMutex());
+  if (txnDepth == 0) {
+    return;
+  }
+
+  for (uint8_t i = 0; i < txnPageCount; ++i) {
+    const TxnPage& saved = txnPages[i];
+    bool wasDirty = saved.dirtyEnd != 0;
+    bool isDirty = dirtyEnd[saved.page] != 0;
+    if (wasDirty && !isDirty) {
+      dirtyPageCount++;
+    } else if (!wasDirty && isDirty) {
+      dirtyPageCount--;
+    }
+    dirtyStart[saved.page] = saved.dirtyStart;
+    dirtyEnd[saved.page] = saved.dirtyEnd;
+    memcpy(&shadow[saved.page * EEPROM_PAGE_SIZE], saved.data, pageLength(saved.page));
+  }
+  txnPageCount = 0;
+
+  while (txnDepth > 0) {
+    txnDepth--;
+    getMutex().unlock();  // beginTransaction()で取得した分を解放
   }
+}
 
-  return oss.str();
+/**
+ * @brief トランザクション中か
+ * @return true トランザクション中
+ */
+bool EepromManager::inTransaction(void) {
+  std::lock_guard<std::recursive_mutex> lock(getMutex());
+  return txnDepth > 0;
+}
+
+/**
+ * @brief トランザクション中に変更するページを退避する
+ * @param address 書き込み開始アドレス
+ * @param len 書き込むデータの長さ
+ * @return true 成功、false 退避領域が不足
+ */
+bool EepromManager::saveTxnPages(uint16_t address, uint16_t len) {
+  uint16_t firstPage = address / EEPROM_PAGE_SIZE;
+  uint16_t lastPage = (address + len - 1) / EEPROM_PAGE_SIZE;
+  auto isSaved = [this](uint16_t page) {
+    for (uint8_t i = 0; i < txnPageCount; ++i) {
+      if (txnPages[i].page == page) return true;
+    }
+    return false;
+  };
+
+  // 退避領域が足りるか先に確認する（途中まで書き込まないため）
+  uint8_t required = 0;
+  for (uint16_t page = firstPage; page <= lastPage; ++page) {
+    if (!isSaved(page)) {
+      required++;
+    }
+  }
+  if (txnPageCount + required > TXN_MAX_PAGES) {
+    return false;
+  }
+
+  for (uint16_t page = firstPage; page <= lastPage; ++page) {
+    if (!isSaved(page)) {
+      TxnPage& entry = txnPages[txnPageCount++];
+      entry.page = page;
+      entry.dirtyStart = dirtyStart[page];
+      entry.dirtyEnd = dirtyEnd[page];
+      memcpy(entry.data, &shadow[page * EEPROM_PAGE_SIZE], pageLength(page));
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief 範囲のページがすべて起動時に読み込めているか
+ * @param address 先頭アドレス
+ * @param len バイト数
+ * @return true すべて読み込めている
+ */
+bool EepromManager::isRangeLoaded(uint16_t address, size_t len) {
+  if (!loadFailed || len == 0) {
+    return true;
+  }
+  for (uint16_t page = address / EEPROM_PAGE_SIZE; page <= (address + len - 1) / EEPROM_PAGE_SIZE; ++page) {
+    if (!pageLoaded[page]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief ページ内でシャドウに含まれるバイト数
+ * @param page ページ番号
+ * @return バイト数（最終ページはSHADOW_SIZEまで）
+ */
+uint8_t EepromManager::pageLength(uint16_t page) {
+  uint16_t start = page * EEPROM_PAGE_SIZE;
+  return std::min<uint16_t>(EEPROM_PAGE_SIZE, SHADOW_SIZE - start);
+}
+
+
+/**
+ * @brief 最後の書き込みから書き戻し開始までの時間を設定する
+ * @param delayMs 遅延時間[ms]（0で次のupdate()から書き戻す）
+ */
+void EepromManager::setFlushDelay(uint32_t delayMs) {
+  std::lock_guard<std::recursive_mutex> lock(getMutex());
+  flushDelayMs = delayMs;
+}
+
+/**
+ * @brief 書き戻しの状態を取得する
+ * @return EepromWriteStatus 書き戻しの状態
+ */
+EepromWriteStatus EepromManager::getWriteStatus(void) {
+  std::lock_guard<std::recursive_mutex> lock(getMutex());
+  if (failedPageCount > 0) {
+    return EepromWriteStatus::Error;    // 失敗したページが書き込めるまで保持する
+  }
+  if (dirtyPageCount > 0 || writeActive) {
+    return EepromWriteStatus::Busy;
+  }
+  return EepromWriteStatus::Idle;
+}
+
+/**
+ * @brief 書き込み待ちのページ数を取得する
+ * @return 書き込み待ち数（書き込み中を含む）
+ */
+size_t EepromManager::pendingWriteCount(void) {
+  std::lock_guard<std::recursive_mutex> lock(getMutex());
+  return dirtyPageCount + (writeActive ? 1 : 0);
+}
+
+/**
+ * @brief 書き込み完了コールバックを設定する
+ * @param callback 書き込み完了時に呼び出す関数
+ */
+void EepromManager::onWriteComplete(WriteCompleteCallback callback) {
+  std::lock_guard<std::recursive_mutex> lock(getMutex());
+  writeCompleteCallback = callback;
 }
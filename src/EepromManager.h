@@ -2,22 +2,37 @@
 
 #include <mutex>
 #include <string>
+#include <functional>
+#include "Config.h"
 #include "I2CBusManager.h"
 #include "EepromRawAccessor.h"
 
+/**
+ * @brief 書き戻し（RAMシャドウからEEPROMへの書き込み）の状態
+ */
+enum class EepromWriteStatus {
+  Idle,   // 未書き込みのページなし
+  Busy,   // 未書き込みのページあり（書き込み中を含む）
+  Error   // 書き込みに失敗したページがあり、まだ書き込めていない
+};
+
 // EEPROMアクセス排他制御管理
 class EepromManager {
 public:
+  // 書き込み完了通知（書き込み先アドレス、バイト数、成否）
+  using WriteCompleteCallback = std::function<void(uint16_t address, uint16_t len, bool success)>;
+
   // 初期化
   EepromManager(I2CBusManager *busManager);  // デフォルトコンストラクタ
 
   virtual void begin(void);
+  bool isLoaded(void);                      // 起動時にEEPROM全体をシャドウへ読み込めたか
 
   // EEPROMアクセス用のミューテックスを取得
   virtual std::recursive_mutex& getMutex();
 
   // バイト単位でデータを書き込む
-//  virtual bool writeBytes(int address, const void* data, size_t len);
+  virtual bool writeBytes(uint16_t address, const uint8_t *data, uint16_t len);  // 複数バイト書き込み（ページ書き込み）
   virtual bool writeByte(uint16_t address, const uint8_t data);
 
   // バイト単位でデータを読み込む
@@ -26,11 +41,84 @@ public:
 
   virtual bool readMultipleBytes(int address, uint8_t *data, size_t len);   // i2c EEPROMから複数バイト読み込み
 
-  std::string dumpEepromData(uint16_t address = 0x00, uint16_t len = 16);
+  // ダンプ（1行ごとにsinkへ出力、32バイトごとにyieldFnを呼ぶ）
+  using DumpSink = std::function<void(const char *line, size_t len)>;
+  using DumpYield = std::function<void()>;
+  bool dumpEepromData(uint16_t address, uint16_t len, const DumpSink& sink, const DumpYield& yieldFn = nullptr);
+  uint16_t dumpEepromRow(uint16_t origin, uint16_t address, uint16_t endAddress, const DumpSink& sink, bool& readOk); // 32バイト分を出力し、次のアドレスを返す
+
+  // 書き戻し（RAMシャドウ → EEPROM）
+  virtual void update(uint32_t nowMs);                // 書き戻しを1ステップ進める（メインループから呼ぶ）
+  virtual bool flush(void);                           // 未書き込みのページをすべて書き込む（再起動の前）
+  void setFlushDelay(uint32_t delayMs);               // 最後の書き込みから書き戻し開始までの時間を設定
+  EepromWriteStatus getWriteStatus(void);             // 書き戻しの状態を取得
+  size_t pendingWriteCount(void);                     // 書き込み待ちのページ数
+  void onWriteComplete(WriteCompleteCallback callback); // 書き込み完了コールバックを設定
+
+  // トランザクション（複数の書き込みをまとめて確定・破棄する）
+  virtual bool beginTransaction(void);                // 開始（入れ子可、終了までミューテックスを保持）
+  virtual bool commitTransaction(void);               // 確定（書き戻しの対象にする）
+  virtual void abortTransaction(void);                // 破棄（開始時点の内容に戻す）
+  bool inTransaction(void);                           // トランザクション中か
 
 private:
   I2CBusManager* i2cBus = nullptr;  // I2Cバスマネージャ
   std::recursive_mutex eepromMutex;  // EEPROM用のミューテックス
   EepromRawAccessor rawAccessor;     // 実際のEEPROMデータ操作クラス
 
+  // ダンプ
+  static constexpr uint16_t DUMP_ROW_SIZE = EEPROM_PAGE_SIZE;  // 1回に読み込むバイト数（1ページ）
+  static constexpr size_t DUMP_BYTES_PER_LINE = 16;    // 1行に表示するバイト数
+  static constexpr size_t DUMP_LINE_SIZE = 4 + 1 + 3 * DUMP_BYTES_PER_LINE + 1 + DUMP_BYTES_PER_LINE + 1;  // 1行の文字数
+  static size_t formatDumpLine(char *line, uint16_t address, const uint8_t *data, size_t len);
+
+  // RAMシャドウ（EEPROM全体の写し）
+  static constexpr uint16_t SHADOW_SIZE = EEPROM_MAX_ADDRESS;  // シャドウのサイズ（アクセス可能範囲）
+  static constexpr uint16_t PAGE_COUNT = (SHADOW_SIZE + EEPROM_PAGE_SIZE - 1) / EEPROM_PAGE_SIZE;  // ページ数
+  static constexpr uint8_t LOAD_CHUNK_SIZE = 128;  // 起動時の一括読み込み単位（Wireのバッファ長）
+  static constexpr uint8_t LOAD_RETRIES = 3;       // 起動時の読み込みの試行回数
+  uint8_t shadow[SHADOW_SIZE];                     // EEPROMの写し
+  uint8_t dirtyStart[PAGE_COUNT];                  // ページ内の未書き込み範囲の先頭オフセット
+  uint8_t dirtyEnd[PAGE_COUNT];                    // ページ内の未書き込み範囲の終端オフセット（0なら書き込み済み）
+  uint16_t dirtyPageCount = 0;                     // 未書き込みのページ数
+  bool pageLoaded[PAGE_COUNT];                     // 起動時にEEPROMから読み込めたページ（読めなかったページは読み書きしない）
+  bool loadFailed = false;                         // 起動時に読み込めなかったページがある
+  uint16_t nextFlushPage = 0;                      // 次に書き戻しを確認するページ
+
+  uint16_t activeAddress = 0;                      // 書き込み中の先頭アドレス
+  uint8_t activeLen = 0;                           // 書き込み中のバイト数
+  bool writeActive = false;                        // 書き込みサイクル中
+  bool lastWriteFailed = false;                    // 直前の書き込み失敗
+  static constexpr uint32_t RETRY_MIN_MS = 10;     // 書き込み失敗から再試行までの最短時間[ms]
+  static constexpr uint32_t RETRY_MAX_MS = 5000;   // 書き込み失敗から再試行までの最長時間[ms]
+  bool writeFailed[PAGE_COUNT];                    // 書き込みに失敗し、まだ書き込めていないページ
+  uint16_t failedPageCount = 0;                    // 書き込みに失敗し、まだ書き込めていないページ数
+  uint32_t retryDelayMs = 0;                       // 再試行までの時間[ms]（失敗のたびに倍にする、0なら待たない）
+  uint32_t retryFromMs = 0;                        // 再試行までの時間の計測開始時刻[ms]
+  bool retryPending = false;                       // 失敗した時刻をまだ記録していない
+  bool writePending = false;                       // 前回のupdate()以降に書き込みがあった
+  uint32_t lastWriteMs = 0;                        // 最後の書き込みを検出した時刻[ms]
+  uint32_t flushDelayMs = EEPROM_FLUSH_DELAY_MS;   // 書き戻しまでの遅延時間[ms]
+  WriteCompleteCallback writeCompleteCallback;     // 書き込み完了コールバック
+
+  // トランザクション開始時点のページ内容（破棄時に復元する）
+  struct TxnPage {
+    uint16_t page;                       // ページ番号
+    uint8_t dirtyStart;                  // 開始時点の未書き込み範囲の先頭
+    uint8_t dirtyEnd;                    // 開始時点の未書き込み範囲の終端
+    uint8_t data[EEPROM_PAGE_SIZE];      // 開始時点のページ内容
+  };
+  static constexpr uint8_t TXN_MAX_PAGES = 16;     // 1トランザクションで変更できるページ数（ジャーナルへの全パラメータ追記分）
+  TxnPage txnPages[TXN_MAX_PAGES];                 // 変更したページの退避領域
+  uint8_t txnPageCount = 0;                        // 退避済みのページ数
+  uint8_t txnDepth = 0;                            // トランザクションの入れ子の深さ
+
+  bool storeShadow(uint16_t address, const uint8_t *data, uint16_t len); // シャドウを更新し変化したページを記録
+  bool saveTxnPages(uint16_t address, uint16_t len); // トランザクション中に変更するページを退避
+  static uint8_t pageLength(uint16_t page);        // ページ内でシャドウに含まれるバイト数
+  bool isRangeLoaded(uint16_t address, size_t len); // 範囲のページがすべて読み込めているか
+  void markDirty(uint16_t address);                // 1バイト分の未書き込み範囲を記録
+  void restoreDirty(uint16_t address, uint8_t len);  // 書き込めなかった範囲を未書き込みに戻す
+  bool startNextPage(void);                        // 次の未書き込みページの書き込みを開始
+  void completeWrite(bool success);                // 書き込み完了処理
 };
@@ -10,9 +10,11 @@ EepromRawAccessor::EepromRawAccessor(I2CBusManager *busManager)
 /**
  * @brief EEPROMの初期化
  * I2C EEPROMが接続されていない場合は、ESP32のEEPROMを使用する。
+ * 使用するEEPROMはここで確定し、以降のホットプラグの再スキャンでは切り替えない。
  */
 void EepromRawAccessor::begin(void) {
-  if(i2cBus->isEepromConnected()){
+  i2cEeprom = i2cBus->isEepromConnected();   // 使用するEEPROMは起動時に決める
+  if(i2cEeprom){
     Serial.println("I2C EEPROM is connected.");
   } else {
     Serial.println("I2C EEPROM is not connected.");
@@ -29,13 +31,38 @@ bool EepromRawAccessor::readBytes(int address, void* data, size_t len) {
   memcpy(data, eeprom + address, len);  // データ読み込み
   return true;
 }
+#endif
 
-bool EepromRawAccessor::writeBytes(int address, const void* data, size_t len) {
+/**
+ * @brief EEPROMに複数バイト書き込み
+ * @param address 書き込み開始アドレス
+ * @param data 書き込むデータ
+ * @param len 書き込むデータのバイト数
+ * @return true 成功、false 失敗
+ *  i2c EEPROMが接続されている場合は、32バイトのページ境界で分割してページ単位で書き込む。
+ *  1ページにつきI2Cトランザクションと書き込み完了待ちが1回になる。
+ *  接続されていない場合はESP32のEEPROMにまとめて書き込み、commitは1回だけ行う。
+ */
+bool EepromRawAccessor::writeBytes(uint16_t address, const uint8_t *data, uint16_t len) {
+  if (data == nullptr || len == 0) return false;  // データなし
   if (address + len > EEPROM_SIZE) return false;  // 範囲外アクセスを防止
-  memcpy(eeprom + address, data, len);  // データ書き込み
-  return EEPROM.commit();  // 書き込みを確定
+
+  if(i2cEeprom){
+    while (len > 0) {
+      uint16_t chunk = pageChunkLength(address, len);   // ページ境界までのバイト数
+      if (!i2cWritePage(address, data, chunk)) {
+        return false;
+      }
+      address += chunk;
+      data += chunk;
+      len -= chunk;
+    }
+    return true;
+  } else {
+    memcpy(eeprom + address, data, len);  // ESP32のEEPROMに書き込み
+    return EEPROM.commit();               // 書き込みを確定
+  }
 }
-#endif
 
 /**
  * @brief EEPROMに1バイト書き込み
@@ -50,7 +77,7 @@ bool EepromRawAccessor::writeByte(uint16_t address, uint8_t data) {
     return false;  // 範囲外アクセスを防止
   }
 
-  if(i2cBus->isEepromConnected()){
+  if(i2cEeprom){
     return i2cWriteByte(address, data);   // I2C EEPROMに書き込み
   } else {
     eeprom[address] = data;               // ESP32のEEPROMに書き込み
@@ -66,18 +93,195 @@ bool EepromRawAccessor::writeByte(uint16_t address, uint8_t data) {
  */
 bool EepromRawAccessor::i2cWriteByte(uint16_t address, uint8_t data)
 {
-  std::lock_guard<std::recursive_mutex> lock(i2cBus->getMutex());
+  return i2cWritePage(address, &data, 1);
+}
+
+/**
+ * @brief i2c EEPROMに1ページ内の複数バイトを書き込み
+ * @param address 書き込み開始アドレス
+ * @param data 書き込むデータ
+ * @param len 書き込むデータのバイト数（ページ境界を跨がないこと）
+ * @return true 成功、false 失敗
+ *  ページ境界を跨ぐとページ先頭に回り込んで上書きされるため、呼び出し側で分割すること。
+ *  書き込み完了は固定時間待ちではなくACKポーリングで検出する。
+ */
+bool EepromRawAccessor::i2cWritePage(uint16_t address, const uint8_t *data, uint8_t len)
+{
+  if (!i2cStartPageWrite(address, data, len)) {
+    return false;
+  }
+  return waitWriteComplete();                   // 書き込み完了待ち
+}
+
+/**
+ * @brief i2c EEPROMへ1ページ書き込みを送信する
+ * @param address 書き込み開始アドレス
+ * @param data 書き込むデータ
+ * @param len 書き込むデータのバイト数（ページ境界を跨がないこと）
+ * @return true 送信成功（非同期転送では受付）、false 失敗
+ *  送信後、EEPROMは内部書き込みサイクルに入る。完了はpollWriteComplete()で確認する。
+ *  非同期転送が使える場合は送信もワーカータスクで行い、呼び出し元は送信の完了を待たない。
+ */
+bool EepromRawAccessor::i2cStartPageWrite(uint16_t address, const uint8_t *data, uint8_t len)
+{
+  if (writeInProgress && !waitWriteComplete() && (sendState.load() == SendState::Sending)) {
+    return false;                                // 前回の送信が終わらない（転送が残っているため次を送らない）
+  }
+
   uint8_t i2cADR = I2CADR_EEPROM;       // I2Cアドレス
+  if (i2cBus->hasTransport()) {
+    // 非同期転送：送信はワーカータスクに任せ、完了はpollWriteComplete()で確認する
+    I2CTransfer request;
+    uint8_t head[2] = {(uint8_t)(address >> 8), (uint8_t)(address & 0xFF)};  // EEPROM内アドレス MSB, LSB
+    request.address = i2cADR;
+    if (request.setTx(head, sizeof(head), data, len)) {
+      sendState = SendState::Sending;
+      sendStartUs = micros();
+      if (i2cBus->transfer(request, [this](I2CTransferStatus status) {
+            writeStartUs = micros();             // 書き込みサイクルは送信の完了から始まる（sendStateより先に書く）
+            sendState.store((status == I2CTransferStatus::Ok) ? SendState::Idle : SendState::Failed,
+                            std::memory_order_release);
+          })) {
+        writeInProgress = true;                  // 送信完了後に内部書き込みサイクル開始
+        return true;
+      }
+      sendState = SendState::Idle;               // 受付不可なら同期転送で送る
+    }
+  }
+
+  I2CTransaction transaction(*i2cBus, i2cADR);   // バスの排他制御と計測
   Wire.beginTransmission(i2cADR);                // i2cアドレス指定
   Wire.write((int)(address >> 8));               // EEPROM内アドレス指定 MSB
   Wire.write((int)(address & 0xFF));             // LSB
-  Wire.write(data);
-  Wire.endTransmission();
-  delay(5);                                      // 書き込み完了待ち
+  Wire.write(data, len);
+  transaction.addBytes(len);
+  if (transaction.status(Wire.endTransmission()) != 0) {
+    return false;
+  }
+  writeInProgress = true;                        // 内部書き込みサイクル開始
+  writeStartUs = micros();
+
+  return true;
+}
+
+/**
+ * @brief EEPROMのページ書き込みを開始する（完了を待たない）
+ * @param address 書き込み開始アドレス
+ * @param data 書き込むデータ
+ * @param len 書き込むデータのバイト数（1ページ内に収まること）
+ * @return true 成功、false 失敗
+ *  I2C EEPROMの場合は送信のみ行い、書き込みサイクルの完了はpollWriteComplete()で確認する。
+ *  ESP32のEEPROMの場合はその場で書き込みとcommitを行う。
+ */
+bool EepromRawAccessor::startPageWrite(uint16_t address, const uint8_t *data, uint8_t len)
+{
+  if (data == nullptr || len == 0) return false;          // データなし
+  if (address + len > EEPROM_SIZE) return false;          // 範囲外アクセスを防止
+  if (pageChunkLength(address, len) != len) return false; // ページ境界を跨ぐ書き込みは不可
+
+  if(i2cEeprom){
+    return i2cStartPageWrite(address, data, len);
+  } else {
+    memcpy(eeprom + address, data, len);  // ESP32のEEPROMに書き込み
+    if (batchActive) {
+      batchDirty = true;                  // commitはcommitBatch()でまとめて行う
+      return true;
+    }
+    return EEPROM.commit();               // 書き込みを確定
+  }
+}
 
+/**
+ * @brief 書き込みサイクルのあるI2C EEPROMを使用しているか
+ * @return true I2C EEPROM、false ESP32のEEPROM（フラッシュ）
+ */
+bool EepromRawAccessor::usesWriteCycle(void)
+{
+  return i2cEeprom;
+}
+
+/**
+ * @brief ESP32のEEPROMへのcommitをまとめる
+ *  commitBatch()までのstartPageWrite()はRAMへの書き込みのみ行う。
+ *  ESP32のEEPROMはcommitのたびにフラッシュのセクタを書き換えるため、複数ページの書き込みを1回にまとめる。
+ *  I2C EEPROMでは何もしない（ページ書き込みはその都度行う）。
+ */
+void EepromRawAccessor::beginBatch(void)
+{
+  batchActive = true;
+  batchDirty = false;
+}
+
+/**
+ * @brief まとめた書き込みを1回のcommitで確定する
+ * @return true 成功、false 失敗
+ */
+bool EepromRawAccessor::commitBatch(void)
+{
+  bool dirty = batchDirty;
+  batchActive = false;
+  batchDirty = false;
+  if (dirty) {
+    return EEPROM.commit();               // 書き込みを確定
+  }
   return true;
 }
 
+/**
+ * @brief 書き込みサイクルの完了をACKポーリングで1回確認する
+ * @return WriteCycleState 書き込みサイクルの状態
+ *  EEPROMは内部書き込み中はデバイスアドレスにNAKを返すため、
+ *  アドレスのみのトランザクションでACKが返れば書き込み完了と判定する。
+ *  タイムアウトは、非同期転送の送信中は受付から SEND_TIMEOUT_US、送信の完了後はそこから WRITE_TIMEOUT_US。
+ *  送信のタイムアウトでは転送がまだ残っているため、書き込み中の状態はそのままにする。
+ */
+WriteCycleState EepromRawAccessor::pollWriteComplete(void)
+{
+  if (!writeInProgress) {
+    return WriteCycleState::Complete;
+  }
+  SendState send = sendState.load(std::memory_order_acquire);
+  if (send == SendState::Sending) {
+    if (micros() - sendStartUs > SEND_TIMEOUT_US) {
+      return WriteCycleState::Timeout;           // 送信が終わらない
+    }
+    return WriteCycleState::InProgress;          // ページデータの送信中（バスに触れない）
+  }
+  if (send == SendState::Failed) {
+    sendState = SendState::Idle;
+    writeInProgress = false;
+    return WriteCycleState::Failed;
+  }
+
+  I2CTransaction transaction(*i2cBus, I2CADR_EEPROM);
+  Wire.beginTransmission(I2CADR_EEPROM);         // アドレスのみ送信してACK確認
+  if (transaction.status(Wire.endTransmission()) == 0) {
+    writeInProgress = false;
+    return WriteCycleState::Complete;
+  }
+  transaction.setResult(I2CResult::Busy);        // 書き込みサイクル中のNAKはエラーとして数えない
+  if (micros() - writeStartUs > WRITE_TIMEOUT_US) {
+    writeInProgress = false;
+    return WriteCycleState::Timeout;
+  }
+  return WriteCycleState::InProgress;
+}
+
+/**
+ * @brief 書き込みサイクルの完了を待つ
+ * @return true 完了、false タイムアウト・送信失敗
+ *  pollWriteComplete() が送信・書き込みサイクルのそれぞれに期限を持つため、最長で
+ *  SEND_TIMEOUT_US + WRITE_TIMEOUT_US で戻る。
+ */
+bool EepromRawAccessor::waitWriteComplete(void)
+{
+  WriteCycleState state = pollWriteComplete();
+  while (state == WriteCycleState::InProgress) {
+    state = pollWriteComplete();
+  }
+  return state == WriteCycleState::Complete;
+}
+
 /**
  * @brief EEPROMから1バイト読み込み
  * @param address EEPROM内アドレス
@@ -91,7 +295,7 @@ bool EepromRawAccessor::readByte(uint16_t address, uint8_t *data) {
     return false;  // 範囲外アクセスを防止
   }
 
-  if(i2cBus->isEepromConnected()){
+  if(i2cEeprom){
     return i2cReadByte(address, data);  // I2C EEPROMから読み込み
   } else {
     *data = eeprom[address];            // ESP32のEEPROMから読み込み
@@ -107,17 +311,24 @@ bool EepromRawAccessor::readByte(uint16_t address, uint8_t *data) {
  */
 bool EepromRawAccessor::i2cReadByte(uint16_t address, uint8_t *data)
 {
-  std::lock_guard<std::recursive_mutex> lock(i2cBus->getMutex());
+  if (writeInProgress) {
+    waitWriteComplete();                // 書き込みサイクル中はNAKとなるため完了を待つ
+  }
   uint8_t i2cADR = I2CADR_EEPROM;       // I2Cアドレス
+  I2CTransaction transaction(*i2cBus, i2cADR);  // バスの排他制御と計測
 
   Wire.beginTransmission(i2cADR);       // i2cアドレス指定
   Wire.write((int)(address >> 8));      // EEPROM内アドレス指定 MSB
   Wire.write((int)(address & 0xFF));    // LSB
-  Wire.endTransmission();
-  Wire.requestFrom(i2cADR, 1);          // 1バイトデータリクエスト
-  while (Wire.available()) {
-    *data = Wire.read();                // データ受信
+  if (transaction.status(Wire.endTransmission()) != 0) {
+    return false;                       // アドレス設定でNAK
+  }
+  if (Wire.requestFrom(i2cADR, (uint8_t)1) != 1 || !Wire.available()) {
+    transaction.setResult(I2CResult::Nak);
+    return false;                       // 受信できなかった
   }
+  *data = Wire.read();                  // データ受信
+  transaction.addBytes(1);
 
   return true;  // 成功
 }
@@ -139,7 +350,7 @@ bool EepromRawAccessor::sequentialRead(uint16_t eeADR ,uint8_t *data,uint8_t dat
   if (data == nullptr) return false;  // データポインタがnullptrの場合は失敗 
   if (eeADR + dataNum > EEPROM_SIZE) return false;  // 範囲外アクセスを防止
 
-  if(i2cBus->isEepromConnected()){
+  if(i2cEeprom){
     return i2cSequentialRead(I2CADR_EEPROM, eeADR, data, dataNum);  // I2C EEPROMから読み込み
   } else {
     memcpy(data, eeprom + eeADR, dataNum);  // ESP32のEEPROMから読み込み
@@ -162,14 +373,19 @@ bool EepromRawAccessor::sequentialRead(uint16_t eeADR ,uint8_t *data,uint8_t dat
 bool EepromRawAccessor::i2cSequentialRead(uint8_t i2cADR, uint16_t eeADR ,uint8_t *data,uint8_t dataNum)
 {
   uint8_t i=0;
-  std::lock_guard<std::recursive_mutex> lock(i2cBus->getMutex());
+  if (writeInProgress) {
+    waitWriteComplete();                        // 書き込みサイクル中はNAKとなるため完了を待つ
+  }
+  I2CTransaction transaction(*i2cBus, i2cADR); // バスの排他制御と計測
 
   Wire.beginTransmission(i2cADR);               // i2cアドレス指定
   Wire.write((int)(eeADR >> 8));                // EEPROM内アドレス指定 MSB
   Wire.write((int)(eeADR & 0xFF));              // LSB
-  Wire.endTransmission();
-  Wire.requestFrom(i2cADR, dataNum);            // 1バイトデータリクエスト
-  while (Wire.available()) {                    //
+  if (transaction.status(Wire.endTransmission()) != 0) {
+    return false;                               // アドレス設定でNAK
+  }
+  uint8_t received = Wire.requestFrom(i2cADR, dataNum);   // データリクエスト
+  while (Wire.available() && (i < dataNum)) {   //
     data[i] = Wire.read();
 //    Serial.print(data[i] >> 4, HEX);                // 上位4ビットを16表示
 //    Serial.print(data[i] & 0x0F, HEX);              // 下位4ビット
@@ -177,6 +393,11 @@ bool EepromRawAccessor::i2cSequentialRead(uint8_t i2cADR, uint16_t eeADR ,uint8_
     i++;
   }
 //  Serial.println();                         // データ受信
+  transaction.addBytes(i);
+  if ((received != dataNum) || (i != dataNum)) {
+    transaction.setResult(I2CResult::Nak);
+    return false;                               // 要求したバイト数を受信できなかった
+  }
 
   return true;
 }
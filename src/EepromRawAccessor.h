@@ -1,10 +1,21 @@
 #pragma once
 
 #include <mutex>
+#include <atomic>
 #include "I2CBusManager.h"
 #include "Config.h"
 #include <EEPROM.h>
 
+/**
+ * @brief EEPROM内部書き込みサイクルの状態
+ */
+enum class WriteCycleState {
+  Complete,     // 書き込み完了（デバイスがACKを返した）
+  InProgress,   // 内部書き込み中（デバイスがNAKを返した）
+  Timeout,      // 規定時間内にACKが返らなかった
+  Failed        // ページデータの送信に失敗した（非同期転送）
+};
+
 // EEPROMの低レベル読み書き管理
 class EepromRawAccessor {
 public:
@@ -14,20 +25,57 @@ public:
   void begin(void);
 
 //  bool readBytes(int address, void* data, size_t len);          // バイト単位でデータを読み込む
-//  bool writeBytes(int address, const void* data, size_t len);   // バイト単位でデータを書き込む
 
+  bool writeBytes(uint16_t address, const uint8_t *data, uint16_t len); // 複数バイト書き込み（ページ単位）
   bool writeByte(uint16_t address, uint8_t data);               // データを1バイト書き込む
   bool readByte(uint16_t address, uint8_t *data);               // データを1バイト読み込む
   bool sequentialRead(uint16_t eeADR ,uint8_t *data,uint8_t dataNum);
 
+  bool startPageWrite(uint16_t address, const uint8_t *data, uint8_t len); // ページ書き込みを開始（完了を待たない）
+  WriteCycleState pollWriteComplete(void);    // ACKポーリングで書き込み完了を1回確認
+  bool waitWriteComplete(void);               // 書き込み完了までACKポーリングで待つ
+
+  bool usesWriteCycle(void);                  // 書き込みサイクルのあるI2C EEPROMを使用しているか
+  void beginBatch(void);                      // ESP32のEEPROMへのcommitをまとめる
+  bool commitBatch(void);                     // まとめた書き込みを1回のcommitで確定
+
+  /**
+   * @brief ページ境界を跨がずに書き込めるバイト数
+   * @param address 書き込み開始アドレス
+   * @param len 残りの書き込みバイト数
+   * @return 今回のページ書き込みで書き込むバイト数
+   */
+  static uint16_t pageChunkLength(uint16_t address, uint16_t len) {
+    uint16_t room = EEPROM_PAGE_SIZE - (address % EEPROM_PAGE_SIZE);
+    return (len < room) ? len : room;
+  }
+
 private:
   I2CBusManager* i2cBus = nullptr;  // I2Cバスマネージャ
 
 //  static constexpr size_t EEPROM_SIZE = 512; // EEPROMのサイズ
   static constexpr size_t EEPROM_SIZE = EEPROM_MAX_ADDRESS; // EEPROMのサイズ
   uint8_t* eeprom = nullptr;  // EEPROMデータポインタ
+  bool i2cEeprom = false;     // I2C EEPROMを使用する（begin()で確定）
+
+  static constexpr uint32_t WRITE_TIMEOUT_US = 20000; // 書き込みサイクルのタイムアウト（送信の完了から。24LC32のtWCは最大5ms）
+  static constexpr uint32_t SEND_TIMEOUT_US = 50000;  // 非同期転送の送信のタイムアウト（受付から。キューの待ちを含む）
+  bool writeInProgress = false;   // 内部書き込みサイクル中
+  // 非同期転送によるページデータの送信状態（完了通知はトランスポートのタスクから届く）
+  enum class SendState : uint8_t {
+    Idle,       // 送信済み・送信なし
+    Sending,    // 送信中
+    Failed      // 送信失敗
+  };
+  std::atomic<SendState> sendState{SendState::Idle};
+  uint32_t sendStartUs = 0;       // 非同期転送を受け付けた時刻[us]
+  uint32_t writeStartUs = 0;      // 書き込みサイクルの開始時刻[us]（送信の完了時刻。非同期転送では完了通知が書く）
+  bool batchActive = false;       // commitをまとめている
+  bool batchDirty = false;        // まとめている間に書き込みがあった
 
   bool i2cReadByte(uint16_t address, uint8_t *data);               // データを1バイト読み込む
   bool i2cWriteByte(uint16_t address, uint8_t data);               // データを1バイト書き込む
+  bool i2cWritePage(uint16_t address, const uint8_t *data, uint8_t len); // 1ページ内の複数バイト書き込み
+  bool i2cStartPageWrite(uint16_t address, const uint8_t *data, uint8_t len); // 1ページ書き込みの送信のみ
   bool i2cSequentialRead(uint8_t i2cADR, uint16_t eeADR ,uint8_t *data,uint8_t dataNum);
 };
@@ -13,11 +13,49 @@
  * スキャンは、scanI2CBusメソッドで行われ、見つかったデバイスのアドレスを返す。
  * デバイス名の取得は、getDeviceNameメソッドで行われ、アドレスに対応するデバイス名を返す。
  * I2CBusManagerは、std::recursive_mutexを使用してI2Cバスへのアクセスを排他制御する。
+ * submit/executeで受け付けた処理は、I2CSchedulerが優先度・期限の順にミューテックスを取得して実行する。
  * I2CBusManagerは、TwoWireクラスのインスタンスを保持し、I2Cバスの操作を行う。
  */
 #include <M5Unified.h>
 #include "I2CBusManager.h"
+#include <algorithm>
+#include <string.h>
+#include <esp_attr.h>
+#include <esp_system.h>
 #include "Config.h"
+#include "Crc16.h"
+
+/**
+ * @brief 前回のスキャン結果（ソフトウェアリセットでは消えないRTCメモリに置く）
+ */
+struct LastScanResult {
+  uint32_t magic;
+  uint32_t bits[I2CPresenceMap::WORD_COUNT];
+  uint16_t crc;
+};
+static constexpr uint32_t LAST_SCAN_MAGIC = 0x49324353;  // "I2CS"
+RTC_NOINIT_ATTR static LastScanResult lastScan;
+
+/**
+ * @brief スキャン結果をRTCメモリへ保存する
+ */
+static void saveScanResult(const I2CPresenceMap& presence) {
+  presence.snapshot(lastScan.bits);
+  lastScan.magic = LAST_SCAN_MAGIC;
+  lastScan.crc = crc16Ccitt(reinterpret_cast<const uint8_t*>(lastScan.bits), sizeof(lastScan.bits));
+}
+
+/**
+ * @brief 保存したスキャン結果が使えるか
+ * 電源投入時はRTCメモリの内容が不定で、デバイスの付け替えもありうるため使わない。
+ */
+static bool hasLastScanResult(void) {
+  if (esp_reset_reason() == ESP_RST_POWERON) {
+    return false;
+  }
+  return lastScan.magic == LAST_SCAN_MAGIC
+      && lastScan.crc == crc16Ccitt(reinterpret_cast<const uint8_t*>(lastScan.bits), sizeof(lastScan.bits));
+}
 
 /**
  * @brief I2CBusManagerの初期化
@@ -25,6 +63,8 @@
  */
 void I2CBusManager::begin() {
   wire.begin(SDA_PIN, SCL_PIN, I2C_FREQ);
+  setTimeSource([]() { return (uint32_t)micros(); });   // 待ち時間・期限・占有時間の計測用
+  scheduler.setOwner(std::this_thread::get_id());       // キューの処理はupdate()を呼ぶメインループで実行する
 }
 
 /**
@@ -45,79 +85,189 @@ TwoWire& I2CBusManager::getWire() {
 
 /**
  * @brief I2Cバスのスキャン
- * @param address スキャン開始アドレス（デフォルトは0x00）
+ * @param startAddress スキャン開始アドレス（デフォルトは0x00）
  * @param count スキャンするアドレスの数（デフォルトは127）
- * @return スキャン結果のアドレスリスト
+ * @return 範囲内で見つかったデバイスのアドレスリスト
  * この関数は、I2Cバス上のデバイスをスキャンし、見つかったデバイスのアドレスを返す。
  * Wireライブラリを使用して、各アドレスに対して通信を試み、応答があったアドレスをリストに追加する。
+ * スキャン結果は範囲内のアドレスだけ接続状態のビットマップへまとめて反映する。
+ * 1アドレスだけ指定すれば、ホットプラグしたデバイスの再確認になる。
  */
 std::vector<uint8_t> I2CBusManager::scanI2CBus(uint8_t startAddress, uint8_t count) {
-  byte error, address;
-  int nDevices;
-  i2cDevice.clear();  // スキャン結果のアドレスリストをクリア
+  std::vector<uint8_t> found;
+  uint32_t bits[I2CPresenceMap::WORD_COUNT] = {0};
+  uint8_t first = (startAddress < 1) ? 1 : startAddress;                  // 0x00はゼネラルコール
+  uint16_t last = std::min<uint16_t>((uint16_t)startAddress + count, 127);  // 0x7Fは予約
+
   std::lock_guard<std::recursive_mutex> lock(i2cMutex); // ミューテックスで排他制御
-  
-  nDevices = 0;
-  for(address = 1; address < 127; address++ )
-  {
-    // The i2c_scanner uses the return value of
-    // the Write.endTransmisstion to see if
-    // a device did acknowledge to the address.
-    Wire.beginTransmission(address);
-    error = Wire.endTransmission();
 
-    if (error == 0)
+  for (uint16_t address = first; address < last; address++)
+  {
+    if (probeAddress((uint8_t)address))
     {
-      i2cDevice.push_back(address);   // DeviceList 追加
-      nDevices++;
+      found.push_back((uint8_t)address);   // DeviceList 追加
+      bits[address >> 5] |= 1u << (address & 31);
     }
-    else if (error==4)
-    {
-      Serial.print("Unknown error at address 0x");
-      if (address<16)
-        Serial.print("0");
-      Serial.println(address,HEX);
+  }
+  if (last > first) {
+    presence.replace(bits, first, (uint8_t)(last - first));   // 範囲内の接続状態を反映
+    saveScanResult(presence);
+  }
+
+  return found;
+}
+
+/**
+ * @brief 段階的スキャンを開始する
+ * @details
+ * I2CDeviceRegistryにある既知のアドレスだけをここで確認するため、
+ * 戻った時点でEEPROM・OLED・RTCの初期化を始められる。
+ * 残りのアドレスはupdate()ごとにI2CBusScanner::SLICE_SIZEずつ確認する。
+ * ソフトウェアリセット後は前回のスキャン結果を信用し、接続されていたデバイスの確認だけで完了する。
+ * 完了したスキャン結果はRTCメモリへ保存する。
+ */
+void I2CBusManager::beginScan(void) {
+  uint8_t known[I2CDeviceRegistry::COUNT];
+  for (size_t i = 0; i < I2CDeviceRegistry::COUNT; i++) {
+    known[i] = I2CDeviceRegistry::at(i).address;
+  }
+
+  scanner.onProgress([this](const I2CScanProgress& progress) {
+    if (progress.phase == I2CScanPhase::Done) {
+      saveScanResult(presence);
     }
-    else{
-//      Serial.println(address,HEX);
-//      Serial.println(error);
+    if (scanProgressCallback) {
+      scanProgressCallback(progress);
     }
+  });
+
+  std::lock_guard<std::recursive_mutex> lock(i2cMutex);
+  if (hasLastScanResult()) {
+    scanner.startWarm(lastScan.bits, known, I2CDeviceRegistry::COUNT);
+  } else {
+    scanner.startCold(known, I2CDeviceRegistry::COUNT);
   }
+}
 
-  return i2cDevice;
+/**
+ * @brief アドレスを送り、ACKが返るか確認する
+ * @param address I2Cアドレス
+ * @return true: ACK（デバイスあり）
+ */
+bool I2CBusManager::probeAddress(uint8_t address) {
+  // The i2c_scanner uses the return value of
+  // the Write.endTransmisstion to see if
+  // a device did acknowledge to the address.
+  applyClock(address);                    // 調整済みのデバイスはその周波数、それ以外は既定の周波数
+  Wire.beginTransmission(address);
+  byte error = Wire.endTransmission();
+  if (error == 4) {
+    Serial.print("Unknown error at address 0x");
+    if (address<16)
+      Serial.print("0");
+    Serial.println(address,HEX);
+  }
+  return error == 0;
+}
+
+/**
+ * @brief SCL周波数を設定する
+ * @param hz 周波数[Hz]
+ */
+void I2CBusManager::setBusClock(uint32_t hz) {
+  Wire.setClock(hz);
+}
+
+static constexpr uint32_t CLOCK_REFERENCE_HZ = 100000;   // 比較の基準を読み込む周波数[Hz]
+
+/**
+ * @brief 周波数の調整で読み返すレジスタを読み込む
+ * @param device デバイスの仕様（読み返すレジスタ）
+ * @param data 読み込んだデータ（device.checkLenバイト）
+ * @return true 成功、false NAK・受信バイト数不足
+ */
+static bool readCheckRegister(const I2CDeviceInfo& device, uint8_t *data) {
+  if (device.checkRegBytes > 0) {
+    Wire.beginTransmission(device.address);
+    if (device.checkRegBytes == 2) {
+      Wire.write((int)(device.checkReg >> 8));
+    }
+    Wire.write((int)(device.checkReg & 0xFF));
+    if (Wire.endTransmission(false) != 0) {   // リピーテッドスタートで読み込みへ
+      return false;
+    }
+  }
+  if (Wire.requestFrom(device.address, device.checkLen) != device.checkLen) {
+    return false;
+  }
+  for (uint8_t i = 0; i < device.checkLen; i++) {
+    data[i] = Wire.read();
+  }
+  return true;
+}
+
+/**
+ * @brief 接続されている既知のデバイスのSCL周波数を調整する
+ * @details
+ * I2CDeviceRegistryのデバイスごとに、基準の周波数で読み込んだ内容と候補の周波数で読み込んだ内容を比較し、
+ * I2CClockTuner::tune()で安定して通信できる周波数を求める。
+ * 読み込みのみのため、EEPROMの内容を変更しない。
+ * 調整中はバスを占有する（起動時に1回、デバイスあたり数十ms）。
+ */
+void I2CBusManager::calibrateClocks(void) {
+  std::lock_guard<std::recursive_mutex> lock(i2cMutex);
+  clockTable.clear();
+
+  for (size_t i = 0; i < I2CDeviceRegistry::COUNT; i++) {
+    const I2CDeviceInfo& device = I2CDeviceRegistry::at(i);
+    if (!presence.isPresent(device.address)) {
+      continue;
+    }
+    uint8_t reference[I2CDeviceRegistry::CHECK_MAX_LEN];
+    setBusClock(CLOCK_REFERENCE_HZ);
+    uint32_t hz = 0;
+    if (device.checkLen > 0 && readCheckRegister(device, reference)) {
+      hz = I2CClockTuner::tune([&device, &reference, this](uint32_t candidateHz) {
+        uint8_t data[I2CDeviceRegistry::CHECK_MAX_LEN];
+        setBusClock(candidateHz);
+        return readCheckRegister(device, data) && memcmp(data, reference, device.checkLen) == 0;
+      }, device.maxClockHz);
+    }
+    clockTable.set(device.address, hz);   // 0なら既定の周波数を使う
+    Serial.printf("I2C 0x%02X %s: %u Hz\n", device.address, device.name, (unsigned)clockTable.clockFor(device.address, I2C_FREQ));
+  }
+
+  setBusClock(I2C_FREQ);
+  busClockHz = I2C_FREQ;
 }
 
 /**
  * @brief I2Cバスのデバイス名を取得
  * @param address I2Cアドレス
  * @return デバイス名
- * デバイス名は、i2cDeviceNameMapからアドレスに対応する名前を取得する。
+ * デバイス名は、I2CDeviceRegistryからアドレスに対応する名前を取得する。
  * アドレスが見つからない場合は "Unknown Device" を返す。
  */
-std::string I2CBusManager::getDeviceName(uint8_t address) {
-  auto it = i2cDeviceNameMap.find(address);
-  if (it != i2cDeviceNameMap.end()) {
-    return it->second;
-  }
-  return "Unknown Device";
+const char* I2CBusManager::getDeviceName(uint8_t address) {
+  return I2CDeviceRegistry::nameOf(address);   // 二分探索（動的メモリ確保なし）
 }    
 
 /**
  * @brief EEPROMが接続されているか確認
  * @return true: 接続されている, false: 接続されていない
+ * ロックを取らずに接続状態のビットマップを参照する。
  */
 bool I2CBusManager::isEepromConnected()
 {
-  std::lock_guard<std::recursive_mutex> lock(i2cMutex);
-  return std::find(i2cDevice.begin(), i2cDevice.end(), I2CADR_EEPROM) != i2cDevice.end();
+  return presence.isPresent(I2CADR_EEPROM);
 }
 
 /**
  * @brief M5 OLEDが接続されているか確認
  * @return true: 接続されている, false: 接続されていない
+ * ロックを取らずに接続状態のビットマップを参照する。
  */
 bool I2CBusManager::isM5oledConnected()
 {
-  std::lock_guard<std::recursive_mutex> lock(i2cMutex);
-  return std::find(i2cDevice.begin(), i2cDevice.end(), I2CADR_M5OLED) != i2cDevice.end();
+  return presence.isPresent(I2CADR_M5OLED);
 }
@@ -9,25 +9,17 @@
 #endif
 
 #include <mutex>
+#include <future>
+#include <memory>
 #include <vector>
-#include <map>
-#include <string>
-
-#define I2CADR_M5OLED   0x3c  // M5 OLEDディスプレイのI2Cアドレス
-#define I2CADR_SSD1306  0x3d  // SSD1306 OLEDディスプレイのI2Cアドレス
-#define I2CADR_EEPROM   0x50  // EEPROMのI2Cアドレス
-/**
- * I2Cデバイス名マップ
- */
-const std::map<uint8_t, std::string> i2cDeviceNameMap = {
-  {I2CADR_M5OLED,   "M5 OLED Display SH1107"},
-  {I2CADR_SSD1306,  "SSD1306 OLED Display"},
-  {I2CADR_EEPROM,   "EEPROM 24C32"},
-  {0x51, "M5 RTC"},
-  {0x68, "RTC"},
-  {0x70, "QMP6988"},
-  {0x77, "BME680"}
-};
+#include "I2CScheduler.h"
+#include "I2CPresenceMap.h"
+#include "I2CBusScanner.h"
+#include "I2CBusStats.h"
+#include "I2CClockTuner.h"
+#include "I2CTransport.h"
+#include "I2CDeviceRegistry.h"
+#include "Config.h"
 
 /**
  * @brief I2Cバスアクセス排他管理クラス
@@ -38,15 +30,189 @@ public:
   virtual std::recursive_mutex& getMutex(); // I2Cバスのミューテックスを取得
   virtual TwoWire& getWire();               // I2CバスのWireオブジェクトを取得
 
-  virtual std::vector<uint8_t> scanI2CBus(uint8_t address = 0x00, uint8_t count = 127); // I2Cバスのスキャン
-  virtual std::string getDeviceName(uint8_t address); // デバイス名を取得
+  virtual std::vector<uint8_t> scanI2CBus(uint8_t address = 0x00, uint8_t count = 127); // I2Cバスのスキャン（範囲内の接続状態を更新）
+
+  // 段階的スキャン（既知のアドレスを確認して戻り、残りはupdate()で少しずつ確認）
+  void beginScan(void);                     // スキャン開始（ウォームブートなら前回の接続状態を確認するだけ）
+  void onScanProgress(I2CBusScanner::ProgressCallback callback) { scanProgressCallback = callback; }
+  const I2CScanProgress& getScanProgress() const { return scanner.getProgress(); }
+
+  // 接続状態（ロックを取らずに参照できる）
+  bool isPresent(uint8_t address) const { return presence.isPresent(address); }           // デバイスが接続されているか
+  uint32_t getPresenceGeneration() const { return presence.generation(); }                // 接続状態の世代番号
+  virtual const char* getDeviceName(uint8_t address); // デバイス名を取得
 
   virtual bool isEepromConnected();         // EEPROMが接続されているか確認
   virtual bool isM5oledConnected();         // M5 OLEDが接続されているか確認
+
+  // トランザクションのスケジューリング（優先度・期限の順に実行）
+  bool submit(I2CPriority priority, I2CScheduler::Job job, uint32_t deadlineUs = I2CScheduler::NO_DEADLINE,
+              I2CScheduler::Done done = nullptr) {
+    return scheduler.submit(priority, job, deadlineUs, done);   // 待たずにキューへ積む
+  }
+  bool execute(I2CPriority priority, I2CScheduler::Job job, uint32_t deadlineUs = I2CScheduler::NO_DEADLINE) {
+    return scheduler.execute(priority, job, deadlineUs);        // 完了まで待つ
+  }
+  size_t update(uint32_t budgetUs = I2C_UPDATE_BUDGET_US) {   // メインループから呼ぶ
+    if (scanner.getPhase() == I2CScanPhase::Sweep) {
+      std::lock_guard<std::recursive_mutex> lock(i2cMutex);
+      scanner.step();                                           // 残りのアドレスを少しずつスキャン
+    }
+    return scheduler.runPending(budgetUs);
+  }
+  I2CScheduler& getScheduler() { return scheduler; }
+  void setTimeSource(I2CScheduler::TimeSource source) {   // 待ち時間・期限・占有時間の計測用
+    timeSource = source;
+    scheduler.setTimeSource(source);
+  }
+
+  // 非同期転送（setTransport()で設定したトランスポートで実行し、完了を待たない）
+  void setTransport(I2CTransport* value) { transport = value; }   // 起動時に1回設定する
+  bool hasTransport() const { return transport != nullptr; }
+  bool transfer(const I2CTransfer& request, I2CTransport::Complete complete) {  // 完了はコールバックで通知
+    return transport != nullptr && transport->submit(request, complete);
+  }
+  std::future<I2CTransferStatus> transfer(const I2CTransfer& request) {         // 完了はfutureで受け取る
+    std::shared_ptr<std::promise<I2CTransferStatus>> promise = std::make_shared<std::promise<I2CTransferStatus>>();
+    std::future<I2CTransferStatus> result = promise->get_future();
+    if (!transfer(request, [promise](I2CTransferStatus status) { promise->set_value(status); })) {
+      promise->set_value(I2CTransferStatus::Error);   // トランスポートなし・満杯
+    }
+    return result;
+  }
+
+  // デバイスごとのSCL周波数（I2CTransactionがWireのトランザクションごとに切り替える）
+  virtual void calibrateClocks(void);       // 接続されている既知のデバイスの周波数を調整する
+  void invalidateClock() {                  // 他のドライバ（LovyanGFX）がポートを設定し直した後に呼ぶ
+    std::lock_guard<std::recursive_mutex> lock(getMutex());
+    busClockHz = 0;                         // 次のトランザクションで必ず設定する
+  }
+  uint32_t getClock(uint8_t address) {      // デバイスとのトランザクションで使う周波数[Hz]
+    std::lock_guard<std::recursive_mutex> lock(getMutex());
+    return clockTable.clockFor(address, I2C_FREQ);
+  }
+  /**
+   * @brief 保存した周波数の表を復元する
+   * @param record I2CClockTable::serialize()で作成したレコード
+   * @param len レコードのバイト数
+   * @return true 復元した、false 未保存・破損、または調整していない既知のデバイスが接続されている
+   */
+  bool restoreClockTable(const uint8_t *record, size_t len) {
+    I2CClockTable table;
+    if (!table.deserialize(record, len)) return false;
+    for (size_t i = 0; i < I2CDeviceRegistry::COUNT; ++i) {
+      uint8_t address = I2CDeviceRegistry::at(i).address;
+      if (presence.isPresent(address) && !table.contains(address)) return false;   // デバイス構成が変わった
+    }
+    std::lock_guard<std::recursive_mutex> lock(getMutex());
+    clockTable = table;
+    return true;
+  }
+  size_t saveClockTable(uint8_t *record, size_t len) {  // 周波数の表を保存用レコードへ変換
+    std::lock_guard<std::recursive_mutex> lock(getMutex());
+    return clockTable.serialize(record, len);
+  }
+
+  // バスの計測（I2CTransactionで記録した値）
+  size_t getDeviceStats(I2CDeviceStats *out, size_t max) {
+    std::lock_guard<std::recursive_mutex> lock(getMutex());
+    return stats.getDevices(out, max);
+  }
+  I2CLockStats getLockStats() {
+    std::lock_guard<std::recursive_mutex> lock(getMutex());
+    return stats.getLockStats();
+  }
+  void resetStats() {
+    std::lock_guard<std::recursive_mutex> lock(getMutex());
+    stats.reset();
+  }
+
+  static constexpr uint32_t I2C_UPDATE_BUDGET_US = 5000;  // update()1回で処理を開始できる時間[us]
 private:
   std::recursive_mutex i2cMutex;
+  I2CScheduler scheduler{i2cMutex};   // i2cMutexの後に初期化すること
+  I2CScheduler::TimeSource timeSource;
+  I2CBusStats stats;                  // バスのミューテックスを保持して更新する
+  I2CTransport* transport = nullptr;  // 非同期転送
+  I2CClockTable clockTable;           // デバイスごとのSCL周波数
+  uint32_t busClockHz = I2C_FREQ;     // 現在のSCL周波数
+
+  uint32_t nowUs() { return timeSource ? timeSource() : 0; }
+  void applyClock(uint8_t address) {  // デバイスの周波数に切り替える（バスのミューテックスを保持して呼ぶ）
+    const I2CDeviceInfo* device = I2CDeviceRegistry::find(address);
+    if (device != nullptr && device->kind == I2CDriverKind::Oled) {
+      busClockHz = 0;                   // OLEDはLovyanGFXのドライバが自身の周波数でポートを設定し直す
+      return;
+    }
+    uint32_t hz = clockTable.clockFor(address, I2C_FREQ);
+    if (hz != busClockHz) {
+      setBusClock(hz);
+      busClockHz = hz;
+    }
+  }
+  friend class I2CTransaction;
 //  TwoWire wire = TwoWire(0);  // 0番ポートを使用（ESP32）
-  std::vector<uint8_t> i2cDevice; // スキャン結果のアドレスリスト
+protected:
+  I2CPresenceMap presence;        // スキャン結果（アドレスごとの接続状態）
+  I2CBusScanner scanner{presence, [this](uint8_t address) { return probeAddress(address); }};  // presenceの後に初期化すること
+  I2CBusScanner::ProgressCallback scanProgressCallback;
+
+  virtual bool probeAddress(uint8_t address);   // アドレスを送りACKが返るか
+  virtual void setBusClock(uint32_t hz);        // SCL周波数を設定
+
+};
+
+/**
+ * @brief 計測付きのI2Cトランザクション
+ * @details バスのミューテックスを取得してデバイスのSCL周波数に切り替え（LovyanGFXが駆動するOLEDを除く）、
+ *  破棄時に占有時間・転送バイト数・結果を記録して解放する。
+ *  ミューテックスが空いていれば時刻の取得は開始・終了の2回のみ。
+ *  使用中だった場合のみ待ち時間を計測する。
+ */
+class I2CTransaction {
+public:
+  I2CTransaction(I2CBusManager& bus, uint8_t address) : bus(bus), address(address) {
+    std::recursive_mutex& mutex = bus.getMutex();
+    bool contended = !mutex.try_lock();
+    uint32_t waitStartUs = 0;
+    if (contended) {
+      waitStartUs = bus.nowUs();
+      mutex.lock();                         // 他のタスクが使用中なら待つ
+    }
+    startUs = bus.nowUs();
+    bus.stats.recordLockWait(contended ? startUs - waitStartUs : 0, contended);
+    bus.applyClock(address);                // デバイスごとのSCL周波数に切り替える
+  }
+  ~I2CTransaction() {
+    bus.stats.record(address, bus.nowUs() - startUs, bytes, result);
+    bus.getMutex().unlock();
+  }
+  I2CTransaction(const I2CTransaction&) = delete;
+  I2CTransaction& operator=(const I2CTransaction&) = delete;
 
+  void addBytes(size_t count) { bytes += (uint16_t)count; }   // 転送したデータのバイト数を加算
+  void setResult(I2CResult value) { result = value; }
+  /**
+   * @brief Wire.endTransmission()の戻り値を結果として記録する
+   * @param error Wire.endTransmission()の戻り値（0:成功、2:アドレスNAK、3:データNAK、その他:エラー）
+   * @return error（そのまま返す）
+   */
+  uint8_t status(uint8_t error) {
+    if (error == 0) {
+      result = I2CResult::Ok;
+    } else if (error == 2 || error == 3) {
+      result = I2CResult::Nak;
+    } else {
+      result = I2CResult::Error;
+    }
+    return error;
+  }
+
+private:
+  I2CBusManager& bus;
+  uint8_t address;
+  uint32_t startUs = 0;
+  uint16_t bytes = 0;
+  I2CResult result = I2CResult::Ok;
 };
 #define wire Wire
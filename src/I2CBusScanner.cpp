@@ -0,0 +1,142 @@
+/**
+ * @file I2CBusScanner.cpp
+ * @brief I2Cバスの段階的スキャン
+ * @details
+ * 126アドレスを続けてスキャンすると、その間I2Cバスを占有し後続の初期化が待たされる。
+ * 起動時は既知のデバイス（EEPROM・OLED・RTCなど）のアドレスだけを確認して初期化を先に進め、
+ * 残りのアドレスはメインループからSLICE_SIZEずつ確認する。
+ * ウォームブートでは前回の接続状態を信用し、接続されていたデバイスと既知のアドレスだけを確認する。
+ * 前回と異なる結果になった場合は、通常のスキャンに切り替える。
+ */
+#include <string.h>
+#include "I2CBusScanner.h"
+
+I2CBusScanner::I2CBusScanner(I2CPresenceMap& presence, Probe probe)
+  : presence(presence), probe(probe), progress(), skip()
+{
+  progress.phase = I2CScanPhase::Idle;
+}
+
+void I2CBusScanner::onProgress(ProgressCallback callback) {
+  progressCallback = callback;
+}
+
+/**
+ * @brief スキャンを開始する
+ * @param known 既知のデバイスのアドレス
+ * @param knownCount 既知のデバイスの数
+ * 既知のアドレスはこの中で確認し、終了時にはそれらのデバイスを初期化できる。
+ */
+void I2CBusScanner::startCold(const uint8_t *known, size_t knownCount) {
+  memset(skip, 0, sizeof(skip));
+  progress.phase = I2CScanPhase::Known;
+  progress.probed = 0;
+  progress.found = 0;
+  progress.total = LAST_ADDRESS - FIRST_ADDRESS + 1;
+  progress.warmBoot = false;
+  nextAddress = FIRST_ADDRESS;
+
+  for (size_t i = 0; i < knownCount; ++i) {
+    if (known[i] >= FIRST_ADDRESS && known[i] <= LAST_ADDRESS && !isProbed(known[i])) {
+      probeAndPublish(known[i]);
+    }
+  }
+  notify();
+  progress.phase = I2CScanPhase::Sweep;
+}
+
+/**
+ * @brief 前回の接続状態を確認するだけのスキャンを開始する
+ * @param lastBits 前回の接続状態（I2CPresenceMap::WORD_COUNT個）
+ * @param known 既知のデバイスのアドレス
+ * @param knownCount 既知のデバイスの数
+ * 前回接続されていたアドレスと既知のアドレスだけを確認し、その他は前回どおり未接続とする。
+ * 1つでも前回と異なれば、残りのアドレスをstep()で確認する通常のスキャンに切り替える。
+ */
+void I2CBusScanner::startWarm(const uint32_t *lastBits, const uint8_t *known, size_t knownCount) {
+  memset(skip, 0, sizeof(skip));
+  progress.phase = I2CScanPhase::Known;
+  progress.probed = 0;
+  progress.found = 0;
+  progress.warmBoot = true;
+  nextAddress = FIRST_ADDRESS;
+
+  presence.replace(lastBits);   // 前回の接続状態を仮に反映
+  bool mismatch = false;
+  uint8_t verify = 0;
+  for (uint16_t address = FIRST_ADDRESS; address <= LAST_ADDRESS; ++address) {
+    if ((lastBits[address >> 5] >> (address & 31)) & 1u) verify++;
+  }
+  for (size_t i = 0; i < knownCount; ++i) {
+    if (known[i] >= FIRST_ADDRESS && known[i] <= LAST_ADDRESS && !((lastBits[known[i] >> 5] >> (known[i] & 31)) & 1u)) verify++;
+  }
+  progress.total = verify;
+
+  for (size_t i = 0; i < knownCount; ++i) {
+    if (known[i] >= FIRST_ADDRESS && known[i] <= LAST_ADDRESS && !isProbed(known[i])) {
+      mismatch = probeAndPublish(known[i]) || mismatch;
+    }
+  }
+  for (uint16_t address = FIRST_ADDRESS; address <= LAST_ADDRESS; ++address) {
+    if (((lastBits[address >> 5] >> (address & 31)) & 1u) && !isProbed((uint8_t)address)) {
+      mismatch = probeAndPublish((uint8_t)address) || mismatch;
+    }
+  }
+  if (mismatch) {
+    progress.warmBoot = false;                       // 前回と異なるため通常のスキャンへ
+    progress.total = LAST_ADDRESS - FIRST_ADDRESS + 1;
+  }
+  notify();
+
+  progress.phase = mismatch ? I2CScanPhase::Sweep : I2CScanPhase::Done;
+  if (!mismatch) {
+    notify();
+  }
+}
+
+/**
+ * @brief 残りのアドレスを確認する（メインループから呼ぶ）
+ * @param slice 今回確認するアドレス数の上限
+ * @return true スキャン中、false 完了または未開始
+ */
+bool I2CBusScanner::step(uint8_t slice) {
+  if (progress.phase != I2CScanPhase::Sweep) {
+    return false;
+  }
+
+  uint8_t probed = 0;
+  while (nextAddress <= LAST_ADDRESS && probed < slice) {
+    uint8_t address = (uint8_t)nextAddress++;
+    if (!isProbed(address)) {
+      probeAndPublish(address);
+      probed++;
+    }
+  }
+  if (nextAddress > LAST_ADDRESS) {
+    progress.phase = I2CScanPhase::Done;
+  }
+  notify();
+  return progress.phase == I2CScanPhase::Sweep;
+}
+
+bool I2CBusScanner::probeAndPublish(uint8_t address) {
+  bool present = probe(address);
+  markProbed(address);
+  progress.probed++;
+  if (present) progress.found++;
+  return presence.set(address, present);    // 1アドレスずつ反映（読み出し側はロック不要）
+}
+
+void I2CBusScanner::markProbed(uint8_t address) {
+  skip[address >> 5] |= 1u << (address & 31);
+}
+
+bool I2CBusScanner::isProbed(uint8_t address) const {
+  return (skip[address >> 5] >> (address & 31)) & 1u;
+}
+
+void I2CBusScanner::notify(void) {
+  if (progressCallback) {
+    progressCallback(progress);
+  }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <functional>
+#include "I2CPresenceMap.h"
+
+/**
+ * @brief I2Cバススキャンの段階
+ */
+enum class I2CScanPhase {
+  Idle,     // 未開始
+  Known,    // 既知アドレスの確認（開始時に一括）
+  Sweep,    // 残りのアドレスを少しずつ確認
+  Done      // 完了
+};
+
+// スキャンの進捗
+struct I2CScanProgress {
+  I2CScanPhase phase;   // 現在の段階
+  uint8_t probed;       // 確認したアドレス数
+  uint8_t total;        // 確認するアドレス数
+  uint8_t found;        // 見つかったデバイス数
+  bool warmBoot;        // 前回の接続状態を確認するだけのスキャンか
+};
+
+// I2Cバスの段階的スキャン
+// 起動時は既知のデバイスのアドレスだけを確認し、残りはupdate()ごとに少しずつ確認する
+// 確認した範囲はその都度I2CPresenceMapへ反映する
+class I2CBusScanner {
+public:
+  using Probe = std::function<bool(uint8_t address)>;                     // アドレスを送りACKが返るか
+  using ProgressCallback = std::function<void(const I2CScanProgress&)>;  // 進捗通知
+
+  static constexpr uint8_t FIRST_ADDRESS = 0x01;    // 0x00はゼネラルコール
+  static constexpr uint8_t LAST_ADDRESS = 0x7E;     // 0x7Fは予約
+  static constexpr uint8_t SLICE_SIZE = 8;          // step()1回で確認するアドレス数
+
+  I2CBusScanner(I2CPresenceMap& presence, Probe probe);
+
+  void onProgress(ProgressCallback callback);
+  void startCold(const uint8_t *known, size_t knownCount);                            // 既知アドレスを確認し、残りを順次スキャン
+  void startWarm(const uint32_t *lastBits, const uint8_t *known, size_t knownCount); // 前回の接続状態を確認するだけ
+  bool step(uint8_t slice = SLICE_SIZE);  // 残りのアドレスを確認する（スキャン中ならtrue）
+  I2CScanPhase getPhase(void) const { return progress.phase; }
+  const I2CScanProgress& getProgress(void) const { return progress; }
+
+private:
+  I2CPresenceMap& presence;
+  Probe probe;
+  ProgressCallback progressCallback;
+  I2CScanProgress progress;
+  uint32_t skip[I2CPresenceMap::WORD_COUNT];   // 確認済みのアドレス（Sweepでは飛ばす）
+  uint16_t nextAddress = FIRST_ADDRESS;        // Sweepで次に確認するアドレス
+
+  bool probeAndPublish(uint8_t address);       // 1アドレスを確認して反映（接続状態が変わればtrue）
+  void markProbed(uint8_t address);
+  bool isProbed(uint8_t address) const;
+  void notify(void);
+};
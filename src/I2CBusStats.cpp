@@ -0,0 +1,96 @@
+/**
+ * @file I2CBusStats.cpp
+ * @brief I2Cバスの計測
+ * @details
+ * どのデバイス（OLED・RTC・EEPROMなど）がバスを占有しているかを調べるため、
+ * アドレスごとのトランザクション数・転送バイト数・NAK/エラー数・占有時間の分布と、
+ * バスのミューテックス待ち時間を記録する。
+ * 常時有効にできるよう、1件の記録は数回の整数演算で済ませる。
+ */
+#include <string.h>
+#include "I2CBusStats.h"
+
+/**
+ * @brief トランザクション1件を記録する
+ * @param address I2Cアドレス
+ * @param latencyUs バス占有時間[us]
+ * @param bytes 転送したデータのバイト数
+ * @param result 結果
+ */
+void I2CBusStats::record(uint8_t address, uint32_t latencyUs, uint16_t bytes, I2CResult result) {
+  I2CDeviceStats* device = nullptr;
+  for (size_t i = 0; i < deviceCount; ++i) {
+    if (devices[i].address == address) {
+      device = &devices[i];
+      break;
+    }
+  }
+  if (device == nullptr) {
+    if (deviceCount >= MAX_DEVICES) {
+      dropped++;
+      return;
+    }
+    device = &devices[deviceCount++];
+    device->address = address;
+  }
+
+  device->transactions++;
+  device->bytes += bytes;
+  switch (result) {
+    case I2CResult::Nak:   device->naks++; break;
+    case I2CResult::Busy:  device->busy++; break;
+    case I2CResult::Error: device->errors++; break;
+    default: break;
+  }
+  device->totalUs += latencyUs;
+  if (latencyUs > device->maxUs) device->maxUs = latencyUs;
+  device->histogram[latencyBucket(latencyUs)]++;
+}
+
+/**
+ * @brief ミューテックス取得1回を記録する
+ * @param waitUs 待ち時間[us]
+ * @param contended 他のタスクが使用中だったか
+ */
+void I2CBusStats::recordLockWait(uint32_t waitUs, bool contended) {
+  lock.acquisitions++;
+  if (contended) lock.contended++;
+  lock.totalWaitUs += waitUs;
+  if (waitUs > lock.maxWaitUs) lock.maxWaitUs = waitUs;
+}
+
+/**
+ * @brief アドレスごとの統計を取得する
+ * @param out 出力先
+ * @param max 出力先の件数
+ * @return 出力した件数
+ */
+size_t I2CBusStats::getDevices(I2CDeviceStats *out, size_t max) const {
+  size_t count = (deviceCount < max) ? deviceCount : max;
+  memcpy(out, devices, count * sizeof(I2CDeviceStats));
+  return count;
+}
+
+void I2CBusStats::reset(void) {
+  memset(devices, 0, sizeof(devices));
+  memset(&lock, 0, sizeof(lock));
+  deviceCount = 0;
+  dropped = 0;
+}
+
+/**
+ * @brief バス占有時間の分布の区分
+ * @param latencyUs バス占有時間[us]
+ * @return 区分（0: 64us未満、1: 128us未満、…、7: 4096us以上）
+ */
+size_t I2CBusStats::latencyBucket(uint32_t latencyUs) {
+  size_t bucket = 0;
+  for (uint32_t limit = 64; bucket + 1 < I2CDeviceStats::LATENCY_BUCKETS && latencyUs >= limit; limit <<= 1) {
+    bucket++;
+  }
+  return bucket;
+}
+
+uint32_t I2CBusStats::bucketLimitUs(size_t bucket) {
+  return (bucket + 1 < I2CDeviceStats::LATENCY_BUCKETS) ? (64u << bucket) : 0;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief I2Cトランザクションの結果
+ */
+enum class I2CResult : uint8_t {
+  Ok,       // 正常終了
+  Nak,      // デバイスがNAKを返した（アドレス・データ）
+  Busy,     // 書き込みサイクル中のACKポーリングなど、想定どおりのNAK
+  Error     // バスエラー・タイムアウト
+};
+
+// アドレスごとの統計
+struct I2CDeviceStats {
+  static constexpr size_t LATENCY_BUCKETS = 8;   // <64us, <128us, ... , <4096us, 4096us以上
+
+  uint8_t address;
+  uint32_t transactions;                  // トランザクション数
+  uint32_t bytes;                         // 転送したデータのバイト数
+  uint32_t naks;                          // NAK数
+  uint32_t busy;                          // 想定どおりのNAK数（ACKポーリング）
+  uint32_t errors;                        // エラー数
+  uint32_t totalUs;                       // バス占有時間の合計[us]
+  uint32_t maxUs;                         // バス占有時間の最大値[us]
+  uint32_t histogram[LATENCY_BUCKETS];    // バス占有時間の分布
+};
+
+// バスのミューテックス待ちの統計
+struct I2CLockStats {
+  uint32_t acquisitions;  // 取得回数
+  uint32_t contended;     // 他のタスクが使用中で待った回数
+  uint32_t totalWaitUs;   // 待ち時間の合計[us]
+  uint32_t maxWaitUs;     // 待ち時間の最大値[us]
+};
+
+// I2Cバスの計測
+// 記録はバスのミューテックスを保持して行うため、記録側に排他処理は不要
+// 1件の記録は固定長の配列を更新するだけで、動的メモリ確保はしない
+class I2CBusStats {
+public:
+  static constexpr size_t MAX_DEVICES = 8;        // 記録するアドレスの数（超えた分は記録しない）
+
+  I2CBusStats() { reset(); }
+
+  void record(uint8_t address, uint32_t latencyUs, uint16_t bytes, I2CResult result);  // トランザクション1件を記録
+  void recordLockWait(uint32_t waitUs, bool contended);                                // ミューテックス取得1回を記録
+  size_t getDevices(I2CDeviceStats *out, size_t max) const;   // アドレスごとの統計を取得（件数を返す）
+  I2CLockStats getLockStats(void) const { return lock; }
+  uint32_t getDropped(void) const { return dropped; }         // 記録できなかったトランザクション数
+  void reset(void);
+
+  static size_t latencyBucket(uint32_t latencyUs);            // バス占有時間の分布の区分
+  static uint32_t bucketLimitUs(size_t bucket);               // 区分の上限[us]（最後の区分は0）
+
+private:
+  I2CDeviceStats devices[MAX_DEVICES];
+  size_t deviceCount = 0;
+  I2CLockStats lock;
+  uint32_t dropped = 0;
+};
@@ -0,0 +1,159 @@
+/**
+ * @file I2CClockTuner.cpp
+ * @brief I2CデバイスごとのSCL周波数の自動調整
+ * @details
+ * バス全体をI2C_FREQに固定すると、Fast-mode Plusに対応したデバイスは遅いまま、
+ * 配線の長いデバイスでは400kHzでも余裕がない。
+ * 接続されたデバイスごとに読み返し確認で安定して通信できる最高の周波数を求め、
+ * Wireでアクセスするデバイスは、I2CTransactionがトランザクションごとにその周波数へ切り替える。
+ * OLEDはLovyanGFXのドライバが送信のたびにポートを設定するため、初期化時にその周波数を渡す。
+ * 結果はI2CClockTableのレコードとしてEEPROMに保存し、起動のたびに調整しない。
+ */
+#include <string.h>
+#include "I2CClockTuner.h"
+#include "Crc16.h"
+
+void I2CClockTable::clear(void) {
+  memset(entries, 0, sizeof(entries));
+  entryCount = 0;
+}
+
+/**
+ * @brief デバイスの周波数を登録する
+ * @param address I2Cアドレス
+ * @param hz 周波数[Hz]（I2CClockTuner::rate()の候補、0なら既定の周波数を使う）
+ * @return true 登録した、false 候補にない周波数・表が満杯
+ */
+bool I2CClockTable::set(uint8_t address, uint32_t hz) {
+  uint8_t index = NO_RATE;
+  if (hz != 0) {
+    size_t found = I2CClockTuner::rateIndex(hz);
+    if (found >= I2CClockTuner::RATE_COUNT) return false;
+    index = (uint8_t)found;
+  }
+  for (size_t i = 0; i < entryCount; ++i) {
+    if (entries[i].address == address) {
+      entries[i].rateIndex = index;
+      return true;
+    }
+  }
+  if (entryCount >= MAX_ENTRIES) return false;
+  entries[entryCount].address = address;
+  entries[entryCount].rateIndex = index;
+  entryCount++;
+  return true;
+}
+
+bool I2CClockTable::contains(uint8_t address) const {
+  for (size_t i = 0; i < entryCount; ++i) {
+    if (entries[i].address == address) return true;
+  }
+  return false;
+}
+
+/**
+ * @brief トランザクションで使う周波数
+ * @param address I2Cアドレス
+ * @param defaultHz 未登録・調整できなかったデバイスの周波数[Hz]
+ * @return 周波数[Hz]
+ */
+uint32_t I2CClockTable::clockFor(uint8_t address, uint32_t defaultHz) const {
+  for (size_t i = 0; i < entryCount; ++i) {
+    if (entries[i].address == address) {
+      return (entries[i].rateIndex == NO_RATE) ? defaultHz : I2CClockTuner::rate(entries[i].rateIndex);
+    }
+  }
+  return defaultHz;
+}
+
+/**
+ * @brief 保存用レコードへ変換する
+ * @param record 出力先
+ * @param len 出力先のバイト数（RECORD_SIZE以上）
+ * @return 書き込んだバイト数（出力先が小さい場合は0）
+ */
+size_t I2CClockTable::serialize(uint8_t *record, size_t len) const {
+  if (record == nullptr || len < RECORD_SIZE) return 0;
+  memset(record, 0xFF, RECORD_SIZE);
+  record[0] = (uint8_t)(RECORD_MAGIC >> 8);
+  record[1] = (uint8_t)(RECORD_MAGIC & 0xFF);
+  record[2] = (uint8_t)entryCount;
+  record[3] = 0;
+  for (size_t i = 0; i < entryCount; ++i) {
+    record[4 + i * 2] = entries[i].address;
+    record[4 + i * 2 + 1] = entries[i].rateIndex;
+  }
+  uint16_t crc = crc16Ccitt(record, RECORD_SIZE - 2);
+  record[RECORD_SIZE - 2] = (uint8_t)(crc >> 8);
+  record[RECORD_SIZE - 1] = (uint8_t)(crc & 0xFF);
+  return RECORD_SIZE;
+}
+
+/**
+ * @brief 保存用レコードから復元する
+ * @param record レコード
+ * @param len レコードのバイト数
+ * @return true 復元した、false 未保存・破損（表は変更しない）
+ */
+bool I2CClockTable::deserialize(const uint8_t *record, size_t len) {
+  if (record == nullptr || len < RECORD_SIZE) return false;
+  if (record[0] != (uint8_t)(RECORD_MAGIC >> 8) || record[1] != (uint8_t)(RECORD_MAGIC & 0xFF)) return false;
+  uint16_t crc = (uint16_t)((record[RECORD_SIZE - 2] << 8) | record[RECORD_SIZE - 1]);
+  if (crc != crc16Ccitt(record, RECORD_SIZE - 2)) return false;
+  size_t count = record[2];
+  if (count > MAX_ENTRIES) return false;
+  for (size_t i = 0; i < count; ++i) {
+    uint8_t index = record[4 + i * 2 + 1];
+    if (index != NO_RATE && index >= I2CClockTuner::RATE_COUNT) return false;
+  }
+
+  clear();
+  for (size_t i = 0; i < count; ++i) {
+    entries[i].address = record[4 + i * 2];
+    entries[i].rateIndex = record[4 + i * 2 + 1];
+  }
+  entryCount = count;
+  return true;
+}
+
+/**
+ * @brief 周波数の候補
+ * @param index 番号（0〜RATE_COUNT-1）
+ * @return 周波数[Hz]（範囲外は0）
+ */
+uint32_t I2CClockTuner::rate(size_t index) {
+  static const uint32_t rates[RATE_COUNT] = {100000, 200000, 300000, 400000, 600000, 800000, 1000000};
+  return (index < RATE_COUNT) ? rates[index] : 0;
+}
+
+size_t I2CClockTuner::rateIndex(uint32_t hz) {
+  for (size_t i = 0; i < RATE_COUNT; ++i) {
+    if (rate(i) == hz) return i;
+  }
+  return RATE_COUNT;
+}
+
+/**
+ * @brief 採用する周波数を求める
+ * @param check 周波数hzで読み返しが一致するか確認する関数
+ * @param maxHz デバイスの仕様上の上限[Hz]
+ * @return 周波数[Hz]（最低の周波数でも失敗した場合は0）
+ */
+uint32_t I2CClockTuner::tune(const Check& check, uint32_t maxHz) {
+  size_t passed = RATE_COUNT;   // 成功した最も高い周波数の番号
+  bool failed = false;
+  for (size_t i = 0; i < RATE_COUNT && rate(i) <= maxHz; ++i) {
+    for (uint8_t n = 0; n < CHECK_REPEAT && !failed; ++n) {
+      failed = !check(rate(i));
+    }
+    if (failed) break;
+    passed = i;
+  }
+  if (passed == RATE_COUNT) {
+    return 0;
+  }
+  if (failed && passed > 0) {
+    passed--;                   // 失敗した周波数の直下は余裕がないため1段下げる
+  }
+  return rate(passed);
+}
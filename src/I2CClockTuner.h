@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <functional>
+
+/**
+ * @brief デバイスごとのSCL周波数の表
+ * - 周波数は候補（I2CClockTuner::rate()）の番号で持つ
+ * - EEPROMに保存するため、CRC付きの固定長レコードに変換できる
+ */
+class I2CClockTable {
+public:
+  static constexpr size_t MAX_ENTRIES = 8;        // 登録できるデバイス数
+  static constexpr size_t RECORD_SIZE = 4 + MAX_ENTRIES * 2 + 2;  // マジック2 + 件数1 + 予備1 + (アドレス + 番号) × 8 + CRC2
+  static constexpr uint8_t NO_RATE = 0xFF;        // 調整できなかった（既定の周波数を使う）
+
+  I2CClockTable() { clear(); }
+
+  void clear(void);
+  bool set(uint8_t address, uint32_t hz);         // 周波数を登録（0なら既定の周波数を使う）
+  bool contains(uint8_t address) const;           // 調整済みか（既定の周波数を使う場合を含む）
+  uint32_t clockFor(uint8_t address, uint32_t defaultHz) const;   // トランザクションで使う周波数
+  size_t count(void) const { return entryCount; }
+
+  size_t serialize(uint8_t *record, size_t len) const;   // 保存用レコードへ変換（書き込んだバイト数を返す）
+  bool deserialize(const uint8_t *record, size_t len);   // 保存用レコードから復元（破損していればfalse）
+
+private:
+  static constexpr uint16_t RECORD_MAGIC = 0x4B43;  // "CK"
+
+  struct Entry {
+    uint8_t address;
+    uint8_t rateIndex;
+  };
+  Entry entries[MAX_ENTRIES];
+  size_t entryCount = 0;
+};
+
+/**
+ * @brief SCL周波数の自動調整
+ * 候補の周波数を低い方から順に、読み返し確認をCHECK_REPEAT回すべて成功するか試す。
+ * 失敗した周波数があれば、成功した最も高い周波数の1段下を余裕として採用する。
+ */
+class I2CClockTuner {
+public:
+  using Check = std::function<bool(uint32_t hz)>;   // 周波数hzで読み返しが一致するか
+
+  static constexpr size_t RATE_COUNT = 7;           // 周波数の候補数
+  static constexpr uint8_t CHECK_REPEAT = 16;       // 1つの周波数で確認する回数
+
+  static uint32_t rate(size_t index);               // 周波数の候補（昇順）[Hz]
+  static size_t rateIndex(uint32_t hz);             // 周波数の候補の番号（候補にない場合はRATE_COUNT）
+  static uint32_t tune(const Check& check, uint32_t maxHz);   // 採用する周波数（最低の周波数でも失敗なら0）
+};
@@ -0,0 +1,22 @@
+/**
+ * @file I2CDeviceRegistry.cpp
+ * @brief 既知のI2Cデバイスの表
+ */
+#include "I2CDeviceRegistry.h"
+
+constexpr I2CDeviceInfo I2CDeviceRegistry::devices[];
+
+/**
+ * @brief ドライバの種類の表示名
+ * @param kind ドライバの種類
+ * @return 表示名
+ */
+const char* I2CDeviceRegistry::kindName(I2CDriverKind kind) {
+  switch (kind) {
+    case I2CDriverKind::Oled:   return "oled";
+    case I2CDriverKind::Eeprom: return "eeprom";
+    case I2CDriverKind::Rtc:    return "rtc";
+    case I2CDriverKind::Sensor: return "sensor";
+    default:                    return "unknown";
+  }
+}
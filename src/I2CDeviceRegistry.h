@@ -0,0 +1,94 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define I2CADR_M5OLED   0x3c  // M5 OLEDディスプレイのI2Cアドレス
+#define I2CADR_SSD1306  0x3d  // SSD1306 OLEDディスプレイのI2Cアドレス
+#define I2CADR_EEPROM   0x50  // EEPROMのI2Cアドレス
+#define I2CADR_M5RTC    0x51  // M5 RTC(BM8563)のI2Cアドレス
+#define I2CADR_RTC      0x68  // DS1307/DS3231のI2Cアドレス
+#define I2CADR_QMP6988  0x70  // 気圧センサQMP6988のI2Cアドレス
+#define I2CADR_BME680   0x77  // 環境センサBME680のI2Cアドレス
+
+/**
+ * @brief I2Cデバイスを扱うドライバの種類
+ */
+enum class I2CDriverKind : uint8_t {
+  Unknown,
+  Oled,     // OLEDディスプレイ
+  Eeprom,   // I2C EEPROM
+  Rtc,      // リアルタイムクロック
+  Sensor    // 環境センサ
+};
+
+/**
+ * @brief I2Cデバイスの仕様
+ */
+struct I2CDeviceInfo {
+  uint8_t address;          // I2Cアドレス
+  const char *name;         // デバイス名
+  I2CDriverKind kind;       // ドライバの種類
+  uint32_t maxClockHz;      // 仕様上のSCL周波数の上限[Hz]
+  uint16_t pageSize;        // ページ書き込みのバイト数（0：ページ書き込みなし）
+  uint8_t checkRegBytes;    // 周波数の調整で読み返すレジスタのアドレスのバイト数（0：レジスタ指定なしで読む）
+  uint16_t checkReg;        // 周波数の調整で読み返すレジスタ（内容が変化しないもの）
+  uint8_t checkLen;         // 周波数の調整で読み返すバイト数（0：読み返しできない）
+};
+
+/**
+ * @brief 既知のI2Cデバイスの表（アドレス順）
+ * コンパイル時に確定する定数表のため、起動時の初期化と動的メモリ確保がない。
+ * 検索は二分探索。スキャン・周波数の調整・EEPROMのページサイズはこの表を参照する。
+ */
+class I2CDeviceRegistry {
+public:
+  static constexpr size_t COUNT = 7;
+  static constexpr size_t CHECK_MAX_LEN = 8;      // 読み返すバイト数の上限
+  static constexpr I2CDeviceInfo devices[COUNT] = {
+    // address         name                      kind                    maxClockHz  page  check(bytes, reg, len)
+    {I2CADR_M5OLED,  "M5 OLED Display SH1107", I2CDriverKind::Oled,    1000000,    0,    0, 0x0000, 1},  // ステータス（Fast-mode Plus対応）
+    {I2CADR_SSD1306, "SSD1306 OLED Display",   I2CDriverKind::Oled,     400000,    0,    0, 0x0000, 1},  // ステータス
+    {I2CADR_EEPROM,  "EEPROM 24C32",           I2CDriverKind::Eeprom,   400000,   32,    2, 0x0000, 8},  // 先頭8バイト
+    {I2CADR_M5RTC,   "M5 RTC",                 I2CDriverKind::Rtc,      400000,    0,    1, 0x0009, 4},  // BM8563：アラームレジスタ
+    {I2CADR_RTC,     "RTC",                    I2CDriverKind::Rtc,      400000,    0,    1, 0x0007, 4},  // DS3231：アラーム1（DS1307：制御レジスタとRAM）
+    {I2CADR_QMP6988, "QMP6988",                I2CDriverKind::Sensor,  1000000,    0,    1, 0x00D1, 1},  // チップID
+    {I2CADR_BME680,  "BME680",                 I2CDriverKind::Sensor,  1000000,    0,    1, 0x00D0, 1},  // チップID
+  };
+
+  /**
+   * @brief アドレスからデバイスの仕様を検索する
+   * @param address I2Cアドレス
+   * @return 仕様（未登録ならnullptr）
+   */
+  static constexpr const I2CDeviceInfo* find(uint8_t address) {
+    return search(address, 0, COUNT);
+  }
+  static constexpr const I2CDeviceInfo& at(size_t index) { return devices[index]; }
+
+  static const char* nameOf(uint8_t address) {      // デバイス名（未登録なら"Unknown Device"）
+    const I2CDeviceInfo* info = find(address);
+    return info ? info->name : "Unknown Device";
+  }
+  static const char* kindName(I2CDriverKind kind);  // ドライバの種類の表示名
+
+  static constexpr bool isSorted(size_t index = 1) {   // アドレス順に並んでいるか（static_assertで確認）
+    return index >= COUNT || (devices[index - 1].address < devices[index].address && isSorted(index + 1));
+  }
+  static constexpr bool checksFit(size_t index = 0) {  // 読み返すバイト数が上限以内か
+    return index >= COUNT || (devices[index].checkLen <= CHECK_MAX_LEN && checksFit(index + 1));
+  }
+
+private:
+  static constexpr const I2CDeviceInfo* search(uint8_t address, size_t low, size_t high) {
+    return (low >= high) ? nullptr
+         : (devices[(low + high) / 2].address == address) ? &devices[(low + high) / 2]
+         : (devices[(low + high) / 2].address < address) ? search(address, (low + high) / 2 + 1, high)
+         : search(address, low, (low + high) / 2);
+  }
+};
+
+static_assert(I2CDeviceRegistry::isSorted(), "I2CDeviceRegistry::devices must be sorted by address");
+static_assert(I2CDeviceRegistry::checksFit(), "checkLen exceeds I2CDeviceRegistry::CHECK_MAX_LEN");
+static_assert(I2CDeviceRegistry::find(I2CADR_EEPROM) != nullptr && I2CDeviceRegistry::find(I2CADR_EEPROM)->pageSize > 0,
+              "EEPROM must have a page size");
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief I2Cデバイスの接続状態（7bitアドレス128個分のビットマップ）
+ * - isPresent()はロックを取らず、32bitのアトミック変数1個を読むだけ
+ * - 更新のたびに世代番号が変わるため、利用側は世代番号が同じ間は判定結果を使い回せる
+ * - 世代番号は更新中は奇数になる（シーケンスロック）。snapshot()は更新中の値を読まない
+ * - 更新（set/replace）は1スレッドから行うこと（I2Cバスのミューテックスを保持したスキャン処理）
+ */
+class I2CPresenceMap {
+public:
+  static constexpr size_t WORD_COUNT = 4;   // 32bit × 4 = 128アドレス
+
+  I2CPresenceMap() {
+    for (size_t i = 0; i < WORD_COUNT; ++i) {
+      words[i].store(0, std::memory_order_relaxed);
+    }
+    gen.store(0, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief デバイスが接続されているか
+   * @param address 7bitアドレス
+   */
+  bool isPresent(uint8_t address) const {
+    if (address >= 128) return false;
+    return (words[address >> 5].load(std::memory_order_acquire) >> (address & 31)) & 1u;
+  }
+
+  /**
+   * @brief 世代番号（接続状態が変わるたびに進む）
+   */
+  uint32_t generation() const {
+    return gen.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief 1アドレスの接続状態を更新する（ホットプラグの再スキャン）
+   * @param address 7bitアドレス
+   * @param present 接続されているか
+   * @return true 状態が変化した
+   */
+  bool set(uint8_t address, bool present) {
+    if (address >= 128 || isPresent(address) == present) return false;
+    uint32_t bit = 1u << (address & 31);
+    beginUpdate();
+    if (present) {
+      words[address >> 5].fetch_or(bit, std::memory_order_release);
+    } else {
+      words[address >> 5].fetch_and(~bit, std::memory_order_release);
+    }
+    endUpdate();
+    return true;
+  }
+
+  /**
+   * @brief 範囲内の接続状態をまとめて置き換える（スキャン結果の反映）
+   * @param bits スキャン結果（WORD_COUNT個の32bit値）
+   * @param first 範囲の先頭アドレス
+   * @param count 範囲のアドレス数
+   * @return true 状態が変化した
+   */
+  bool replace(const uint32_t *bits, uint8_t first = 0, uint8_t count = 128) {
+    uint32_t mask[WORD_COUNT] = {0};
+    for (uint16_t a = first; a < (uint16_t)first + count && a < 128; ++a) {
+      mask[a >> 5] |= 1u << (a & 31);
+    }
+    bool changed = false;
+    for (size_t i = 0; i < WORD_COUNT; ++i) {
+      changed = changed || (((words[i].load(std::memory_order_relaxed) ^ bits[i]) & mask[i]) != 0);
+    }
+    if (!changed) return false;
+
+    beginUpdate();
+    for (size_t i = 0; i < WORD_COUNT; ++i) {
+      uint32_t current = words[i].load(std::memory_order_relaxed);
+      words[i].store((current & ~mask[i]) | (bits[i] & mask[i]), std::memory_order_release);
+    }
+    endUpdate();
+    return true;
+  }
+
+  /**
+   * @brief 一貫した接続状態を読み出す
+   * @param bits 読み出し先（WORD_COUNT個）
+   * @return 読み出した状態の世代番号
+   */
+  uint32_t snapshot(uint32_t *bits) const {
+    for (;;) {
+      uint32_t before = gen.load(std::memory_order_acquire);
+      if (before & 1u) continue;      // 更新中
+      for (size_t i = 0; i < WORD_COUNT; ++i) {
+        bits[i] = words[i].load(std::memory_order_acquire);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (gen.load(std::memory_order_relaxed) == before) {
+        return before;
+      }
+    }
+  }
+
+private:
+  std::atomic<uint32_t> words[WORD_COUNT];
+  std::atomic<uint32_t> gen;
+
+  void beginUpdate() {
+    gen.fetch_add(1, std::memory_order_acq_rel);   // 奇数: 更新中
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+  void endUpdate() {
+    gen.fetch_add(1, std::memory_order_release);   // 偶数: 更新完了
+  }
+};
@@ -0,0 +1,234 @@
+/**
+ * @file I2CScheduler.cpp
+ * @brief I2Cトランザクションのスケジューラ
+ * @details
+ * OLED・RTC・EEPROM・環境センサは1本のI2Cバスを共有している。
+ * 各処理をキューに積み、優先度と期限の順に1件ずつ実行することで、
+ * 時間のかかるOLEDの描画中でもRTCの読み込みを先に実行できるようにする。
+ */
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "I2CScheduler.h"
+
+I2CScheduler::I2CScheduler(std::recursive_mutex& busMutex)
+  : busMutex(busMutex), slots(), stats()
+{
+}
+
+/**
+ * @brief 現在時刻の取得関数を設定する
+ * @param source 現在時刻[us]を返す関数（未設定なら常に0）
+ */
+void I2CScheduler::setTimeSource(TimeSource source) {
+  timeSource = source;
+}
+
+uint32_t I2CScheduler::now(void) {
+  return timeSource ? timeSource() : 0;
+}
+
+/**
+ * @brief 処理をキューに積む
+ * @param priority 優先度
+ * @param job バスを使う処理
+ * @param deadlineUs 受付から開始までの期限[us]（NO_DEADLINEなら期限なし）
+ * @param done 完了通知（実行したスレッドから呼ばれる）
+ * @return true 受付、false キューが満杯
+ */
+bool I2CScheduler::submit(I2CPriority priority, Job job, uint32_t deadlineUs, Done done) {
+  uint32_t seq;
+  return enqueue(priority, job, deadlineUs, done, seq);
+}
+
+/**
+ * @brief 処理をキューに積む
+ * @param seq 受付順の格納先（cancel()に渡す）
+ * @return true 受付、false キューが満杯
+ */
+bool I2CScheduler::enqueue(I2CPriority priority, Job job, uint32_t deadlineUs, Done done, uint32_t& seq) {
+  if (!job) {
+    return false;
+  }
+  uint32_t nowUs = now();
+  std::lock_guard<std::mutex> lock(queueMutex);
+  for (size_t i = 0; i < MAX_JOBS; ++i) {
+    Slot& slot = slots[i];
+    if (!slot.used) {
+      slot.used = true;
+      slot.priority = priority;
+      slot.hasDeadline = (deadlineUs != NO_DEADLINE);
+      slot.deadlineUs = nowUs + deadlineUs;
+      slot.submitUs = nowUs;
+      slot.seq = nextSeq++;
+      seq = slot.seq;
+      slot.job = job;
+      slot.done = done;
+      stats.submitted++;
+      return true;
+    }
+  }
+  stats.rejected++;
+  return false;
+}
+
+/**
+ * @brief 処理をキューに積み、完了まで待つ
+ * @param priority 優先度
+ * @param job バスを使う処理
+ * @param deadlineUs 受付から開始までの期限[us]
+ * @return 処理の成否（所有者が期限までに開始しなかったときはfalse）
+ *  所有者のスレッドから呼んだときは、待っている間にキューの処理を実行する（優先度の高い処理は
+ *  先に積まれた優先度の低い処理を追い越す）。他のスレッドから呼んだときは、所有者が実行するのを待ち、
+ *  他のタスクが積んだ処理（OLEDの描画など）を呼び出し元のスレッドで実行しない。
+ *  所有者が期限（期限なしなら WAIT_TIMEOUT_US）までに開始しなければ、処理を取り消してfalseを返す。
+ *  期限は呼び出し元の実時間で測る（所有者が止まっていると時刻の取得関数も進まないことがあるため）。
+ *  キューが満杯のときはバスのミューテックスを取得して直接実行する。
+ */
+bool I2CScheduler::execute(I2CPriority priority, Job job, uint32_t deadlineUs) {
+  std::atomic<bool> finished(false);
+  bool result = false;
+  uint32_t seq = 0;
+  bool queued = enqueue(priority, job, deadlineUs, [&finished, &result](bool success) {
+    result = success;
+    finished.store(true);
+  }, seq);
+  if (!queued) {
+    std::lock_guard<std::recursive_mutex> lock(busMutex);
+    return job ? job() : false;
+  }
+  const bool runsQueue = (owner == std::thread::id()) || (owner == std::this_thread::get_id());
+  const auto giveUpAt = std::chrono::steady_clock::now()
+                      + std::chrono::microseconds((deadlineUs != NO_DEADLINE) ? deadlineUs : WAIT_TIMEOUT_US);
+  bool waiting = true;      // 期限を過ぎて取り消せなかった（開始していた）ら、完了まで待つ
+  while (!finished.load()) {
+    if (!runsQueue) {
+      if (waiting && (std::chrono::steady_clock::now() >= giveUpAt)) {
+        if (cancel(seq)) {
+          return false;     // 所有者が開始しなかった
+        }
+        waiting = false;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));   // 所有者が実行するのを待つ
+    } else if (!runNext()) {
+      std::this_thread::yield();    // 他のスレッドが実行中
+    }
+  }
+  return result;
+}
+
+/**
+ * @brief まだ開始していない処理を取り消す
+ * @param seq 受付順
+ * @return true 取り消した、false 見つからない（開始済み）
+ */
+bool I2CScheduler::cancel(uint32_t seq) {
+  std::lock_guard<std::mutex> lock(queueMutex);
+  for (size_t i = 0; i < MAX_JOBS; ++i) {
+    Slot& slot = slots[i];
+    if (slot.used && slot.seq == seq) {
+      slot.used = false;
+      slot.job = nullptr;
+      slot.done = nullptr;
+      stats.abandoned++;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief aをbより先に実行するか
+ */
+bool I2CScheduler::runsBefore(const Slot& a, const Slot& b, uint32_t nowUs) const {
+  bool aOverdue = a.hasDeadline && (int32_t)(nowUs - a.deadlineUs) >= 0;
+  bool bOverdue = b.hasDeadline && (int32_t)(nowUs - b.deadlineUs) >= 0;
+  if (aOverdue != bOverdue) {
+    return aOverdue;                        // 期限切れを最優先
+  }
+  if (!aOverdue && a.priority != b.priority) {
+    return a.priority < b.priority;
+  }
+  if (a.hasDeadline != b.hasDeadline) {
+    return a.hasDeadline;                   // 期限ありを先に
+  }
+  if (a.hasDeadline && a.deadlineUs != b.deadlineUs) {
+    return (int32_t)(a.deadlineUs - b.deadlineUs) < 0;
+  }
+  return (int32_t)(a.seq - b.seq) < 0;      // 受付順
+}
+
+/**
+ * @brief 次の処理を1件実行する
+ * @return true 実行した、false キューが空
+ */
+bool I2CScheduler::runNext(void) {
+  Slot next;
+  uint32_t nowUs = now();
+  {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    Slot* best = nullptr;
+    for (size_t i = 0; i < MAX_JOBS; ++i) {
+      if (slots[i].used && (best == nullptr || runsBefore(slots[i], *best, nowUs))) {
+        best = &slots[i];
+      }
+    }
+    if (best == nullptr) {
+      return false;
+    }
+    next = *best;
+    best->used = false;
+    best->job = nullptr;
+    best->done = nullptr;
+  }
+
+  bool success;
+  {
+    std::lock_guard<std::recursive_mutex> busLock(busMutex);
+    uint32_t startUs = now();
+    {
+      std::lock_guard<std::mutex> lock(queueMutex);
+      uint32_t waitUs = startUs - next.submitUs;
+      size_t p = static_cast<size_t>(next.priority);
+      if (waitUs > stats.maxWaitUs[p]) stats.maxWaitUs[p] = waitUs;
+      if (next.hasDeadline && (int32_t)(startUs - next.deadlineUs) > 0) stats.deadlineMissed++;
+    }
+    success = next.job();
+  }
+  {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    stats.completed++;
+  }
+  if (next.done) {
+    next.done(success);
+  }
+  return true;
+}
+
+/**
+ * @brief 予算時間内でキューの処理を実行する（メインループから呼ぶ）
+ * @param budgetUs 予算時間[us]（超えた時点で新しい処理を開始しない）
+ * @return 実行した件数
+ */
+size_t I2CScheduler::runPending(uint32_t budgetUs) {
+  uint32_t startUs = now();
+  size_t count = 0;
+  while (now() - startUs < budgetUs && runNext()) {
+    count++;
+  }
+  return count;
+}
+
+size_t I2CScheduler::pending(void) {
+  std::lock_guard<std::mutex> lock(queueMutex);
+  size_t count = 0;
+  for (size_t i = 0; i < MAX_JOBS; ++i) {
+    if (slots[i].used) count++;
+  }
+  return count;
+}
+
+I2CSchedulerStats I2CScheduler::getStats(void) {
+  std::lock_guard<std::mutex> lock(queueMutex);
+  return stats;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief I2Cトランザクションの優先度（小さいほど先に実行）
+ */
+enum class I2CPriority : uint8_t {
+  Critical = 0,   // 時刻表示を駆動するRTC読み込みなど
+  High,           // EEPROMの書き込み・読み込み
+  Normal,         // 環境センサなど
+  Bulk            // OLEDの描画など、遅れてもよい大量転送
+};
+
+// I2Cスケジューラの統計
+struct I2CSchedulerStats {
+  static constexpr size_t PRIORITY_COUNT = 4;
+
+  uint32_t submitted;                     // 受け付けた件数
+  uint32_t completed;                     // 実行した件数
+  uint32_t rejected;                      // キューが満杯で受け付けなかった件数
+  uint32_t deadlineMissed;                // 期限を過ぎてから開始した件数
+  uint32_t abandoned;                     // 他のスレッドのexecute()が所有者の実行を待ちきれずに取り消した件数
+  uint32_t maxWaitUs[PRIORITY_COUNT];     // 優先度ごとの最大待ち時間（受付から開始まで）[us]
+};
+
+// I2Cトランザクションのスケジューラ
+// 受け付けた処理を優先度・期限の順に1件ずつ、バスのミューテックスを取得して実行する
+// - 期限を過ぎた処理は優先度に関係なく、期限の早い順に実行する
+// - それ以外は優先度の高い順、同じ優先度では期限の早い順、受付順
+// - submit()はキューへ積むだけで、バスの使用中でも待たない
+// - キューの処理は所有者（メインループ）のスレッドだけが実行する。他のスレッドのexecute()は期限まで実行を待つ
+class I2CScheduler {
+public:
+  using Job = std::function<bool(void)>;          // バスを使う処理（成否を返す）
+  using Done = std::function<void(bool success)>; // 完了通知
+  using TimeSource = std::function<uint32_t(void)>; // 現在時刻[us]の取得関数
+
+  static constexpr size_t MAX_JOBS = 16;          // キューに積める件数
+  static constexpr uint32_t NO_DEADLINE = 0;      // 期限なし
+  static constexpr uint32_t WAIT_TIMEOUT_US = 1000000;  // 期限なしの処理を他のスレッドから待つ上限[us]
+
+  explicit I2CScheduler(std::recursive_mutex& busMutex);
+
+  void setTimeSource(TimeSource source);
+  void setOwner(std::thread::id id) { owner = id; }   // キューの処理を実行するスレッド（未設定ならどのスレッドでも実行する）
+  bool submit(I2CPriority priority, Job job, uint32_t deadlineUs = NO_DEADLINE, Done done = nullptr);  // 処理を積む（deadlineUsは受付からの期限）
+  bool execute(I2CPriority priority, Job job, uint32_t deadlineUs = NO_DEADLINE);   // 処理を積み、完了まで待つ
+  bool runNext(void);                             // 次の処理を1件実行する
+  size_t runPending(uint32_t budgetUs);           // 予算時間内で処理を実行する
+  size_t pending(void);                           // キューに残っている件数
+  I2CSchedulerStats getStats(void);
+
+private:
+  struct Slot {
+    bool used;
+    I2CPriority priority;
+    bool hasDeadline;
+    uint32_t deadlineUs;    // 期限（絶対時刻）[us]
+    uint32_t submitUs;      // 受付時刻[us]
+    uint32_t seq;           // 受付順
+    Job job;
+    Done done;
+  };
+
+  std::recursive_mutex& busMutex;   // I2Cバスのミューテックス
+  std::mutex queueMutex;            // キューの排他制御
+  Slot slots[MAX_JOBS];
+  uint32_t nextSeq = 0;
+  TimeSource timeSource;
+  I2CSchedulerStats stats;
+  std::thread::id owner;            // キューの処理を実行するスレッド
+
+  uint32_t now(void);
+  bool enqueue(I2CPriority priority, Job job, uint32_t deadlineUs, Done done, uint32_t& seq);  // 処理を積む（受付順を返す）
+  bool cancel(uint32_t seq);                      // まだ開始していない処理を取り消す
+  bool runsBefore(const Slot& a, const Slot& b, uint32_t nowUs) const;
+};
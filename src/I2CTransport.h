@@ -0,0 +1,63 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <functional>
+#include "Config.h"
+
+/**
+ * @brief I2C転送の結果
+ */
+enum class I2CTransferStatus : uint8_t {
+  Ok,       // 正常終了
+  Nak,      // デバイスがNAKを返した（書き込みサイクル中のEEPROMなど）
+  Error     // バスエラー・タイムアウト・受付不可
+};
+
+/**
+ * @brief I2C転送1件（書き込み、読み込み、または書き込み後にリピーテッドスタートで読み込み）
+ * 送信データはsubmit()時にコピーするため、呼び出し元のバッファはすぐに再利用できる。
+ * 受信先は完了通知まで有効であること。
+ */
+struct I2CTransfer {
+  static constexpr size_t MAX_TX = 2 + EEPROM_PAGE_SIZE;  // EEPROMのアドレス2バイト + 1ページ
+
+  uint8_t address = 0;          // I2Cアドレス
+  uint8_t txLen = 0;            // 送信バイト数
+  uint8_t tx[MAX_TX];           // 送信データ
+  uint8_t *rx = nullptr;        // 受信先
+  uint8_t rxLen = 0;            // 受信バイト数
+
+  /**
+   * @brief 送信データを設定する
+   * @param head 先頭に付けるデータ（レジスタアドレスなど）
+   * @param headLen headのバイト数
+   * @param data 送信データ
+   * @param len dataのバイト数
+   * @return true 設定した、false MAX_TXを超える
+   */
+  bool setTx(const uint8_t *head, size_t headLen, const uint8_t *data, size_t len) {
+    if (headLen + len > MAX_TX) return false;
+    if (headLen > 0) memcpy(tx, head, headLen);
+    if (len > 0) memcpy(tx + headLen, data, len);
+    txLen = (uint8_t)(headLen + len);
+    return true;
+  }
+};
+
+/**
+ * @brief I2C転送の抽象インターフェース（開始と完了通知）
+ * - submit()は転送を受け付けるだけで、バスの使用中でも転送の完了を待たない
+ * - 完了通知はトランスポートの実行コンテキスト（ターゲットではワーカータスク）から呼ばれる。
+ *   短時間で戻ること（結果を保存する、promiseを完了するなど）
+ * - 転送はバスのミューテックスを取得して行うため、ミューテックスを保持したまま完了を待たないこと
+ */
+class I2CTransport {
+public:
+  using Complete = std::function<void(I2CTransferStatus status)>;
+
+  virtual ~I2CTransport() {}
+  virtual bool submit(const I2CTransfer& transfer, Complete complete) = 0;  // 受け付けたらtrue（満杯ならfalse）
+  virtual size_t inFlight(void) const = 0;                                  // 受け付けて未完了の件数
+};
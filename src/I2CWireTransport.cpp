@@ -0,0 +1,109 @@
+/**
+ * @file I2CWireTransport.cpp
+ * @brief ワーカータスクによるI2C非同期転送
+ * @details
+ * 呼び出し元はI2CBusManager::transfer()で転送を依頼し、完了をコールバックまたはfutureで受け取る。
+ * 転送はワーカータスクが受付順に1件ずつ、バスのミューテックスを取得して実行する。
+ * Arduinoのi2cドライバはバスを占有するため、ESP-IDFの非同期I2Cマスタードライバを同じポートで併用できない。
+ * そのためWireの同期転送を別タスクで実行し、呼び出し元を待たせない。
+ */
+#include <Arduino.h>
+#include "I2CWireTransport.h"
+
+I2CWireTransport::I2CWireTransport(I2CBusManager& bus)
+  : bus(bus), pending(0)
+{
+  for (uint8_t i = 0; i < MAX_IN_FLIGHT; i++) {
+    freeSlots.push(i);
+  }
+}
+
+/**
+ * @brief ワーカータスクを開始する
+ * @return true 成功、false キュー・タスクの作成に失敗
+ */
+bool I2CWireTransport::begin(void) {
+  if (requests != nullptr) {
+    return true;
+  }
+  requests = xQueueCreate(MAX_IN_FLIGHT, sizeof(uint8_t));
+  if (requests == nullptr) {
+    return false;
+  }
+  return xTaskCreatePinnedToCore(taskEntry, "i2c", TASK_STACK_SIZE, this, TASK_PRIORITY, nullptr, TASK_CORE) == pdPASS;
+}
+
+/**
+ * @brief 転送を受け付ける
+ * @param transfer 転送内容（送信データはコピーする）
+ * @param complete 完了通知（ワーカータスクから呼ばれる）
+ * @return true 受付、false 未開始・満杯
+ */
+bool I2CWireTransport::submit(const I2CTransfer& transfer, Complete complete) {
+  uint8_t index;
+  if (requests == nullptr || !freeSlots.pop(index)) {
+    return false;
+  }
+  slots[index].transfer = transfer;
+  slots[index].complete = complete;
+  pending.fetch_add(1, std::memory_order_relaxed);
+  xQueueSend(requests, &index, 0);    // 空きスロットの数だけ積めるため失敗しない
+  return true;
+}
+
+void I2CWireTransport::taskEntry(void *arg) {
+  static_cast<I2CWireTransport*>(arg)->run();
+}
+
+/**
+ * @brief ワーカータスク本体（受付順に転送し、完了を通知する）
+ */
+void I2CWireTransport::run(void) {
+  for (;;) {
+    uint8_t index;
+    if (xQueueReceive(requests, &index, portMAX_DELAY) != pdTRUE) {
+      continue;
+    }
+    Slot& slot = slots[index];
+    I2CTransferStatus status = execute(slot.transfer);
+    Complete complete = slot.complete;
+    slot.complete = nullptr;
+    freeSlots.push(index);              // 完了通知の中から次の転送を依頼できるよう先に解放する
+    pending.fetch_sub(1, std::memory_order_relaxed);
+    if (complete) {
+      complete(status);
+    }
+  }
+}
+
+/**
+ * @brief 転送1件を実行する
+ * @param transfer 転送内容
+ * @return 結果
+ */
+I2CTransferStatus I2CWireTransport::execute(I2CTransfer& transfer) {
+  I2CTransaction transaction(bus, transfer.address);    // バスの排他制御・計測・SCL周波数
+
+  if (transfer.txLen > 0 || transfer.rxLen == 0) {
+    Wire.beginTransmission(transfer.address);
+    Wire.write(transfer.tx, transfer.txLen);
+    transaction.addBytes(transfer.txLen);
+    uint8_t error = transaction.status(Wire.endTransmission(transfer.rxLen == 0));   // 読み込みが続く場合はリピーテッドスタート
+    if (error == 2 || error == 3) {
+      return I2CTransferStatus::Nak;
+    } else if (error != 0) {
+      return I2CTransferStatus::Error;
+    }
+  }
+  if (transfer.rxLen > 0) {
+    if (Wire.requestFrom(transfer.address, transfer.rxLen) != transfer.rxLen) {
+      transaction.setResult(I2CResult::Nak);
+      return I2CTransferStatus::Nak;
+    }
+    for (uint8_t i = 0; i < transfer.rxLen; i++) {
+      transfer.rx[i] = Wire.read();
+    }
+    transaction.addBytes(transfer.rxLen);
+  }
+  return I2CTransferStatus::Ok;
+}
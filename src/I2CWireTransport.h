@@ -0,0 +1,44 @@
+#pragma once
+
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#include "I2CBusManager.h"
+#include "LockFreeQueue.h"
+
+/**
+ * @brief ワーカータスクでWireを使って転送するI2CTransport
+ * - submit()は転送をキューに積んで戻る。呼び出し元（メインループ）は転送中も他の処理を進められる
+ * - ワーカータスクはI2CTransactionでバスを取得して転送する（計測・SCL周波数の切り替えも同じ）
+ * - ワーカーはloop()より高い優先度で動き、I2C割り込みを待つ間はCPUを手放す
+ */
+class I2CWireTransport : public I2CTransport {
+public:
+  static constexpr size_t MAX_IN_FLIGHT = 8;        // 同時に受け付ける転送数（2のべき乗）
+
+  explicit I2CWireTransport(I2CBusManager& bus);
+  bool begin(void);                                 // ワーカータスクを開始する
+  bool submit(const I2CTransfer& transfer, Complete complete) override;
+  size_t inFlight(void) const override { return pending.load(std::memory_order_relaxed); }
+
+private:
+  static constexpr uint32_t TASK_STACK_SIZE = 4096;
+  static constexpr UBaseType_t TASK_PRIORITY = 5;   // loop()（優先度1）より高く、WiFi（23）より低い
+  static constexpr BaseType_t TASK_CORE = 1;        // loop()と同じコア（WiFiはコア0）
+
+  struct Slot {
+    I2CTransfer transfer;
+    Complete complete;
+  };
+
+  I2CBusManager& bus;
+  Slot slots[MAX_IN_FLIGHT];
+  LockFreeQueue<uint8_t, MAX_IN_FLIGHT> freeSlots;  // 空きスロットの番号
+  QueueHandle_t requests = nullptr;                 // 受け付けたスロットの番号（受付順）
+  std::atomic<size_t> pending;
+
+  static void taskEntry(void *arg);
+  void run(void);
+  I2CTransferStatus execute(I2CTransfer& transfer);
+};
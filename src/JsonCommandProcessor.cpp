@@ -1,8 +1,8 @@
 #include <M5Unified.h>
 #include "JsonCommandProcessor.h"
 
-JsonCommandProcessor::JsonCommandProcessor(ParameterManager* pm, WiFiManager* wifiManager, SystemManager* systemManager)
-  : parameterManager(pm), wifiManager(wifiManager), systemManager(systemManager)
+JsonCommandProcessor::JsonCommandProcessor(ParameterManager* pm, WiFiManager* wifiManager, SystemManager* systemManager, I2CBusManager* i2cBus)
+  : parameterManager(pm), wifiManager(wifiManager), systemManager(systemManager), i2cBus(i2cBus)
 {
   return;
 }
@@ -136,6 +136,8 @@ void JsonCommandProcessor::processCommand(const String& jsonString) {
     handleSetCommand(doc);
   } else if (command == "ping") {
     handlePingCommand(doc);
+  } else if (command == "i2cstat") {
+    handleI2CStatCommand(doc);
   } else {
 //    handleUnknownCommand(command);
   }
@@ -193,6 +195,61 @@ void JsonCommandProcessor::handleSetCommand(JsonDocument& doc) {
 }
 
 
+/**
+ * @brief I2Cバスの統計を返す
+ * @param doc 受信したJSON（"reset":1で統計をクリアしてから返す）
+ * 応答例：{"command":"i2cstat","buckets":[64,128,...,0],
+ *          "devices":[{"addr":80,"count":12,"bytes":384,"nak":0,"busy":3,"err":0,"avgUs":95,"maxUs":410,"hist":[...]}],
+ *          "lock":{"count":12,"contended":1,"waitUs":250,"maxWaitUs":250}}
+ * bucketsは占有時間の分布の区分の上限[us]（0は上限なし）
+ */
+void JsonCommandProcessor::handleI2CStatCommand(JsonDocument& doc) {
+  if (i2cBus == nullptr) {
+    responseCallback("{\"error\":\"I2C bus not available\"}");
+    return;
+  }
+  if (doc["reset"].as<int>() == 1) {
+    i2cBus->resetStats();
+  }
+
+  I2CDeviceStats devices[I2CBusStats::MAX_DEVICES];
+  size_t count = i2cBus->getDeviceStats(devices, I2CBusStats::MAX_DEVICES);
+  I2CLockStats lockStats = i2cBus->getLockStats();
+
+  DynamicJsonDocument response(2048);
+  response["command"] = "i2cstat";
+  JsonArray buckets = response.createNestedArray("buckets");
+  for (size_t b = 0; b < I2CDeviceStats::LATENCY_BUCKETS; b++) {
+    buckets.add(I2CBusStats::bucketLimitUs(b));
+  }
+  JsonArray deviceArray = response.createNestedArray("devices");
+  for (size_t i = 0; i < count; i++) {
+    const I2CDeviceStats& dev = devices[i];
+    JsonObject entry = deviceArray.createNestedObject();
+    entry["addr"] = dev.address;
+    entry["count"] = dev.transactions;
+    entry["bytes"] = dev.bytes;
+    entry["nak"] = dev.naks;
+    entry["busy"] = dev.busy;
+    entry["err"] = dev.errors;
+    entry["avgUs"] = dev.transactions ? dev.totalUs / dev.transactions : 0;
+    entry["maxUs"] = dev.maxUs;
+    JsonArray hist = entry.createNestedArray("hist");
+    for (size_t b = 0; b < I2CDeviceStats::LATENCY_BUCKETS; b++) {
+      hist.add(dev.histogram[b]);
+    }
+  }
+  JsonObject lock = response.createNestedObject("lock");
+  lock["count"] = lockStats.acquisitions;
+  lock["contended"] = lockStats.contended;
+  lock["waitUs"] = lockStats.totalWaitUs;
+  lock["maxWaitUs"] = lockStats.maxWaitUs;
+
+  String out;
+  serializeJson(response, out);
+  responseCallback(out);
+}
+
 void JsonCommandProcessor::handleGetWifiStaListCommand(JsonDocument& doc) {
   // WiFi STAリストの取得処理を実装
   StaticJsonDocument<256> response;
@@ -5,6 +5,7 @@
 #include "ParameterManager.h"
 #include "WiFiManager.h"
 #include "SystemManager.h"
+#include "I2CBusManager.h"
 
 /**
  * @brief JSONコマンド処理クラス
@@ -17,7 +18,7 @@ public:
   // 応答データ送信関数（WebSocketやシリアル出力に利用される）
   using ResponseCallback = std::function<void(const String&)>;
 
-  JsonCommandProcessor(ParameterManager* pm, WiFiManager* wifiManager, SystemManager* systemManager);
+  JsonCommandProcessor(ParameterManager* pm, WiFiManager* wifiManager, SystemManager* systemManager, I2CBusManager* i2cBus = nullptr);
 
   // パラメータ管理と応答用コールバックをセット
   void begin(ResponseCallback callback);
@@ -30,12 +31,14 @@ private:
   ResponseCallback responseCallback;
   WiFiManager* wifiManager = nullptr;
   SystemManager* systemManager = nullptr;               // SystemManagerへのポインタ
+  I2CBusManager* i2cBus = nullptr;                      // I2CBusManagerへのポインタ（I2C統計の取得用）
 
   // 内部コマンド処理（個別に関数化）
   void handlePingCommand(JsonDocument& doc);            // "ping" コマンドの処理
   void handleGetCommand(JsonDocument& doc);             // "get" コマンドの処理
   void handleSetCommand(JsonDocument& doc);             // "set" コマンドの処理
   void handleGetWifiStaListCommand(JsonDocument& doc);  // "getWifiStaList" コマンドの処理
+  void handleI2CStatCommand(JsonDocument& doc);         // "i2cstat" コマンドの処理
   
   void handleUnknownCommand(const String& command);     // 未知のコマンドの処理
 };
@@ -0,0 +1,146 @@
+/**
+ * @file LocalTime.cpp
+ * @brief UNIX時間と暦の変換（libcのタイムゾーン処理を使わない）
+ * @details
+ * 暦は3月始まりの年で数えると、閏日が年の最後になり、月の日数が (153 × 月 + 2) / 5 で求まる。
+ * これを400年（146097日）の周期に分けて、ループなしで年月日と日数を相互に変換する。
+ * 夏時間は、ローカル時刻の年の「始まり」と「終わり」をUNIX時間に直して比べる（南半球は始まりが終わりより後）。
+ */
+#include "LocalTime.h"
+
+/**
+ * @brief 日数から年月日
+ * @param days 1970-01-01 からの日数
+ * @param y 年の格納先
+ * @param m 月（1～12）の格納先
+ * @param d 日（1～31）の格納先
+ */
+void LocalTime::civilFromDays(int64_t days, int32_t& y, uint32_t& m, uint32_t& d) {
+  days += 719468;                                         // 0000-03-01 からの日数
+  const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+  const uint32_t doe = static_cast<uint32_t>(days - era * 146097);              // 400年周期の中の日数 [0, 146096]
+  const uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;   // 周期の中の年 [0, 399]
+  const uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);                 // 3月1日からの日数 [0, 365]
+  const uint32_t mp = (5 * doy + 2) / 153;                                      // 3月からの月 [0, 11]
+  d = doy - (153 * mp + 2) / 5 + 1;
+  m = mp < 10 ? mp + 3 : mp - 9;
+  y = static_cast<int32_t>(static_cast<int64_t>(yoe) + era * 400 + (m <= 2 ? 1 : 0));
+}
+
+/**
+ * @brief UNIX時間をUTCの時刻に変換
+ * @param t UNIX時間
+ * @param out 時刻の格納先（tm_isdst は 0）
+ */
+void LocalTime::toUtc(int64_t t, struct tm& out) {
+  int64_t days = t / DAY_S;
+  int32_t sod = static_cast<int32_t>(t - days * DAY_S);
+  if (sod < 0) {                  // 1970年より前
+    sod += DAY_S;
+    days--;
+  }
+  int32_t y;
+  uint32_t m, d;
+  civilFromDays(days, y, m, d);
+  out.tm_year = y - 1900;
+  out.tm_mon = static_cast<int>(m) - 1;
+  out.tm_mday = static_cast<int>(d);
+  out.tm_hour = sod / 3600;
+  out.tm_min = sod / 60 % 60;
+  out.tm_sec = sod % 60;
+  out.tm_wday = weekdayFromDays(days);
+  out.tm_yday = static_cast<int>(days - daysFromCivil(y, 1, 1));
+  out.tm_isdst = 0;
+}
+
+/**
+ * @brief UTCの時刻をUNIX時間に変換
+ * @param t 時刻（tm_wday, tm_yday, tm_isdst は使わない）
+ * @return UNIX時間
+ * @note 範囲外の月・日・時・分・秒は繰り上げ・繰り下げる（timegm()と同じ）。
+ */
+int64_t LocalTime::fromUtc(const struct tm& t) {
+  int64_t y = static_cast<int64_t>(t.tm_year) + 1900 + t.tm_mon / 12;
+  int32_t mon = t.tm_mon % 12;
+  if (mon < 0) {
+    mon += 12;
+    y--;
+  }
+  int64_t days = daysFromCivil(y, static_cast<uint32_t>(mon) + 1, 1) + t.tm_mday - 1;
+  return days * DAY_S + static_cast<int64_t>(t.tm_hour) * 3600 + static_cast<int64_t>(t.tm_min) * 60 + t.tm_sec;
+}
+
+/**
+ * @brief その年の夏時間の切り替えの時刻
+ * @param rule 切り替え日時
+ * @param year 年
+ * @param offsetS 切り替わる前のUTCからの差[s]
+ * @return 切り替えの時刻（UNIX時間）
+ */
+int64_t LocalTime::transitionAt(const DstRule& rule, int32_t year, int32_t offsetS) {
+  const int64_t first = daysFromCivil(year, rule.month, 1);
+  const int64_t next = (rule.month == 12) ? daysFromCivil(year + 1, 1, 1) : daysFromCivil(year, rule.month + 1u, 1);
+  int64_t day = first + (rule.weekday + 7 - weekdayFromDays(first)) % 7 + (rule.week - 1) * 7;
+  if (day >= next) {
+    day -= 7;                     // 第5週がない月は最終週
+  }
+  return day * DAY_S + rule.timeS - offsetS;
+}
+
+/**
+ * @brief その時刻のUTCからの差
+ * @param zone タイムゾーンの規則
+ * @param t UNIX時間
+ * @param isDst 夏時間かどうかの格納先（nullptrなら格納しない）
+ * @return UTCからの差[s]
+ */
+int32_t LocalTime::utcOffset(const TimeZoneRule& zone, int64_t t, bool* isDst) {
+  bool dst = false;
+  if (zone.hasDst()) {
+    int64_t local = t + zone.stdOffsetS;
+    int64_t days = local / DAY_S - ((local % DAY_S) < 0 ? 1 : 0);
+    int32_t y;
+    uint32_t m, d;
+    civilFromDays(days, y, m, d);
+    const int64_t start = transitionAt(zone.dstStart, y, zone.stdOffsetS);
+    const int64_t end = transitionAt(zone.dstEnd, y, zone.dstOffsetS);
+    dst = (start < end) ? ((t >= start) && (t < end))     // 北半球
+                        : ((t >= start) || (t < end));    // 南半球（年をまたぐ）
+  }
+  if (isDst) {
+    *isDst = dst;
+  }
+  return dst ? zone.dstOffsetS : zone.stdOffsetS;
+}
+
+/**
+ * @brief UNIX時間をローカル時刻に変換
+ * @param zone タイムゾーンの規則
+ * @param t UNIX時間
+ * @param out ローカル時刻の格納先
+ */
+void LocalTime::toLocal(const TimeZoneRule& zone, int64_t t, struct tm& out) {
+  bool dst = false;
+  const int32_t offset = utcOffset(zone, t, &dst);
+  toUtc(t + offset, out);
+  out.tm_isdst = dst ? 1 : 0;
+}
+
+/**
+ * @brief ローカル時刻をUNIX時間に変換
+ * @param zone タイムゾーンの規則
+ * @param t ローカル時刻（tm_wday, tm_yday, tm_isdst は使わない）
+ * @return UNIX時間
+ * @note 夏時間の終わりで2回ある時刻は夏時間とみなす。
+ *       夏時間の始まりで飛ばされる時刻は標準時とみなす（切り替え後の時刻になる）。
+ */
+int64_t LocalTime::fromLocal(const TimeZoneRule& zone, const struct tm& t) {
+  const int64_t local = fromUtc(t);
+  if (zone.hasDst()) {
+    const int64_t asDst = local - zone.dstOffsetS;
+    if (utcOffset(zone, asDst) == zone.dstOffsetS) {
+      return asDst;
+    }
+  }
+  return local - zone.stdOffsetS;
+}
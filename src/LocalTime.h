@@ -0,0 +1,78 @@
+#pragma once
+
+#include <stdint.h>
+#include <time.h>
+
+/**
+ * @brief 夏時間の切り替え日時（POSIXのTZの "Mm.w.d/time" と同じ）
+ * @note 集成体のまま constexpr の表に置けるように、初期値や構築子は持たない。
+ */
+struct DstRule {
+  uint8_t month;      // 月（1～12）
+  uint8_t week;       // 第何週（1～5。5は最終週）
+  uint8_t weekday;    // 曜日（0=日曜）
+  int32_t timeS;      // その日の0時からの秒（切り替わる前の時刻で数える）
+};
+
+/**
+ * @brief タイムゾーンの規則（UTCからの差と夏時間）
+ * @details 差は東を正とする（日本は +32400）。POSIXのTZの "GMT+9" とは符号が逆になる。
+ *          夏時間がなければ dstOffsetS に stdOffsetS と同じ値を入れる（dstStart, dstEnd は使わない）。
+ */
+struct TimeZoneRule {
+  int32_t stdOffsetS;   // 標準時のUTCからの差[s]
+  int32_t dstOffsetS;   // 夏時間のUTCからの差[s]
+  DstRule dstStart;     // 夏時間の始まり（標準時で数える）
+  DstRule dstEnd;       // 夏時間の終わり（夏時間で数える）
+
+  constexpr bool hasDst(void) const { return dstOffsetS != stdOffsetS; }
+};
+
+/**
+ * @brief UNIX時間と暦の変換（libcのタイムゾーン処理を使わない）
+ * - localtime() / mktime() と違い、環境変数TZ・静的な領域・ロックを使わない純粋な関数なので、どのタスクから呼んでもよい
+ * - 暦の計算は H. Hinnant の days_from_civil / civil_from_days（400年周期）による。ループも表も使わない
+ * - 夏時間はその年の切り替え日時を求めて比べるだけで、タイムゾーンのデータベースは読まない
+ */
+class LocalTime {
+public:
+  static constexpr int32_t DAY_S = 86400;     // 1日[s]
+
+  /**
+   * @brief 1970-01-01 からの日数
+   * @param y 年
+   * @param m 月（1～12）
+   * @param d 日（1～31。範囲外でもそのまま日数に足す）
+   */
+  static constexpr int64_t daysFromCivil(int64_t y, uint32_t m, uint32_t d) {
+    return daysFromMarchYear(y - (m <= 2 ? 1 : 0), m, d);
+  }
+  /**
+   * @brief 曜日
+   * @param days 1970-01-01 からの日数
+   * @return 0=日曜～6=土曜
+   */
+  static constexpr uint8_t weekdayFromDays(int64_t days) {
+    return static_cast<uint8_t>(days >= -4 ? (days + 4) % 7 : (days + 5) % 7 + 6);
+  }
+
+  static void civilFromDays(int64_t days, int32_t& y, uint32_t& m, uint32_t& d);  // 日数から年月日
+  static void toUtc(int64_t t, struct tm& out);             // UNIX時間をUTCの時刻に変換（gmtime_r()の代わり）
+  static int64_t fromUtc(const struct tm& t);               // UTCの時刻をUNIX時間に変換（timegm()の代わり）
+  static int32_t utcOffset(const TimeZoneRule& zone, int64_t t, bool* isDst = nullptr);  // その時刻のUTCからの差[s]
+  static void toLocal(const TimeZoneRule& zone, int64_t t, struct tm& out);   // UNIX時間をローカル時刻に変換（localtime_r()の代わり）
+  static int64_t fromLocal(const TimeZoneRule& zone, const struct tm& t);     // ローカル時刻をUNIX時間に変換（mktime()の代わり）
+  static int64_t transitionAt(const DstRule& rule, int32_t year, int32_t offsetS);  // その年の切り替えの時刻（UNIX時間）
+
+private:
+  // 3月始まりの年での日数（1・2月は前の年の続きとして数える）
+  static constexpr int64_t eraOf(int64_t y) {
+    return (y >= 0 ? y : y - 399) / 400;
+  }
+  static constexpr int64_t daysFromMarchYear(int64_t y, uint32_t m, uint32_t d) {
+    return eraOf(y) * 146097 + dayOfEra(static_cast<uint32_t>(y - eraOf(y) * 400), m, d) - 719468;
+  }
+  static constexpr int64_t dayOfEra(uint32_t yoe, uint32_t m, uint32_t d) {
+    return static_cast<int64_t>(yoe) * 365 + yoe / 4 - yoe / 100 + (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+  }
+};
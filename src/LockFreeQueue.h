@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#ifdef UNIT_TEST
+#define LFQ_ISR_INLINE inline
+#else
+#define LFQ_ISR_INLINE inline __attribute__((always_inline))  // 呼び出し元（IRAMの関数）に展開し、フラッシュに置かない
+#endif
+
+/**
+ * @brief 固定長のロックフリーキュー（複数生産者・複数消費者）
+ * @tparam T 要素の型（コピー可能であること）
+ * @tparam SIZE 要素数（2のべき乗）
+ * - 各セルのシーケンス番号で書き込み済み・読み出し済みを判定する（Vyukov方式）
+ * - ミューテックスと動的メモリ確保を使わないため、割り込みハンドラや別タスクからも呼び出せる
+ * - 満杯・空のときは待たずにfalseを返す
+ */
+template <typename T, size_t SIZE>
+class LockFreeQueue {
+  static_assert(SIZE >= 2 && (SIZE & (SIZE - 1)) == 0, "SIZE must be a power of two");
+
+public:
+  LockFreeQueue() {
+    for (size_t i = 0; i < SIZE; ++i) {
+      cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    enqueuePos.store(0, std::memory_order_relaxed);
+    dequeuePos.store(0, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief 要素を追加する
+   * @param item 追加する要素
+   * @return true 成功、false 満杯
+   */
+  LFQ_ISR_INLINE bool push(const T& item) {
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+      Cell& cell = cells[pos & (SIZE - 1)];
+      size_t seq = cell.sequence.load(std::memory_order_acquire);
+      intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+      if (diff == 0) {
+        if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          cell.data = item;
+          cell.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;   // 満杯
+      } else {
+        pos = enqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * @brief 先頭の要素を取り出す
+   * @param item 取り出した要素の格納先
+   * @return true 成功、false 空
+   */
+  bool pop(T& item) {
+    size_t pos = dequeuePos.load(std::memory_order_relaxed);
+    for (;;) {
+      Cell& cell = cells[pos & (SIZE - 1)];
+      size_t seq = cell.sequence.load(std::memory_order_acquire);
+      intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+      if (diff == 0) {
+        if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          item = cell.data;
+          cell.sequence.store(pos + SIZE, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;   // 空
+      } else {
+        pos = dequeuePos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * @brief 格納されている要素数（目安）
+   * @return 要素数
+   * 他のスレッドが操作中の場合は概算値となる。
+   */
+  LFQ_ISR_INLINE size_t size() const {
+    size_t head = dequeuePos.load(std::memory_order_relaxed);
+    size_t tail = enqueuePos.load(std::memory_order_relaxed);
+    return (tail >= head) ? (tail - head) : 0;
+  }
+
+  static constexpr size_t capacity() { return SIZE; }
+
+private:
+  struct Cell {
+    std::atomic<size_t> sequence;   // セルの状態（書き込み可能・読み出し可能）
+    T data;                         // 要素
+  };
+  Cell cells[SIZE];                 // リングバッファ
+  std::atomic<size_t> enqueuePos;   // 次に書き込む位置
+  std::atomic<size_t> dequeuePos;   // 次に読み出す位置
+};
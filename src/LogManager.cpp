@@ -1,23 +1,348 @@
+#include <algorithm>
 #include "LogManager.h"
+#include "Crc16.h"
 
+#ifdef UNIT_TEST
+#include <chrono>
+#else
+#include <esp_timer.h>
+#endif
+
+/**
+ * @brief ログ管理の初期化
+ * @param eeprom EepromManagerの参照
+ * ログ領域から最新のレコードを探し、続きから書き込めるよう書き込み位置を復元する。
+ */
 void LogManager::begin(EepromManager& eeprom) {
   this->eeprom = &eeprom;  // EepromManagerの参照を保持
   storage.begin(eeprom);   // ログストレージの初期化
-  currentAddr = LOG_START_ADDR;  // ログ書き込みの初期アドレス設定
+
+  std::lock_guard<std::recursive_mutex> lock(eeprom.getMutex());  // 排他制御
+  recoverHead();
+}
+
+/**
+ * @brief 記録時刻の取得関数を設定する
+ * @param source 現在時刻（UNIX時間）を返す関数
+ */
+void LogManager::setTimeSource(TimeSource source) {
+  timeSource = source;
+}
+
+/**
+ * @brief 単調増加の時刻の取得関数を設定する
+ * @param source 起動からの時間[ms]を返す関数（割り込みから呼べること、nullptrなら既定に戻す）
+ */
+void LogManager::setMonotonicSource(MonotonicSource source) {
+  monotonicSource = source ? source : defaultMonotonicMs;
+}
+
+/**
+ * @brief 起動からの時間[ms]
+ * @return 時間[ms]
+ * esp_timer_get_time()はIRAMにあり、割り込みハンドラからも呼べる。
+ */
+uint32_t LOG_ISR_ATTR LogManager::defaultMonotonicMs(void) {
+#ifdef UNIT_TEST
+  return (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+#else
+  return (uint32_t)(esp_timer_get_time() / 1000);
+#endif
 }
 
+/**
+ * @brief ログを書き込みキューへ積む
+ * @param message メッセージ（LogRecord::MESSAGE_LENGTHを超える分は切り捨て）
+ * 実処理はwriteLogFromISR()で、割り込みハンドラ・別タスクのどちらからでも呼び出せる。
+ */
 void LogManager::writeLog(const char* message) {
+  writeLogFromISR(message);
+}
+
+/**
+ * @brief ログを書き込みキューへ積む（割り込みハンドラから呼べる）
+ * @param message メッセージ（LogRecord::MESSAGE_LENGTHを超える分は切り捨て）
+ * @return true 積んだ、false キューが満杯で破棄した
+ * 積んだ時点の単調増加の時刻を記録し、update()で記録時刻（UNIX時間）に変換するため、
+ * 書き込みが遅れても事象の発生時刻が残る。
+ * ミューテックス・EEPROMアクセス・フラッシュ上の関数（仮想関数、文字列関数）を使わないため、
+ * EEPROMのミューテックスを保持したままでも、割り込みハンドラや別タスクからでも呼び出せる。
+ * キューが満杯の場合は破棄して件数を数える。
+ */
+bool LOG_ISR_ATTR LogManager::writeLogFromISR(const char* message) {
+  PendingLog entry;
+  entry.stampMs = monotonicSource();
+  size_t len = 0;
+  while (len < LogRecord::MESSAGE_LENGTH && message[len] != '\0') {
+    entry.message[len] = message[len];
+    len++;
+  }
+  entry.message[len] = '\0';
+
+  if (!queue.push(entry)) {
+    droppedCount.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  size_t depth = queue.size();
+  size_t peak = highWater.load(std::memory_order_relaxed);
+  while (depth > peak && !highWater.compare_exchange_weak(peak, depth, std::memory_order_relaxed)) {
+  }
+  return true;
+}
+
+/**
+ * @brief キューのログをEEPROMへ書き込む
+ * @param maxBatch 今回書き込む最大件数
+ * @return 書き込んだ件数
+ * メインループから呼び出す。ミューテックスは1回だけ取得し、まとめて書き込む。
+ * 記録時刻は、現在時刻から積んでからの経過時間を引いて求める（時刻未設定なら0）。
+ */
+size_t LogManager::update(size_t maxBatch) {
+  if (eeprom == nullptr) return 0;
   std::lock_guard<std::recursive_mutex> lock(eeprom->getMutex());  // 排他制御
-  size_t len = strnlen(message, MAX_LOG_LENGTH - 1);  // メッセージ長取得
-  if (currentAddr + len + 1 > LOG_END_ADDR) {  // ログの終了アドレスを超える場合、開始アドレスに戻る
-    currentAddr = LOG_START_ADDR;
+
+  size_t count = 0;
+  PendingLog entry;
+  uint32_t nowMs = monotonicSource();
+  uint32_t nowTime = timeSource ? timeSource() : 0;   // 時刻未設定なら0を記録する
+  while (count < maxBatch && queue.pop(entry)) {
+    uint32_t elapsed = (nowMs - entry.stampMs) / 1000;   // 積んでからの経過秒
+    writeRecord(entry, (nowTime > elapsed) ? nowTime - elapsed : 0);
+    count++;
+  }
+  return count;
+}
+
+/**
+ * @brief ログ書き込みキューの統計を取得する
+ * @return LogQueueStats 統計
+ */
+LogQueueStats LogManager::getQueueStats(void) const {
+  LogQueueStats stats;
+  stats.depth = queue.size();
+  stats.highWater = highWater.load(std::memory_order_relaxed);
+  stats.dropped = droppedCount.load(std::memory_order_relaxed);
+  stats.written = writtenCount;
+  return stats;
+}
+
+/**
+ * @brief ログを1件EEPROMへ書き込む
+ * @param entry 書き込み待ちのログ
+ * @param timestamp 記録時刻（UNIX時間）
+ * レコード（シーケンス番号、時刻、メッセージ、CRC）はページ境界に揃えた2ページで、ページ書き込み2回となる。
+ * 書き込み途中で電源が切れたレコードはCRCが一致しないため、読み出し・復元の際に無視される。
+ */
+void LogManager::writeRecord(const PendingLog& entry, uint32_t timestamp) {
+  uint8_t record[RECORD_SIZE];
+  uint32_t seq = nextSeq;
+  memset(record, 0, sizeof(record));
+  for (int i = 0; i < 4; ++i) {
+    record[i] = (seq >> (8 * i)) & 0xFF;
+    record[4 + i] = (timestamp >> (8 * i)) & 0xFF;
   }
-  storage.write(currentAddr, message, len + 1);  // ログの書き込み
-  currentAddr += len + 1;  // 書き込みアドレス更新
+  size_t len = strnlen(entry.message, LogRecord::MESSAGE_LENGTH);  // メッセージ長取得
+  memcpy(&record[8], entry.message, len);
+  uint16_t crc = crc16Ccitt(record, RECORD_SIZE - 2);
+  record[RECORD_SIZE - 2] = crc & 0xFF;
+  record[RECORD_SIZE - 1] = crc >> 8;
 
+  if (!storage.write(currentAddr, record, RECORD_SIZE)) {  // ログの書き込み
+    return;
+  }
+  nextSeq++;
+  writtenCount++;
+  if (logCount < SLOT_COUNT) {
+    logCount++;
+  }
+  currentAddr += RECORD_SIZE;  // 書き込みアドレス更新
+  if (currentAddr + (int)RECORD_SIZE > LOG_END_ADDR) {  // ログの終了アドレスを超える場合、開始アドレスに戻る
+    currentAddr = LOG_START_ADDR;
+  }
 }
 
+/**
+ * @brief 最も古いログのメッセージを読み取る
+ * @param buffer メッセージを格納するバッファ
+ * @param bufferSize バッファのサイズ
+ * @return true 成功、false ログなし
+ */
 bool LogManager::readFirstLog(char* buffer, size_t bufferSize) {
+  if (eeprom == nullptr || bufferSize == 0) return false;
+  std::lock_guard<std::recursive_mutex> lock(eeprom->getMutex());  // 排他制御
+
+  LogRecord record;
+  if (!readOrdered(0, &record)) {
+    return false;
+  }
+  strncpy(buffer, record.message, bufferSize - 1);
+  buffer[bufferSize - 1] = '\0';
+  return true;
+}
+
+/**
+ * @brief 新しい順にログを読み出す
+ * @param records 読み出したログの格納先
+ * @param count 読み出す最大件数
+ * @param beforeSeq このシーケンス番号より古いログから読み出す（前ページの最後のseqを渡すと続きを読める）
+ * @return 読み出した件数
+ */
+size_t LogManager::readLatest(LogRecord* records, size_t count, uint32_t beforeSeq) {
+  if (eeprom == nullptr) return 0;
   std::lock_guard<std::recursive_mutex> lock(eeprom->getMutex());  // 排他制御
-  return storage.read(LOG_START_ADDR, buffer, bufferSize);  // 最初のログの読み込み
+
+  // 古い順の位置はシーケンス番号から直接求まる
+  uint32_t firstSeq = nextSeq - logCount;
+  uint32_t endSeq = std::min<uint32_t>(beforeSeq, nextSeq);
+  if (endSeq <= firstSeq) {
+    return 0;
+  }
+
+  size_t found = 0;
+  for (size_t position = endSeq - firstSeq; position > 0 && found < count; --position) {
+    if (readOrdered(position - 1, &records[found])) {
+      found++;
+    }
+  }
+  return found;
+}
+
+/**
+ * @brief 期間内のログを古い順に読み出す
+ * @param fromTime 期間の開始（UNIX時間、この時刻を含む）
+ * @param toTime 期間の終了（UNIX時間、この時刻を含む）
+ * @param records 読み出したログの格納先
+ * @param count 読み出す最大件数
+ * @param afterSeq このシーケンス番号より新しいログから読み出す（前ページの最後のseqを渡すと続きを読める）
+ * @return 読み出した件数
+ * 時刻は記録順に増加するとは限らない（時刻の設定で戻る、時刻が決まる前は0で記録する）ため、
+ * 時刻で探索せず、シーケンス番号の順に読んで期間内のものを集める。
+ */
+size_t LogManager::readRange(uint32_t fromTime, uint32_t toTime, LogRecord* records, size_t count, uint32_t afterSeq) {
+  if (eeprom == nullptr) return 0;
+  std::lock_guard<std::recursive_mutex> lock(eeprom->getMutex());  // 排他制御
+
+  // afterSeq以前は読み飛ばす
+  size_t position = 0;
+  uint32_t firstSeq = nextSeq - logCount;
+  if (afterSeq >= firstSeq) {
+    position = afterSeq - firstSeq + 1;
+  }
+
+  size_t found = 0;
+  for (; position < logCount && found < count; ++position) {
+    if (!readOrdered(position, &records[found])) {
+      continue;
+    }
+    if (records[found].timestamp >= fromTime && records[found].timestamp <= toTime) {
+      found++;
+    }
+  }
+  return found;
+}
+
+/**
+ * @brief 書き込み位置を復元する
+ * 各スロットのシーケンス番号は、先頭から最新のレコードまで増加し、その先は古いレコード（または未使用）となる。
+ * 最初の有効なレコードを基準に「基準以上のシーケンス番号を持つ」範囲の末尾を二分探索で求め、最新のレコードとする。
+ * 破損したスロット（書き込み途中の電源断など）は、次の有効なスロットまで読み飛ばして判定する。
+ */
+void LogManager::recoverHead(void) {
+  size_t lo;
+  LogRecord first;
+  if (!findValidSlot(0, SLOT_COUNT - 1, &lo, &first)) {
+    currentAddr = LOG_START_ADDR;   // ログなし
+    nextSeq = 1;
+    logCount = 0;
+    return;
+  }
+
+  LogRecord newest = first;
+  size_t hi = SLOT_COUNT - 1;
+  while (lo < hi) {
+    size_t mid = (lo + hi + 1) / 2;
+    size_t slot;
+    LogRecord record;
+    if (findValidSlot(mid, hi, &slot, &record) && record.seq >= first.seq) {
+      lo = slot;
+      newest = record;
+    } else {
+      hi = mid - 1;
+    }
+  }
+
+  nextSeq = newest.seq + 1;
+  logCount = std::min<uint32_t>(newest.seq, SLOT_COUNT);
+  currentAddr = LOG_START_ADDR + ((lo + 1) % SLOT_COUNT) * RECORD_SIZE;
+}
+
+/**
+ * @brief 範囲内で最初の有効なレコードを探す
+ * @param from 探索を始めるスロット
+ * @param to 探索を終えるスロット（このスロットを含む）
+ * @param slot 見つかったスロットの格納先
+ * @param record 見つかったレコードの格納先
+ * @return true 見つかった、false 範囲内に有効なレコードなし
+ */
+bool LogManager::findValidSlot(size_t from, size_t to, size_t* slot, LogRecord* record) {
+  for (size_t i = from; i <= to; ++i) {
+    if (readSlot(i, record)) {
+      *slot = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief 最も古いレコードのスロット
+ * @return スロット番号
+ */
+size_t LogManager::oldestSlot(void) const {
+  size_t head = (currentAddr - LOG_START_ADDR) / RECORD_SIZE;
+  return (logCount < SLOT_COUNT) ? 0 : head;
+}
+
+/**
+ * @brief 古い順の位置でレコードを読み込む
+ * @param position 最も古いログを0とする位置
+ * @param record 読み込んだログの格納先
+ * @return true 成功、false 範囲外・破損
+ */
+bool LogManager::readOrdered(size_t position, LogRecord* record) {
+  if (position >= logCount) {
+    return false;
+  }
+  return readSlot((oldestSlot() + position) % SLOT_COUNT, record);
+}
+
+/**
+ * @brief スロットのレコードを読み込む
+ * @param slot スロット番号
+ * @param record 読み込んだログの格納先
+ * @return true 有効なレコード、false 未使用・破損
+ */
+bool LogManager::readSlot(size_t slot, LogRecord* record) {
+  uint8_t data[RECORD_SIZE];
+  if (!storage.read(LOG_START_ADDR + slot * RECORD_SIZE, data, RECORD_SIZE)) {
+    return false;
+  }
+  uint16_t crc = data[RECORD_SIZE - 2] | (data[RECORD_SIZE - 1] << 8);
+  if (crc != crc16Ccitt(data, RECORD_SIZE - 2)) {
+    return false;
+  }
+
+  record->seq = 0;
+  record->timestamp = 0;
+  for (int i = 0; i < 4; ++i) {
+    record->seq |= (uint32_t)data[i] << (8 * i);
+    record->timestamp |= (uint32_t)data[4 + i] << (8 * i);
+  }
+  if (record->seq == 0) {
+    return false;
+  }
+  memcpy(record->message, &data[8], LogRecord::MESSAGE_LENGTH);
+  record->message[LogRecord::MESSAGE_LENGTH] = '\0';
+  return true;
 }
@@ -1,28 +1,104 @@
 #pragma once
 
 #include <string.h>
+#include <stdint.h>
+#include <functional>
+#include <atomic>
+#include "LockFreeQueue.h"
 #include "LogStorage.h"
 #include "EepromManager.h"
 
+#ifdef UNIT_TEST
+#define LOG_ISR_ATTR
+#else
+#include <esp_attr.h>
+#define LOG_ISR_ATTR IRAM_ATTR    // フラッシュ書き込み中も割り込みから呼べるようにIRAMに置く
+#endif
+
+// 動作ログの1件分
+struct LogRecord {
+  static constexpr size_t MESSAGE_LENGTH = 54;  // 保存できるメッセージ長（超過分は切り捨て）
+
+  uint32_t seq;                         // シーケンス番号（1から連番）
+  uint32_t timestamp;                   // 記録時刻（UNIX時間）
+  char message[MESSAGE_LENGTH + 1];     // メッセージ（終端文字付き）
+};
+
+// ログ書き込みキューの統計
+struct LogQueueStats {
+  size_t depth;         // キューに残っている件数
+  size_t highWater;     // キューの最大使用件数
+  uint32_t dropped;     // キューが満杯で破棄した件数
+  uint32_t written;     // EEPROMへ書き込んだ件数
+};
+
 // 動作ログの管理クラス
+// EEPROMのログ領域に固定長レコードを循環して記録する
+// writeLog()はキューへ積むだけで、EEPROMへの書き込みはupdate()でまとめて行う
 class LogManager {
 public:
   virtual ~LogManager() = default;
 
+  using TimeSource = std::function<uint32_t(void)>;  // 記録時刻の取得関数（UNIX時間）
+  using MonotonicSource = uint32_t (*)(void);        // 単調増加の時刻[ms]の取得関数（割り込みから呼べること）
+
   // 初期化
   void begin(EepromManager& eeprom);
+  void setTimeSource(TimeSource source);
+  void setMonotonicSource(MonotonicSource source);   // 既定はesp_timer_get_time()
 
-  // ログの書き込み
+  // ログの書き込み（単調増加の時刻を付けてキューへ積むだけで待たない。別タスクから呼び出し可）
   virtual void writeLog(const char* message);
+  bool writeLogFromISR(const char* message);          // 割り込みハンドラから呼ぶ（仮想関数を経由しない）
+
+  // キューのログをEEPROMへ書き込む（メインループから呼ぶ）
+  size_t update(size_t maxBatch = LOG_DRAIN_BATCH);
+  LogQueueStats getQueueStats(void) const;
 
   // 最初のログを読み取る
   bool readFirstLog(char* buffer, size_t bufferSize);
 
+  // ログの読み出し（ページング用）
+  size_t readLatest(LogRecord* records, size_t count, uint32_t beforeSeq = UINT32_MAX);   // 新しい順にcount件
+  size_t readRange(uint32_t fromTime, uint32_t toTime, LogRecord* records, size_t count, uint32_t afterSeq = 0); // 期間内を古い順にcount件
+  size_t getLogCount(void) const { return logCount; }         // 記録されているログ数
+
+  static constexpr size_t LOG_QUEUE_SIZE = 16;    // 書き込みキューの段数（ログ領域のレコード数より少なくする）
+  static constexpr size_t LOG_DRAIN_BATCH = 8;    // update()1回で書き込む最大件数
+
+  static constexpr int LOG_START_ADDR = 0x0840;   // ログの開始アドレス（I2C_CLOCK_TABLE_ADDRの次から）
+  static constexpr int LOG_END_ADDR = 0x0FC0;     // ログの終了アドレス（シャドウの範囲内）
+  static constexpr size_t RECORD_SIZE = 64;       // 1レコードのバイト数（seq 4 + 時刻 4 + メッセージ 54 + CRC 2、2ページ）
+  static constexpr size_t SLOT_COUNT = (LOG_END_ADDR - LOG_START_ADDR) / RECORD_SIZE;  // レコード数（30件）
+
 private:
+  // 書き込み待ちのログ
+  struct PendingLog {
+    uint32_t stampMs;                             // 積んだ時点の単調増加の時刻[ms]（update()で記録時刻に変換）
+    char message[LogRecord::MESSAGE_LENGTH + 1];
+  };
+
+  LockFreeQueue<PendingLog, LOG_QUEUE_SIZE> queue;  // 書き込みキュー
+  std::atomic<uint32_t> droppedCount{0};            // 破棄した件数
+  std::atomic<size_t> highWater{0};                 // キューの最大使用件数
+  uint32_t writtenCount = 0;                        // 書き込んだ件数
+
   EepromManager* eeprom = nullptr;  // EepromManagerの参照
   LogStorage storage;                // ログストレージ
+  TimeSource timeSource;             // 記録時刻の取得関数
+  MonotonicSource monotonicSource = defaultMonotonicMs;  // 単調増加の時刻の取得関数
+  static uint32_t defaultMonotonicMs(void);               // 起動からの時間[ms]（割り込みから呼べる）
   int currentAddr = 0;               // 現在の書き込みアドレス
-  static constexpr int LOG_START_ADDR = 256;  // ログの開始アドレス
-  static constexpr int LOG_END_ADDR = 512;    // ログの終了アドレス
-  static constexpr size_t MAX_LOG_LENGTH = 64; // 最大ログ長
+  uint32_t nextSeq = 1;              // 次に書き込むシーケンス番号
+  size_t logCount = 0;               // 記録されているログ数
+
+  void writeRecord(const PendingLog& entry, uint32_t timestamp);  // レコードを1件書き込む
+  void recoverHead(void);                                 // 書き込み位置を復元
+  bool readSlot(size_t slot, LogRecord* record);           // レコードを読み込む
+  bool findValidSlot(size_t from, size_t to, size_t* slot, LogRecord* record);  // from〜toで最初の有効なレコード
+  bool readOrdered(size_t position, LogRecord* record);    // 古い順の位置でレコードを読み込む
+  size_t oldestSlot(void) const;                           // 最も古いレコードのスロット
 };
+
+// キューを一度に書き込んでも、それより前のログが領域に残るようにする
+static_assert(LogManager::SLOT_COUNT > LogManager::LOG_QUEUE_SIZE, "log ring must be larger than the write queue");
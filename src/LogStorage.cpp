@@ -4,12 +4,12 @@ void LogStorage::begin(EepromManager& eeprom) {
   this->eeprom = &eeprom;  // EepromManagerの参照を保持
 }
 
-bool LogStorage::write(int address, const char* message, size_t len) {
-//  return eeprom->writeBytes(address, message, len);  // ログの書き込み
-  return true;
+bool LogStorage::write(int address, const uint8_t* data, size_t len) {
+  if (eeprom == nullptr) return false;
+  return eeprom->writeBytes(address, data, len);  // ログの書き込み
 }
 
-bool LogStorage::read(int address, char* buffer, size_t len) {
-//  return eeprom->readBytes(address, buffer, len);  // ログの読み込み
-  return true;
+bool LogStorage::read(int address, uint8_t* buffer, size_t len) {
+  if (eeprom == nullptr) return false;
+  return eeprom->readMultipleBytes(address, buffer, len);  // ログの読み込み
 }
@@ -8,11 +8,11 @@ public:
   // EepromManagerとの紐付け
   void begin(EepromManager& eeprom);
 
-  // ログメッセージを書き込む
-  bool write(int address, const char* message, size_t len);
+  // ログレコードを書き込む
+  bool write(int address, const uint8_t* data, size_t len);
 
-  // ログメッセージを読み込む
-  bool read(int address, char* buffer, size_t len);
+  // ログレコードを読み込む
+  bool read(int address, uint8_t* buffer, size_t len);
 
 private:
   EepromManager* eeprom = nullptr;  // EepromManagerの参照
@@ -0,0 +1,193 @@
+/**
+ * @file OledFrameBuffer.cpp
+ * @brief 1ビットOLEDのオフスクリーンフレームバッファ
+ */
+#include <string.h>
+#include "OledFrameBuffer.h"
+
+/**
+ * @brief 5x7フォント（0x20～0x7E）
+ * 1文字5列。1バイトが1列で、ビット0が上端。
+ */
+const uint8_t OledFrameBuffer::FONT[][5] = {
+  {0x00, 0x00, 0x00, 0x00, 0x00}, {0x00, 0x00, 0x5F, 0x00, 0x00}, {0x00, 0x07, 0x00, 0x07, 0x00}, {0x14, 0x7F, 0x14, 0x7F, 0x14},  //   ! " #
+  {0x24, 0x2A, 0x7F, 0x2A, 0x12}, {0x23, 0x13, 0x08, 0x64, 0x62}, {0x36, 0x49, 0x55, 0x22, 0x50}, {0x00, 0x05, 0x03, 0x00, 0x00},  // $ % & '
+  {0x00, 0x1C, 0x22, 0x41, 0x00}, {0x00, 0x41, 0x22, 0x1C, 0x00}, {0x08, 0x2A, 0x1C, 0x2A, 0x08}, {0x08, 0x08, 0x3E, 0x08, 0x08},  // ( ) * +
+  {0x00, 0x50, 0x30, 0x00, 0x00}, {0x08, 0x08, 0x08, 0x08, 0x08}, {0x00, 0x60, 0x60, 0x00, 0x00}, {0x20, 0x10, 0x08, 0x04, 0x02},  // , - . /
+  {0x3E, 0x51, 0x49, 0x45, 0x3E}, {0x00, 0x42, 0x7F, 0x40, 0x00}, {0x42, 0x61, 0x51, 0x49, 0x46}, {0x21, 0x41, 0x45, 0x4B, 0x31},  // 0 1 2 3
+  {0x18, 0x14, 0x12, 0x7F, 0x10}, {0x27, 0x45, 0x45, 0x45, 0x39}, {0x3C, 0x4A, 0x49, 0x49, 0x30}, {0x01, 0x71, 0x09, 0x05, 0x03},  // 4 5 6 7
+  {0x36, 0x49, 0x49, 0x49, 0x36}, {0x06, 0x49, 0x49, 0x29, 0x1E}, {0x00, 0x36, 0x36, 0x00, 0x00}, {0x00, 0x56, 0x36, 0x00, 0x00},  // 8 9 : ;
+  {0x08, 0x14, 0x22, 0x41, 0x00}, {0x14, 0x14, 0x14, 0x14, 0x14}, {0x00, 0x41, 0x22, 0x14, 0x08}, {0x02, 0x01, 0x51, 0x09, 0x06},  // < = > ?
+  {0x32, 0x49, 0x79, 0x41, 0x3E}, {0x7E, 0x11, 0x11, 0x11, 0x7E}, {0x7F, 0x49, 0x49, 0x49, 0x36}, {0x3E, 0x41, 0x41, 0x41, 0x22},  // @ A B C
+  {0x7F, 0x41, 0x41, 0x22, 0x1C}, {0x7F, 0x49, 0x49, 0x49, 0x41}, {0x7F, 0x09, 0x09, 0x01, 0x01}, {0x3E, 0x41, 0x41, 0x51, 0x32},  // D E F G
+  {0x7F, 0x08, 0x08, 0x08, 0x7F}, {0x00, 0x41, 0x7F, 0x41, 0x00}, {0x20, 0x40, 0x41, 0x3F, 0x01}, {0x7F, 0x08, 0x14, 0x22, 0x41},  // H I J K
+  {0x7F, 0x40, 0x40, 0x40, 0x40}, {0x7F, 0x02, 0x04, 0x02, 0x7F}, {0x7F, 0x04, 0x08, 0x10, 0x7F}, {0x3E, 0x41, 0x41, 0x41, 0x3E},  // L M N O
+  {0x7F, 0x09, 0x09, 0x09, 0x06}, {0x3E, 0x41, 0x51, 0x21, 0x5E}, {0x7F, 0x09, 0x19, 0x29, 0x46}, {0x46, 0x49, 0x49, 0x49, 0x31},  // P Q R S
+  {0x01, 0x01, 0x7F, 0x01, 0x01}, {0x3F, 0x40, 0x40, 0x40, 0x3F}, {0x1F, 0x20, 0x40, 0x20, 0x1F}, {0x7F, 0x20, 0x18, 0x20, 0x7F},  // T U V W
+  {0x63, 0x14, 0x08, 0x14, 0x63}, {0x03, 0x04, 0x78, 0x04, 0x03}, {0x61, 0x51, 0x49, 0x45, 0x43}, {0x00, 0x7F, 0x41, 0x41, 0x00},  // X Y Z [
+  {0x02, 0x04, 0x08, 0x10, 0x20}, {0x00, 0x41, 0x41, 0x7F, 0x00}, {0x04, 0x02, 0x01, 0x02, 0x04}, {0x40, 0x40, 0x40, 0x40, 0x40},  // \ ] ^ _
+  {0x00, 0x01, 0x02, 0x04, 0x00}, {0x20, 0x54, 0x54, 0x54, 0x78}, {0x7F, 0x48, 0x44, 0x44, 0x38}, {0x38, 0x44, 0x44, 0x44, 0x20},  // ` a b c
+  {0x38, 0x44, 0x44, 0x48, 0x7F}, {0x38, 0x54, 0x54, 0x54, 0x18}, {0x08, 0x7E, 0x09, 0x01, 0x02}, {0x08, 0x14, 0x54, 0x54, 0x3C},  // d e f g
+  {0x7F, 0x08, 0x04, 0x04, 0x78}, {0x00, 0x44, 0x7D, 0x40, 0x00}, {0x20, 0x40, 0x44, 0x3D, 0x00}, {0x00, 0x7F, 0x10, 0x28, 0x44},  // h i j k
+  {0x00, 0x41, 0x7F, 0x40, 0x00}, {0x7C, 0x04, 0x18, 0x04, 0x78}, {0x7C, 0x08, 0x04, 0x04, 0x78}, {0x38, 0x44, 0x44, 0x44, 0x38},  // l m n o
+  {0x7C, 0x14, 0x14, 0x14, 0x08}, {0x08, 0x14, 0x14, 0x18, 0x7C}, {0x7C, 0x08, 0x04, 0x04, 0x08}, {0x48, 0x54, 0x54, 0x54, 0x20},  // p q r s
+  {0x04, 0x3F, 0x44, 0x40, 0x20}, {0x3C, 0x40, 0x40, 0x20, 0x7C}, {0x1C, 0x20, 0x40, 0x20, 0x1C}, {0x3C, 0x40, 0x30, 0x40, 0x3C},  // t u v w
+  {0x44, 0x28, 0x10, 0x28, 0x44}, {0x0C, 0x50, 0x50, 0x50, 0x3C}, {0x44, 0x64, 0x54, 0x4C, 0x44}, {0x00, 0x08, 0x36, 0x41, 0x00},  // x y z {
+  {0x00, 0x00, 0x7F, 0x00, 0x00}, {0x00, 0x41, 0x36, 0x08, 0x00}, {0x08, 0x04, 0x08, 0x10, 0x08},                                  // | } ~
+};
+
+OledFrameBuffer::OledFrameBuffer(void) {
+  memset(pixels, 0, sizeof(pixels));
+  memset(shown, 0, sizeof(shown));
+}
+
+/**
+ * @brief 描画内容を消す
+ * パネルへは、次に送るときに変わった範囲として送られる。
+ */
+void OledFrameBuffer::clear(void) {
+  memset(pixels, 0, sizeof(pixels));
+}
+
+/**
+ * @brief 文字列を描く
+ * @param x 左端の列
+ * @param y 上端の行（8の倍数でなくてもよい）
+ * @param text 文字列
+ * @return 描いた文字数（右端からはみ出した文字は描かない）
+ */
+uint8_t OledFrameBuffer::drawText(uint8_t x, uint8_t y, const char* text) {
+  uint8_t count = 0;
+  for (const char* p = text; (p != nullptr) && (*p != '\0'); ++p) {
+    if (x + CHAR_WIDTH > WIDTH) {
+      break;
+    }
+    drawGlyph(x, y, *p);
+    x = static_cast<uint8_t>(x + CHAR_WIDTH);
+    count++;
+  }
+  return count;
+}
+
+/**
+ * @brief 1文字を描く
+ * @param x 左端の列
+ * @param y 上端の行
+ * @param c 文字（表にない文字は空白）
+ * @details 文字の枠（CHAR_WIDTH×CHAR_HEIGHT）全体を書き換える。
+ */
+void OledFrameBuffer::drawGlyph(uint8_t x, uint8_t y, char c) {
+  uint8_t code = static_cast<uint8_t>(c);
+  const uint8_t* glyph = FONT[((code >= 0x20) && (code <= 0x7E)) ? code - 0x20 : 0];
+  for (uint8_t col = 0; col < CHAR_WIDTH; ++col) {
+    blitColumn(static_cast<uint8_t>(x + col), y, (col < 5) ? glyph[col] : 0x00);
+  }
+}
+
+/**
+ * @brief 縦8ドットを書き込む
+ * @param x 列
+ * @param y 上端の行
+ * @param bits 縦8ドット（ビット0が上）
+ * @details y が8の倍数でないときは、2つのページにまたがって書く。範囲外は切り捨てる。
+ */
+void OledFrameBuffer::blitColumn(uint8_t x, uint8_t y, uint8_t bits) {
+  if ((x >= WIDTH) || (y >= HEIGHT)) {
+    return;
+  }
+  uint8_t page = y >> 3;
+  uint8_t shift = y & 0x07;
+  pixels[page][x] = static_cast<uint8_t>((pixels[page][x] & ~(0xFF << shift)) | (bits << shift));
+  if ((shift != 0) && (page + 1 < PAGES)) {
+    pixels[page + 1][x] = static_cast<uint8_t>((pixels[page + 1][x] & ~(0xFF >> (8 - shift))) | (bits >> (8 - shift)));
+  }
+}
+
+/**
+ * @brief ドットを取得する
+ * @param x 列
+ * @param y 行
+ * @return true 点灯
+ */
+bool OledFrameBuffer::getPixel(uint8_t x, uint8_t y) const {
+  if ((x >= WIDTH) || (y >= HEIGHT)) {
+    return false;
+  }
+  return (pixels[y >> 3][x] >> (y & 0x07)) & 0x01;
+}
+
+/**
+ * @brief ページの中の変わった範囲を求める
+ * @param page ページ
+ * @param spans 範囲の格納先
+ * @param maxSpans 格納できる数（MAX_SPANS あれば足りる）
+ * @return 範囲の数
+ * @details 隙間が MERGE_GAP 列未満の範囲はまとめる（範囲ごとのコマンドより隙間を送る方が安い）。
+ */
+size_t OledFrameBuffer::collectDirty(uint8_t page, OledSpan* spans, size_t maxSpans) const {
+  size_t count = 0;
+  if (page >= PAGES) {
+    return 0;
+  }
+  const uint8_t* now = pixels[page];
+  const uint8_t* old = shown[page];
+  int start = -1;
+  int last = -1;
+  for (int x = 0; x < WIDTH; ++x) {
+    if (now[x] == old[x]) {
+      continue;
+    }
+    if ((start >= 0) && (x - last > MERGE_GAP)) {
+      if (count >= maxSpans) return count;
+      spans[count++] = OledSpan{page, static_cast<uint8_t>(start), static_cast<uint8_t>(last)};
+      start = -1;
+    }
+    if (start < 0) start = x;
+    last = x;
+  }
+  if ((start >= 0) && (count < maxSpans)) {
+    spans[count++] = OledSpan{page, static_cast<uint8_t>(start), static_cast<uint8_t>(last)};
+  }
+  return count;
+}
+
+/**
+ * @brief 範囲を送ったことを記録する
+ * @param span 送った範囲
+ */
+void OledFrameBuffer::markShown(const OledSpan& span) {
+  if ((span.page >= PAGES) || (span.x1 >= WIDTH) || (span.x0 > span.x1)) {
+    return;
+  }
+  memcpy(&shown[span.page][span.x0], &pixels[span.page][span.x0], span.width());
+}
+
+/**
+ * @brief ページの中の変わった範囲と送る内容を受け取り、送ったことにする
+ * @param page ページ
+ * @param spans 範囲の格納先
+ * @param maxSpans 格納できる数（MAX_SPANS あれば足りる）
+ * @param sent 送る内容の格納先（WIDTHバイト、範囲の列だけを書く）
+ * @return 範囲の数
+ * @details 送る前に送ったことにするため、送っている間に描いた内容は次の送信で送られる。
+ */
+size_t OledFrameBuffer::takeDirty(uint8_t page, OledSpan* spans, size_t maxSpans, uint8_t* sent) {
+  size_t count = collectDirty(page, spans, maxSpans);
+  for (size_t i = 0; i < count; ++i) {
+    memcpy(&sent[spans[i].x0], &pixels[page][spans[i].x0], spans[i].width());
+    memcpy(&shown[page][spans[i].x0], &sent[spans[i].x0], spans[i].width());
+  }
+  return count;
+}
+
+/**
+ * @brief 全体を送り直す
+ * パネルを初期化した直後など、パネルの内容がわからないときに呼ぶ。
+ */
+void OledFrameBuffer::invalidate(void) {
+  for (uint8_t page = 0; page < PAGES; ++page) {
+    for (uint8_t x = 0; x < WIDTH; ++x) {
+      shown[page][x] = static_cast<uint8_t>(~pixels[page][x]);
+    }
+  }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief OLEDへ送る範囲（1ページ＝縦8ドット内の連続した列）
+ */
+struct OledSpan {
+  uint8_t page;     // ページ（縦8ドット単位の行）
+  uint8_t x0;       // 先頭の列
+  uint8_t x1;       // 最後の列（x1を含む）
+  uint8_t width(void) const { return static_cast<uint8_t>(x1 - x0 + 1); }
+};
+
+/**
+ * @brief 1ビットOLEDのオフスクリーンフレームバッファ
+ * - 表示内容はページ（縦8ドット）×列のバイト列。1バイトが縦8ドット（ビット0が上）
+ * - 文字は5x7フォントを直接ビット演算で書き込む（背景も書くので前の文字は残らない）
+ * - パネルに送った内容を覚えておき、変わった列だけを送る範囲（OledSpan）として返す
+ *
+ * 使い方：drawText() で描いたあと、ページごとに takeDirty() で送る範囲と内容を受け取り、その内容を送る。
+ * （collectDirty() で範囲を求め、送れたら markShown() を呼んでもよい）
+ */
+class OledFrameBuffer {
+public:
+  static constexpr uint8_t WIDTH = 128;             // 横のドット数（横向き）
+  static constexpr uint8_t HEIGHT = 64;             // 縦のドット数
+  static constexpr uint8_t PAGES = HEIGHT / 8;      // ページ数
+  static constexpr uint8_t CHAR_WIDTH = 6;          // 1文字の幅（字形5＋空き1）
+  static constexpr uint8_t CHAR_HEIGHT = 8;         // 1文字の高さ（字形7＋空き1）
+  static constexpr uint8_t MERGE_GAP = 4;           // この列数未満の隙間は1つの範囲にまとめて送る
+  static constexpr uint8_t SPAN_OVERHEAD = 6;       // 範囲1つあたりのI2Cのバイト数（アドレス・ページ/列の指定）
+  static constexpr size_t MAX_SPANS = WIDTH / (MERGE_GAP + 1) + 1;  // 1ページあたりの範囲の数の上限
+
+  OledFrameBuffer(void);
+
+  void clear(void);                                         // 描画内容を消す
+  uint8_t drawText(uint8_t x, uint8_t y, const char* text); // 文字列を描く
+  void drawGlyph(uint8_t x, uint8_t y, char c);             // 1文字を描く
+  bool getPixel(uint8_t x, uint8_t y) const;                // ドットを取得する
+  const uint8_t* pageData(uint8_t page) const { return pixels[page]; }  // ページの先頭（送るデータ）
+
+  size_t collectDirty(uint8_t page, OledSpan* spans, size_t maxSpans) const;  // ページの中の変わった範囲を求める
+  void markShown(const OledSpan& span);                     // 範囲を送ったことを記録する
+  size_t takeDirty(uint8_t page, OledSpan* spans, size_t maxSpans, uint8_t* sent);  // 変わった範囲と送る内容を受け取り、送ったことにする
+  void invalidate(void);                                    // 全体を送り直す（パネルの内容が不明なとき）
+
+  static uint32_t spanBytes(const OledSpan& span) { return span.width() + SPAN_OVERHEAD; }  // 範囲を送るI2Cのバイト数
+
+private:
+  uint8_t pixels[PAGES][WIDTH];   // 描画内容
+  uint8_t shown[PAGES][WIDTH];    // パネルに送った内容
+
+  void blitColumn(uint8_t x, uint8_t y, uint8_t bits);
+
+  static const uint8_t FONT[][5];   // 5x7フォント（0x20～0x7E）
+};
@@ -0,0 +1,234 @@
+/**
+ * @file ParameterJournal.cpp
+ * @brief パラメータの追記型ジャーナル（ウェアレベリング）
+ * @version 0.1
+ * @date 2025-06-10
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#include "ParameterJournal.h"
+#include "Crc16.h"
+
+/**
+ * @brief Construct a new Parameter Journal object
+ * @param eeprom EepromManagerのポインタ
+ */
+ParameterJournal::ParameterJournal(EepromManager *eeprom)
+  : eeprom(eeprom) {
+  for (uint8_t i = 0; i < MAX_PARAMS; ++i) {
+    latestSlot[i] = NO_SLOT;
+    latestValue[i] = 0;
+  }
+}
+
+/**
+ * @brief ジャーナル領域を設定し、走査して各パラメータの最新値を復元する
+ * @param startAddr 領域の開始アドレス（ページ境界）
+ * @param endAddr 領域の終了アドレス（この手前まで使用、ページ境界）
+ * @param paramCount パラメータ数
+ * @return true 成功、false 領域またはパラメータ数が不正
+ * 領域には、全パラメータの最新レコードに加えて2ページ分の空きが必要。
+ */
+bool ParameterJournal::begin(uint16_t startAddr, uint16_t endAddr, uint8_t paramCount) {
+  ready = false;
+  if (startAddr % EEPROM_PAGE_SIZE != 0 || endAddr % EEPROM_PAGE_SIZE != 0 || endAddr <= startAddr) {
+    return false;   // ページ境界に揃っていない
+  }
+  if (paramCount > MAX_PARAMS || endAddr > EEPROM_MAX_ADDRESS) {
+    return false;
+  }
+  uint16_t slots = (endAddr - startAddr) / RECORD_SIZE;
+  if (slots < paramCount + 2 * RECORDS_PER_PAGE) {
+    return false;   // ページ再利用の移し替えが収まらない
+  }
+
+  this->startAddr = startAddr;
+  this->slotCount = slots;
+  this->paramCount = paramCount;
+  appendCount = 0;
+  relocateCount = 0;
+  ready = scan();
+  return ready;
+}
+
+/**
+ * @brief 領域を走査し直して最新値と書き込み位置を復元する
+ * @return true 成功、false begin()していない
+ * トランザクションを破棄すると書き込んだレコードも元に戻るため、走査し直して書き込み位置を合わせる。
+ */
+bool ParameterJournal::reload(void) {
+  if (!ready) {
+    return false;
+  }
+  ready = scan();
+  return ready;
+}
+
+/**
+ * @brief 領域を走査して各パラメータの最新値と書き込み位置を復元する
+ * @return true 成功、false 読み込み失敗
+ * CRCが一致しないレコード（未使用・書き込み途中の電源断）は無視する。
+ * 次の書き込み位置は、シーケンス番号が最大のレコードの次のスロットとなる。
+ */
+bool ParameterJournal::scan(void) {
+  uint32_t latestSeq[MAX_PARAMS];
+  uint32_t maxSeq = 0;
+  uint16_t maxSlot = NO_SLOT;
+
+  for (uint8_t i = 0; i < MAX_PARAMS; ++i) {
+    latestSlot[i] = NO_SLOT;
+    latestSeq[i] = 0;
+  }
+
+  for (uint16_t slot = 0; slot < slotCount; ++slot) {
+    uint8_t index, value;
+    uint32_t seq;
+    if (!readRecord(slot, &index, &value, &seq)) {
+      continue;
+    }
+    if (latestSlot[index] == NO_SLOT || seq > latestSeq[index]) {
+      latestSlot[index] = slot;
+      latestSeq[index] = seq;
+      latestValue[index] = value;
+    }
+    if (maxSlot == NO_SLOT || seq > maxSeq) {
+      maxSeq = seq;
+      maxSlot = slot;
+    }
+  }
+
+  if (maxSlot == NO_SLOT) {
+    head = 0;       // レコードなし
+    nextSeq = 1;
+  } else {
+    head = (maxSlot + 1) % slotCount;
+    nextSeq = maxSeq + 1;
+  }
+  return true;
+}
+
+/**
+ * @brief パラメータの変更を追記する
+ * @param index パラメータのインデックス
+ * @param value 値
+ * @return true 成功、false 失敗
+ * 書き込み位置がページ先頭に来たら、そのページの最新レコードを移し替えてから追記する。
+ */
+bool ParameterJournal::append(uint8_t index, uint8_t value) {
+  if (!ready || index >= paramCount) {
+    return false;
+  }
+
+  if (head % RECORDS_PER_PAGE == 0) {
+    uint16_t pageCount = slotCount / RECORDS_PER_PAGE;
+    uint16_t reclaimed = 0;
+    while (reclaimPage(index) == RECORDS_PER_PAGE) {   // ページがすべて最新レコードなら次のページへ
+      if (++reclaimed >= pageCount) {
+        return false;
+      }
+    }
+  }
+
+  if (!writeRecord(head, index, value)) {
+    return false;
+  }
+  appendCount++;
+  return true;
+}
+
+/**
+ * @brief 最新値を取得する
+ * @param index パラメータのインデックス
+ * @param value 最新値を格納するポインタ
+ * @return true 成功、false レコードなし
+ */
+bool ParameterJournal::lookup(uint8_t index, uint8_t *value) {
+  if (!ready || index >= paramCount || latestSlot[index] == NO_SLOT) {
+    return false;
+  }
+  *value = latestValue[index];
+  return true;
+}
+
+/**
+ * @brief 書き込み位置のページを再利用する
+ * @param skipIndex これから追記するパラメータ（移し替え不要）
+ * @return 移し替えたレコード数
+ * ページ内で最新のレコードを新しいシーケンス番号でページ先頭から書き直す。
+ * 古いレコードはシーケンス番号が小さいため、走査時に無視される。
+ */
+uint8_t ParameterJournal::reclaimPage(uint8_t skipIndex) {
+  uint16_t first = head;
+  uint8_t liveIndex[RECORDS_PER_PAGE];
+  uint8_t liveCount = 0;
+
+  for (uint8_t i = 0; i < paramCount; ++i) {
+    if (i != skipIndex && latestSlot[i] != NO_SLOT &&
+        latestSlot[i] >= first && latestSlot[i] < first + RECORDS_PER_PAGE) {
+      liveIndex[liveCount++] = i;
+    }
+  }
+
+  for (uint8_t i = 0; i < liveCount; ++i) {
+    uint8_t index = liveIndex[i];
+    if (!writeRecord(head, index, latestValue[index])) {
+      break;
+    }
+    relocateCount++;
+  }
+  return liveCount;
+}
+
+/**
+ * @brief 書き込み位置にレコードを書き込み、書き込み位置を進める
+ * @param slot 書き込むスロット
+ * @param index パラメータのインデックス
+ * @param value 値
+ * @return true 成功、false 失敗
+ */
+bool ParameterJournal::writeRecord(uint16_t slot, uint8_t index, uint8_t value) {
+  uint8_t record[RECORD_SIZE];
+  uint32_t seq = nextSeq;
+  record[0] = index;
+  record[1] = value;
+  record[2] = seq & 0xFF;
+  record[3] = (seq >> 8) & 0xFF;
+  record[4] = (seq >> 16) & 0xFF;
+  record[5] = (seq >> 24) & 0xFF;
+  uint16_t crc = crc16Ccitt(record, 6);
+  record[6] = crc & 0xFF;
+  record[7] = crc >> 8;
+
+  if (!eeprom->writeBytes(startAddr + slot * RECORD_SIZE, record, RECORD_SIZE)) {
+    return false;
+  }
+  latestSlot[index] = slot;
+  latestValue[index] = value;
+  nextSeq++;
+  head = (slot + 1) % slotCount;
+  return true;
+}
+
+/**
+ * @brief レコードを読み込む
+ * @param slot スロット
+ * @param index パラメータのインデックスを格納するポインタ
+ * @param value 値を格納するポインタ
+ * @param seq シーケンス番号を格納するポインタ
+ * @return true 有効なレコード、false 未使用・破損・範囲外
+ */
+bool ParameterJournal::readRecord(uint16_t slot, uint8_t *index, uint8_t *value, uint32_t *seq) {
+  uint8_t record[RECORD_SIZE];
+  if (!eeprom->readMultipleBytes(startAddr + slot * RECORD_SIZE, record, RECORD_SIZE)) {
+    return false;
+  }
+  uint16_t crc = record[6] | (record[7] << 8);
+  if (crc != crc16Ccitt(record, 6) || record[0] >= paramCount) {
+    return false;
+  }
+  *index = record[0];
+  *value = record[1];
+  *seq = (uint32_t)record[2] | ((uint32_t)record[3] << 8) | ((uint32_t)record[4] << 16) | ((uint32_t)record[5] << 24);
+  return true;
+}
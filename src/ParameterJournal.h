@@ -0,0 +1,58 @@
+/**
+ * @file ParameterJournal.h
+ * @brief パラメータの追記型ジャーナル（ウェアレベリング）
+ * @version 0.1
+ * @date 2025-06-10
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#pragma once
+
+#include <cstdint>
+#include "EepromManager.h"
+
+/**
+ * @brief パラメータの追記型ジャーナル
+ * - パラメータの変更を（インデックス、値、シーケンス番号、CRC）のレコードとして領域内に循環して追記する
+ * - 書き込み位置が一巡してページ先頭に戻ったら、そのページにある最新レコードを移し替えてから再利用する
+ * - 起動時に領域を走査し、シーケンス番号の最も大きいレコードから各パラメータの最新値を復元する
+ */
+class ParameterJournal {
+public:
+  static constexpr uint8_t RECORD_SIZE = 8;                                // レコードのバイト数
+  static constexpr uint8_t RECORDS_PER_PAGE = EEPROM_PAGE_SIZE / RECORD_SIZE; // 1ページのレコード数
+  static constexpr uint8_t MAX_PARAMS = 64;                                // 扱えるパラメータ数の上限
+
+  ParameterJournal(EepromManager *eeprom);
+
+  bool begin(uint16_t startAddr, uint16_t endAddr, uint8_t paramCount);  // 領域を設定し、走査して最新値を復元
+  bool reload(void);                              // 領域を走査し直す（トランザクション破棄後）
+  bool append(uint8_t index, uint8_t value);      // パラメータの変更を追記
+  bool lookup(uint8_t index, uint8_t *value);     // 最新値を取得（レコードがなければfalse）
+  bool isReady(void) const { return ready; }      // begin()済みか
+
+  uint32_t getSequence(void) const { return nextSeq - 1; }      // 最後に書き込んだシーケンス番号
+  uint32_t getAppendCount(void) const { return appendCount; }   // 追記したレコード数（起動後）
+  uint32_t getRelocateCount(void) const { return relocateCount; } // ページ再利用で移し替えたレコード数（起動後）
+
+private:
+  EepromManager* eeprom = nullptr;  // EepromManagerの参照
+  bool ready = false;               // begin()済み
+  uint16_t startAddr = 0;           // 領域の開始アドレス（ページ境界）
+  uint16_t slotCount = 0;           // 領域のレコード数
+  uint8_t paramCount = 0;           // パラメータ数
+  uint16_t head = 0;                // 次に書き込むスロット
+  uint32_t nextSeq = 1;             // 次に書き込むシーケンス番号
+  uint32_t appendCount = 0;         // 追記したレコード数
+  uint32_t relocateCount = 0;       // 移し替えたレコード数
+
+  static constexpr uint16_t NO_SLOT = 0xFFFF;
+  uint16_t latestSlot[MAX_PARAMS];  // パラメータごとの最新レコードのスロット
+  uint8_t latestValue[MAX_PARAMS];  // パラメータごとの最新値
+
+  bool scan(void);                                              // 領域を走査して最新値を復元
+  uint8_t reclaimPage(uint8_t skipIndex);                       // 書き込み位置のページを再利用する
+  bool writeRecord(uint16_t slot, uint8_t index, uint8_t value); // レコードを書き込む
+  bool readRecord(uint16_t slot, uint8_t *index, uint8_t *value, uint32_t *seq); // レコードを読み込む
+};
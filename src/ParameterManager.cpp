@@ -3,7 +3,7 @@
 #include <cstdio> // snprintf
 #include <iostream>
 
-#define MAX_PARAMS 50  // 最大パラメータ数
+#define MAX_PARAMS ParameterStorage::PARAM_COUNT  // 最大パラメータ数
 
 ParameterManager::ParameterManager(EepromManager *eeprom, LogManager *logger, SystemManager *systemManager)
   : eeprom(eeprom),     // EepromManagerの参照を初期化
@@ -23,6 +23,11 @@ void ParameterManager::begin(void) {
   Parameter defaultParam = {0, 0, 0, 0, nullptr}; // 任意の初期値
   params.resize(MAX_PARAMS, defaultParam);        // パラメータ数を予約 すべてこの値で埋める
 
+#if PARAM_JOURNAL_ENABLE
+  storage.useJournal(PARAM_JOURNAL_START, PARAM_JOURNAL_END);  // ジャーナル形式で保存
+#endif
+  storage.loadAll();                              // パラメータ領域を一括読み込み（失敗時は個別に読み込む）
+
   setupParameter( 0, 0x01, 0x00, 0x01, nullptr);          // Pr.0 初期化 表示フォーマット：時刻表示12/24
   setupParameter( 1, 0x03, 0x01, 0x0A, nullptr);          // Pr.1 初期化 表示フォーマット：Display Format
   setupParameter( 2, 0x00, 0x00, 0x0A, nullptr);          // Pr.2 初期化 表示フォーマット：timeDisplayFormat
@@ -51,6 +56,7 @@ void ParameterManager::begin(void) {
   setupParameter(43, 0x00, 0x00, 0x03, nullptr);          // Pr.43 初期化 地域設定
   setupParameter(44, 0x00, 0x00, 0x01, std::bind(&SystemManager::updateWiFiAutoConnect, systemManager));   // Pr.44 初期化 WiFi Station 設定：STA自動接続有効
 
+  storage.releaseCache();                         // 以降はEEPROMから読み込む
 }
 
 /**
@@ -100,10 +106,11 @@ bool ParameterManager::setupParameter(uint8_t index, int defaultValue, int minVa
   if (!loaded || loadedValue < minValue || loadedValue > maxValue) {
     // EEPROM読み込み失敗 または 範囲外 → 初期値で復元
     param.currentValue = defaultValue;  // 初期値を設定
-    storage.save(index, defaultValue);  // 初期値をEEPROMに保存
+    bool saved = storage.save(index, defaultValue);  // 初期値をEEPROMに保存
 
     char buf[80];
-    snprintf(buf, sizeof(buf), "Param %u load fail or out of range, set to default", index);
+    snprintf(buf, sizeof(buf), saved ? "Param %u load fail or out of range, set to default"
+                                     : "Param %u load fail, default not saved", index);
     logError(buf);
     std::cout << buf << std::endl;
   } else {
@@ -129,8 +136,11 @@ bool ParameterManager::setupParameter(uint8_t index, int defaultValue, int minVa
  * 
  * @param index  パラメータのインデックス
  * @param value  設定する値
+ * 保存に失敗した場合はEEPROMトランザクションを破棄し、値を変更しない。
+ * 呼び出し元のトランザクション中であれば、そのトランザクションごと破棄する。
+ * 
  * @return true  成功
- * @return false 範囲外エラー
+ * @return false 範囲外エラー、保存失敗
  */
 bool ParameterManager::setParameter(uint8_t index, uint8_t value) {
 //  Serial.printf("setParameter: index=%u, value=%d\n", index, value);
@@ -151,8 +161,21 @@ bool ParameterManager::setParameter(uint8_t index, uint8_t value) {
   }
 
   if (param.currentValue != value) {
+    bool saved = eeprom->beginTransaction();  // ジャーナルのページ再利用を含めて1回の変更とする
+    if (saved) {
+      saved = storage.save(index, value) && eeprom->commitTransaction();
+      if (!saved) {
+        eeprom->abortTransaction();
+        storage.revert();
+      }
+    }
+    if (!saved) {
+      char buf[80];
+      snprintf(buf, sizeof(buf), "Param %u save failed", index);
+      logError(buf);
+      return false; // 保存失敗
+    }
     param.currentValue = value;
-    storage.save(index, value);
   }
   systemManager->onParameterChanged(index, value); // データ設定
   if (param.onChanged) {
@@ -162,6 +185,85 @@ bool ParameterManager::setParameter(uint8_t index, uint8_t value) {
   return true; // 成功
 }
 
+/**
+ * @brief 連続したパラメータの一括設定（EEPROM書き込み）
+ * すべての値の範囲を確認してから、1回のEEPROMトランザクションで書き込む。
+ * 1つでも範囲外の値があれば、どのパラメータも変更しない。
+ * 保存に失敗した場合はトランザクションを破棄し、設定済みのパラメータも元の値に戻す。
+ *
+ * @param firstIndex 先頭パラメータのインデックス
+ * @param values     設定する値の配列
+ * @param count      パラメータ数
+ * @return true  成功
+ * @return false 範囲外エラー、保存失敗
+ */
+bool ParameterManager::setParameters(uint8_t firstIndex, const uint8_t *values, size_t count) {
+  if (firstIndex + count > params.size()) {
+    logError("setParameters: Invalid index");
+    return false;
+  }
+
+  std::lock_guard<std::recursive_mutex> lock(eeprom->getMutex());
+
+  for (size_t i = 0; i < count; ++i) {
+    const Parameter& param = params[firstIndex + i];
+    if (values[i] < param.minValue || values[i] > param.maxValue) {
+      char buf[80];
+      snprintf(buf, sizeof(buf), "Param %u set out of range (%d-%d)", static_cast<unsigned>(firstIndex + i), param.minValue, param.maxValue);
+      logError(buf);
+      return false; // 範囲外エラー
+    }
+  }
+
+  std::vector<int> previous(count);
+  for (size_t i = 0; i < count; ++i) {
+    previous[i] = params[firstIndex + i].currentValue;
+  }
+
+  if (!eeprom->beginTransaction()) {  // 書き込みを1回にまとめる
+    logError("setParameters: Transaction failed");
+    return false;
+  }
+  for (size_t i = 0; i < count; ++i) {
+    if (!setParameter(firstIndex + i, values[i])) {
+      eeprom->abortTransaction();
+      restoreParameters(firstIndex, previous);
+      return false; // 保存失敗
+    }
+  }
+  if (!eeprom->commitTransaction()) {
+    eeprom->abortTransaction();
+    storage.revert();
+    restoreParameters(firstIndex, previous);
+    logError("setParameters: Commit failed");
+    return false;
+  }
+
+  return true; // 成功
+}
+
+/**
+ * @brief パラメータをトランザクション前の値に戻す（EEPROMには書き込まない）
+ * 値が変わったパラメータのみ、コールバックを発火して反映し直す。
+ *
+ * @param firstIndex 先頭パラメータのインデックス
+ * @param values     戻す値の配列
+ */
+void ParameterManager::restoreParameters(uint8_t firstIndex, const std::vector<int>& values) {
+  for (size_t i = 0; i < values.size(); ++i) {
+    uint8_t index = firstIndex + i;
+    Parameter& param = params[index];
+    if (param.currentValue == values[i]) {
+      continue;
+    }
+    param.currentValue = values[i];
+    systemManager->onParameterChanged(index, param.currentValue);
+    if (param.onChanged) {
+      param.onChanged(index, param.currentValue);
+    }
+  }
+}
+
 /**
  * @brief パラメータの取得（RAM読み込み）
  * この関数は、指定されたインデックスのパラメータの現在の値を取得する。
@@ -185,19 +287,27 @@ uint8_t ParameterManager::getParameter(uint8_t index) {
 }
 
 /**
- * @brief パラメータの取得（EEPROM読み込み）
- * この関数は、指定されたインデックスのパラメータの現在の値をEEPROMから読み込む。
+ * @brief すべてのパラメータを初期値に戻す
+ * 1回のEEPROMトランザクションで書き込み、失敗した場合はどのパラメータも変更しない。
  * 
+ * @return true  成功
+ * @return false 保存失敗
  */
-void ParameterManager::clearAllParameters() {
+bool ParameterManager::clearAllParameters() {
   std::lock_guard<std::recursive_mutex> lock(eeprom->getMutex());
   std::cout << "ParameterManager::clearAllParameters\n";
 
-  for (uint8_t i = 0; i < params.size(); ++i) {
-    setParameter(i, params[i].defaultValue);
+  std::vector<uint8_t> defaults(params.size());
+  for (size_t i = 0; i < params.size(); ++i) {
+    defaults[i] = params[i].defaultValue;
+  }
+  if (!setParameters(0, defaults.data(), defaults.size())) {  // 全パラメータの書き込みを1回にまとめる
+    logError("Parameter reset failed");
+    return false;
   }
 
   logInfo("All parameters reset to default");
+  return true;
 }
 
 void ParameterManager::logError(const char* message) {
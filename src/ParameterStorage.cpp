@@ -16,7 +16,8 @@
  * @param eeprom EepromManagerのポインタ
  */
 ParameterStorage::ParameterStorage(EepromManager *eeprom)
-  : eeprom(eeprom) {  // EepromManagerの参照を初期化
+  : eeprom(eeprom),   // EepromManagerの参照を初期化
+    journal(eeprom) {
 }
 
 /**
@@ -32,9 +33,33 @@ ParameterStorage::~ParameterStorage(){
  * @brief パラメータの保存
  * @param index パラメータのインデックス
  * @param value 保存する値
+ * @return true 成功、false 失敗（ジャーナルの追記失敗、EEPROMの書き込み失敗）
+ * ジャーナル形式の場合は、固定アドレスではなくジャーナル領域に追記する。
  */
-void ParameterStorage::save(uint8_t index, int value) {
-  eeprom->writeByte(PARAM_START_ADDR + index, value);  // パラメータ保存
+bool ParameterStorage::save(uint8_t index, int value) {
+  if (mode == ParameterStorageMode::Journal) {
+    return journal.append(index, value);   // パラメータ保存（追記）
+  }
+  if (!eeprom->writeByte(PARAM_START_ADDR + index, value)) {  // パラメータ保存
+    return false;
+  }
+  if (cacheValid && index < PARAM_COUNT) {
+    cache[index] = value;   // 一括読み込み中はキャッシュも更新
+  }
+  return true;
+}
+
+/**
+ * @brief トランザクションの破棄後に、EEPROMの内容と状態を合わせる
+ * ジャーナルの書き込み位置と、一括読み込みしたパラメータ領域を読み直す。
+ */
+void ParameterStorage::revert(void) {
+  if (mode == ParameterStorageMode::Journal) {
+    journal.reload();
+  }
+  if (cacheValid) {
+    loadAll();
+  }
 }
 
 /**
@@ -44,5 +69,47 @@ void ParameterStorage::save(uint8_t index, int value) {
  * @return true 成功、false 失敗
  */
 bool ParameterStorage::load(uint8_t index, uint8_t *value) {
+  if (mode == ParameterStorageMode::Journal && journal.lookup(index, value)) {
+    return true;            // ジャーナルの最新値（なければ固定アドレスの値）
+  }
+  if (cacheValid && index < PARAM_COUNT) {
+    *value = cache[index];  // 一括読み込み済みの値を使用
+    return true;
+  }
   return eeprom->readByte(PARAM_START_ADDR + index, value);  // パラメータ読み込み
 }
+
+/**
+ * @brief パラメータ領域の一括読み込み
+ * @return true 成功、false 失敗
+ * パラメータ領域（0x0010〜0x0041）を1回の連続読み込みで取得し、以降のload()はこの値を返す。
+ * 起動時のパラメータ設定が終わったらreleaseCache()で解放する。
+ */
+bool ParameterStorage::loadAll(void) {
+  cacheValid = eeprom->readMultipleBytes(PARAM_START_ADDR, cache, PARAM_COUNT);
+  return cacheValid;
+}
+
+/**
+ * @brief 一括読み込みしたパラメータ領域を破棄する
+ * 以降のload()はEEPROMから読み込む。
+ */
+void ParameterStorage::releaseCache(void) {
+  cacheValid = false;
+}
+
+/**
+ * @brief ジャーナル形式に切り替える
+ * @param startAddr ジャーナル領域の開始アドレス（ページ境界）
+ * @param endAddr ジャーナル領域の終了アドレス（この手前まで使用、ページ境界）
+ * @return true 成功、false 領域が不正（固定アドレス形式のまま）
+ * ジャーナルにまだ記録のないパラメータは、固定アドレスの値を読み込む（従来形式からの移行）。
+ */
+bool ParameterStorage::useJournal(uint16_t startAddr, uint16_t endAddr) {
+  if (!journal.begin(startAddr, endAddr, PARAM_COUNT)) {
+    mode = ParameterStorageMode::InPlace;
+    return false;
+  }
+  mode = ParameterStorageMode::Journal;
+  return true;
+}
@@ -11,6 +11,15 @@
 #pragma once
 
 #include "EepromManager.h"
+#include "ParameterJournal.h"
+
+/**
+ * @brief パラメータの保存形式
+ */
+enum class ParameterStorageMode {
+  InPlace,    // パラメータごとの固定アドレスに上書き
+  Journal     // ジャーナル領域に追記（ウェアレベリング）
+};
 
 class ParameterStorage {
 public:
@@ -18,12 +27,27 @@ public:
   ~ParameterStorage();
 
   // パラメータの保存
-  void save(uint8_t index, int value);
+  bool save(uint8_t index, int value);
+  void revert(void);    // トランザクション破棄後にEEPROMの内容と合わせる
 
   // パラメータの読み込み
   bool load(uint8_t index, uint8_t *value);
 
+  // パラメータ領域の一括読み込み（起動時）
+  bool loadAll(void);
+  void releaseCache(void);
+
+  // 保存形式
+  bool useJournal(uint16_t startAddr, uint16_t endAddr);  // ジャーナル形式に切り替え（領域を走査して最新値を復元）
+  ParameterStorageMode getMode(void) const { return mode; }
+
+  static constexpr int PARAM_COUNT = 50;           // パラメータ領域のバイト数（0x0010〜0x0041）
+
 private:
   EepromManager* eeprom = nullptr;  // EepromManagerの参照
   static constexpr int PARAM_START_ADDR = 0x0010;  // パラメータの開始アドレス
+  uint8_t cache[PARAM_COUNT];       // 一括読み込みしたパラメータ領域
+  bool cacheValid = false;          // cacheが有効
+  ParameterStorageMode mode = ParameterStorageMode::InPlace; // 保存形式
+  ParameterJournal journal;         // パラメータジャーナル
 };
@@ -37,7 +37,7 @@ bool RTCManager::begin(void)
     type = RTCType::None;  // I2CBusManagerが設定されていない場合はRTCTypeをNoneに設定
     return false;
   }
-  std::lock_guard<std::recursive_mutex> lock(i2cBus->getMutex());
+  I2CTransaction transaction(*i2cBus, I2CADR_RTC);  // 外付けRTCの周波数で確認する
 
   bool found = false;
 
@@ -55,6 +55,17 @@ bool RTCManager::begin(void)
     type = RTCType::None;
   }
 
+  // 種類ごとの読み込みをここで決め、読むたびに種類で分岐しない
+  switch (type) {
+    case RTCType::M5RTC: readClock = [this]() { return toDateTime(M5.Rtc.getDateTime()); }; break;   // GMT
+    case RTCType::DS1307: readClock = [this]() { return rtc1307.now(); }; break;
+    case RTCType::DS3231: readClock = [this]() { return rtc3231.now(); }; break;
+    default: readClock = nullptr; break;
+  }
+  if (found) {
+    timeCache.begin([this](uint32_t& unixtime) { return readUnixTime(unixtime); }, millis());
+  }
+
   return found;
 }
 
@@ -80,7 +91,7 @@ void RTCManager::dispRtcType(void) {
  *      RTCが動作している場合は、RTCType::M5RTC, RTCType::DS1307, RTCType::DS3231のいずれかを返す。
  */
 bool RTCManager::isRunning() {
-  std::lock_guard<std::recursive_mutex> lock(i2cBus->getMutex());
+  I2CTransaction transaction(*i2cBus, i2cAddress());
   switch (type) {
     case RTCType::M5RTC: return M5.Rtc.isEnabled();
     case RTCType::DS1307: return rtc1307.isrunning();
@@ -92,20 +103,66 @@ bool RTCManager::isRunning() {
 /**
  * @brief RTCの現在時刻を取得
  * @return 現在時刻
- * @note M5RTCの場合は、M5.Rtc.getDateTime()を使用して時刻を取得する。
- *      DS1307とDS3231の場合は、RTCライブラリのnow()メソッドを使用して時刻を取得する。
- *      現在時刻は、DateTime型で返される。
+ * @note 再同期で読んだ時刻をmillis()で延長した値を返し、I2Cは使わない。
+ *      まだ読めていない場合だけ、RTCから読む。
  */
 DateTime RTCManager::now() {
-  std::lock_guard<std::recursive_mutex> lock(i2cBus->getMutex());
-  switch (type) {
-    case RTCType::M5RTC:{
-      return toDateTime(M5.Rtc.getDateTime());  // GMT
+  uint32_t unixtime = 0;
+  if (timeCache.now(millis(), unixtime)) {
+    return DateTime(unixtime);
+  }
+  return readNow();
+}
+
+/**
+ * @brief RTCの現在時刻を読む
+ * @return 現在時刻（読めなければ2000-01-01 00:00:00）
+ * @note 読み込みはI2CPriority::Criticalとして、待っている他の処理より先に実行する。
+ */
+DateTime RTCManager::readNow() {
+  uint32_t unixtime = 0;
+  if (readUnixTime(unixtime)) {
+    return DateTime(unixtime);
+  }
+  return DateTime(2000, 1, 1, 0, 0, 0);
+}
+
+/**
+ * @brief キャッシュの再同期を進める
+ * @param nowMs 現在のmillis()
+ * @note 再同期の時期でなければI2Cは使わない。
+ */
+void RTCManager::update(uint32_t nowMs) {
+  timeCache.update(nowMs);
+}
+
+/**
+ * @brief RTCから読む
+ * @param unixtime 時刻（UNIX時間）の格納先
+ * @return true: 読めた、false: 期限までに開始できなかった・読んだ時刻が範囲外
+ * @note 読めなかった転送は I2CResult::Error としてバスの統計に記録する。
+ */
+bool RTCManager::readUnixTime(uint32_t& unixtime) {
+  if (!readClock) {
+    return false;
+  }
+  DateTime result(2000, 1, 1, 0, 0, 0);
+  // 時刻表示を駆動するため、キューに積まれたOLED描画などより先に実行する
+  bool done = i2cBus->execute(I2CPriority::Critical, [this, &result]() {
+    I2CTransaction transaction(*i2cBus, i2cAddress());
+    transaction.addBytes(RTC_TIME_BYTES);
+    result = readClock();
+    if (!result.isValid()) {
+      transaction.setResult(I2CResult::Error);    // 読めなかった（ライブラリは失敗を返さず、範囲外の値になる）
+      return false;
     }
-    case RTCType::DS1307: return rtc1307.now();
-    case RTCType::DS3231: return rtc3231.now();
-    default: return DateTime(2000, 1, 1, 0, 0, 0);
+    return true;
+  }, RTC_READ_DEADLINE_US);
+  if (!done) {
+    return false;
   }
+  unixtime = result.unixtime();
+  return true;
 }
 
 /**
@@ -113,16 +170,35 @@ DateTime RTCManager::now() {
  * @param dt 設定する時刻
  * @note M5RTCの場合は、M5.Rtc.setDateTime()を使用して時刻を設定する。
  *      DS1307とDS3231の場合は、RTCライブラリのadjust()メソッドを使用する。
+ *      SNTPのタスクからも呼ばれるため、キャッシュへは預けるだけにして update() で反映する。
  */
 void RTCManager::adjust(const DateTime& dt) {
-  std::lock_guard<std::recursive_mutex> lock(i2cBus->getMutex());
+  I2CTransaction transaction(*i2cBus, i2cAddress());
   switch (type) {
     case RTCType::M5RTC: M5.Rtc.setDateTime(toRtcDateTime(dt)); break;
     case RTCType::DS1307: rtc1307.adjust(dt); break;
     case RTCType::DS3231: rtc3231.adjust(dt); break;
     default: break;
   }
-} 
+  if (type != RTCType::None) {
+    timeCache.post(dt.unixtime(), millis());  // 次の update() で設定した時刻から延長し、秒の境界を探し直す
+  }
+}
+
+/**
+ * @brief SQW端子から1Hzの矩形波を出す
+ * @return true: 出力した, false: 対応していないRTC
+ * @note 立ち下がりで秒が進む。DS3231は秒のレジスタを書くと分周がリセットされるため、
+ *      adjust()のあとは立ち下がりの位相が変わる。
+ */
+bool RTCManager::enableSecondPulse() {
+  I2CTransaction transaction(*i2cBus, i2cAddress());
+  switch (type) {
+    case RTCType::DS1307: rtc1307.writeSqwPinMode(DS1307_SquareWave1HZ); return true;
+    case RTCType::DS3231: rtc3231.writeSqwPinMode(DS3231_SquareWave1Hz); return true;
+    default: return false;
+  }
+}
 
 /**
  * @brief DS3231の温度を取得
@@ -132,7 +208,7 @@ void RTCManager::adjust(const DateTime& dt) {
  *      温度は摂氏で返す。
  */
 float RTCManager::getTemperature() {
-  std::lock_guard<std::recursive_mutex> lock(i2cBus->getMutex());
+  I2CTransaction transaction(*i2cBus, i2cAddress());
   if (type == RTCType::DS3231) {
     return rtc3231.getTemperature();
   } else {
@@ -6,7 +6,9 @@
 
 #include <M5Unified.h>
 #include <RTClib.h>
+#include <functional>
 #include "I2CBusManager.h"
+#include "RtcTimeCache.h"
 
 /**
  * @brief RTCの種類を表す列挙型
@@ -34,9 +36,14 @@ public:
   ~RTCManager() = default;
   bool begin(void);                             // RTCの初期化（I2CBusManager経由でI2Cを使用）
   bool isRunning();                             // RTCが動作しているか確認
-  DateTime now();                               // 現在時刻を取得
+  DateTime now();                               // 現在時刻を取得（キャッシュから推定）
+  DateTime readNow();                           // 現在時刻をRTCから読む
+  void update(uint32_t nowMs);                  // キャッシュの再同期を進める
+  void onResync(const RtcTimeCache::SyncCallback& callback) { timeCache.onResync(callback); }  // 再同期コールバック関数を設定
+  const RtcTimeCache& getTimeCache() const { return timeCache; }    // キャッシュ（RTCの進みの推定値など）
   void adjust(const DateTime& dt);              // RTCの時刻を設定
   float getTemperature();                       // DS3231の温度を取得（摂氏）
+  bool enableSecondPulse();                     // SQW端子から1Hzの矩形波を出す
   RTCType getRTCType() const { return type; }   // RTCの種類を取得
   void dispRtcType(void);                       // RTCの種類を表示
 
@@ -45,7 +52,14 @@ private:
   RTC_DS1307 rtc1307;               // DS1307 RTC
   RTC_DS3231 rtc3231;               // DS3231 RTC
   RTCType type = RTCType::None;     // RTCの種類
+  std::function<DateTime()> readClock;  // 種類に応じた時刻の読み込み（begin()で決める）
+  RtcTimeCache timeCache;           // 時刻のキャッシュ
 
+  static constexpr uint32_t RTC_READ_DEADLINE_US = 1000;  // 時刻読み込みの開始期限[us]
+  static constexpr uint8_t RTC_TIME_BYTES = 7;            // 時刻レジスタのバイト数（秒〜年）
+
+  uint8_t i2cAddress() const { return type == RTCType::M5RTC ? I2CADR_M5RTC : I2CADR_RTC; }  // RTCのI2Cアドレス
+  bool readUnixTime(uint32_t& unixtime);                // RTCから読む（キャッシュの読み込み関数）
   DateTime toDateTime(const m5::rtc_datetime_t dt);     // RTCの時刻をDateTime型に変換
   m5::rtc_datetime_t toRtcDateTime(const DateTime& dt); // DateTime型の時刻をRTCの形式に変換
 };
@@ -0,0 +1,202 @@
+/**
+ * @file RtcTimeCache.cpp
+ * @brief RTCの時刻のキャッシュ
+ * @details
+ * RTCは秒単位でしか読めないため、1回読んだだけでは秒未満の位相がわからない。
+ * 再同期では EDGE_POLL_MS ごとに読み、値が変わった2回の読み込みの中点を秒の境界とする（誤差は±EDGE_POLL_MS/2）。
+ * 境界の時刻とmillis()を基準にして、あいだの時刻はmillis()の経過で求める。
+ * RTCの進みは、最初の境界からの RTC と CPU の経過時間の差で求めるため、期間が長いほど精度が上がる。
+ */
+#include "RtcTimeCache.h"
+
+/**
+ * @brief 最初の読み込みを始める
+ * @param reader RTCを読む関数
+ * @param nowMs 現在のmillis()
+ * @details 最初の1回で時刻を推定できるようにし（位相は±500ms）、続けて秒の境界を探す。
+ */
+void RtcTimeCache::begin(const Reader& reader, uint32_t nowMs) {
+  this->reader = reader;
+  valid = false;
+  edgeBased = false;
+  anchored = false;
+  driftValid = false;
+  driftPpb = 0;
+  baselineS = 0;
+  reads = 0;
+  resyncRequested.store(false, std::memory_order_relaxed);
+  setPosted.store(false, std::memory_order_relaxed);
+  startSearch(nowMs);
+  update(nowMs);
+}
+
+/**
+ * @brief 再同期を進める
+ * @param nowMs 現在のmillis()
+ * @details 再同期の時期でなければ比較だけで戻る。post() された時刻があれば先に反映する。
+ */
+void RtcTimeCache::update(uint32_t nowMs) {
+  if (setPosted.load(std::memory_order_acquire)) {
+    uint32_t sec = 0;
+    uint32_t ms = 0;
+    {
+      std::lock_guard<std::mutex> lock(postMutex);
+      sec = postedSec;
+      ms = postedMs;
+      setPosted.store(false, std::memory_order_relaxed);
+    }
+    set(sec, ms);
+  }
+  if (state == State::Idle) {
+    if (!resyncRequested.load(std::memory_order_acquire) && (static_cast<int32_t>(nowMs - nextResyncMs) < 0)) {
+      return;
+    }
+    resyncRequested.store(false, std::memory_order_relaxed);
+    startSearch(nowMs);
+  }
+  if (polled && (nowMs - lastPollMs < EDGE_POLL_MS)) {
+    return;
+  }
+  poll(nowMs);
+}
+
+/**
+ * @brief 推定した現在の時刻
+ * @param nowMs 現在のmillis()
+ * @param unixtime 時刻（UNIX時間）の格納先
+ * @return true 推定できた、false まだ読めていない
+ */
+bool RtcTimeCache::now(uint32_t nowMs, uint32_t& unixtime) const {
+  if (!valid) {
+    return false;
+  }
+  unixtime = baseSec + (nowMs - baseMs) / 1000;
+  return true;
+}
+
+/**
+ * @brief RTCに時刻を設定した
+ * @param unixtime 設定した時刻
+ * @param nowMs 設定したときのmillis()
+ * @details 時刻を設定するとRTCの秒の位相が変わるため、進みの基準を取り直して境界を探し直す。
+ *          進みの推定値は発振子の性質なので残す。
+ */
+void RtcTimeCache::set(uint32_t unixtime, uint32_t nowMs) {
+  baseSec = unixtime;
+  baseMs = nowMs;
+  valid = true;
+  edgeBased = false;
+  anchored = false;
+  baselineS = 0;
+  startSearch(nowMs);
+}
+
+/**
+ * @brief 別のタスクからRTCに時刻を設定した
+ * @param unixtime 設定した時刻
+ * @param nowMs 設定したときのmillis()
+ * @details set() はループの update()/now() と同じ状態を書き換えるため、ここでは時刻を預けるだけにする。
+ *          反映は次の update() で行い、それまでに複数回呼ばれたら最後の時刻を使う。
+ */
+void RtcTimeCache::post(uint32_t unixtime, uint32_t nowMs) {
+  std::lock_guard<std::mutex> lock(postMutex);
+  postedSec = unixtime;
+  postedMs = nowMs;
+  setPosted.store(true, std::memory_order_release);
+}
+
+/**
+ * @brief 秒の境界を探し始める
+ * @param nowMs 現在のmillis()
+ */
+void RtcTimeCache::startSearch(uint32_t nowMs) {
+  state = State::Searching;
+  searchStartMs = nowMs;
+  polled = false;
+}
+
+/**
+ * @brief 境界を探して1回読む
+ * @param nowMs 現在のmillis()
+ * @details 前回から1秒だけ進んでいて、読み込みの間隔が EDGE_MAX_GAP_MS 以下なら境界とする。
+ *          間隔が空いた（ループが止まっていた）ときは次の境界を待つ。
+ */
+void RtcTimeCache::poll(uint32_t nowMs) {
+  uint32_t sec = 0;
+  reads++;
+  bool read = reader && reader(sec);
+  if (read) {
+    if (!valid) {
+      baseSec = sec;              // 境界が見つかるまでは、読んだ秒の中ほどとみなす
+      baseMs = nowMs - 500;
+      valid = true;
+    }
+    if (polled && (sec == lastSec + 1) && (nowMs - lastPollMs <= EDGE_MAX_GAP_MS)) {
+      onEdge(sec, lastPollMs + (nowMs - lastPollMs) / 2);
+      return;
+    }
+    polled = true;
+    lastSec = sec;
+    lastPollMs = nowMs;
+  }
+  if (nowMs - searchStartMs >= EDGE_TIMEOUT_MS) {
+    finishSearch(nowMs);
+  }
+}
+
+/**
+ * @brief 探すのをやめて次の再同期を待つ
+ * @param nowMs 現在のmillis()
+ */
+void RtcTimeCache::finishSearch(uint32_t nowMs) {
+  state = State::Idle;
+  polled = false;
+  nextResyncMs = nowMs + RESYNC_INTERVAL_MS;
+}
+
+/**
+ * @brief 秒の境界が見つかった
+ * @param sec 境界のあとの時刻
+ * @param edgeMs 境界のmillis()
+ */
+void RtcTimeCache::onEdge(uint32_t sec, uint32_t edgeMs) {
+  RtcSyncReport report = {};
+  report.unixtime = sec;
+  if (edgeBased) {
+    // それまでの基準では、秒 sec は baseMs + (sec - baseSec) × 1000 に始まるはずだった
+    int64_t expectedMs = static_cast<int64_t>(static_cast<int32_t>(baseMs - edgeMs))
+                       + (static_cast<int64_t>(sec) - static_cast<int64_t>(baseSec)) * 1000;
+    report.phaseErrorMs = static_cast<int32_t>(expectedMs);
+  }
+
+  if (!anchored) {
+    anchored = true;
+    anchorSec = sec;
+    anchorMs = edgeMs;
+  } else {
+    uint32_t cpuMs = edgeMs - anchorMs;
+    int64_t rtcMs = (static_cast<int64_t>(sec) - static_cast<int64_t>(anchorSec)) * 1000;
+    baselineS = cpuMs / 1000;
+    if (cpuMs >= DRIFT_MIN_BASELINE_MS) {
+      driftPpb = static_cast<int32_t>((rtcMs - static_cast<int64_t>(cpuMs)) * 1000000000LL / static_cast<int64_t>(cpuMs));
+      driftValid = true;
+    }
+    if (cpuMs >= DRIFT_REANCHOR_MS) {
+      anchorSec = sec;
+      anchorMs = edgeMs;
+    }
+  }
+  report.driftValid = driftValid;
+  report.driftPpb = driftPpb;
+  report.baselineS = baselineS;
+
+  baseSec = sec;
+  baseMs = edgeMs;
+  valid = true;
+  edgeBased = true;
+  finishSearch(edgeMs);
+
+  if (syncCallback) {
+    syncCallback(report);
+  }
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <functional>
+#include <mutex>
+
+/**
+ * @brief RTCを読み直したときの結果
+ */
+struct RtcSyncReport {
+  uint32_t unixtime;      // 秒の境界で読んだRTCの時刻（UNIX時間）
+  int32_t phaseErrorMs;   // それまでの推定と実際の境界の差[ms]（正：推定が遅れていた。最初は0）
+  bool driftValid;        // driftPpb が有効（基準の期間が DRIFT_MIN_BASELINE_MS 以上）
+  int32_t driftPpb;       // CPUの時計に対するRTCの進み[ppb]（正：RTCが速い）
+  uint32_t baselineS;     // 進みを求めた期間[s]
+};
+
+/**
+ * @brief RTCの時刻のキャッシュ
+ * - RTCは再同期のときだけ読み、あいだは最後に読んだ時刻をmillis()で延長する
+ * - 再同期では秒が変わる瞬間を探して読む（秒未満の位相がわかる）
+ * - 最初に境界を見つけてからの RTC と CPU の経過時間を比べ、RTCの進み（ドリフト）を推定する
+ *
+ * 使い方：begin() のあと、ループから update() を呼ぶ。now() は読み込みなしで時刻を返す。
+ * ループ以外のタスク（SNTPのコールバックなど）からは set() ではなく post() を使う。
+ */
+class RtcTimeCache {
+public:
+  using Reader = std::function<bool(uint32_t& unixtime)>;             // RTCを読む
+  using SyncCallback = std::function<void(const RtcSyncReport& report)>;  // 読み直した
+
+  static constexpr uint32_t RESYNC_INTERVAL_MS = 600000UL;      // 読み直す間隔（10分）
+  static constexpr uint32_t EDGE_POLL_MS = 10;                  // 秒の境界を探すときの読み込み間隔
+  static constexpr uint32_t EDGE_MAX_GAP_MS = 30;               // 読み込みの間隔がこれより空いた境界は使わない
+  static constexpr uint32_t EDGE_TIMEOUT_MS = 3000;             // 境界が見つからなければあきらめる
+  static constexpr uint32_t DRIFT_MIN_BASELINE_MS = 600000UL;   // 進みを求めるのに必要な期間（10分）
+  static constexpr uint32_t DRIFT_REANCHOR_MS = 0x7FFFFFFFUL;   // 基準を取り直す期間（millis()の桁あふれ前）
+
+  void begin(const Reader& reader, uint32_t nowMs);     // 最初の読み込みを始める
+  void update(uint32_t nowMs);                          // 再同期を進める
+  bool now(uint32_t nowMs, uint32_t& unixtime) const;   // 推定した現在の時刻
+  void set(uint32_t unixtime, uint32_t nowMs);          // RTCに時刻を設定した
+  void post(uint32_t unixtime, uint32_t nowMs);         // 別のタスクからRTCに時刻を設定した（次の update() で反映）
+  void requestResync(void) { resyncRequested.store(true, std::memory_order_release); }  // 次の update() で読み直す（別のタスクからも可）
+  void onResync(const SyncCallback& callback) { syncCallback = callback; }
+
+  bool isValid(void) const { return valid; }            // 時刻を推定できる
+  bool isSearching(void) const { return state == State::Searching; }   // 秒の境界を探している
+  bool isDriftValid(void) const { return driftValid; }
+  int32_t getDriftPpb(void) const { return driftPpb; }  // CPUの時計に対するRTCの進み[ppb]
+  uint32_t getBaselineS(void) const { return baselineS; }   // 進みを求めた期間[s]
+  uint32_t getReads(void) const { return reads; }       // RTCを読んだ回数
+
+private:
+  enum class State : uint8_t {
+    Idle,         // 次の再同期を待っている
+    Searching     // 秒の境界を探している
+  };
+
+  Reader reader;
+  SyncCallback syncCallback;
+  State state = State::Idle;
+  std::atomic<bool> resyncRequested{false};
+
+  std::mutex postMutex;         // posted* を守る
+  std::atomic<bool> setPosted{false};   // post() された時刻がある
+  uint32_t postedSec = 0;       // post() された時刻
+  uint32_t postedMs = 0;        // post() されたときのmillis()
+
+  bool valid = false;           // baseSec/baseMs が有効
+  bool edgeBased = false;       // baseMs が秒の境界で求めた値
+  uint32_t baseSec = 0;         // 基準の時刻
+  uint32_t baseMs = 0;          // 基準の時刻になったときのmillis()
+  uint32_t nextResyncMs = 0;    // 次に読み直すmillis()
+
+  uint32_t searchStartMs = 0;   // 境界を探し始めたmillis()
+  bool polled = false;          // 探し始めてから読めた
+  uint32_t lastSec = 0;         // 前回読んだ時刻
+  uint32_t lastPollMs = 0;      // 前回読んだmillis()
+
+  bool anchored = false;        // 進みを求める基準がある
+  uint32_t anchorSec = 0;       // 基準の境界の時刻
+  uint32_t anchorMs = 0;        // 基準の境界のmillis()
+  bool driftValid = false;
+  int32_t driftPpb = 0;
+  uint32_t baselineS = 0;
+  uint32_t reads = 0;
+
+  void startSearch(uint32_t nowMs);         // 秒の境界を探し始める
+  void poll(uint32_t nowMs);                // 境界を探して1回読む
+  void finishSearch(uint32_t nowMs);        // 探すのをやめて次の再同期を待つ
+  void onEdge(uint32_t sec, uint32_t edgeMs);   // 秒の境界が見つかった
+};
@@ -0,0 +1,136 @@
+/**
+ * @file SecondTick.cpp
+ * @brief RTCの1Hz矩形波（SQW）による秒の刻み
+ * @details
+ * 割り込みで記録した立ち下がりの時刻には、割り込みの入りの遅れ（ばらつき）が乗る。
+ * ループ側では次の境界を「直前の境界＋周期」で予測し、実際の立ち下がりとの差で
+ * 位相（差の1/4）と周期（差の1/32）を補正する（2次のPLL）。
+ * 予測から大きく外れた立ち下がりはノイズとして捨て、続けて外れたときだけ位相を取り直す。
+ * 立ち下がりが欠けたときは予測した境界で刻み、続けて欠けたら Software に戻す。
+ */
+#include "SecondTick.h"
+
+/**
+ * @brief 立ち下がりを記録する（割り込みから呼ぶ）
+ * @param edgeUs 立ち下がりの時刻（micros()）
+ */
+void TICK_ISR_ATTR SecondTick::captureEdge(uint32_t edgeUs) {
+  edgeAtUs.store(edgeUs, std::memory_order_relaxed);
+  edgeSeq.fetch_add(1, std::memory_order_release);
+}
+
+/**
+ * @brief 立ち下がりを処理する
+ * @param nowUs 現在のmicros()
+ * @return true 秒の境界（時刻は getTickUs()）。同期していないときは常に false
+ * @details 前回から複数の立ち下がりがあった場合は、最後の1つだけを使う。
+ */
+bool SecondTick::update(uint32_t nowUs) {
+  uint32_t seq = edgeSeq.load(std::memory_order_acquire);
+  if (seq != seenSeq) {
+    seenSeq = seq;
+    edges++;
+    lastEdgeUs = edgeAtUs.load(std::memory_order_relaxed);
+    flipPending = onEdge(lastEdgeUs);
+    return flipPending;
+  }
+  if (locked && (static_cast<int32_t>(nowUs - (nextUs() + MISS_GRACE_US)) >= 0)) {
+    missed++;
+    flipPending = false;          // 予測した境界で刻むときは遅れを記録しない
+    phaseUs = nextUs();           // 学習した周期で予測した境界で刻む
+    if (++missRun >= MISS_LIMIT) {
+      locked = false;             // SQWが途切れた
+      acquiring = false;
+      return false;
+    }
+    return true;
+  }
+  return false;
+}
+
+/**
+ * @brief 秒の境界で表示を切り替えた
+ * @param flipUs 表示を切り替えた時刻（micros()）
+ * @details update() が立ち下がりで true を返したあとの最初の呼び出しだけ、立ち下がりからの遅れを記録する。
+ */
+void SecondTick::recordFlip(uint32_t flipUs) {
+  if (!flipPending) {
+    return;
+  }
+  flipPending = false;
+  flipLatencyUs = flipUs - lastEdgeUs;
+  if (flipLatencyUs > maxFlipLatencyUs) {
+    maxFlipLatencyUs = flipLatencyUs;
+  }
+}
+
+/**
+ * @brief 境界でのシステム時刻の秒未満
+ * @param subUs 現在のシステム時刻の秒未満[us]
+ * @param nowUs 現在のmicros()
+ * @param edgeUs 境界のmicros()
+ * @return 境界でのシステム時刻の秒未満[us]（-500000～499999。0なら境界とシステム時刻の秒がそろっている）
+ */
+int32_t SecondTick::subSecondOffsetUs(uint32_t subUs, uint32_t nowUs, uint32_t edgeUs) {
+  const int64_t second = NOMINAL_US;
+  int64_t at = (static_cast<int64_t>(subUs) - static_cast<int64_t>(nowUs - edgeUs)) % second;
+  if (at < -second / 2) {
+    at += second;
+  } else if (at >= second / 2) {
+    at -= second;
+  }
+  return static_cast<int32_t>(at);
+}
+
+/**
+ * @brief 立ち下がりを位相同期に使う
+ * @param edgeUs 立ち下がりの時刻
+ * @return true 同期していて秒の境界
+ */
+bool SecondTick::onEdge(uint32_t edgeUs) {
+  if (!acquiring) {
+    restart(edgeUs);
+    return false;
+  }
+  int32_t err = static_cast<int32_t>(edgeUs - nextUs());
+  lastErrorUs = err;
+  uint32_t window = locked ? LOCK_WINDOW_US : ACQUIRE_WINDOW_US;
+  if (static_cast<uint32_t>(err < 0 ? -err : err) > window) {
+    if (!locked) {
+      restart(edgeUs);            // まだ同期していなければすぐに取り直す
+      return false;
+    }
+    glitches++;                   // ノイズとして捨てる
+    if (++outWindow >= RELOCK_EDGES) {
+      restart(edgeUs);            // RTCの時刻を設定したなど、位相が変わった
+    }
+    return false;
+  }
+
+  outWindow = 0;
+  missRun = 0;
+  phaseUs = nextUs() + err / (1 << PHASE_GAIN_SHIFT);
+  int64_t period = static_cast<int64_t>(periodQ8) + static_cast<int64_t>(err) * 256 / (1 << FREQ_GAIN_SHIFT);
+  const int64_t minPeriod = static_cast<int64_t>(NOMINAL_US - MAX_DEVIATION_US) << 8;
+  const int64_t maxPeriod = static_cast<int64_t>(NOMINAL_US + MAX_DEVIATION_US) << 8;
+  periodQ8 = static_cast<uint32_t>(period < minPeriod ? minPeriod : (period > maxPeriod ? maxPeriod : period));
+
+  if (!locked && (++inWindow >= LOCK_EDGES)) {
+    locked = true;
+  }
+  return locked;
+}
+
+/**
+ * @brief 位相を取り直す
+ * @param edgeUs 基準にする立ち下がりの時刻
+ * @details 周期は学習した値を残す。
+ */
+void SecondTick::restart(uint32_t edgeUs) {
+  acquiring = true;
+  locked = false;
+  phaseUs = edgeUs;
+  inWindow = 0;
+  outWindow = 0;
+  missRun = 0;
+}
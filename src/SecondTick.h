@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+#ifdef UNIT_TEST
+#define TICK_ISR_ATTR
+#else
+#include <esp_attr.h>
+#define TICK_ISR_ATTR IRAM_ATTR   // フラッシュ書き込み中も割り込みから呼べるようにIRAMに置く
+#endif
+
+/**
+ * @brief 秒の刻みの出どころ
+ */
+enum class SecondTickMode : uint8_t {
+  Software,     // システム時刻から求める（SQWを配線していない・途切れた）
+  Sqw           // RTCの1Hz矩形波（SQW）に同期している
+};
+
+/**
+ * @brief RTCの1Hz矩形波（SQW）による秒の刻み
+ * - 割り込みでは立ち下がりの時刻（micros()）を記録するだけ
+ * - ループ側で位相同期（PLL）し、割り込みの遅れのばらつきやノイズの影響を抑えた秒の境界を求める
+ * - 同期できるまで・SQWが途切れたときは Software に戻り、呼び出し側はシステム時刻から刻む
+ *
+ * 使い方：割り込みから captureEdge() を呼び、ループから update() を呼ぶ。update() が true を返したら秒の境界。
+ */
+class SecondTick {
+public:
+  static constexpr uint32_t NOMINAL_US = 1000000UL;     // 1秒[us]
+  static constexpr uint32_t MAX_DEVIATION_US = 500;     // 周期の許容範囲（±500ppm）
+  static constexpr uint32_t ACQUIRE_WINDOW_US = 100000; // 同期中でないときに同じ位相とみなす範囲
+  static constexpr uint32_t LOCK_WINDOW_US = 20000;     // 同期中に正しい立ち下がりとみなす範囲
+  static constexpr uint8_t LOCK_EDGES = 4;              // 続けて範囲に入ったら同期したとみなす数
+  static constexpr uint8_t RELOCK_EDGES = 3;            // 続けて範囲を外れたら位相を取り直す数
+  static constexpr uint32_t MISS_GRACE_US = 100000;     // 予測からこれだけ過ぎても来なければ欠けたとみなす
+  static constexpr uint8_t MISS_LIMIT = 3;              // 続けて欠けたら Software に戻す数
+  static constexpr uint8_t PHASE_GAIN_SHIFT = 2;        // 位相の補正量（誤差の1/4）
+  static constexpr uint8_t FREQ_GAIN_SHIFT = 5;         // 周期の補正量（誤差の1/32）
+
+  void TICK_ISR_ATTR captureEdge(uint32_t edgeUs);      // 立ち下がりを記録する（割り込みから呼ぶ）
+  bool update(uint32_t nowUs);                          // 立ち下がりを処理する（秒の境界なら true）
+
+  SecondTickMode getMode(void) const { return locked ? SecondTickMode::Sqw : SecondTickMode::Software; }
+  bool isLocked(void) const { return locked; }
+  uint32_t getTickUs(void) const { return phaseUs; }    // 直前の秒の境界（micros()の値）
+  uint32_t getPeriodUs(void) const { return periodQ8 >> 8; }   // 推定した周期[us]
+  int32_t getLastErrorUs(void) const { return lastErrorUs; }   // 直前の立ち下がりの予測との差[us]
+  uint32_t getEdges(void) const { return edges; }       // 処理した立ち下がりの数
+  uint32_t getGlitches(void) const { return glitches; } // 範囲外として捨てた立ち下がりの数
+  uint32_t getMissed(void) const { return missed; }     // 欠けた立ち下がりの数
+
+  void recordFlip(uint32_t flipUs);                     // 秒の境界で表示を切り替えた（立ち下がりからの遅れを記録する）
+  uint32_t getFlipLatencyUs(void) const { return flipLatencyUs; }       // 直前の立ち下がりから表示までの遅れ[us]
+  uint32_t getMaxFlipLatencyUs(void) const { return maxFlipLatencyUs; } // その最大値[us]
+  void resetMaxFlipLatency(void) { maxFlipLatencyUs = 0; }
+
+  static int32_t subSecondOffsetUs(uint32_t subUs, uint32_t nowUs, uint32_t edgeUs);  // 境界でのシステム時刻の秒未満（±0.5秒）
+
+private:
+  std::atomic<uint32_t> edgeSeq{0};   // 記録した立ち下がりの数（割り込みで増やす）
+  std::atomic<uint32_t> edgeAtUs{0};  // 最後の立ち下がりの時刻
+  uint32_t seenSeq = 0;               // 処理した edgeSeq
+
+  bool acquiring = false;         // 位相を合わせている（最初の立ち下がりを受けた）
+  bool locked = false;            // 同期している
+  uint32_t phaseUs = 0;           // 推定した直前の境界
+  uint32_t periodQ8 = NOMINAL_US << 8;  // 推定した周期[1/256us]
+  uint8_t inWindow = 0;           // 続けて範囲に入った数
+  uint8_t outWindow = 0;          // 続けて範囲を外れた数
+  uint8_t missRun = 0;            // 続けて欠けた数
+  int32_t lastErrorUs = 0;
+  uint32_t edges = 0;
+  uint32_t glitches = 0;
+  uint32_t missed = 0;
+  uint32_t lastEdgeUs = 0;        // 直前に処理した立ち下がり（割り込みで記録した時刻）
+  bool flipPending = false;       // 立ち下がりで刻み、まだ表示の切り替えを記録していない
+  uint32_t flipLatencyUs = 0;
+  uint32_t maxFlipLatencyUs = 0;
+
+  uint32_t nextUs(void) const { return phaseUs + (periodQ8 >> 8); }   // 次の境界の予測
+  bool onEdge(uint32_t edgeUs);   // 立ち下がりを位相同期に使う
+  void restart(uint32_t edgeUs);  // 位相を取り直す
+};
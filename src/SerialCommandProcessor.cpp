@@ -77,6 +77,7 @@ void SerialCommandProcessor::init(void)
 
   codeArray.push_back({"eepromdump" ,[this](){ return opecodeEepromDump(command); }, "eepromdump\tEEPROM Data dump."});
   codeArray.push_back({"i2cscan"    ,[this](){ return opecodeI2CScan(command); }, "i2cscan\tI2C Bus Device Scan."});
+  codeArray.push_back({"i2cstat"    ,[this](){ return opecodeI2CStat(command); }, "i2cstat [reset]\tI2C Bus Statistics."});
   codeArray.push_back({"wifiscan"   ,[this](){ return opecodeWiFiScan(command); }, "wifiscan\tWiFi Station SSID Scan."});
 
   codeArray.push_back({"getpr"      ,[this](){ return opecodeGetPr(command); }, "getpr [Pr number]\t"});  // ダミーコマンド
@@ -97,6 +98,10 @@ bool SerialCommandProcessor::exec(void)
 //  std::vector<std::string> command;     // シリアルモニタコマンド
   bool ret = true;
 
+  if(dumping){
+    return continueEepromDump();    // ダンプ中は入力を受け付けず、続きを出力する
+  }
+
   try {
     commandBuf = monitorIo_->rsv();
 
@@ -400,23 +405,41 @@ bool SerialCommandProcessor::opecodeEepromDump(std::vector<std::string> command)
   }
 
   if(eeprom) {
-    while(datalen > 0) {
-      uint16_t chunkSize = (datalen > 0x100) ? 0x100 : datalen;
-      std::string dump = eeprom->dumpEepromData(startAddress, chunkSize);
-      startAddress += chunkSize;
-      datalen -= chunkSize;
-      if(dump.empty()) {
-        monitorIo_->send("EEPROMダンプ失敗\n");
-        return false;
-      }
-      monitorIo_->send(dump);
-    }
-    return true;
+    // 32バイトずつ出力し、続きは次回以降のexec()で出力する（待たずにメインループへ戻る）
+    dumping = true;
+    dumpOk = true;
+    dumpOrigin = startAddress;
+    dumpNext = startAddress;
+    dumpEnd = startAddress + datalen;
+    return continueEepromDump();
   }
   monitorIo_->send("EEPROM未初期化\n");
   return false;
 }
 
+/**
+ * @brief EEPROMダンプの続きを出力する
+ * @return true 出力中または成功、false 読み込み失敗あり（最後に通知）
+ * @details
+ * exec()1回につき32バイト（2行）だけ出力するため、ダンプ中も表示やWiFiの処理は止まらない。
+ * 行は文字列を生成せず、行バッファのままシリアルへ出力する。
+ */
+bool SerialCommandProcessor::continueEepromDump(void) {
+  bool readOk;
+  dumpNext = eeprom->dumpEepromRow(dumpOrigin, dumpNext, dumpEnd,
+    [this](const char *line, size_t len) { monitorIo_->write(line, len); }, readOk);
+  dumpOk = dumpOk && readOk;
+
+  if(dumpNext < dumpEnd) {
+    return true;      // 続きあり
+  }
+  dumping = false;
+  if(!dumpOk) {
+    monitorIo_->send("EEPROMダンプ失敗\n");
+  }
+  return dumpOk;
+}
+
 /**
  * @brief I2Cスキャンコマンド処理
  * @param command コマンド引数
@@ -435,7 +458,17 @@ bool SerialCommandProcessor::opecodeI2CScan(std::vector<std::string> /*command*/
     std::vector<uint8_t> found = i2cBus->scanI2CBus();
     monitorIo_->send("Scanning...\n");
     for(auto addr : found) {
-      monitorIo_->send("Found device at 0x" + toHex(addr) + " : " + i2cBus->getDeviceName(addr) + "\n");
+      std::string line = "Found device at 0x" + toHex(addr) + " : " + i2cBus->getDeviceName(addr);
+      const I2CDeviceInfo* info = I2CDeviceRegistry::find(addr);
+      if(info) {    // 既知のデバイスは仕様と使用中の周波数を表示
+        line += " (" + std::string(I2CDeviceRegistry::kindName(info->kind))
+              + ", max " + std::to_string(info->maxClockHz / 1000) + "kHz, use " + std::to_string(i2cBus->getClock(addr) / 1000) + "kHz";
+        if(info->pageSize > 0) {
+          line += ", page " + std::to_string(info->pageSize);
+        }
+        line += ")";
+      }
+      monitorIo_->send(line + "\n");
     }
     if(found.empty()) {
       monitorIo_->send("No I2C devices found.\n");
@@ -449,6 +482,71 @@ bool SerialCommandProcessor::opecodeI2CScan(std::vector<std::string> /*command*/
   return false;
 }
 
+/**
+ * @brief I2C統計表示コマンド処理
+ * @param command コマンド引数（"reset"を指定すると統計をクリアする）
+ * @return true コマンド実行成功
+ * @return false コマンド実行失敗
+ * @details
+ * アドレスごとのトランザクション数・転送バイト数・NAK/エラー数・占有時間と占有時間の分布、
+ * バスのミューテックス待ち時間、スケジューラの統計を表示する。
+ */
+bool SerialCommandProcessor::opecodeI2CStat(std::vector<std::string> command) {
+  if(!i2cBus) {
+    monitorIo_->send("I2Cバス未初期化\n");
+    return false;
+  }
+  if(command.size() > 1 && command[1] == "reset") {
+    i2cBus->resetStats();
+    monitorIo_->send("I2C statistics reset.\n");
+    return true;
+  }
+
+  I2CDeviceStats devices[I2CBusStats::MAX_DEVICES];
+  size_t count = i2cBus->getDeviceStats(devices, I2CBusStats::MAX_DEVICES);
+  std::ostringstream oss;
+
+  oss << "ADDR      COUNT    BYTES    NAK   BUSY    ERR  AVGus  MAXus  NAME\n";
+  for(size_t i = 0; i < count; ++i) {
+    const I2CDeviceStats& dev = devices[i];
+    uint32_t avgUs = dev.transactions ? dev.totalUs / dev.transactions : 0;
+    oss << "0x" << toHex(dev.address)
+        << std::setw(9) << dev.transactions << std::setw(9) << dev.bytes
+        << std::setw(7) << dev.naks << std::setw(7) << dev.busy << std::setw(7) << dev.errors
+        << std::setw(7) << avgUs << std::setw(7) << dev.maxUs
+        << "  " << i2cBus->getDeviceName(dev.address) << "\n";
+  }
+  if(count == 0) {
+    oss << "No I2C transactions recorded.\n";
+  }
+  else {
+    oss << "latency[us]";
+    for(size_t b = 0; b < I2CDeviceStats::LATENCY_BUCKETS; ++b) {
+      uint32_t limit = I2CBusStats::bucketLimitUs(b);
+      oss << std::setw(7) << (limit ? "<" + std::to_string(limit) : ">=" + std::to_string(I2CBusStats::bucketLimitUs(b - 1)));
+    }
+    oss << "\n";
+    for(size_t i = 0; i < count; ++i) {
+      oss << "0x" << toHex(devices[i].address) << "       ";
+      for(size_t b = 0; b < I2CDeviceStats::LATENCY_BUCKETS; ++b) {
+        oss << std::setw(7) << devices[i].histogram[b];
+      }
+      oss << "\n";
+    }
+  }
+
+  I2CLockStats lock = i2cBus->getLockStats();
+  oss << "lock: acquisitions " << lock.acquisitions << ", contended " << lock.contended
+      << ", wait " << lock.totalWaitUs << "us (max " << lock.maxWaitUs << "us)\n";
+  I2CSchedulerStats sched = i2cBus->getScheduler().getStats();
+  oss << "scheduler: submitted " << sched.submitted << ", completed " << sched.completed
+      << ", rejected " << sched.rejected << ", deadline missed " << sched.deadlineMissed
+      << ", abandoned " << sched.abandoned << "\n";
+
+  monitorIo_->send(oss.str());
+  return true;
+}
+
 /**
  * @brief 1バイトの値を16進数表記の文字列に変換
  */
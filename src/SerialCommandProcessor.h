@@ -33,6 +33,7 @@ class MonitorDeviseIo{
     virtual ~MonitorDeviseIo(void) = 0;         // 純粋仮想デストラクタ
     virtual std::string rsv(void) = 0;          // 純粋仮想関数
     virtual uint8_t send(std::string data) = 0; // 純粋仮想関数
+    virtual uint8_t write(const char *data, size_t len) { return send(std::string(data, len)); }  // 文字列を生成せずに送信（実機は直接出力）
 };
 
 class codeTbl{
@@ -65,7 +66,9 @@ class SerialCommandProcessor{
     bool opecodeenv(std::vector<std::string> command);        // env　設定値表示
     bool opecodeVer(std::vector<std::string> command);        // バージョン表示
     bool opecodeEepromDump(std::vector<std::string> command);   // EEPROMダンプ
+    bool continueEepromDump(void);                              // EEPROMダンプの続き（exec()1回につき32バイト）
     bool opecodeI2CScan(std::vector<std::string> command);   // I2Cスキャン
+    bool opecodeI2CStat(std::vector<std::string> command);   // I2C統計表示
     bool opecodeWiFiScan(std::vector<std::string> command);   // WiFiスキャン
     bool opecodeGetPr(std::vector<std::string> command);      // Pr設定値取得
     bool opecodeSetPr(std::vector<std::string> command);      // Pr設定値設定
@@ -80,6 +83,13 @@ class SerialCommandProcessor{
     SystemManager *systemManager = nullptr; // SystemManagerの参照
 
     std::vector<std::string> command;         // シリアルモニタコマンド
+
+    // EEPROMダンプの途中経過（exec()ごとに続きを出力する）
+    bool dumping = false;                     // ダンプ中
+    bool dumpOk = true;                       // ここまで読み込みに成功した
+    uint16_t dumpOrigin = 0;                  // ダンプの開始アドレス
+    uint16_t dumpNext = 0;                    // 次に出力するアドレス
+    uint16_t dumpEnd = 0;                     // ダンプの終端（この手前まで）
     std::vector<codeTbl> codeArray;           // コードテーブル
 
     std::string toHex(uint8_t value) const;
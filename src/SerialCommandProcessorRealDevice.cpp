@@ -59,3 +59,16 @@ uint8_t RealMonitorDeviseIo::send(std::string data) {
 
   return ret;
 }
+
+/**
+ * @brief シリアル送信処理（文字列を生成せずに出力）
+ * 
+ * @param data 送信データ
+ * @param len 送信バイト数
+ * @return uint8_t 
+ */
+uint8_t RealMonitorDeviseIo::write(const char *data, size_t len) {
+  Serial.write(reinterpret_cast<const uint8_t *>(data), len);
+
+  return 0;
+}
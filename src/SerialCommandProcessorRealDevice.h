@@ -29,6 +29,7 @@ class RealMonitorDeviseIo : public MonitorDeviseIo {
     RealMonitorDeviseIo();
     std::string rsv(void) override;
     uint8_t send(std::string data) override;
+    uint8_t write(const char *data, size_t len) override;
 
   private:
     std::string buffer;
@@ -3,6 +3,7 @@
 #include "SystemManager.h"
 #include "parameterManager.h"
 #include "WiFiManager.h"
+#include "TimeZoneTable.h"
 
 /**
  * @brief 依存関係の初期化
@@ -36,6 +37,9 @@ void SystemManager::begin(void)    // 初期化処理
 
   wifiManager->withBoot();  // ブート時のWiFi接続要求
 
+  notifyBrightness();       // パラメータの輝度を表示に反映
+  notifyEffect();           // パラメータの表示効果を表示に反映
+
   return;
 }
 
@@ -137,6 +141,12 @@ void SystemManager::onParameterChanged(uint8_t index, uint8_t newValue) {
   if(index == static_cast<uint8_t>(ParamIndex::BrDig6)){ brDig[6] = newValue;}                        // Pr.14: 表示桁6の輝度
   if(index == static_cast<uint8_t>(ParamIndex::BrDig7)){ brDig[7] = newValue;}                        // Pr.15: 表示桁7の輝度
   if(index == static_cast<uint8_t>(ParamIndex::BrDig8)){ brDig[8] = newValue;}                        // Pr.16: 表示桁8の輝度
+  if((index == static_cast<uint8_t>(ParamIndex::DisplayEffect)) || (index == static_cast<uint8_t>(ParamIndex::FadeTime))){
+    notifyEffect();       // Pr.4-5: 表示効果の変更を表示に反映
+  }
+  if((index >= static_cast<uint8_t>(ParamIndex::GlowInTheBrightTmp)) && (index <= static_cast<uint8_t>(ParamIndex::BrDig8))){
+    notifyBrightness();   // Pr.6-16: 輝度の変更を表示に反映
+  }
 
   if(index == static_cast<uint8_t>(ParamIndex::NtpSet)){ ntpSet = (bool)newValue;}                    // Pr.32: SNTP設定：SNTP使用
   if(index == static_cast<uint8_t>(ParamIndex::TimeZoneAreaId)){ timeZoneAreaId = newValue;}          // Pr.33: SNTP設定：タイムゾーンエリアID
@@ -195,26 +205,27 @@ bool SystemManager::setParameterByKey(const std::string& key, int value) {
   return false; // 未対応のキー
 }
 */
+/**
+ * @brief タイムゾーン設定
+ * @param zoneData Pr.35（UTCからの差の選択肢）の値
+ * @return true 設定した、false 範囲外
+ * @details Pr.33/34（地域とタイムゾーン）を選んでいて、Pr.35 が Web画面がそのタイムゾーンと一緒に送る値であれば、
+ *          Pr.33/34 の規則（tzdata から作った夏時間を含む規則）を使う。そうでなければ Pr.35 のUTCからの差だけを使う。
+ *          Web画面は Pr.33, 34, 35 の順に送るため、Pr.35 の変更時には Pr.33/34 は新しい値になっている。
+ *          「～Summer」の選択肢も夏時間を含む同じ規則になり、夏時間は自動で切り替わる。
+ */
 bool SystemManager::setTimezone(uint8_t zoneData) {
-  const char* gmt[] = {
-  "GMT+12:00","GMT+11:00","GMT+10:00","GMT+09:30",
-  "GMT+09:00","GMT+08:00","GMT+07:00","GMT+06:00",
-  "GMT+05:00","GMT+04:00","GMT+03:30","GMT+03:00",
-  "GMT+02:00","GMT+01:00","GMT-00:00","GMT-01:00",
-  "GMT-02:00","GMT-03:00","GMT-03:30","GMT-04:00",
-  "GMT-04:30","GMT-05:00","GMT-05:30","GMT-05:45",
-  "GMT-06:00","GMT-06:30","GMT-07:00","GMT-08:00",
-  "GMT-08:30","GMT-08:45","GMT-09:00","GMT-09:30",
-  "GMT-10:00","GMT-10:30","GMT-11:00","GMT-12:00",
-  "GMT-12:45","GMT-13:00","GMT-14:00"
-  };
-
-  if (zoneData < sizeof(gmt) / sizeof(gmt[0])) {
-    std::cout << "Setting timezone to: " << gmt[zoneData] << "\n";
+  const TimeZoneRule* zone = TimeZoneTable::fromGmtIndex(zoneData);
+  const TimeZoneRule* byZone = TimeZoneTable::fromZoneId(timeZoneAreaId, timeZoneId);
+  if (byZone && (!zone || (TimeZoneTable::gmtIndexOf(timeZoneAreaId, timeZoneId) == zoneData))) {
+    zone = byZone;
+  }
 
-    const char* tz = gmt[zoneData];
-    const std::string& tzStr = std::string(tz);
-    timeManager->updateTimeZone(tzStr); // TimeManagerのupdateTimeZoneを呼び出す
+  if (zone) {
+    std::cout << "Setting timezone to: " << TimeZoneTable::posixTz(zone) << "\n";
+    if (timeManager) {
+      timeManager->updateTimeZone(zone);
+    }
     return true;
   }
   std::cout << "Invalid timezone data: " << static_cast<int>(zoneData) << "\n";
@@ -232,28 +243,67 @@ void SystemManager::setBrDig(uint8_t adj_point,uint8_t brw) // 輝度情報個
 {
   if((brw >= BR_MIN) && (brw<=BR_MAX)&&(adj_point<DISP_KETAMAX)){
     brDig[adj_point] = brw;
+    notifyBrightness();
   }
 
   return;
 }
 
 bool SystemManager::setParameterBrDig(void) {
+  uint8_t values[DISP_KETAMAX];
   for (uint8_t i = 0; i < DISP_KETAMAX; ++i) {
-    if (brDig[i] != 0) {
-      // パラメータの書き込み処理を実施
-      parameterManager->setParameter(8 + i, brDig[i]);
-    }
+    // 未設定の桁は現在の値のまま
+    values[i] = (brDig[i] != 0) ? brDig[i] : parameterManager->getParameter(8 + i);
   }
-  return true;
+  // 9桁分をまとめて書き込む
+  return parameterManager->setParameters(8, values, DISP_KETAMAX);
 }
 
 bool SystemManager::resetBrDig(void) {
   for (uint8_t i = 0; i < DISP_KETAMAX; ++i) {
     brDig[i] = parameterManager->getParameter(8 + i); // 輝度値をリセット
   }
+  notifyBrightness();
   return true;
 }
 
+/**
+ * @brief 輝度変更通知の登録
+ * @param callback 通知先（桁ごとの輝度 Pr.8-16、全体輝度 Pr.6）
+ */
+void SystemManager::onBrightnessChanged(BrightnessCallback callback) {
+  brightnessCallback = callback;
+  notifyBrightness();
+}
+
+/**
+ * @brief 輝度変更を通知する
+ * 明暗の切り替えは未実装のため、全体輝度は「明」（Pr.6）を使う。
+ */
+void SystemManager::notifyBrightness(void) {
+  if (brightnessCallback) {
+    brightnessCallback(brDig, glowInTheBrightTmp);
+  }
+}
+
+/**
+ * @brief 表示効果変更通知の登録
+ * @param callback 通知先（表示効果 Pr.4、クロスフェード時間 Pr.5）
+ */
+void SystemManager::onEffectChanged(EffectCallback callback) {
+  effectCallback = callback;
+  notifyEffect();
+}
+
+/**
+ * @brief 表示効果変更を通知する
+ */
+void SystemManager::notifyEffect(void) {
+  if (effectCallback) {
+    effectCallback(displayEffect, fadetimew);
+  }
+}
+
 std::string SystemManager::makeSettingJs(void) {
   std::string js = "var _initial_setting_ = \'{\\\n";
   
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include "SystemEvent.h"
 #include "WiFiManager.h"
 #include "TimeManager.h"
@@ -63,6 +64,11 @@ public:
 
   virtual void updateWiFiAutoConnect(void); // WiFi自動接続の更新
 
+  using BrightnessCallback = std::function<void(const uint8_t* brDig, uint8_t glow)>;
+  void onBrightnessChanged(BrightnessCallback callback);  // 輝度変更通知（VFDの輝度の表を作り直す）
+  using EffectCallback = std::function<void(uint8_t effect, uint8_t fadeTime)>;
+  void onEffectChanged(EffectCallback callback);          // 表示効果変更通知（VFDの切り替えの増分を求め直す）
+
   virtual std::string makeSettingJs(void);  // ./setting.jsを生成する
 
 private:
@@ -75,6 +81,10 @@ private:
   LedManager* ledManager = nullptr;                         // LED管理クラスへのポインタ
 
   bool ledPatternCtrl(void);              // LED表示パターン設定
+  BrightnessCallback brightnessCallback = nullptr;  // 輝度変更通知
+  void notifyBrightness(void);            // 輝度変更を通知する
+  EffectCallback effectCallback = nullptr;  // 表示効果変更通知
+  void notifyEffect(void);                // 表示効果変更を通知する
 
   bool format12h = false;                 // 時刻表示12/24 Pr.0と連動
   uint8_t dispFormat = 0;                 // 表示フォーマット設定 Pr.1と連動
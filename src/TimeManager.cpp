@@ -33,6 +33,39 @@ time_t TimeManager::getSystemTime() {
   return time(nullptr);
 }
 
+/**
+ * @brief システム時刻を取得（秒未満を含む）
+ * @param epoch UNIX時間の格納先
+ * @param subUs 秒未満[us]の格納先
+ * @return true: 取得成功
+ * @note 秒未満の値は、次の秒の境界を求めるために使う。
+ */
+bool TimeManager::readSystemTime(time_t& epoch, uint32_t& subUs) {
+  struct timeval tv;
+  if (gettimeofday(&tv, nullptr) != 0) {
+    return false;
+  }
+  epoch = tv.tv_sec;
+  subUs = (uint32_t)tv.tv_usec;
+  return true;
+}
+
+/**
+ * @brief UNIX時間をローカル時刻に変換
+ * @param t UNIX時間
+ * @param out ローカル時刻の格納先
+ * @note localtime()と違い、TZ・静的な領域・ロックを使わないため、どのタスクから呼んでもよい。
+ *       タイムゾーンの規則は表の中を指すポインタで、切り替えは1回の書き込みで済む。
+ */
+void TimeManager::toLocalTime(time_t t, struct tm& out) {
+  const TimeZoneRule* rule = zone.load(std::memory_order_acquire);
+  if (rule) {
+    LocalTime::toLocal(*rule, t, out);
+  } else {
+    LocalTime::toUtc(t, out);
+  }
+}
+
 /**
  * @brief システム時刻を取得
  * @return 現在のシステム時刻（struct tm形式）
@@ -40,10 +73,8 @@ time_t TimeManager::getSystemTime() {
  *       これを使用することで、システム時刻を簡単に取得することができる。
  */
 struct tm TimeManager::getSystemTimeStruct() {
-  time_t now;
-  time(&now);
   struct tm timeinfo;
-  localtime_r(&now, &timeinfo);
+  toLocalTime(time(nullptr), timeinfo);
 
   return timeinfo;
 }
@@ -52,6 +83,7 @@ struct tm TimeManager::getSystemTimeStruct() {
  * @brief RTC時刻を取得
  * @return 現在のRTC時刻（struct tm形式）
  * @note RTCは、リアルタイムクロックであり、システム時刻とは独立して動作する。
+ *       RTCManager::now()はキャッシュから推定するため、I2Cは使わない。
  */
 struct tm TimeManager::getRtcTimeStruct()
 {
@@ -74,18 +106,14 @@ struct tm TimeManager::getRtcTimeStruct()
 /**
  * @brief ローカル時刻を取得
  * @return 現在のローカル時刻（struct tm形式）
- * @note ローカル時刻は、システムのタイムゾーンに基づいて計算される。
- *       タイムゾーンは事前に設定されている必要がある。
- *       これを使用することで、ローカル時刻を簡単に取得することができる。
+ * @note ローカル時刻は、updateTimeZone()で設定したタイムゾーンに基づいて計算される。
+ *       タイムゾーンを設定していなければUTCになる。
  */
 struct tm TimeManager::getLocalTimeStruct()
 {
-  // 現在のUTC時刻を取得
-  time_t now = time(nullptr);
-
-  // JST（ローカル時刻）に変換
-  struct tm *local = localtime(&now);
-  return *local;
+  struct tm local;
+  toLocalTime(time(nullptr), local);
+  return local;
 }
 
 /**
@@ -97,6 +125,20 @@ struct tm TimeManager::getLocalTimeStruct()
 void TimeManager::setSystemTime(time_t t) {
     struct timeval tv = { .tv_sec = t, .tv_usec = 0 };
     settimeofday(&tv, nullptr);
+    notifyTimeChanged();
+}
+
+/**
+ * @brief システム時刻を少しずつ補正
+ * @param deltaUs 補正量[us]（正：進める）
+ * @note adjtime()で時計の進みを少し変えて補正するため、時刻は飛ばない。
+ *       前回の補正が残っていれば置き換える。
+ */
+void TimeManager::slewSystemTime(int32_t deltaUs) {
+  struct timeval delta;
+  delta.tv_sec = deltaUs / 1000000;
+  delta.tv_usec = deltaUs % 1000000;
+  adjtime(&delta, nullptr);
 }
 
 /**
@@ -104,33 +146,18 @@ void TimeManager::setSystemTime(time_t t) {
  * @param tz タイムゾーン情報
  * @note RTCから取得した時刻をシステム時刻として設定する。
  *       RTCは、RTCManagerクラスを使用して取得する。
+ *       RTCはUTCで持つため、mktime()のためにTZを切り替える必要はない。
  */
 void TimeManager::setSystemTimeFromRtc(struct timezone* tz)
 {
   if (!rtc) return;
   DateTime dt = rtc->now();
 
-  struct tm t_st;
-  t_st.tm_year = dt.year() - 1900;
-  t_st.tm_mon  = dt.month() - 1;
-  t_st.tm_mday = dt.day();
-  t_st.tm_hour = dt.hour();
-  t_st.tm_min  = dt.minute();
-  t_st.tm_sec  = dt.second();
-  t_st.tm_isdst = 0;
-
   timeval now;
-  char *oldtz = getenv("TZ");
-  setenv("TZ", "GMT0", 1);
-  tzset(); // Workaround for https://github.com/espressif/esp-idf/issues/11455
-  now.tv_sec = mktime(&t_st);
-  if (oldtz){
-    setenv("TZ", oldtz, 1);
-  } else {
-    unsetenv("TZ");
-  }
+  now.tv_sec = static_cast<time_t>(dt.unixtime());
   now.tv_usec = 0;
   settimeofday(&now, tz);
+  notifyTimeChanged();
 
   return;
 }
@@ -144,7 +171,7 @@ void TimeManager::setSystemTimeFromRtc(struct timezone* tz)
  * @param minute 分
  * @param second 秒
  * @note 手動でシステム時刻を設定するための関数である。
- *       引数には、年、月、日、時、分、秒を指定する。
+ *       引数には、ローカル時刻の年、月、日、時、分、秒を指定する。
  */
 void TimeManager::setSystemTimeFromManually(int year, int month, int day, int hour, int minute, int second) {
   struct tm t;
@@ -156,19 +183,20 @@ void TimeManager::setSystemTimeFromManually(int year, int month, int day, int ho
   t.tm_sec  = second;
   t.tm_isdst = 0;
 
-  setSystemTime(mktime(&t));
+  const TimeZoneRule* rule = zone.load(std::memory_order_acquire);
+  setSystemTime(static_cast<time_t>(rule ? LocalTime::fromLocal(*rule, t) : LocalTime::fromUtc(t)));
 
   return;
 }
 
 /**
  * @brief タイムゾーンを更新
- * @param tzParam タイムゾーンのパラメータ（例: "JST-9"）
- * @note タイムゾーンを更新するための関数である。
+ * @param zone タイムゾーンの規則（TimeZoneTableの表の中を指すこと。nullptrならUTC）
+ * @note libcのTZは変えない（SNTPの設定どおりUTCのまま）。
  */
-void TimeManager::updateTimeZone(const std::string& tzParam) {
-  setenv("TZ", tzParam.c_str(), 1);
-  tzset();
+void TimeManager::updateTimeZone(const TimeZoneRule* zone) {
+  this->zone.store(zone, std::memory_order_release);
+  notifyTimeChanged();
 
   return;
 }
@@ -194,7 +222,7 @@ void TimeManager::updateRTCFromSystemTime() {
 
   rtc->adjust(dt);
 
-  DateTime now = rtc->now();
+  DateTime now = rtc->readNow();    // キャッシュへの反映はループの update() で行うため、RTCから読む
   Serial.printf("RTC updated: %04d-%02d-%02d %02d:%02d:%02d\n",
                 now.year(), now.month(), now.day(),
                 now.hour(), now.minute(), now.second());
@@ -258,6 +286,7 @@ void TimeManager::SntpTimeSyncNotificationCallback(struct timeval *tv) {
   }
 
   if (s_instance) s_instance->updateRTCFromSystemTime();  // RTCに時刻を設定
+  if (s_instance) s_instance->notifyTimeChanged();        // 表示の時刻を読み直す
 
   return;
 }
@@ -265,3 +294,20 @@ void TimeManager::SntpTimeSyncNotificationCallback(struct timeval *tv) {
 void TimeManager::onSntpSync(std::function<void()> callback) {
   sntpSyncCallback = callback;
 }
+
+/**
+ * @brief 時刻・タイムゾーン変更コールバック関数を設定
+ * @param callback 時刻の設定、SNTP同期、タイムゾーンの変更のあとに呼ばれる
+ */
+void TimeManager::onTimeChanged(std::function<void()> callback) {
+  timeChangedCallback = callback;
+}
+
+/**
+ * @brief 時刻・タイムゾーンの変更を通知
+ */
+void TimeManager::notifyTimeChanged(void) {
+  if (timeChangedCallback) {
+    timeChangedCallback();
+  }
+}
@@ -9,6 +9,8 @@
 #include <functional>
 #include <sys/time.h> // struct timezoneを使用するために必要
 #include <string>
+#include <atomic>
+#include "LocalTime.h"
 
 #ifdef UNIT_TEST
 // ...モック定義...
@@ -21,7 +23,7 @@ class RTCManager{}; // RTCManagerの前方宣言（実際のRTCManagerクラス
 class AbstractTimeManager {
 public:
   virtual ~AbstractTimeManager() = default;
-  virtual void updateTimeZone(const std::string& tzParam) = 0;
+  virtual void updateTimeZone(const TimeZoneRule* zone) = 0;
   // 必要なら他の純粋仮想関数もここに追加
 };
 
@@ -30,27 +32,38 @@ public:
  * 
  * TimeManagerは、RTC（リアルタイムクロック）を使用してシステム時刻を管理するクラスである。
  * システム時刻の取得、設定、RTCとの同期、SNTP同期などの機能を提供する。
+ * ローカル時刻はタイムゾーンの規則（TimeZoneRule）から LocalTime で求め、libcのTZ・localtime()は使わない。
+ * システム時刻とRTCはUTCで持つ。
  */
 class TimeManager : public AbstractTimeManager {
 public:
   bool begin(RTCManager* rtcManager);         // RTCManagerの初期化
   time_t getSystemTime();                     // システム時刻を取得（UNIX時間）
+  bool readSystemTime(time_t& epoch, uint32_t& subUs);  // システム時刻を取得（UNIX時間と秒未満[us]）
+  void toLocalTime(time_t t, struct tm& out);           // UNIX時間をローカル時刻に変換
+  const TimeZoneRule* getTimeZone(void) const { return zone.load(std::memory_order_acquire); }  // タイムゾーンの規則（nullptrならUTC）
   struct tm getSystemTimeStruct();            // システム時刻を取得（struct tm形式）
   struct tm getRtcTimeStruct();               // RTC時刻を取得（struct tm形式）
   struct tm getLocalTimeStruct();             // ローカル時刻を取得（struct tm形式）
   void setSystemTime(time_t t);               // システム時刻を設定
+  void slewSystemTime(int32_t deltaUs);       // システム時刻を少しずつ補正
   void setSystemTimeFromRtc(struct timezone* tz);     // RTCからシステム時刻を設定
   void setSystemTimeFromManually(int year, int month, int day, int hour, int minute, int second); // 手動でシステム時刻を設定
   void updateRTCFromSystemTime();             // システム時刻をRTCに保存
-  virtual void updateTimeZone(const std::string& tzParam) override;    // タイムゾーンを更新
+  virtual void updateTimeZone(const TimeZoneRule* zone) override;     // タイムゾーンを更新
 
   void configureSNTP(void);                   // SNTP同期設定
   static void setInstance(TimeManager* inst); // インスタンス設定
   static void SntpTimeSyncNotificationCallback(struct timeval *tv);   // SNTP同期完了コールバック(system)
   void onSntpSync(std::function<void()> callback);                    // SNTP同期完了コールバック関数を設定
+  void onTimeChanged(std::function<void()> callback);                 // 時刻・タイムゾーン変更コールバック関数を設定
 private:
   RTCManager* rtc = nullptr;              // RTCManagerインスタンス
   static TimeManager* s_instance;         // シングルトンインスタンス
 
   std::function<void()> sntpSyncCallback; // SNTP同期完了コールバック関数
+  std::function<void()> timeChangedCallback;  // 時刻・タイムゾーン変更コールバック関数
+  std::atomic<const TimeZoneRule*> zone{nullptr};   // タイムゾーンの規則（nullptrならUTC）
+
+  void notifyTimeChanged(void);           // 時刻・タイムゾーンの変更を通知
 };
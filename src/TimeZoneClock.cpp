@@ -0,0 +1,89 @@
+/**
+ * @file TimeZoneClock.cpp
+ * @brief 次の切り替えを覚えておくローカル時刻の変換
+ * @details
+ * 夏時間の切り替えは年に2回なので、前後の年を含めた6回の切り替えを時刻の順に並べ、
+ * t を挟む2つを期間の始まりと終わりにする。t の年の前後を含めるため、年をまたぐ期間（南半球の夏時間など）も求まる。
+ * 夏時間のない規則は期間が無限になり、求め直すことはない。
+ */
+#include "TimeZoneClock.h"
+
+constexpr int64_t TimeZoneClock::NEVER;
+
+/**
+ * @brief UNIX時間をローカル時刻に変換
+ * @param zone タイムゾーンの規則（nullptrならUTC）
+ * @param t UNIX時間
+ * @param out ローカル時刻の格納先
+ */
+void TimeZoneClock::toLocal(const TimeZoneRule* zone, int64_t t, struct tm& out) {
+  const int32_t offset = utcOffset(zone, t);
+  LocalTime::toUtc(t + offset, out);
+  out.tm_isdst = dst ? 1 : 0;
+}
+
+/**
+ * @brief その時刻のUTCからの差
+ * @param zone タイムゾーンの規則（nullptrならUTC）
+ * @param t UNIX時間
+ * @return UTCからの差[s]
+ * @details 期間の中なら比較だけで返す。規則が変わった・期間を外れたときだけ求め直す。
+ */
+int32_t TimeZoneClock::utcOffset(const TimeZoneRule* zone, int64_t t) {
+  if (!valid || (zone != this->zone) || (t >= untilUtc) || (t < fromUtc)) {
+    refresh(zone, t);
+  }
+  return offsetS;
+}
+
+/**
+ * @brief t を含む期間を求める
+ * @param zone タイムゾーンの規則
+ * @param t UNIX時間
+ */
+void TimeZoneClock::refresh(const TimeZoneRule* zone, int64_t t) {
+  refreshes++;
+  this->zone = zone;
+  valid = true;
+  if (!zone || !zone->hasDst()) {
+    fromUtc = INT64_MIN;
+    untilUtc = NEVER;
+    offsetS = zone ? zone->stdOffsetS : 0;
+    nextOffsetS = offsetS;
+    dst = false;
+    return;
+  }
+
+  struct Transition {
+    int64_t at;       // 切り替えの時刻
+    bool toDst;       // 夏時間になる
+  };
+  Transition list[6];
+  struct tm local;
+  LocalTime::toUtc(t + zone->stdOffsetS, local);
+  const int32_t year = local.tm_year + 1900;
+  uint8_t count = 0;
+  for (int32_t y = year - 1; y <= year + 1; ++y) {
+    const Transition both[2] = {
+      {LocalTime::transitionAt(zone->dstStart, y, zone->stdOffsetS), true},
+      {LocalTime::transitionAt(zone->dstEnd, y, zone->dstOffsetS), false},
+    };
+    for (const Transition& add : both) {     // 時刻の順に挿入する
+      uint8_t i = count++;
+      for (; (i > 0) && (list[i - 1].at > add.at); --i) {
+        list[i] = list[i - 1];
+      }
+      list[i] = add;
+    }
+  }
+
+  uint8_t last = 0;               // t 以前の最後の切り替え（前の年の切り替えは必ず t より前）
+  while ((last + 1 < count) && (list[last + 1].at <= t)) {
+    last++;
+  }
+  fromUtc = list[last].at;
+  untilUtc = list[last + 1].at;   // 次の年の切り替えは必ず t より後
+  dst = list[last].toDst;
+  offsetS = dst ? zone->dstOffsetS : zone->stdOffsetS;
+  nextOffsetS = list[last + 1].toDst ? zone->dstOffsetS : zone->stdOffsetS;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <stdint.h>
+#include <time.h>
+#include "LocalTime.h"
+
+/**
+ * @brief 次の切り替えを覚えておくローカル時刻の変換
+ * - 今のUTCからの差が有効な期間（直前の切り替えから次の切り替えまで）を覚えておく
+ * - 期間の中なら、差を求めるのは時刻の比較だけで、夏時間の規則は計算し直さない
+ * - 次の切り替えの時刻（UNIX時間）ちょうどから、次の差に変わる
+ *
+ * 状態を持つため、1つのタスク（表示のループなど）からだけ使う。どのタスクからでも呼ぶ場合は LocalTime::toLocal() を使う。
+ */
+class TimeZoneClock {
+public:
+  static constexpr int64_t NEVER = INT64_MAX;   // 切り替えがない
+
+  void toLocal(const TimeZoneRule* zone, int64_t t, struct tm& out);   // UNIX時間をローカル時刻に変換（nullptrならUTC）
+  int32_t utcOffset(const TimeZoneRule* zone, int64_t t);              // その時刻のUTCからの差[s]
+
+  int64_t getNextTransition(void) const { return untilUtc; }   // 次の切り替えの時刻（なければ NEVER）
+  int32_t getNextOffset(void) const { return nextOffsetS; }    // 次の切り替えのあとのUTCからの差[s]
+  bool isDst(void) const { return dst; }                       // 今の期間は夏時間
+  uint32_t getRefreshes(void) const { return refreshes; }      // 期間を求め直した回数
+
+private:
+  const TimeZoneRule* zone = nullptr;   // 期間を求めた規則
+  bool valid = false;
+  int64_t fromUtc = 0;            // 期間の始まり（直前の切り替え）
+  int64_t untilUtc = 0;           // 期間の終わり（次の切り替え）
+  int32_t offsetS = 0;            // 期間のUTCからの差
+  int32_t nextOffsetS = 0;        // 次の切り替えのあとのUTCからの差
+  bool dst = false;
+  uint32_t refreshes = 0;
+
+  void refresh(const TimeZoneRule* zone, int64_t t);   // t を含む期間を求める
+};
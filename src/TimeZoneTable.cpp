@@ -0,0 +1,914 @@
+/**
+ * @file TimeZoneTable.cpp
+ * @brief Web画面で選べるタイムゾーンの表
+ * @details
+ * scripts/gen_timezone_table.py が生成する（直接編集しない）。tzdata 2025b
+ * webpack/src/infra/timezone.json・timezoneArea.json と同じ並びにする（Pr.33/34 はこの並びの番号）。
+ * 各タイムゾーンは tzdata の今の規則（TZifファイルの末尾の POSIX TZ）の番号を持ち、同じ規則は共有する。
+ * 「～Summer」の選択肢も同じタイムゾーンとし、夏時間は規則で切り替える。
+ * 表はすべて constexpr で、フラッシュに置かれる。
+ */
+#include "TimeZoneTable.h"
+
+namespace {
+
+// 規則（標準時のUTCからの差の順）
+constexpr TimeZoneRule RULES[] = {
+  {-43200, -43200, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   //  0: <-12>12
+  {-39600, -39600, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   //  1: <-11>11
+  {-36000, -36000, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   //  2: <-10>10
+  {-36000, -32400, { 3, 2, 0,   7200}, {11, 1, 0,   7200}},   //  3: HST10HDT,M3.2.0,M11.1.0
+  {-34200, -34200, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   //  4: <-0930>9:30
+  {-32400, -32400, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   //  5: <-09>9
+  {-32400, -28800, { 3, 2, 0,   7200}, {11, 1, 0,   7200}},   //  6: AKST9AKDT,M3.2.0,M11.1.0
+  {-28800, -28800, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   //  7: <-08>8
+  {-28800, -25200, { 3, 2, 0,   7200}, {11, 1, 0,   7200}},   //  8: PST8PDT,M3.2.0,M11.1.0
+  {-25200, -25200, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   //  9: MST7
+  {-25200, -21600, { 3, 2, 0,   7200}, {11, 1, 0,   7200}},   // 10: MST7MDT,M3.2.0,M11.1.0
+  {-21600, -21600, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   // 11: CST6
+  {-21600, -18000, { 3, 2, 0,   7200}, {11, 1, 0,   7200}},   // 12: CST6CDT,M3.2.0,M11.1.0
+  {-21600, -18000, { 9, 1, 6,  79200}, { 4, 1, 6,  79200}},   // 13: <-06>6<-05>,M9.1.6/22,M4.1.6/22
+  {-18000, -18000, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   // 14: EST5
+  {-18000, -14400, { 3, 2, 0,      0}, {11, 1, 0,   3600}},   // 15: CST5CDT,M3.2.0/0,M11.1.0/1
+  {-18000, -14400, { 3, 2, 0,   7200}, {11, 1, 0,   7200}},   // 16: EST5EDT,M3.2.0,M11.1.0
+  {-14400, -14400, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   // 17: <-04>4
+  {-14400, -10800, { 3, 2, 0,   7200}, {11, 1, 0,   7200}},   // 18: AST4ADT,M3.2.0,M11.1.0
+  {-14400, -10800, { 9, 1, 6,  86400}, { 4, 1, 6,  86400}},   // 19: <-04>4<-03>,M9.1.6/24,M4.1.6/24
+  {-12600, -12600, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   // 20: <-0330>3:30
+  {-12600,  -9000, { 3, 2, 0,   7200}, {11, 1, 0,   7200}},   // 21: NST3:30NDT,M3.2.0,M11.1.0
+  {-10800, -10800, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   // 22: <-03>3
+  {-10800,  -7200, { 3, 2, 0,   7200}, {11, 1, 0,   7200}},   // 23: <-03>3<-02>,M3.2.0,M11.1.0
+  { -7200,  -7200, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   // 24: <-02>2
+  { -7200,  -3600, { 3, 5, 0,  -3600}, {10, 5, 0,      0}},   // 25: <-02>2<-01>,M3.5.0/-1,M10.5.0/0
+  { -3600,  -3600, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   // 26: <-01>1
+  { -3600,      0, { 3, 5, 0,      0}, {10, 5, 0,   3600}},   // 27: <-01>1<+00>,M3.5.0/0,M10.5.0/1
+  {     0,      0, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   // 28: GMT0
+  {     0,   3600, { 3, 5, 0,   3600}, {10, 5, 0,   7200}},   // 29: WET0WEST,M3.5.0/1,M10.5.0
+  {  3600,      0, {10, 5, 0,   7200}, { 3, 5, 0,   3600}},   // 30: IST-1GMT0,M10.5.0,M3.5.0/1
+  {  3600,   3600, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   // 31: <+01>-1
+  {  3600,   7200, { 3, 5, 0,   7200}, {10, 5, 0,  10800}},   // 32: CET-1CEST,M3.5.0,M10.5.0/3
+  {  7200,   7200, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   // 33: CAT-2
+  {  7200,  10800, { 3, 4, 4,  93600}, {10, 5, 0,   7200}},   // 34: IST-2IDT,M3.4.4/26,M10.5.0
+  {  7200,  10800, { 3, 4, 4, 180000}, {10, 4, 4, 180000}},   // 35: EET-2EEST,M3.4.4/50,M10.4.4/50
+  {  7200,  10800, { 3, 5, 0,      0}, {10, 5, 0,      0}},   // 36: EET-2EEST,M3.5.0/0,M10.5.0/0
+  {  7200,  10800, { 3, 5, 0,   7200}, {10, 5, 0,  10800}},   // 37: EET-2EEST,M3.5.0,M10.5.0/3
+  {  7200,  10800, { 3, 5, 0,  10800}, {10, 5, 0,  14400}},   // 38: EET-2EEST,M3.5.0/3,M10.5.0/4
+  {  7200,  10800, { 4, 5, 5,      0}, {10, 5, 4,  86400}},   // 39: EET-2EEST,M4.5.5/0,M10.5.4/24
+  { 10800,  10800, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   // 40: EAT-3
+  { 12600,  12600, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   // 41: <+0330>-3:30
+  { 14400,  14400, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   // 42: <+04>-4
+  { 16200,  16200, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   // 43: <+0430>-4:30
+  { 18000,  18000, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   // 44: <+05>-5
+  { 19800,  19800, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   // 45: IST-5:30
+  { 20700,  20700, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   // 46: <+0545>-5:45
+  { 21600,  21600, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   // 47: <+06>-6
+  { 23400,  23400, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   // 48: <+0630>-6:30
+  { 25200,  25200, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   // 49: <+07>-7
+  { 28800,  28800, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   // 50: <+08>-8
+  { 30600,  30600, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   // 51: <+0830>-8:30
+  { 31500,  31500, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   // 52: <+0845>-8:45
+  { 32400,  32400, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   // 53: WIT-9
+  { 34200,  34200, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   // 54: ACST-9:30
+  { 34200,  37800, {10, 1, 0,   7200}, { 4, 1, 0,  10800}},   // 55: ACST-9:30ACDT,M10.1.0,M4.1.0/3
+  { 36000,  36000, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   // 56: <+10>-10
+  { 36000,  39600, {10, 1, 0,   7200}, { 4, 1, 0,  10800}},   // 57: AEST-10AEDT,M10.1.0,M4.1.0/3
+  { 37800,  37800, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   // 58: <+1030>-10:30
+  { 37800,  39600, {10, 1, 0,   7200}, { 4, 1, 0,   7200}},   // 59: <+1030>-10:30<+11>-11,M10.1.0,M4.1.0
+  { 39600,  39600, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   // 60: <+11>-11
+  { 39600,  43200, {10, 1, 0,   7200}, { 4, 1, 0,  10800}},   // 61: <+11>-11<+12>,M10.1.0,M4.1.0/3
+  { 43200,  43200, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   // 62: <+12>-12
+  { 43200,  46800, { 9, 5, 0,   7200}, { 4, 1, 0,  10800}},   // 63: NZST-12NZDT,M9.5.0,M4.1.0/3
+  { 45900,  45900, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   // 64: <+1245>-12:45
+  { 46800,  46800, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   // 65: <+13>-13
+  { 50400,  50400, { 0, 0, 0,      0}, { 0, 0, 0,      0}},   // 66: <+14>-14
+};
+
+// 規則の POSIX TZ（ログ用）
+constexpr const char* RULE_NAMES[] = {
+  "<-12>12",
+  "<-11>11",
+  "<-10>10",
+  "HST10HDT,M3.2.0,M11.1.0",
+  "<-0930>9:30",
+  "<-09>9",
+  "AKST9AKDT,M3.2.0,M11.1.0",
+  "<-08>8",
+  "PST8PDT,M3.2.0,M11.1.0",
+  "MST7",
+  "MST7MDT,M3.2.0,M11.1.0",
+  "CST6",
+  "CST6CDT,M3.2.0,M11.1.0",
+  "<-06>6<-05>,M9.1.6/22,M4.1.6/22",
+  "EST5",
+  "CST5CDT,M3.2.0/0,M11.1.0/1",
+  "EST5EDT,M3.2.0,M11.1.0",
+  "<-04>4",
+  "AST4ADT,M3.2.0,M11.1.0",
+  "<-04>4<-03>,M9.1.6/24,M4.1.6/24",
+  "<-0330>3:30",
+  "NST3:30NDT,M3.2.0,M11.1.0",
+  "<-03>3",
+  "<-03>3<-02>,M3.2.0,M11.1.0",
+  "<-02>2",
+  "<-02>2<-01>,M3.5.0/-1,M10.5.0/0",
+  "<-01>1",
+  "<-01>1<+00>,M3.5.0/0,M10.5.0/1",
+  "GMT0",
+  "WET0WEST,M3.5.0/1,M10.5.0",
+  "IST-1GMT0,M10.5.0,M3.5.0/1",
+  "<+01>-1",
+  "CET-1CEST,M3.5.0,M10.5.0/3",
+  "CAT-2",
+  "IST-2IDT,M3.4.4/26,M10.5.0",
+  "EET-2EEST,M3.4.4/50,M10.4.4/50",
+  "EET-2EEST,M3.5.0/0,M10.5.0/0",
+  "EET-2EEST,M3.5.0,M10.5.0/3",
+  "EET-2EEST,M3.5.0/3,M10.5.0/4",
+  "EET-2EEST,M4.5.5/0,M10.5.4/24",
+  "EAT-3",
+  "<+0330>-3:30",
+  "<+04>-4",
+  "<+0430>-4:30",
+  "<+05>-5",
+  "IST-5:30",
+  "<+0545>-5:45",
+  "<+06>-6",
+  "<+0630>-6:30",
+  "<+07>-7",
+  "<+08>-8",
+  "<+0830>-8:30",
+  "<+0845>-8:45",
+  "WIT-9",
+  "ACST-9:30",
+  "ACST-9:30ACDT,M10.1.0,M4.1.0/3",
+  "<+10>-10",
+  "AEST-10AEDT,M10.1.0,M4.1.0/3",
+  "<+1030>-10:30",
+  "<+1030>-10:30<+11>-11,M10.1.0,M4.1.0",
+  "<+11>-11",
+  "<+11>-11<+12>,M10.1.0,M4.1.0/3",
+  "<+12>-12",
+  "NZST-12NZDT,M9.5.0,M4.1.0/3",
+  "<+1245>-12:45",
+  "<+13>-13",
+  "<+14>-14",
+};
+
+// Pr.35 の値 → RULES の番号（UTCからの差だけ）
+constexpr uint8_t GMT_ZONES[] = {
+   0,   //  0: UTC-12:00
+   1,   //  1: UTC-11:00
+   2,   //  2: UTC-10:00
+   4,   //  3: UTC-09:30
+   5,   //  4: UTC-09:00
+   7,   //  5: UTC-08:00
+   9,   //  6: UTC-07:00
+  11,   //  7: UTC-06:00
+  14,   //  8: UTC-05:00
+  17,   //  9: UTC-04:00
+  20,   // 10: UTC-03:30
+  22,   // 11: UTC-03:00
+  24,   // 12: UTC-02:00
+  26,   // 13: UTC-01:00
+  28,   // 14: UTC+00:00
+  31,   // 15: UTC+01:00
+  33,   // 16: UTC+02:00
+  40,   // 17: UTC+03:00
+  41,   // 18: UTC+03:30
+  42,   // 19: UTC+04:00
+  43,   // 20: UTC+04:30
+  44,   // 21: UTC+05:00
+  45,   // 22: UTC+05:30
+  46,   // 23: UTC+05:45
+  47,   // 24: UTC+06:00
+  48,   // 25: UTC+06:30
+  49,   // 26: UTC+07:00
+  50,   // 27: UTC+08:00
+  51,   // 28: UTC+08:30
+  52,   // 29: UTC+08:45
+  53,   // 30: UTC+09:00
+  54,   // 31: UTC+09:30
+  56,   // 32: UTC+10:00
+  58,   // 33: UTC+10:30
+  60,   // 34: UTC+11:00
+  62,   // 35: UTC+12:00
+  64,   // 36: UTC+12:45
+  65,   // 37: UTC+13:00
+  66,   // 38: UTC+14:00
+};
+
+constexpr uint8_t NO_GMT = TimeZoneTable::NO_GMT;
+
+struct Zone {
+  uint8_t rule;     // RULES の番号
+  uint8_t gmt;      // Web画面が一緒に送る Pr.35 の値（Pr.35 にない差は NO_GMT）
+};
+
+// Africa（Pr.34 の値 - 1 の順）
+constexpr Zone AFRICA_ZONES[] = {
+  {28, 14},   // Africa000 Abidjan (Africa/Abidjan)
+  {28, 14},   // Africa001 Accra (Africa/Accra)
+  {28, 14},   // Africa002 Bamako (Africa/Bamako)
+  {28, 14},   // Africa003 Banjul (Africa/Banjul)
+  {28, 14},   // Africa004 Bissau (Africa/Bissau)
+  {28, 14},   // Africa005 Conakry (Africa/Conakry)
+  {28, 14},   // Africa006 Dakar (Africa/Dakar)
+  {28, 14},   // Africa007 Freetown (Africa/Freetown)
+  {28, 14},   // Africa008 Lome (Africa/Lome)
+  {28, 14},   // Africa009 Monrovia (Africa/Monrovia)
+  {28, 14},   // Africa010 Nouakchott (Africa/Nouakchott)
+  {28, 14},   // Africa011 Ouagadougou (Africa/Ouagadougou)
+  {28, 14},   // Africa012 Sao_Tome (Africa/Sao_Tome)
+  {31, 14},   // Africa013 Casablanca (Africa/Casablanca)
+  {31, 14},   // Africa014 El_Aaiun (Africa/El_Aaiun)
+  {31, 15},   // Africa015 Algiers (Africa/Algiers)
+  {32, 15},   // Africa016 Ceuta (Africa/Ceuta)
+  {32, 16},   // Africa017 CeutaSummer (Africa/Ceuta)
+  {31, 15},   // Africa018 Tunis (Africa/Tunis)
+  {31, 15},   // Africa019 Bangui (Africa/Bangui)
+  {31, 15},   // Africa020 Brazzaville (Africa/Brazzaville)
+  {31, 15},   // Africa021 Douala (Africa/Douala)
+  {31, 15},   // Africa022 Kinshasa (Africa/Kinshasa)
+  {31, 15},   // Africa023 Lagos (Africa/Lagos)
+  {31, 15},   // Africa024 Libreville (Africa/Libreville)
+  {31, 15},   // Africa025 Luanda (Africa/Luanda)
+  {31, 15},   // Africa026 Malabo (Africa/Malabo)
+  {31, 15},   // Africa027 Ndjamena (Africa/Ndjamena)
+  {31, 15},   // Africa028 Niamey (Africa/Niamey)
+  {31, 15},   // Africa029 Porto_Novo (Africa/Porto-Novo)
+  {33, 15},   // Africa030 Windhoek (Africa/Windhoek)
+  {33, 16},   // Africa031 WindhoekSummer (Africa/Windhoek)
+  {33, 16},   // Africa032 Blantyre (Africa/Blantyre)
+  {33, 16},   // Africa033 Bujumbura (Africa/Bujumbura)
+  {33, 16},   // Africa034 Gaborone (Africa/Gaborone)
+  {33, 16},   // Africa035 Harare (Africa/Harare)
+  {33, 16},   // Africa036 Kigali (Africa/Kigali)
+  {33, 16},   // Africa037 Lubumbashi (Africa/Lubumbashi)
+  {33, 16},   // Africa038 Lusaka (Africa/Lusaka)
+  {33, 16},   // Africa039 Maputo (Africa/Maputo)
+  {39, 16},   // Africa040 Cairo (Africa/Cairo)
+  {33, 16},   // Africa041 Tripoli (Africa/Tripoli)
+  {33, 16},   // Africa042 Johannesburg (Africa/Johannesburg)
+  {33, 16},   // Africa043 Maseru (Africa/Maseru)
+  {33, 16},   // Africa044 Mbabane (Africa/Mbabane)
+  {40, 17},   // Africa045 Addis_Ababa (Africa/Addis_Ababa)
+  {40, 17},   // Africa046 Asmera (Africa/Asmera)
+  {40, 17},   // Africa047 Dar_es_Salaam (Africa/Dar_es_Salaam)
+  {40, 17},   // Africa048 Djibouti (Africa/Djibouti)
+  {40, 17},   // Africa049 Kampala (Africa/Kampala)
+  {33, 17},   // Africa050 Khartoum (Africa/Khartoum)
+  {40, 17},   // Africa051 Mogadishu (Africa/Mogadishu)
+  {40, 17},   // Africa052 Nairobi (Africa/Nairobi)
+};
+
+// America（Pr.34 の値 - 1 の順）
+constexpr Zone AMERICA_ZONES[] = {
+  { 3,  2},   // America000 Adak (America/Adak)
+  { 6,  4},   // America001 Anchorage (America/Anchorage)
+  { 6,  5},   // America002 AnchorageSummer (America/Anchorage)
+  { 6,  4},   // America003 Juneau (America/Juneau)
+  { 6,  5},   // America004 JuneauSummer (America/Juneau)
+  { 6,  4},   // America005 Nome (America/Nome)
+  { 6,  5},   // America006 NomeSummer (America/Nome)
+  { 6,  4},   // America007 Yakutat (America/Yakutat)
+  { 6,  5},   // America008 YakutatSummer (America/Yakutat)
+  { 9,  5},   // America009 Dawson (America/Dawson)
+  { 9,  6},   // America010 DawsonSummer (America/Dawson)
+  { 8,  5},   // America011 Los_Angeles (America/Los_Angeles)
+  { 8,  6},   // America012 Los_AngelesSummer (America/Los_Angeles)
+  { 8,  5},   // America013 Tijuana (America/Tijuana)
+  { 8,  6},   // America014 TijuanaSummer (America/Tijuana)
+  { 8,  5},   // America015 Vancouver (America/Vancouver)
+  { 8,  6},   // America016 VancouverSummer (America/Vancouver)
+  { 9,  5},   // America017 Whitehorse (America/Whitehorse)
+  { 9,  6},   // America018 WhitehorseSummer (America/Whitehorse)
+  {10,  6},   // America019 Boise (America/Boise)
+  {10,  7},   // America020 BoiseSummer (America/Boise)
+  {11,  6},   // America021 Chihuahua (America/Chihuahua)
+  {11,  7},   // America022 ChihuahuaSummer (America/Chihuahua)
+  { 9,  6},   // America023 Dawson_Creek (America/Dawson_Creek)
+  {10,  6},   // America024 Denver (America/Denver)
+  {10,  7},   // America025 DenverSummer (America/Denver)
+  {10,  6},   // America026 Edmonton (America/Edmonton)
+  {10,  7},   // America027 EdmontonSummer (America/Edmonton)
+  { 9,  6},   // America028 Hermosillo (America/Hermosillo)
+  {10,  6},   // America029 Inuvik (America/Inuvik)
+  {10,  7},   // America030 InuvikSummer (America/Inuvik)
+  { 9,  6},   // America031 Mazatlan (America/Mazatlan)
+  { 9,  7},   // America032 MazatlanSummer (America/Mazatlan)
+  { 9,  6},   // America033 Phoenix (America/Phoenix)
+  {10,  6},   // America034 Shiprock (America/Shiprock)
+  {10,  7},   // America035 ShiprockSummer (America/Shiprock)
+  {10,  6},   // America036 Yellowknife (America/Yellowknife)
+  {10,  7},   // America037 YellowknifeSummer (America/Yellowknife)
+  {11,  7},   // America038 Belize (America/Belize)
+  {14,  7},   // America039 Cancun (America/Cancun)
+  {14,  8},   // America040 CancunSummer (America/Cancun)
+  {12,  7},   // America041 Chicago (America/Chicago)
+  {12,  8},   // America042 ChicagoSummer (America/Chicago)
+  {11,  7},   // America043 Costa_Rica (America/Costa_Rica)
+  {11,  7},   // America044 El_Salvador (America/El_Salvador)
+  {11,  7},   // America045 Guatemala (America/Guatemala)
+  {12,  7},   // America046 Indiana_Knox (America/Indiana/Knox)
+  {12,  8},   // America047 Indiana_KnoxSummer (America/Indiana/Knox)
+  {11,  7},   // America048 Managua (America/Managua)
+  {12,  7},   // America049 Menominee (America/Menominee)
+  {12,  8},   // America050 MenomineeSummer (America/Menominee)
+  {11,  7},   // America051 Merida (America/Merida)
+  {11,  8},   // America052 MeridaSummer (America/Merida)
+  {11,  7},   // America053 Mexico_City (America/Mexico_City)
+  {11,  8},   // America054 Mexico_CitySummer (America/Mexico_City)
+  {11,  7},   // America055 Monterrey (America/Monterrey)
+  {11,  8},   // America056 MonterreySummer (America/Monterrey)
+  {12,  7},   // America057 Rainy_River (America/Rainy_River)
+  {12,  8},   // America058 Rainy_RiverSummer (America/Rainy_River)
+  {12,  7},   // America059 Rankin_Inlet (America/Rankin_Inlet)
+  {12,  8},   // America060 Rankin_InletSummer (America/Rankin_Inlet)
+  {11,  7},   // America061 Regina (America/Regina)
+  {11,  7},   // America062 Tegucigalpa (America/Tegucigalpa)
+  {12,  7},   // America063 Winnipeg (America/Winnipeg)
+  {12,  8},   // America064 WinnipegSummer (America/Winnipeg)
+  {14,  8},   // America065 Bogota (America/Bogota)
+  {15,  8},   // America066 Havana (America/Havana)
+  {15,  9},   // America067 HavanaSummer (America/Havana)
+  {14,  8},   // America068 Guayaquil (America/Guayaquil)
+  {14,  8},   // America069 Cayman (America/Cayman)
+  {16,  8},   // America070 Detroit (America/Detroit)
+  {16,  9},   // America071 DetroitSummer (America/Detroit)
+  {16,  8},   // America072 Grand_Turk (America/Grand_Turk)
+  {16,  9},   // America073 Grand_TurkSummer (America/Grand_Turk)
+  {16,  8},   // America074 Indianapolis (America/Indianapolis)
+  {16,  9},   // America075 IndianapolisSummer (America/Indianapolis)
+  {16,  8},   // America076 Iqaluit (America/Iqaluit)
+  {16,  9},   // America077 IqaluitSummer (America/Iqaluit)
+  {14,  8},   // America078 Jamaica (America/Jamaica)
+  {16,  8},   // America079 Louisville (America/Louisville)
+  {16,  9},   // America080 LouisvilleSummer (America/Louisville)
+  {16,  8},   // America081 Montreal (America/Montreal)
+  {16,  9},   // America082 MontrealSummer (America/Montreal)
+  {16,  8},   // America083 Nassau (America/Nassau)
+  {16,  9},   // America084 NassauSummer (America/Nassau)
+  {16,  8},   // America085 New_York (America/New_York)
+  {16,  9},   // America086 New_YorkSummer (America/New_York)
+  {16,  8},   // America087 Nipigon (America/Nipigon)
+  {16,  9},   // America088 NipigonSummer (America/Nipigon)
+  {14,  8},   // America089 Panama (America/Panama)
+  {16,  8},   // America090 Pangnirtung (America/Pangnirtung)
+  {16,  9},   // America091 PangnirtungSummer (America/Pangnirtung)
+  {12,  8},   // America092 Resolute (America/Resolute)
+  {16,  8},   // America093 Thunder_Bay (America/Thunder_Bay)
+  {16,  9},   // America094 Thunder_BaySummer (America/Thunder_Bay)
+  {16,  8},   // America095 Toronto (America/Toronto)
+  {16,  9},   // America096 TorontoSummer (America/Toronto)
+  {14,  8},   // America097 Lima (America/Lima)
+  {17, NO_GMT},   // America098 Caracas (America/Caracas)
+  {17,  9},   // America099 Boa_Vista (America/Boa_Vista)
+  {17,  9},   // America100 Campo_Grande (America/Campo_Grande)
+  {17, 11},   // America101 Campo_GrandeSummer (America/Campo_Grande)
+  {17,  9},   // America102 Cuiaba (America/Cuiaba)
+  {17, 11},   // America103 CuiabaSummer (America/Cuiaba)
+  {14,  9},   // America104 Eirunepe (America/Eirunepe)
+  {17,  9},   // America105 Manaus (America/Manaus)
+  {17,  9},   // America106 Porto_Velho (America/Porto_Velho)
+  {14,  9},   // America107 Rio_Branco (America/Rio_Branco)
+  {17,  9},   // America108 Anguilla (America/Anguilla)
+  {17,  9},   // America109 Antigua (America/Antigua)
+  {17,  9},   // America110 Aruba (America/Aruba)
+  {17,  9},   // America111 Barbados (America/Barbados)
+  {17,  9},   // America112 Blanc_Sablon (America/Blanc-Sablon)
+  {17,  9},   // America113 Curacao (America/Curacao)
+  {17,  9},   // America114 Dominica (America/Dominica)
+  {18,  9},   // America115 Glace_Bay (America/Glace_Bay)
+  {18, 11},   // America116 Glace_BaySummer (America/Glace_Bay)
+  {18,  9},   // America117 Goose_Bay (America/Goose_Bay)
+  {18, 11},   // America118 Goose_BaySummer (America/Goose_Bay)
+  {17,  9},   // America119 Grenada (America/Grenada)
+  {17,  9},   // America120 Guadeloupe (America/Guadeloupe)
+  {18,  9},   // America121 Halifax (America/Halifax)
+  {18, 11},   // America122 HalifaxSummer (America/Halifax)
+  {17,  9},   // America123 Marigot (America/Marigot)
+  {17,  9},   // America124 Martinique (America/Martinique)
+  {18,  9},   // America125 Moncton (America/Moncton)
+  {18, 11},   // America126 MonctonSummer (America/Moncton)
+  {17,  9},   // America127 Montserrat (America/Montserrat)
+  {17,  9},   // America128 Puerto_Rico (America/Puerto_Rico)
+  {17,  9},   // America129 St_Kitts (America/St_Kitts)
+  {17,  9},   // America130 St_Lucia (America/St_Lucia)
+  {17,  9},   // America131 St_Thomas (America/St_Thomas)
+  {17,  9},   // America132 St_Vincent (America/St_Vincent)
+  {18,  9},   // America133 Thule (America/Thule)
+  {18, 11},   // America134 ThuleSummer (America/Thule)
+  {17,  9},   // America135 Tortola (America/Tortola)
+  {17,  9},   // America136 La_Paz (America/La_Paz)
+  {19,  9},   // America137 Santiago (America/Santiago)
+  {19, 11},   // America138 SantiagoSummer (America/Santiago)
+  {17,  9},   // America139 Guyana (America/Guyana)
+  {22,  9},   // America140 Asuncion (America/Asuncion)
+  {22, 11},   // America141 AsuncionSummer (America/Asuncion)
+  {21, 10},   // America142 St_Johns (America/St_Johns)
+  {21, NO_GMT},   // America143 St_JohnsSummer (America/St_Johns)
+  {22, 11},   // America144 Buenos_Aires (America/Buenos_Aires)
+  {22, 11},   // America145 Catamarca (America/Catamarca)
+  {22, 11},   // America146 Cordoba (America/Cordoba)
+  {22, 11},   // America147 Jujuy (America/Jujuy)
+  {22, 11},   // America148 Mendoza (America/Mendoza)
+  {22, 11},   // America149 Araguaina (America/Araguaina)
+  {22, 11},   // America150 Bahia (America/Bahia)
+  {22, 11},   // America151 Belem (America/Belem)
+  {22, 11},   // America152 Fortaleza (America/Fortaleza)
+  {22, 11},   // America153 Maceio (America/Maceio)
+  {22, 11},   // America154 Recife (America/Recife)
+  {22, 11},   // America155 Santarem (America/Santarem)
+  {22, 11},   // America156 Sao_Paulo (America/Sao_Paulo)
+  {22, 12},   // America157 Sao_PauloSummer (America/Sao_Paulo)
+  {22, 11},   // America158 Cayenne (America/Cayenne)
+  {23, 11},   // America159 Miquelon (America/Miquelon)
+  {23, 12},   // America160 MiquelonSummer (America/Miquelon)
+  {22, 11},   // America161 Paramaribo (America/Paramaribo)
+  {22, 11},   // America162 Montevido (America/Montevideo)
+  {22, 12},   // America163 MontevidoSummer (America/Montevideo)
+  {25, 11},   // America164 Godthab (America/Godthab)
+  {25, 12},   // America165 GodthabSummer (America/Godthab)
+  {24, 12},   // America166 Noronha (America/Noronha)
+  {25, 13},   // America167 Scoresbysund (America/Scoresbysund)
+  {25, 14},   // America168 ScoresbysundSummer (America/Scoresbysund)
+  {28, 14},   // America169 Danmarkshavn (America/Danmarkshavn)
+};
+
+// Antarctica（Pr.34 の値 - 1 の順）
+constexpr Zone ANTARCTICA_ZONES[] = {
+  {22,  9},   // Antarctica000 PalmerStation (Antarctica/Palmer)
+  {22, 11},   // Antarctica001 PalmerStationSummer (Antarctica/Palmer)
+  {22, 11},   // Antarctica002 RotheraResearchStation (Antarctica/Rothera)
+  {40, 17},   // Antarctica003 ShowaStation (Antarctica/Syowa)
+  {44, 21},   // Antarctica004 MawsonStation (Antarctica/Mawson)
+  {44, 24},   // Antarctica005 VostokStation (Antarctica/Vostok)
+  {49, 26},   // Antarctica006 DavisStation (Antarctica/Davis)
+  {50, 27},   // Antarctica007 CaseyStation (Antarctica/Casey)
+  {63, 35},   // Antarctica008 McMurdoStation (Antarctica/McMurdo)
+  {63, 37},   // Antarctica009 McMurdoStationSummer (Antarctica/McMurdo)
+};
+
+// Arctic（Pr.34 の値 - 1 の順）
+constexpr Zone ARCTIC_ZONES[] = {
+  {32, 15},   // Arctic000 Longyearbyen (Arctic/Longyearbyen)
+  {32, 16},   // Arctic001 LongyearbyenSummer (Arctic/Longyearbyen)
+};
+
+// Asia（Pr.34 の値 - 1 の順）
+constexpr Zone ASIA_ZONES[] = {
+  {40, 16},   // Asia000 Amman (Asia/Amman)
+  {40, 17},   // Asia001 AmmanSummer (Asia/Amman)
+  {36, 16},   // Asia002 Beirut (Asia/Beirut)
+  {36, 17},   // Asia003 BeirutSummer (Asia/Beirut)
+  {40, 16},   // Asia004 Damascus (Asia/Damascus)
+  {40, 17},   // Asia005 DamascusSummer (Asia/Damascus)
+  {35, 16},   // Asia006 Gaza (Asia/Gaza)
+  {38, 16},   // Asia007 Nicosia (Asia/Nicosia)
+  {38, 17},   // Asia008 NicosiaSummer (Asia/Nicosia)
+  {34, 16},   // Asia009 Jerusalem (Asia/Jerusalem)
+  {40, 17},   // Asia010 Aden (Asia/Aden)
+  {40, 17},   // Asia011 Baghdad (Asia/Baghdad)
+  {40, 17},   // Asia012 Bahrain (Asia/Bahrain)
+  {40, 17},   // Asia013 Kuwait (Asia/Kuwait)
+  {40, 17},   // Asia014 Qatar (Asia/Qatar)
+  {40, 17},   // Asia015 Riyadh (Asia/Riyadh)
+  {41, 18},   // Asia016 Tehran (Asia/Tehran)
+  {42, 19},   // Asia017 Yerevan (Asia/Yerevan)
+  {42, 21},   // Asia018 YerevanSummer (Asia/Yerevan)
+  {42, 19},   // Asia019 Baku (Asia/Baku)
+  {42, 21},   // Asia020 BakuSummer (Asia/Baku)
+  {42, 19},   // Asia021 Tbilisi (Asia/Tbilisi)
+  {42, 19},   // Asia022 Dubai (Asia/Dubai)
+  {42, 19},   // Asia023 Muscat (Asia/Muscat)
+  {43, 20},   // Asia024 Kabul (Asia/Kabul)
+  {44, 21},   // Asia025 Karachi (Asia/Karachi)
+  {44, 21},   // Asia026 Dushanbe (Asia/Dushanbe)
+  {44, 21},   // Asia027 Ashgabat (Asia/Ashgabat)
+  {44, 21},   // Asia028 Samarkand (Asia/Samarkand)
+  {44, 21},   // Asia029 Tashkent (Asia/Tashkent)
+  {44, 21},   // Asia030 Aqtau (Asia/Aqtau)
+  {44, 21},   // Asia031 Aqtobe (Asia/Aqtobe)
+  {44, 21},   // Asia032 Oral (Asia/Oral)
+  {44, 21},   // Asia033 Yekaterinbufg (Asia/Yekaterinburg)
+  {44, 24},   // Asia034 YekaterinbufgSummer (Asia/Yekaterinburg)
+  {45, 22},   // Asia035 Calcutta (Asia/Calcutta)
+  {45, 22},   // Asia036 Colombo (Asia/Colombo)
+  {46, 23},   // Asia037 Katmandu (Asia/Katmandu)
+  {47, 24},   // Asia038 Dhaka (Asia/Dhaka)
+  {47, 24},   // Asia039 Thimphu (Asia/Thimphu)
+  {44, 24},   // Asia040 Almaty (Asia/Almaty)
+  {44, 24},   // Asia041 Qyzylorda (Asia/Qyzylorda)
+  {47, 24},   // Asia042 Bishkek (Asia/Bishkek)
+  {49, 24},   // Asia043 Novosibirsk (Asia/Novosibirsk)
+  {49, 26},   // Asia044 NovosibirskSummer (Asia/Novosibirsk)
+  {47, 24},   // Asia045 Omsk (Asia/Omsk)
+  {47, 26},   // Asia046 OmskSummer (Asia/Omsk)
+  {48, 25},   // Asia047 Rangoon (Asia/Rangoon)
+  {49, 26},   // Asia048 Hovd (Asia/Hovd)
+  {49, 26},   // Asia049 Bangkok (Asia/Bangkok)
+  {49, 26},   // Asia050 Phnom_Penh (Asia/Phnom_Penh)
+  {49, 26},   // Asia051 Saigon (Asia/Saigon)
+  {49, 26},   // Asia052 Vientiane (Asia/Vientiane)
+  {49, 26},   // Asia053 Krasnoyarsk (Asia/Krasnoyarsk)
+  {49, 27},   // Asia054 KrasnoyarskSummer (Asia/Krasnoyarsk)
+  {49, 26},   // Asia055 Jakarta (Asia/Jakarta)
+  {49, 26},   // Asia056 Pontianak (Asia/Pontianak)
+  {50, 27},   // Asia057 Brunei (Asia/Brunei)
+  {50, 27},   // Asia058 Choibalsan (Asia/Choibalsan)
+  {50, 27},   // Asia059 Makassar (Asia/Makassar)
+  {50, 27},   // Asia060 Beijing (Asia/Shanghai)
+  {50, 27},   // Asia061 Chongqing (Asia/Chongqing)
+  {50, 27},   // Asia062 Harbin (Asia/Harbin)
+  {47, 27},   // Asia063 Kashgar (Asia/Kashgar)
+  {50, 27},   // Asia064 Macau (Asia/Macau)
+  {50, 27},   // Asia065 Shanghai (Asia/Shanghai)
+  {50, 27},   // Asia066 Taipei (Asia/Taipei)
+  {47, 27},   // Asia067 Urumqi (Asia/Urumqi)
+  {50, 27},   // Asia068 Hong_Kong (Asia/Hong_Kong)
+  {50, 27},   // Asia069 Irkutsk (Asia/Irkutsk)
+  {50, 30},   // Asia070 IrkutskSummer (Asia/Irkutsk)
+  {50, 27},   // Asia071 Kuala_Lumpur (Asia/Kuala_Lumpur)
+  {50, 27},   // Asia072 Kuching (Asia/Kuching)
+  {50, 27},   // Asia073 Manila (Asia/Manila)
+  {50, 27},   // Asia074 Singapore (Asia/Singapore)
+  {50, 27},   // Asia075 Ulaanbaatar (Asia/Ulaanbaatar)
+  {53, 30},   // Asia076 Jayapura (Asia/Jayapura)
+  {53, 30},   // Asia077 Osaka (Asia/Tokyo)
+  {53, 30},   // Asia078 Sapporo (Asia/Tokyo)
+  {53, 30},   // Asia079 Tokyo (Asia/Tokyo)
+  {53, 30},   // Asia080 Pyongyang (Asia/Pyongyang)
+  {53, 30},   // Asia081 Seoul (Asia/Seoul)
+  {53, 30},   // Asia082 Dili (Asia/Dili)
+  {53, 30},   // Asia083 Yakutsk (Asia/Yakutsk)
+  {53, 32},   // Asia084 YakutskSummer (Asia/Yakutsk)
+  {60, 32},   // Asia085 Sakhalin (Asia/Sakhalin)
+  {60, 34},   // Asia086 SakhalinSummer (Asia/Sakhalin)
+  {56, 32},   // Asia087 Vladivostok (Asia/Vladivostok)
+  {56, 34},   // Asia088 VladivostokSummer (Asia/Vladivostok)
+  {62, 34},   // Asia089 Anadyr (Asia/Anadyr)
+  {62, 35},   // Asia090 AnadyrSummer (Asia/Anadyr)
+  {62, 34},   // Asia091 Kamchatka (Asia/Kamchatka)
+  {62, 35},   // Asia092 KamchatkaSummer (Asia/Kamchatka)
+  {60, 34},   // Asia093 Magadan (Asia/Magadan)
+  {60, 35},   // Asia094 MagadanSummer (Asia/Magadan)
+};
+
+// Atlantic（Pr.34 の値 - 1 の順）
+constexpr Zone ATLANTIC_ZONES[] = {
+  {18,  9},   // Atlantic000 Bermuda (Atlantic/Bermuda)
+  {18, 11},   // Atlantic001 BermudaSummer (Atlantic/Bermuda)
+  {22,  9},   // Atlantic002 Stanley (Atlantic/Stanley)
+  {22, 11},   // Atlantic003 StanleySummer (Atlantic/Stanley)
+  {27, 13},   // Atlantic004 Azores (Atlantic/Azores)
+  {27, 14},   // Atlantic005 AzoresSummer (Atlantic/Azores)
+  {26, 13},   // Atlantic006 Cape_Verde (Atlantic/Cape_Verde)
+  {28, 14},   // Atlantic007 Reykjavik (Atlantic/Reykjavik)
+  {28, 14},   // Atlantic008 St_Helena (Atlantic/St_Helena)
+  {29, 14},   // Atlantic009 Canary (Atlantic/Canary)
+  {29, 15},   // Atlantic010 CanarySummer (Atlantic/Canary)
+  {29, 14},   // Atlantic011 Faeroe (Atlantic/Faeroe)
+  {29, 15},   // Atlantic012 FaeroeSummer (Atlantic/Faeroe)
+  {29, 14},   // Atlantic013 Madeira (Atlantic/Madeira)
+  {29, 15},   // Atlantic014 MadeiraSummer (Atlantic/Madeira)
+};
+
+// Australia（Pr.34 の値 - 1 の順）
+constexpr Zone AUSTRALIA_ZONES[] = {
+  {50, 27},   // Australia000 Perth (Australia/Perth)
+  {52, 29},   // Australia001 Eucla (Australia/Eucla)
+  {55, 31},   // Australia002 Adelaide (Australia/Adelaide)
+  {55, 33},   // Australia003 AdelaideSummer (Australia/Adelaide)
+  {54, 31},   // Australia004 Darwin (Australia/Darwin)
+  {56, 32},   // Australia005 Brisbane (Australia/Brisbane)
+  {57, 32},   // Australia006 Currie (Australia/Currie)
+  {57, 34},   // Australia007 CurrieSummer (Australia/Currie)
+  {57, 32},   // Australia008 Hobart (Australia/Hobart)
+  {57, 34},   // Australia009 HobartSummer (Australia/Hobart)
+  {56, 32},   // Australia010 Lindeman (Australia/Lindeman)
+  {57, 32},   // Australia011 Melbourne (Australia/Melbourne)
+  {57, 34},   // Australia012 MelbourneSummer (Australia/Melbourne)
+  {57, 32},   // Australia013 Sydney (Australia/Sydney)
+  {57, 34},   // Australia014 SydneySummer (Australia/Sydney)
+  {59, 33},   // Australia015 Lord_Howe (Australia/Lord_Howe)
+  {59, 34},   // Australia016 Lord_HoweSummer (Australia/Lord_Howe)
+};
+
+// Europe（Pr.34 の値 - 1 の順）
+constexpr Zone EUROPE_ZONES[] = {
+  {30, 14},   // Europe000 Dublin (Europe/Dublin)
+  {29, 14},   // Europe001 Guernsey (Europe/Guernsey)
+  {29, 14},   // Europe002 Isle_of_Man (Europe/Isle_of_Man)
+  {29, 14},   // Europe003 Jersey (Europe/Jersey)
+  {29, 14},   // Europe004 London (Europe/London)
+  {29, 14},   // Europe005 Lisbon (Europe/Lisbon)
+  {29, 15},   // Europe006 LisbonSummer (Europe/Lisbon)
+  {32, 15},   // Europe007 Amsterdam (Europe/Amsterdam)
+  {32, 16},   // Europe008 AmsterdamSummer (Europe/Amsterdam)
+  {32, 15},   // Europe009 Andorra (Europe/Andorra)
+  {32, 16},   // Europe010 AndorraSummer (Europe/Andorra)
+  {32, 15},   // Europe011 Belgrade (Europe/Belgrade)
+  {32, 16},   // Europe012 BelgradeSummer (Europe/Belgrade)
+  {32, 15},   // Europe013 Berlin (Europe/Berlin)
+  {32, 16},   // Europe014 BerlinSummer (Europe/Berlin)
+  {32, 15},   // Europe015 Bratislava (Europe/Bratislava)
+  {32, 16},   // Europe016 BratislavaSummer (Europe/Bratislava)
+  {32, 15},   // Europe017 Brussels (Europe/Brussels)
+  {32, 16},   // Europe018 BrusselsSummer (Europe/Brussels)
+  {32, 15},   // Europe019 Budapest (Europe/Budapest)
+  {32, 16},   // Europe020 BudapestSummer (Europe/Budapest)
+  {32, 15},   // Europe021 Copenhagen (Europe/Copenhagen)
+  {32, 16},   // Europe022 CopenhagenSummer (Europe/Copenhagen)
+  {32, 15},   // Europe023 Gibraltar (Europe/Gibraltar)
+  {32, 16},   // Europe024 GibraltarSummer (Europe/Gibraltar)
+  {32, 15},   // Europe025 Ljubljana (Europe/Ljubljana)
+  {32, 16},   // Europe026 LjubljanaSummer (Europe/Ljubljana)
+  {32, 15},   // Europe027 Luxembourg (Europe/Luxembourg)
+  {32, 16},   // Europe028 LuxembourgSummer (Europe/Luxembourg)
+  {32, 15},   // Europe029 Madrid (Europe/Madrid)
+  {32, 16},   // Europe030 MadridSummer (Europe/Madrid)
+  {32, 15},   // Europe031 Malta (Europe/Malta)
+  {32, 16},   // Europe032 MaltaSummer (Europe/Malta)
+  {32, 15},   // Europe033 Monaco (Europe/Monaco)
+  {32, 16},   // Europe034 MonacoSummer (Europe/Monaco)
+  {32, 15},   // Europe035 Oslo (Europe/Oslo)
+  {32, 16},   // Europe036 OsloSummer (Europe/Oslo)
+  {32, 15},   // Europe037 Paris (Europe/Paris)
+  {32, 16},   // Europe038 ParisSummer (Europe/Paris)
+  {32, 15},   // Europe039 Podgorica (Europe/Podgorica)
+  {32, 16},   // Europe040 PodgoricaSummer (Europe/Podgorica)
+  {32, 15},   // Europe041 Prague (Europe/Prague)
+  {32, 16},   // Europe042 PragueSummer (Europe/Prague)
+  {32, 15},   // Europe043 Rome (Europe/Rome)
+  {32, 16},   // Europe044 RomeSummer (Europe/Rome)
+  {32, 15},   // Europe045 San_Marino (Europe/San_Marino)
+  {32, 16},   // Europe046 San_MarinoSummer (Europe/San_Marino)
+  {32, 15},   // Europe047 Sarajevo (Europe/Sarajevo)
+  {32, 16},   // Europe048 SarajevoSummer (Europe/Sarajevo)
+  {32, 15},   // Europe049 Skopje (Europe/Skopje)
+  {32, 16},   // Europe050 SkopjeSummer (Europe/Skopje)
+  {32, 15},   // Europe051 Stockholm (Europe/Stockholm)
+  {32, 16},   // Europe052 StockholmSummer (Europe/Stockholm)
+  {32, 15},   // Europe053 Tirane (Europe/Tirane)
+  {32, 16},   // Europe054 TiraneSummer (Europe/Tirane)
+  {32, 15},   // Europe055 Vaduz (Europe/Vaduz)
+  {32, 16},   // Europe056 VaduzSummer (Europe/Vaduz)
+  {32, 15},   // Europe057 Vatican (Europe/Vatican)
+  {32, 16},   // Europe058 VaticanSummer (Europe/Vatican)
+  {32, 15},   // Europe059 Vienna (Europe/Vienna)
+  {32, 16},   // Europe060 ViennaSummer (Europe/Vienna)
+  {32, 15},   // Europe061 Warsaw (Europe/Warsaw)
+  {32, 16},   // Europe062 WarsawSummer (Europe/Warsaw)
+  {32, 15},   // Europe063 Zagreb (Europe/Zagreb)
+  {32, 16},   // Europe064 ZagrebSummer (Europe/Zagreb)
+  {32, 15},   // Europe065 Zurich (Europe/Zurich)
+  {32, 16},   // Europe066 ZurichSummer (Europe/Zurich)
+  {38, 16},   // Europe067 Athens (Europe/Athens)
+  {38, 17},   // Europe068 AthensSummer (Europe/Athens)
+  {38, 16},   // Europe069 Bucharest (Europe/Bucharest)
+  {38, 17},   // Europe070 BucharestSummer (Europe/Bucharest)
+  {37, 16},   // Europe071 Chisinau (Europe/Chisinau)
+  {37, 17},   // Europe072 ChisinauSummer (Europe/Chisinau)
+  {38, 16},   // Europe073 Helsinki (Europe/Helsinki)
+  {38, 17},   // Europe074 HelsinkiSummer (Europe/Helsinki)
+  {40, 16},   // Europe075 Istanbul (Europe/Istanbul)
+  {40, 17},   // Europe076 IstanbulSummer (Europe/Istanbul)
+  {33, 16},   // Europe077 Kaliningrad (Europe/Kaliningrad)
+  {33, 17},   // Europe078 KaliningradSummer (Europe/Kaliningrad)
+  {38, 16},   // Europe079 Kiev (Europe/Kiev)
+  {38, 17},   // Europe080 KievSummer (Europe/Kiev)
+  {38, 16},   // Europe081 Mariehamn (Europe/Mariehamn)
+  {38, 17},   // Europe082 MariehamnSummer (Europe/Mariehamn)
+  {40, 16},   // Europe083 Minsk (Europe/Minsk)
+  {40, 17},   // Europe084 MinskSummer (Europe/Minsk)
+  {38, 16},   // Europe085 Riga (Europe/Riga)
+  {38, 17},   // Europe086 RigaSummer (Europe/Riga)
+  {40, 16},   // Europe087 Simferopol (Europe/Simferopol)
+  {40, 17},   // Europe088 SimferopolSummer (Europe/Simferopol)
+  {38, 16},   // Europe089 Sofia (Europe/Sofia)
+  {38, 17},   // Europe090 SofiaSummer (Europe/Sofia)
+  {38, 16},   // Europe091 Tallinn (Europe/Tallinn)
+  {38, 17},   // Europe092 TallinnSummer (Europe/Tallinn)
+  {38, 16},   // Europe093 Uzhgorod (Europe/Uzhgorod)
+  {38, 17},   // Europe094 UzhgorodSummer (Europe/Uzhgorod)
+  {38, 16},   // Europe095 Vilnius (Europe/Vilnius)
+  {38, 17},   // Europe096 VilniusSummer (Europe/Vilnius)
+  {38, 16},   // Europe097 Zaporozhye (Europe/Zaporozhye)
+  {38, 17},   // Europe098 ZaporozhyeSummer (Europe/Zaporozhye)
+  {40, 17},   // Europe099 Moscow (Europe/Moscow)
+  {40, 19},   // Europe100 MoscowSummer (Europe/Moscow)
+  {42, 17},   // Europe101 Samara (Europe/Samara)
+  {42, 19},   // Europe102 SamaraSummer (Europe/Samara)
+  {40, 17},   // Europe103 Volgograd (Europe/Volgograd)
+  {40, 19},   // Europe104 VolgogradSummer (Europe/Volgograd)
+};
+
+// Indian（Pr.34 の値 - 1 の順）
+constexpr Zone INDIAN_ZONES[] = {
+  {40, 17},   // Indian000 Antananarivo (Indian/Antananarivo)
+  {40, 17},   // Indian001 Comoro (Indian/Comoro)
+  {40, 17},   // Indian002 Mayotte (Indian/Mayotte)
+  {42, 19},   // Indian003 Mauritius (Indian/Mauritius)
+  {42, 19},   // Indian004 Reunion (Indian/Reunion)
+  {42, 19},   // Indian005 Mahe (Indian/Mahe)
+  {44, 21},   // Indian006 Maldives (Indian/Maldives)
+  {44, 21},   // Indian007 Kerguelen (Indian/Kerguelen)
+  {47, 24},   // Indian008 Chagos (Indian/Chagos)
+  {48, 25},   // Indian009 Cocos (Indian/Cocos)
+  {49, 26},   // Indian010 Christmas (Indian/Christmas)
+};
+
+// Pacific（Pr.34 の値 - 1 の順）
+constexpr Zone PACIFIC_ZONES[] = {
+  { 1,  1},   // Pacific000 Niue (Pacific/Niue)
+  {65,  1},   // Pacific001 Apia (Pacific/Apia)
+  { 1,  1},   // Pacific002 Midway (Pacific/Midway)
+  { 1,  1},   // Pacific003 Pago_pago (Pacific/Pago_Pago)
+  { 2,  2},   // Pacific004 Rarotonga (Pacific/Rarotonga)
+  { 2,  2},   // Pacific005 Honolulu (Pacific/Honolulu)
+  { 2,  2},   // Pacific006 Johnston (Pacific/Johnston)
+  { 2,  2},   // Pacific007 Tahiti (Pacific/Tahiti)
+  {65,  2},   // Pacific008 Fakaofo (Pacific/Fakaofo)
+  { 4,  3},   // Pacific009 Marquesas (Pacific/Marquesas)
+  { 5,  4},   // Pacific010 Gambier (Pacific/Gambier)
+  { 7,  5},   // Pacific011 Pitcairn (Pacific/Pitcairn)
+  {13,  7},   // Pacific012 Easter (Pacific/Easter)
+  {13,  8},   // Pacific013 EasterSummer (Pacific/Easter)
+  {11,  7},   // Pacific014 Galapagos (Pacific/Galapagos)
+  {53, 30},   // Pacific015 Palau (Pacific/Palau)
+  {56, 32},   // Pacific016 Guam (Pacific/Guam)
+  {56, 32},   // Pacific017 Saipan (Pacific/Saipan)
+  {56, 32},   // Pacific018 Truk (Pacific/Truk)
+  {56, 32},   // Pacific019 Port_Moresby (Pacific/Port_Moresby)
+  {60, 34},   // Pacific020 Kosrae (Pacific/Kosrae)
+  {60, 34},   // Pacific021 Noumea (Pacific/Noumea)
+  {60, 34},   // Pacific022 Ponape (Pacific/Ponape)
+  {60, 34},   // Pacific023 Guadalcanal (Pacific/Guadalcanal)
+  {60, 34},   // Pacific024 Efate (Pacific/Efate)
+  {61, NO_GMT},   // Pacific025 Norfolk (Pacific/Norfolk)
+  {62, 35},   // Pacific026 Fiji (Pacific/Fiji)
+  {62, 35},   // Pacific027 Tarawa (Pacific/Tarawa)
+  {62, 35},   // Pacific028 Kwajalein (Pacific/Kwajalein)
+  {62, 35},   // Pacific029 Majuro (Pacific/Majuro)
+  {62, 35},   // Pacific030 Nauru (Pacific/Nauru)
+  {63, 35},   // Pacific031 Auckland (Pacific/Auckland)
+  {63, 37},   // Pacific032 AucklandSummer (Pacific/Auckland)
+  {62, 35},   // Pacific033 Funafuti (Pacific/Funafuti)
+  {62, 35},   // Pacific034 Wake (Pacific/Wake)
+  {62, 35},   // Pacific035 Wallis (Pacific/Wallis)
+  {65, 37},   // Pacific036 Enderbury (Pacific/Enderbury)
+  {65, 37},   // Pacific037 Tongatapu (Pacific/Tongatapu)
+  {66, 38},   // Pacific038 Kiritimati (Pacific/Kiritimati)
+};
+
+// AreaGMT は Pr.35 と同じ並び
+constexpr Zone AREA_GMT_ZONES[] = {
+  { 0,  0},   // AreaGMT000
+  { 1,  1},   // AreaGMT001
+  { 2,  2},   // AreaGMT002
+  { 4,  3},   // AreaGMT003
+  { 5,  4},   // AreaGMT004
+  { 7,  5},   // AreaGMT005
+  { 9,  6},   // AreaGMT006
+  {11,  7},   // AreaGMT007
+  {14,  8},   // AreaGMT008
+  {17,  9},   // AreaGMT009
+  {20, 10},   // AreaGMT010
+  {22, 11},   // AreaGMT011
+  {24, 12},   // AreaGMT012
+  {26, 13},   // AreaGMT013
+  {28, 14},   // AreaGMT014
+  {31, 15},   // AreaGMT015
+  {33, 16},   // AreaGMT016
+  {40, 17},   // AreaGMT017
+  {41, 18},   // AreaGMT018
+  {42, 19},   // AreaGMT019
+  {43, 20},   // AreaGMT020
+  {44, 21},   // AreaGMT021
+  {45, 22},   // AreaGMT022
+  {46, 23},   // AreaGMT023
+  {47, 24},   // AreaGMT024
+  {48, 25},   // AreaGMT025
+  {49, 26},   // AreaGMT026
+  {50, 27},   // AreaGMT027
+  {51, 28},   // AreaGMT028
+  {52, 29},   // AreaGMT029
+  {53, 30},   // AreaGMT030
+  {54, 31},   // AreaGMT031
+  {56, 32},   // AreaGMT032
+  {58, 33},   // AreaGMT033
+  {60, 34},   // AreaGMT034
+  {62, 35},   // AreaGMT035
+  {64, 36},   // AreaGMT036
+  {65, 37},   // AreaGMT037
+  {66, 38},   // AreaGMT038
+};
+
+struct Area {
+  const char* name;         // 地域名
+  const Zone* zones;        // タイムゾーンの並び
+  uint8_t count;            // タイムゾーンの数
+};
+
+// Pr.33 の値 → 地域
+constexpr Area AREAS[] = {
+  {"Africa", AFRICA_ZONES, sizeof(AFRICA_ZONES) / sizeof(Zone)},
+  {"America", AMERICA_ZONES, sizeof(AMERICA_ZONES) / sizeof(Zone)},
+  {"Antarctica", ANTARCTICA_ZONES, sizeof(ANTARCTICA_ZONES) / sizeof(Zone)},
+  {"Arctic", ARCTIC_ZONES, sizeof(ARCTIC_ZONES) / sizeof(Zone)},
+  {"Asia", ASIA_ZONES, sizeof(ASIA_ZONES) / sizeof(Zone)},
+  {"Atlantic", ATLANTIC_ZONES, sizeof(ATLANTIC_ZONES) / sizeof(Zone)},
+  {"Australia", AUSTRALIA_ZONES, sizeof(AUSTRALIA_ZONES) / sizeof(Zone)},
+  {"Europe", EUROPE_ZONES, sizeof(EUROPE_ZONES) / sizeof(Zone)},
+  {"Indian", INDIAN_ZONES, sizeof(INDIAN_ZONES) / sizeof(Zone)},
+  {"Pacific", PACIFIC_ZONES, sizeof(PACIFIC_ZONES) / sizeof(Zone)},
+  {"AreaGMT", AREA_GMT_ZONES, sizeof(AREA_GMT_ZONES) / sizeof(Zone)},
+};
+
+constexpr uint8_t RULE_COUNT = sizeof(RULES) / sizeof(RULES[0]);
+static_assert(sizeof(RULE_NAMES) / sizeof(RULE_NAMES[0]) == RULE_COUNT, "規則の名前の数");
+static_assert(sizeof(GMT_ZONES) == TimeZoneTable::GMT_COUNT, "Pr.35 の選択肢の数");
+static_assert(sizeof(AREAS) / sizeof(AREAS[0]) == TimeZoneTable::AREA_COUNT, "Pr.33 の選択肢の数");
+
+// Pr.33/34 のタイムゾーン（未選択・範囲外なら nullptr）
+const Zone* findZone(uint8_t areaId, uint8_t zoneId) {
+  if ((areaId >= TimeZoneTable::AREA_COUNT) || (zoneId == 0) || (zoneId > AREAS[areaId].count)) {
+    return nullptr;
+  }
+  return &AREAS[areaId].zones[zoneId - 1];
+}
+
+}  // namespace
+
+constexpr uint8_t TimeZoneTable::AREA_COUNT;
+constexpr uint8_t TimeZoneTable::GMT_COUNT;
+constexpr uint8_t TimeZoneTable::NO_GMT;
+
+/**
+ * @brief Pr.35（UTCからの差の選択肢）の規則
+ * @param index Pr.35 の値
+ * @return 規則（範囲外なら nullptr）
+ */
+const TimeZoneRule* TimeZoneTable::fromGmtIndex(uint8_t index) {
+  if (index >= GMT_COUNT) {
+    return nullptr;
+  }
+  return &RULES[GMT_ZONES[index]];
+}
+
+/**
+ * @brief Pr.33/34（地域とタイムゾーン）の規則
+ * @param areaId Pr.33 の値
+ * @param zoneId Pr.34 の値（1から。0は未選択）
+ * @return 規則（未選択・範囲外なら nullptr）
+ */
+const TimeZoneRule* TimeZoneTable::fromZoneId(uint8_t areaId, uint8_t zoneId) {
+  const Zone* zone = findZone(areaId, zoneId);
+  return zone ? &RULES[zone->rule] : nullptr;
+}
+
+/**
+ * @brief Web画面が Pr.33/34 と一緒に送る Pr.35 の値
+ * @param areaId Pr.33 の値
+ * @param zoneId Pr.34 の値
+ * @return Pr.35 の値（Pr.35 にない差・未選択・範囲外なら NO_GMT）
+ */
+uint8_t TimeZoneTable::gmtIndexOf(uint8_t areaId, uint8_t zoneId) {
+  const Zone* zone = findZone(areaId, zoneId);
+  if (!zone) {
+    return NO_GMT;
+  }
+  return zone->gmt;
+}
+
+/**
+ * @brief 地域のタイムゾーンの数
+ * @param areaId Pr.33 の値
+ * @return タイムゾーンの数（範囲外なら 0）
+ */
+uint8_t TimeZoneTable::zoneCount(uint8_t areaId) {
+  return (areaId < AREA_COUNT) ? AREAS[areaId].count : 0;
+}
+
+/**
+ * @brief 地域名
+ * @param areaId Pr.33 の値
+ * @return 地域名（範囲外なら ""）
+ */
+const char* TimeZoneTable::areaName(uint8_t areaId) {
+  return (areaId < AREA_COUNT) ? AREAS[areaId].name : "";
+}
+
+/**
+ * @brief 規則の POSIX TZ
+ * @param rule fromGmtIndex() / fromZoneId() が返した規則
+ * @return POSIX TZ（"CET-1CEST,M3.5.0,M10.5.0/3" など。表にない規則なら ""）
+ */
+const char* TimeZoneTable::posixTz(const TimeZoneRule* rule) {
+  for (uint8_t i = 0; i < RULE_COUNT; ++i) {
+    if (rule == &RULES[i]) {
+      return RULE_NAMES[i];
+    }
+  }
+  return "";
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <stdint.h>
+#include "LocalTime.h"
+
+/**
+ * @brief Web画面で選べるタイムゾーンの表
+ * - Pr.33（地域）・Pr.34（地域の中のタイムゾーン、1から）と、Pr.35（UTCからの差の選択肢）から規則を引く
+ * - 並びは webpack/src/infra/timezone.json・timezoneArea.json と同じ
+ * - Pr.33/34 の規則は tzdata から作り、夏時間を含む。Pr.35 の規則はUTCからの差だけ
+ * - 返す規則は表の中を指すので、呼び出し側は持ち続けてよい
+ *
+ * 実装（TimeZoneTable.cpp）は scripts/gen_timezone_table.py で生成して登録したもの（ビルドでは生成しない）。
+ */
+class TimeZoneTable {
+public:
+  static constexpr uint8_t AREA_COUNT = 11;   // Pr.33 の選択肢の数
+  static constexpr uint8_t GMT_COUNT = 39;    // Pr.35 の選択肢の数
+  static constexpr uint8_t NO_GMT = 0xFF;     // Pr.35 の選択肢にない差
+
+  static const TimeZoneRule* fromGmtIndex(uint8_t index);               // Pr.35 の規則
+  static const TimeZoneRule* fromZoneId(uint8_t areaId, uint8_t zoneId);  // Pr.33/34 の規則
+  static uint8_t gmtIndexOf(uint8_t areaId, uint8_t zoneId);            // Web画面が Pr.33/34 と一緒に送る Pr.35 の値
+  static uint8_t zoneCount(uint8_t areaId);   // 地域のタイムゾーンの数
+  static const char* areaName(uint8_t areaId);  // 地域名
+  static const char* posixTz(const TimeZoneRule* rule);   // 規則の POSIX TZ（ログ用）
+};
@@ -0,0 +1,107 @@
+/**
+ * @file VfdDriver.cpp
+ * @brief VFDのダイナミック点灯（ハードウェアタイマ割り込み）
+ * @details
+ * タイマは1MHz（1カウント=1us）で止めずに数え続け、割り込みのたびに次の時刻を設定する。
+ * 時刻は前回の設定値に足すため、割り込みの入りが遅れても桁の周期とフレーム周期はずれない。
+ * 点灯（Show）はラッチとブランク解除だけで、シフトはその後（次の割り込みまでの間）に済ませておく。
+ * Arduinoのタイマ関数は割り込みから呼べないため、ESP-IDFのタイマドライバの割り込み用APIを使う。
+ */
+#include <Arduino.h>
+#include <soc/gpio_reg.h>
+#include "Config.h"
+#include "VfdDriver.h"
+
+#define VFD_TIMER_GROUP TIMER_GROUP_1   // IRリモート・Arduinoのタイマと重ならないようにグループ1を使う
+#define VFD_TIMER_INDEX TIMER_1
+#define VFD_TIMER_DIVIDER 80            // APBクロック80MHz → 1MHz
+
+#define VFD_PIN_HIGH(pin) REG_WRITE(GPIO_OUT_W1TS_REG, 1UL << (pin))
+#define VFD_PIN_LOW(pin)  REG_WRITE(GPIO_OUT_W1TC_REG, 1UL << (pin))
+
+static_assert(VFD_DIN_PIN < 32 && VFD_CLK_PIN < 32 && VFD_LOAD_PIN < 32 && VFD_BLANK_PIN < 32,
+              "VFD pins must be GPIO0-31 (written through GPIO_OUT_W1TS_REG)");
+static_assert(VfdRenderer::GRID_SHIFT + VfdRenderer::DIGITS <= VFD_SHIFT_BITS,
+              "VFD word does not fit the driver shift register");
+
+VfdDriver::VfdDriver(VfdRenderer& renderer)
+  : renderer(renderer)
+{
+}
+
+/**
+ * @brief 端子を設定してタイマを開始する
+ * @return true 成功、false タイマの初期化に失敗
+ */
+bool VfdDriver::begin(void) {
+  pinMode(VFD_DIN_PIN, OUTPUT);
+  pinMode(VFD_CLK_PIN, OUTPUT);
+  pinMode(VFD_LOAD_PIN, OUTPUT);
+  pinMode(VFD_BLANK_PIN, OUTPUT);
+  digitalWrite(VFD_BLANK_PIN, HIGH);    // 最初の桁を送るまで消灯
+  digitalWrite(VFD_LOAD_PIN, LOW);
+  digitalWrite(VFD_CLK_PIN, LOW);
+
+  timer_config_t config = {};
+  config.divider = VFD_TIMER_DIVIDER;
+  config.counter_dir = TIMER_COUNT_UP;
+  config.counter_en = TIMER_PAUSE;
+  config.alarm_en = TIMER_ALARM_EN;
+  config.auto_reload = TIMER_AUTORELOAD_DIS;  // 時刻は割り込みで足していく
+  config.intr_type = TIMER_INTR_LEVEL;
+  if (timer_init(VFD_TIMER_GROUP, VFD_TIMER_INDEX, &config) != ESP_OK) {
+    return false;
+  }
+
+  alarmUs = VfdRenderer::SLOT_US;
+  timer_set_counter_value(VFD_TIMER_GROUP, VFD_TIMER_INDEX, 0);
+  timer_set_alarm_value(VFD_TIMER_GROUP, VFD_TIMER_INDEX, alarmUs);
+  timer_enable_intr(VFD_TIMER_GROUP, VFD_TIMER_INDEX);
+  if (timer_isr_callback_add(VFD_TIMER_GROUP, VFD_TIMER_INDEX, &VfdDriver::onAlarm, this, ESP_INTR_FLAG_IRAM) != ESP_OK) {
+    return false;
+  }
+  return timer_start(VFD_TIMER_GROUP, VFD_TIMER_INDEX) == ESP_OK;
+}
+
+/**
+ * @brief タイマ割り込み
+ * @param arg VfdDriver
+ * @return false（タスクの切り替えは不要）
+ */
+bool IRAM_ATTR VfdDriver::onAlarm(void* arg) {
+  VfdDriver* self = static_cast<VfdDriver*>(arg);
+  VfdDrive drive;
+  uint32_t durationUs = self->renderer.step(drive);
+
+  if (drive.phase == VfdPhase::Show) {
+    VFD_PIN_HIGH(VFD_LOAD_PIN);         // 送っておいた内容をラッチして点灯
+    VFD_PIN_LOW(VFD_LOAD_PIN);
+    VFD_PIN_LOW(VFD_BLANK_PIN);
+  } else {
+    VFD_PIN_HIGH(VFD_BLANK_PIN);        // 消灯
+  }
+  if (drive.shift) {
+    self->shiftOut(drive.preload);      // 次にラッチする内容を送っておく（ラッチまで出力は変わらない）
+  }
+
+  self->alarmUs += durationUs;
+  timer_group_set_alarm_value_in_isr(VFD_TIMER_GROUP, VFD_TIMER_INDEX, self->alarmUs);
+  timer_group_enable_alarm_in_isr(VFD_TIMER_GROUP, VFD_TIMER_INDEX);
+  return false;
+}
+
+/**
+ * @brief シフトレジスタへ送る（最上位ビットから）
+ * @param word 送るデータ（VFD_SHIFT_BITSビット）
+ */
+void IRAM_ATTR VfdDriver::shiftOut(uint32_t word) {
+  for (int bit = VFD_SHIFT_BITS - 1; bit >= 0; --bit) {
+    if (word & (1UL << bit)) {
+      VFD_PIN_HIGH(VFD_DIN_PIN);
+    } else {
+      VFD_PIN_LOW(VFD_DIN_PIN);
+    }
+    VFD_PIN_HIGH(VFD_CLK_PIN);
+    VFD_PIN_LOW(VFD_CLK_PIN);
+  }
+}
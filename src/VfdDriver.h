@@ -0,0 +1,23 @@
+#pragma once
+
+#include <driver/timer.h>
+#include "VfdRenderer.h"
+
+/**
+ * @brief VFDドライバ（シフトレジスタ方式の高耐圧ドライバ）
+ * - ハードウェアタイマの割り込みで VfdRenderer::step() を呼び、桁を順に点灯する
+ * - 次の割り込みは前回の設定時刻に足して設定する（割り込みの遅れが積み重ならない）
+ * - 割り込みはIRAMで動き、GPIOはレジスタを直接書く（フラッシュ書き込み中も表示を続ける）
+ */
+class VfdDriver {
+public:
+  explicit VfdDriver(VfdRenderer& renderer);
+  bool begin(void);     // 端子を設定してタイマを開始する
+
+private:
+  VfdRenderer& renderer;
+  uint64_t alarmUs = 0;     // 最後に設定した割り込みの時刻[us]（タイマのカウント値）
+
+  static bool onAlarm(void* arg);
+  void shiftOut(uint32_t word);
+};
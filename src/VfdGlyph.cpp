@@ -0,0 +1,7 @@
+/**
+ * @file VfdGlyph.cpp
+ * @brief VFDの字形表
+ */
+#include "VfdGlyph.h"
+
+constexpr uint8_t VfdGlyph::glyphs[];
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief VFD（7セグメント＋ドット）の字形表
+ * ASCII 0x20～0x7Fの文字を、セグメントのビットパターンに変換する。
+ * コンパイル時に確定する定数表のため、起動時の初期化と動的メモリ確保がない。
+ *
+ *      a
+ *    f   b
+ *      g
+ *    e   c
+ *      d   dp
+ */
+class VfdGlyph {
+public:
+  static constexpr uint8_t SEG_A  = 0x01;
+  static constexpr uint8_t SEG_B  = 0x02;
+  static constexpr uint8_t SEG_C  = 0x04;
+  static constexpr uint8_t SEG_D  = 0x08;
+  static constexpr uint8_t SEG_E  = 0x10;
+  static constexpr uint8_t SEG_F  = 0x20;
+  static constexpr uint8_t SEG_G  = 0x40;
+  static constexpr uint8_t SEG_DP = 0x80;
+
+  static constexpr uint8_t FIRST = 0x20;    // 表の先頭の文字
+  static constexpr uint8_t COUNT = 96;      // 表の文字数（0x20～0x7F）
+  static constexpr uint8_t glyphs[COUNT] = {
+    //  sp     !     "     #     $     %     &     '     (     )     *     +     ,     -     .     /
+      0x00, 0x86, 0x22, 0x00, 0x6D, 0x00, 0x00, 0x20, 0x39, 0x0F, 0x63, 0x00, 0x80, 0x40, 0x80, 0x52,
+    //   0     1     2     3     4     5     6     7     8     9     :     ;     <     =     >     ?
+      0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F, 0x00, 0x00, 0x00, 0x48, 0x00, 0x53,
+    //   @     A     B     C     D     E     F     G     H     I     J     K     L     M     N     O
+      0x00, 0x77, 0x7C, 0x39, 0x5E, 0x79, 0x71, 0x3D, 0x76, 0x30, 0x1E, 0x75, 0x38, 0x55, 0x37, 0x3F,
+    //   P     Q     R     S     T     U     V     W     X     Y     Z     [     \     ]     ^     _
+      0x73, 0x67, 0x50, 0x6D, 0x78, 0x3E, 0x3E, 0x2A, 0x76, 0x6E, 0x5B, 0x39, 0x64, 0x0F, 0x23, 0x08,
+    //   `     a     b     c     d     e     f     g     h     i     j     k     l     m     n     o
+      0x02, 0x5F, 0x7C, 0x58, 0x5E, 0x7B, 0x71, 0x6F, 0x74, 0x10, 0x0E, 0x75, 0x30, 0x55, 0x54, 0x5C,
+    //   p     q     r     s     t     u     v     w     x     y     z     {     |     }     ~   DEL
+      0x73, 0x67, 0x50, 0x6D, 0x78, 0x1C, 0x1C, 0x2A, 0x76, 0x6E, 0x5B, 0x39, 0x30, 0x0F, 0x01, 0x00,
+  };
+
+  /**
+   * @brief 文字の字形を取得する
+   * @param c 文字
+   * @return セグメントのビットパターン（表にない文字は空白）
+   */
+  static constexpr uint8_t of(char c) {
+    return (static_cast<uint8_t>(c) >= FIRST && static_cast<uint8_t>(c) < FIRST + COUNT)
+           ? glyphs[static_cast<uint8_t>(c) - FIRST] : 0x00;
+  }
+
+  /**
+   * @brief 数字の字形を取得する
+   * @param n 数値（0～9）
+   * @return セグメントのビットパターン（範囲外は空白）
+   */
+  static constexpr uint8_t digit(uint8_t n) {
+    return (n < 10) ? glyphs['0' - FIRST + n] : 0x00;
+  }
+};
+
+static_assert(VfdGlyph::of('8') == 0x7F, "glyph '8' must light segments a-g");
+static_assert(VfdGlyph::of('.') == VfdGlyph::SEG_DP, "glyph '.' must be the decimal point");
+static_assert(VfdGlyph::digit(0) == VfdGlyph::of('0'), "digit() must share the ASCII table");
@@ -0,0 +1,291 @@
+/**
+ * @file VfdRenderer.cpp
+ * @brief VFDのダイナミック点灯の描画エンジン
+ */
+#include <string.h>
+#include "VfdRenderer.h"
+
+/**
+ * @brief 輝度の段階→明るさ（ガンマ2.2、0～255）
+ * 段階が等間隔に明るくなって見えるように、点灯時間を曲線で割り当てる。
+ */
+const uint8_t VfdRenderer::GAMMA[LEVEL_MAX + 1] = {
+  0, 1, 3, 7, 14, 23, 34, 48, 64, 83, 105, 129, 156, 186, 219, 255
+};
+
+/**
+ * @brief 進み具合→新しい表示の割合（smoothstep、0～256）
+ * 切り替えの始めと終わりをゆっくりにする。割り込みから読むためRAMに置く。
+ */
+VFD_ISR_DATA const uint16_t VfdRenderer::RAMP[(PROGRESS_FULL >> RAMP_SHIFT) + 1] = {
+    0,   1,   3,   6,  11,  17,  24,  31,  40,  49,  59,  70,  81,  92, 104, 116,
+  128, 140, 152, 164, 175, 186, 197, 207, 216, 225, 232, 239, 245, 250, 253, 255,
+  256
+};
+
+VfdRenderer::VfdRenderer(void)
+  : front(0), pending(NO_PAGE),
+    digit(DIGITS - 1), stage(Stage::First),     // 最初の割り込みで先頭の桁を送る
+    progress(PROGRESS_FULL)
+{
+  memset(&work, 0, sizeof(work));
+  for (uint8_t i = 0; i < DIGITS; ++i) {
+    work.onUs[i] = static_cast<uint8_t>(MIN_ON_US);
+  }
+  work.effect = VfdEffect::None;
+  work.fadeStep = PROGRESS_FULL;
+  last = work;
+  pages[0] = work;
+  pages[1] = work;
+  memset(&plan, 0, sizeof(plan));
+}
+
+/**
+ * @brief 表示を消す
+ * 輝度はそのまま。present()を呼ぶまで表示は変わらない。
+ */
+void VfdRenderer::clear(void) {
+  memset(work.segments, 0, sizeof(work.segments));
+}
+
+/**
+ * @brief 桁のセグメントを設定する
+ * @param digit 桁（0：左端）
+ * @param segments セグメントのビットパターン（VfdGlyph::SEG_*）
+ */
+void VfdRenderer::setSegments(uint8_t digit, uint8_t segments) {
+  if (digit < DIGITS) {
+    work.segments[digit] = segments;
+  }
+}
+
+/**
+ * @brief 桁のセグメントを取得する
+ * @param digit 桁（0：左端）
+ * @return 描画中のセグメントのビットパターン（範囲外は0）
+ */
+uint8_t VfdRenderer::getSegments(uint8_t digit) const {
+  return (digit < DIGITS) ? work.segments[digit] : 0;
+}
+
+/**
+ * @brief 文字列を表示する
+ * @param text 文字列
+ * @param start 書き始める桁
+ * @return 書き込んだ桁数
+ * @details '.' は直前の桁のドットにする（先頭や連続した '.' は1桁使う）。
+ * 桁からはみ出した文字は捨てる。
+ */
+uint8_t VfdRenderer::setText(const char* text, uint8_t start) {
+  uint8_t pos = start;
+  bool dotFree = false;   // 直前の桁のドットが空いている
+  for (const char* p = text; (p != nullptr) && (*p != '\0'); ++p) {
+    if ((*p == '.') && dotFree) {
+      work.segments[pos - 1] |= VfdGlyph::SEG_DP;
+      dotFree = false;
+      continue;
+    }
+    if (pos >= DIGITS) {
+      break;
+    }
+    work.segments[pos++] = VfdGlyph::of(*p);
+    dotFree = (*p != '.');
+  }
+  return static_cast<uint8_t>(pos - start);
+}
+
+/**
+ * @brief 輝度の表を作り直す
+ * @param brDig 桁ごとの輝度（DIGITS個、Pr.8～16）
+ * @param glow 全体輝度[%]（Pr.6/7）
+ */
+void VfdRenderer::setBrightness(const uint8_t* brDig, uint8_t glow) {
+  for (uint8_t i = 0; i < DIGITS; ++i) {
+    work.onUs[i] = static_cast<uint8_t>(onTimeUs(brDig[i], glow));
+  }
+}
+
+/**
+ * @brief 切り替えの効果と時間を設定する
+ * @param effect 効果（Pr.4、VfdEffect にない値は効果なし）
+ * @param fadeTime 切り替え時間（Pr.5、FADE_UNIT_MS 単位、0：即時）
+ */
+void VfdRenderer::setEffect(uint8_t effect, uint8_t fadeTime) {
+  work.effect = (effect <= static_cast<uint8_t>(VfdEffect::Scroll)) ? static_cast<VfdEffect>(effect) : VfdEffect::None;
+  work.fadeStep = fadeStep(fadeTime);
+}
+
+/**
+ * @brief 桁の点灯時間を取得する
+ * @param digit 桁（0：左端）
+ * @return 描画中の点灯時間[us]（範囲外は0）
+ */
+uint32_t VfdRenderer::getOnTimeUs(uint8_t digit) const {
+  return (digit < DIGITS) ? work.onUs[digit] : 0;
+}
+
+/**
+ * @brief 描画した内容を次のフレームから表示する
+ * @details 割り込みが読んでいない方のページに書き写して、次のフレームの先頭で切り替えてもらう。
+ * 先に予約を取り消すので、書き写している間に割り込みがそのページへ切り替えることはない。
+ * 表示が変わったときは、前回の内容を切り替え前として持たせて切り替えを始める。
+ * 変わっていなければ切り替え中の状態を引き継ぐ（輝度・効果だけの変更で切り替えをやり直さない）。
+ */
+void VfdRenderer::present(void) {
+  bool cancelled = (pending.exchange(NO_PAGE) != NO_PAGE);  // 未反映の予約を取り消す（以降 front は変わらない）
+  if (memcmp(work.segments, last.segments, sizeof(work.segments)) != 0) {
+    memcpy(work.from, last.segments, sizeof(work.from));
+    work.restart = true;
+  } else {
+    memcpy(work.from, last.from, sizeof(work.from));
+    work.restart = cancelled && last.restart;   // 取り消した予約の切り替えを引き継ぐ
+  }
+  last = work;
+
+  uint8_t back = front.load() ^ 1;
+  pages[back] = work;
+  pending.store(back);
+}
+
+/**
+ * @brief 割り込み1回分の出力を作る
+ * @param drive 出力（Show：点灯 / Blank：消灯して次の桁を送る）
+ * @return 次の割り込みまでの時間[us]
+ * @details 1桁につき Show（クロスフェード中は2回）と Blank。Show の合計が点灯時間で、
+ * Blank までを含めた合計は常に SLOT_US。効果によらず1回の処理量は一定で、ループしない。
+ */
+uint32_t VFD_ISR_ATTR VfdRenderer::step(VfdDrive& drive) {
+  const Page* page = &pages[front.load(std::memory_order_relaxed)];
+  uint32_t onUs = page->onUs[digit];
+
+  if (stage == Stage::Blanked) {               // 送っておいた内容を点灯
+    stage = Stage::First;
+    drive.phase = VfdPhase::Show;
+    drive.word = gridBit(digit) | plan.first;
+    drive.shift = plan.split;                  // 分けるときは2回目の内容を送っておく
+    drive.preload = gridBit(digit) | plan.second;
+    return plan.split ? plan.firstUs : onUs;
+  }
+  if ((stage == Stage::First) && plan.split) {  // 2回目の点灯（クロスフェード）
+    stage = Stage::Second;
+    drive.phase = VfdPhase::Show;
+    drive.word = gridBit(digit) | plan.second;
+    drive.shift = false;
+    drive.preload = 0;
+    return onUs - plan.firstUs;
+  }
+
+  uint32_t blankUs = SLOT_US - onUs;
+  if (++digit >= DIGITS) {
+    digit = 0;
+    uint32_t next = pending.exchange(NO_PAGE);    // フレームの切れ目でページを切り替える
+    if (next != NO_PAGE) {
+      front.store(static_cast<uint8_t>(next), std::memory_order_relaxed);
+      page = &pages[next];
+    }
+    if ((next != NO_PAGE) && page->restart) {
+      progress = 0;
+    } else if (progress < PROGRESS_FULL) {
+      progress += page->fadeStep;
+      if (progress > PROGRESS_FULL) progress = PROGRESS_FULL;
+    }
+  }
+  planSlot(*page, digit);
+  stage = Stage::Blanked;
+  drive.phase = VfdPhase::Blank;
+  drive.word = 0;
+  drive.shift = true;
+  drive.preload = gridBit(digit) | plan.first;
+  return blankUs;
+}
+
+/**
+ * @brief 1桁分の点灯の予定を決める
+ * @param page 表示中のページ
+ * @param d 桁
+ * @details 割り込みから呼ぶ。表は RAMP だけを引き、分岐は if で書く（switch の表はフラッシュに置かれる）。
+ * クロスフェードは前の表示と新しい表示に点灯時間を分け、片方が MIN_ON_US に満たないときは分けない。
+ */
+void VFD_ISR_ATTR VfdRenderer::planSlot(const Page& page, uint8_t d) {
+  uint8_t to = page.segments[d];
+  uint8_t from = page.from[d];
+  uint8_t onUs = page.onUs[d];
+  plan.first = to;
+  plan.second = to;
+  plan.firstUs = onUs;
+  plan.split = false;
+  if (progress >= PROGRESS_FULL) {
+    return;
+  }
+
+  if (page.effect == VfdEffect::CrossFade) {
+    if (from == to) return;
+    uint32_t newUs = (onUs * RAMP[progress >> RAMP_SHIFT] + 128) >> 8;
+    uint32_t oldUs = onUs - newUs;
+    if (oldUs < MIN_ON_US) return;              // ほぼ新しい表示
+    plan.first = from;
+    if (newUs < MIN_ON_US) return;              // ほぼ前の表示
+    plan.firstUs = static_cast<uint8_t>(oldUs);
+    plan.split = true;
+  } else if (page.effect == VfdEffect::Roll) {
+    if (from == to) return;
+    plan.first = rollFrame(from, to, (progress * (ROLL_STAGES + 1)) >> 16);
+  } else if (page.effect == VfdEffect::Scroll) {
+    uint32_t index = d + ((progress * DIGITS) >> 16);   // 前の表示と新しい表示を並べた位置
+    plan.first = (index < DIGITS) ? page.from[index] : page.segments[index - DIGITS];
+  }
+}
+
+/**
+ * @brief 輝度から点灯時間を求める
+ * @param level 桁の輝度（LEVEL_MIN～LEVEL_MAX、範囲外は丸める）
+ * @param glow 全体輝度[%]（GLOW_MAX以上は100%）
+ * @return 点灯時間[us]（MIN_ON_US～MAX_ON_US）
+ */
+uint32_t VfdRenderer::onTimeUs(uint8_t level, uint8_t glow) {
+  if (level < LEVEL_MIN) level = LEVEL_MIN;
+  if (level > LEVEL_MAX) level = LEVEL_MAX;
+  if (glow > GLOW_MAX) glow = GLOW_MAX;
+  const uint32_t scale = 255UL * GLOW_MAX;
+  return MIN_ON_US + ((MAX_ON_US - MIN_ON_US) * GAMMA[level] * glow + scale / 2) / scale;
+}
+
+/**
+ * @brief 切り替え時間から1フレームの増分を求める
+ * @param fadeTime 切り替え時間（Pr.5、FADE_UNIT_MS 単位、FADE_TIME_MAX 以上は丸める）
+ * @return 1フレームあたりの進み（16ビット固定小数点、0のときは PROGRESS_FULL で即時）
+ */
+uint32_t VfdRenderer::fadeStep(uint8_t fadeTime) {
+  if (fadeTime == 0) {
+    return PROGRESS_FULL;
+  }
+  if (fadeTime > FADE_TIME_MAX) fadeTime = FADE_TIME_MAX;
+  uint32_t frames = fadeTime * FADE_UNIT_MS * 1000UL / FRAME_US;
+  return (PROGRESS_FULL + frames - 1) / frames;
+}
+
+/**
+ * @brief 転がす途中の字形
+ * @param from 前の字形
+ * @param to 新しい字形
+ * @param stage 段階（0：前の字形 ～ ROLL_STAGES：新しい字形）
+ * @return セグメントのビットパターン
+ * @details 前の字形の下に1行空けて新しい字形を縦に並べ、半桁ずつ上へずらして見せる。
+ * 途中の段階ではドットを消す。
+ */
+uint8_t VFD_ISR_ATTR VfdRenderer::rollFrame(uint8_t from, uint8_t to, uint32_t stage) {
+#define VFD_SEG(glyph, seg, dest) ((((glyph) & VfdGlyph::seg) != 0) ? VfdGlyph::dest : 0)
+  if (stage == 0) {
+    return from;
+  }
+  if (stage == 1) {       // 上半分に前の字形の下半分、下端に新しい字形の上端
+    return VFD_SEG(from, SEG_G, SEG_A) | VFD_SEG(from, SEG_E, SEG_F) | VFD_SEG(from, SEG_C, SEG_B) |
+           VFD_SEG(from, SEG_D, SEG_G) | VFD_SEG(to, SEG_A, SEG_D);
+  }
+  if (stage == 2) {       // 上端に前の字形の下端、下半分に新しい字形の上半分
+    return VFD_SEG(from, SEG_D, SEG_A) | VFD_SEG(to, SEG_A, SEG_G) | VFD_SEG(to, SEG_F, SEG_E) |
+           VFD_SEG(to, SEG_B, SEG_C) | VFD_SEG(to, SEG_G, SEG_D);
+  }
+  return to;
+#undef VFD_SEG
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+#include "VfdGlyph.h"
+
+#ifdef UNIT_TEST
+#define VFD_ISR_ATTR
+#define VFD_ISR_DATA
+#else
+#include <esp_attr.h>
+#define VFD_ISR_ATTR IRAM_ATTR    // フラッシュ書き込み中も割り込みから呼べるようにIRAMに置く
+#define VFD_ISR_DATA DRAM_ATTR    // 割り込みから読む定数表はRAMに置く
+#endif
+
+/**
+ * @brief 割り込みで出力する内容の種類
+ */
+enum class VfdPhase : uint8_t {
+  Show,     // 事前に送った桁をラッチして点灯する
+  Blank     // 消灯して次の桁を送る
+};
+
+/**
+ * @brief 表示内容が変わったときの効果（Pr.4）
+ */
+enum class VfdEffect : uint8_t {
+  None = 0,       // すぐに切り替える
+  CrossFade = 1,  // 変わった桁を前の表示から徐々に切り替える
+  Roll = 2,       // 変わった桁を下から上へ転がす
+  Scroll = 3      // 表示全体を右から左へ流す
+};
+
+/**
+ * @brief 割り込み1回分の出力
+ * word/preload の下位8ビットがセグメント（a～g、dp）、その上が桁（グリッド）。
+ */
+struct VfdDrive {
+  VfdPhase phase = VfdPhase::Blank;
+  uint32_t word = 0;        // Show：点灯する内容（ラッチ済みのデータ）、Blank：0
+  bool shift = false;       // この割り込みで preload をシフトレジスタへ送る
+  uint32_t preload = 0;     // 次の Show でラッチする内容
+};
+
+/**
+ * @brief VFDのダイナミック点灯の描画エンジン（ハードウェアに依存しない部分）
+ * - 表示内容は桁ごとのセグメントのビットパターン（フレームバッファ）
+ * - 1桁の表示時間（スロット）は一定で、点灯時間だけを桁の輝度で変える。
+ *   フレーム周期は輝度によらず FRAME_US で一定（1.1kHz）
+ * - 点灯時間は Pr.8～16（桁の輝度）と Pr.6（全体輝度）から表を作っておき、割り込みでは引くだけ
+ * - 消灯中に次の桁を送っておき、点灯はラッチするだけにして点灯タイミングの揺れを抑える
+ * - 描画（メインループ）と割り込みはページを分け、フレームの切れ目で切り替える（表示が途中で混ざらない）
+ * - 表示が変わると、Pr.4 の効果で Pr.5 の時間をかけて切り替える。進み具合は16ビット固定小数点で、
+ *   1フレームの増分は Pr.5 の変更時に求めておく。クロスフェードは点灯時間を前の表示と新しい表示で分け合う
+ *
+ * 使い方：メインループで setText()/setSegments()/setBrightness()/setEffect() のあと present() を呼ぶ。
+ * タイマ割り込みで step() を呼び、戻り値の時間後に次の割り込みを設定する。
+ */
+class VfdRenderer {
+public:
+  static constexpr uint8_t DIGITS = 9;                  // 表示桁数
+  static constexpr uint8_t GRID_SHIFT = 8;              // word の中の桁（グリッド）の位置
+  static constexpr uint32_t SLOT_US = 100;              // 1桁の表示時間[us]
+  static constexpr uint32_t FRAME_US = SLOT_US * DIGITS;  // フレーム周期[us]
+  static constexpr uint32_t MIN_ON_US = 8;              // 最短の点灯時間[us]（割り込みの間隔を確保する）
+  static constexpr uint32_t MIN_BLANK_US = 8;           // 最短の消灯時間[us]（桁を切り替えるときのにじみ防止）
+  static constexpr uint32_t MAX_ON_US = SLOT_US - MIN_BLANK_US;  // 最長の点灯時間[us]
+  static constexpr uint8_t LEVEL_MIN = 1;               // 桁の輝度の下限
+  static constexpr uint8_t LEVEL_MAX = 15;              // 桁の輝度の上限
+  static constexpr uint8_t GLOW_MAX = 100;              // 全体輝度の上限[%]
+  static constexpr uint32_t FADE_UNIT_MS = 100;         // Pr.5 の1あたりの切り替え時間[ms]
+  static constexpr uint8_t FADE_TIME_MAX = 9;           // Pr.5 の上限
+  static constexpr uint32_t PROGRESS_FULL = 1UL << 16;  // 切り替えの完了（16ビット固定小数点の1.0）
+  static constexpr uint8_t RAMP_SHIFT = 11;             // 進み具合→クロスフェードの表の番号
+  static constexpr uint8_t ROLL_STAGES = 3;             // 転がす途中の段階数+1
+
+  VfdRenderer(void);
+
+  void clear(void);                                     // 表示を消す
+  void setSegments(uint8_t digit, uint8_t segments);    // 桁のセグメントを設定する
+  uint8_t getSegments(uint8_t digit) const;             // 桁のセグメントを取得する（描画中の内容）
+  uint8_t setText(const char* text, uint8_t start = 0); // 文字列を表示する
+  void setBrightness(const uint8_t* brDig, uint8_t glow);   // 輝度の表を作り直す
+  void setEffect(uint8_t effect, uint8_t fadeTime);     // 切り替えの効果と時間を設定する
+  uint32_t getOnTimeUs(uint8_t digit) const;            // 桁の点灯時間（描画中の内容）
+  void present(void);                                   // 描画した内容を次のフレームから表示する
+
+  uint32_t step(VfdDrive& drive);                       // 割り込み1回分の出力を作る
+
+  static uint32_t onTimeUs(uint8_t level, uint8_t glow);  // 輝度から点灯時間を求める
+  static uint32_t fadeStep(uint8_t fadeTime);           // 切り替え時間から1フレームの増分を求める
+  static uint8_t rollFrame(uint8_t from, uint8_t to, uint32_t stage);  // 転がす途中の字形
+
+  /**
+   * @brief 桁（グリッド）のビット
+   * @param digit 桁（0：左端）
+   * @return word の中の桁のビット
+   */
+  static constexpr uint32_t gridBit(uint8_t digit) { return 1UL << (GRID_SHIFT + digit); }
+
+  /**
+   * @brief リフレッシュレート
+   * @return 1秒あたりのフレーム数
+   */
+  static constexpr uint32_t refreshHz(void) { return 1000000UL / FRAME_US; }
+
+private:
+  static constexpr uint8_t NO_PAGE = 0xFF;
+
+  /**
+   * @brief 1フレーム分の表示内容
+   */
+  struct Page {
+    uint8_t segments[DIGITS];   // 桁ごとのセグメント
+    uint8_t from[DIGITS];       // 切り替え前のセグメント
+    uint8_t onUs[DIGITS];       // 桁ごとの点灯時間[us]
+    VfdEffect effect;           // 切り替えの効果
+    bool restart;               // このページの表示で切り替えを始める
+    uint32_t fadeStep;          // 1フレームあたりの進み（PROGRESS_FULL で即時）
+  };
+
+  /**
+   * @brief 割り込みの中の位置（最後に出力したもの）
+   */
+  enum class Stage : uint8_t {
+    Blanked,    // 消灯して次の桁を送った
+    First,      // 1回目の点灯
+    Second      // 2回目の点灯（クロスフェード中）
+  };
+
+  /**
+   * @brief 1桁分の点灯の予定（消灯中に決める）
+   */
+  struct SlotPlan {
+    uint8_t first;              // 1回目に点灯するセグメント
+    uint8_t second;             // 2回目に点灯するセグメント
+    uint8_t firstUs;            // 1回目の点灯時間[us]
+    bool split;                 // 点灯時間を2回に分ける
+  };
+
+  Page work;                          // 描画中の内容（メインループのみ）
+  Page last;                          // 最後に present() した内容（メインループのみ）
+  Page pages[2];                      // 表示用（割り込みは front だけを読む）
+  std::atomic<uint8_t> front;         // 表示中のページ（割り込みだけが書き換える）
+  std::atomic<uint32_t> pending;      // 次のフレームから表示するページ（NO_PAGE：なし）
+
+  uint8_t digit;                      // 出力中の桁（割り込みのみ）
+  Stage stage;                        // 出力中の状態（割り込みのみ）
+  uint32_t progress;                  // 切り替えの進み具合（割り込みのみ）
+  SlotPlan plan;                      // 出力中の桁の予定（割り込みのみ）
+
+  void planSlot(const Page& page, uint8_t digit);
+
+  static const uint8_t GAMMA[LEVEL_MAX + 1];  // 輝度の段階→明るさ（0～255）
+  static const uint16_t RAMP[(PROGRESS_FULL >> RAMP_SHIFT) + 1];  // 進み具合→新しい表示の割合（0～256）
+};
+
+static_assert(VfdRenderer::refreshHz() >= 1000, "VFD refresh must be at least 1 kHz");
+static_assert(VfdRenderer::MIN_ON_US < VfdRenderer::MAX_ON_US, "VFD slot is too short");
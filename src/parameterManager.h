@@ -32,9 +32,10 @@ public:
   void begin(void);                               // パラメータ群の初期設定
   bool setupParameter(uint8_t index, int defaultValue, int minValue, int maxValue, CallbackType callback = nullptr);  // パラメータの設定（EEPROM読み込み）
   bool setParameter(uint8_t index, uint8_t value);    // パラメータの設定（EEPROM書き込み）
+  bool setParameters(uint8_t firstIndex, const uint8_t *values, size_t count); // 連続したパラメータの一括設定（EEPROMトランザクション）
   bool getParameter(uint8_t index, uint8_t& value);   // パラメータの取得（EEPROM読み込み）
   uint8_t getParameter(uint8_t index);                // パラメータの取得（EEPROM読み込み）
-  void clearAllParameters();                          // すべて初期値に戻す（コールバックも発火）
+  bool clearAllParameters();                          // すべて初期値に戻す（コールバックも発火）
 
 private:
   struct Parameter {    // パラメータ構造体
@@ -52,6 +53,7 @@ private:
   std::vector<Parameter> params;            // パラメータのリスト
 //  static constexpr uint8_t MAX_PARAMS = 10; // 最大パラメータ数
 
+  void restoreParameters(uint8_t firstIndex, const std::vector<int>& values);  // 保存失敗時に元の値へ戻す
   void logError(const char* message);
   void logInfo(const char* message);
 };
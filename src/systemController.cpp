@@ -1,6 +1,21 @@
 #include <M5Unified.h>
 #include "SystemController.h"
 #include "Config.h"
+#include "esp_system.h"
+
+static_assert(VfdRenderer::DIGITS == DISP_KETAMAX, "VFD renderer digits must match DISP_KETAMAX");
+
+static EepromManager* shutdownEeprom = nullptr;   // 再起動の前に書き戻すEEPROM
+
+/**
+ * @brief 再起動（esp_restart()）の前に未書き込みのページを書き戻す
+ * OTA更新後の再起動も含む。電源断・パニックでは呼ばれない。
+ */
+static void flushEepromOnShutdown(void) {
+  if (shutdownEeprom) {
+    shutdownEeprom->flush();
+  }
+}
 
 /*
 SystemController::SystemController()
@@ -16,13 +31,15 @@ SystemController::SystemController()
     paramManager(&eepromManager, &logManager, &systemManager),  // パラメータ管理の初期化
     systemManager(),                                  // システム管理の初期化
     i2cBus(),        // I2Cバス管理の初期化
+    i2cTransport(i2cBus),                             // I2C非同期転送の初期化
     display(&i2cBus),                                 // OLED表示の初期化
+    vfdDriver(vfdRenderer),                           // VFDのダイナミック点灯の初期化
     eepromManager(&i2cBus),                           // EEPROM管理の初期化
     envSensor(&i2cBus),                               // 環境センサの初期化
     rtcManager(&i2cBus),                              // RTC管理の初期化
     irRemoteManager(),                                // IRリモート管理の初期化
     ledManager(),                                     // LED管理クラスの初期化
-    jsonCommandProcessor(&paramManager, &wiFiManager, &systemManager),                // JSONコマンド処理の初期化
+    jsonCommandProcessor(&paramManager, &wiFiManager, &systemManager, &i2cBus),       // JSONコマンド処理の初期化
     wiFiManager(&wifiReal),                                                           // WiFi接続管理の初期化
     webServerManager(&paramManager, &jsonCommandProcessor, &wiFiManager)              // Webサーバ管理の初期化
 {
@@ -38,7 +55,17 @@ void SystemController::begin() {
 
   // 2. I2Cバス初期化
   i2cBus.begin();              // I2Cバスの初期化
-  i2cBus.scanI2CBus();          // I2Cバスのスキャン
+  if (i2cTransport.begin()) {
+    i2cBus.setTransport(&i2cTransport);   // 非同期転送（EEPROMのページ書き込みなど）
+  }
+  i2cBus.onScanProgress([](const I2CScanProgress& progress) {
+    if (progress.phase == I2CScanPhase::Done) {
+      Serial.printf("I2C scan done (%s): %u/%u addresses probed, %u devices\n",
+                    progress.warmBoot ? "warm" : "cold",
+                    (unsigned)progress.probed, (unsigned)progress.total, (unsigned)progress.found);
+    }
+  });
+  i2cBus.beginScan();           // 既知のデバイスだけ確認し、残りはupdate()でスキャン
 
   if (!LittleFS.begin()) {
     Serial.println("LittleFS mount failed");
@@ -46,12 +73,31 @@ void SystemController::begin() {
   }
 
   // 3. 他モジュールの初期化
-  display.begin();                        // OLED表示の初期化
   eepromManager.begin();            // EEPROMの初期化
+  if (!eepromManager.isLoaded()) {
+    Serial.println("EEPROM load failed (unread pages are read/write protected)");
+  }
+  shutdownEeprom = &eepromManager;
+  esp_register_shutdown_handler(flushEepromOnShutdown);   // 再起動の前に書き戻す
+  beginI2CClocks();                       // デバイスごとのSCL周波数（OLEDの初期化より前）
+  display.begin();                        // OLED表示の初期化
+  if (!vfdDriver.begin()) {               // VFDのダイナミック点灯を開始
+    Serial.println("VFD timer init failed");
+  }
   logManager.begin(eepromManager);        // ログ管理の初期化
+  rtcManager.onResync([](const RtcSyncReport& report) {   // RTCを読み直したら位相の誤差と進みの推定値を表示
+    if (report.driftValid) {
+      Serial.printf("RTC resync: phase %+ldms, drift %+.2fppm over %lus\n",
+                    (long)report.phaseErrorMs, report.driftPpb / 1000.0, (unsigned long)report.baselineS);
+    } else {
+      Serial.printf("RTC resync: phase %+ldms, drift n/a (%lus)\n",
+                    (long)report.phaseErrorMs, (unsigned long)report.baselineS);
+    }
+  });
   rtcManager.begin();                     // RTCの初期化
   timeManager.begin(&rtcManager);         // 時間管理の初期化
   TimeManager::setInstance(&timeManager); // シングルトンインスタンス設定
+  logManager.setTimeSource([this]() { return (uint32_t)timeManager.getSystemTime(); });  // ログの記録時刻
 //  timeManager.setSystemTimeManually(2023, 10, 1, 12, 0, 0); // 手動で時刻設定
   irRemoteManager.begin();                // IRリモートの初期化
 
@@ -109,11 +155,32 @@ void SystemController::begin() {
   // システム起動
   //
   systemManager.initDependencies(wiFiManager, timeManager, paramManager, terminalInputManager, ledManager);   // 依存関係の初期化
+  systemManager.onBrightnessChanged([this](const uint8_t* brDig, uint8_t glow) {
+    vfdRenderer.setBrightness(brDig, glow);   // VFDの輝度の表を作り直す
+    vfdRenderer.present();
+  });
+  systemManager.onEffectChanged([this](uint8_t effect, uint8_t fadeTime) {
+    vfdRenderer.setEffect(effect, fadeTime);  // VFDの表示が変わったときの効果
+    vfdRenderer.present();
+  });
   paramManager.begin();                                             // パラメータ管理の初期化 systemManagerの後に呼び出す必要がある
 
   systemManager.begin();      // システム起動処理：パラメータ設定反映後の初期化処理
 
   rtcManager.dispRtcType();  // RTCの種類を表示
+  beginSecondTick();         // RTCの1Hz矩形波（配線されていなければシステム時刻で刻む）
+
+  // 時刻表示：秒の境界で刻み、RTCは再同期の間隔ごとに1回だけ読む
+  clockTicker.onTick([this](const struct tm& local, uint8_t changed) {
+    updateClockDisplay(local, changed);
+  });
+  timeManager.onTimeChanged([this]() {
+    clockTicker.requestResync();    // 時刻・タイムゾーンが変わったら次の境界で読み直す
+  });
+  clockTicker.begin([this](time_t& epoch, uint32_t& subUs) { return readClockSource(epoch, subUs); },
+                    [this](time_t t, struct tm& out) { zoneClock.toLocal(timeManager.getTimeZone(), t, out); },
+                    micros());
+
     // serialMonitor init
 //  serialCommandProcessor = SerialCommandProcessor(&realMonitorDeviseIo);
    Serial.println("SystemController initialized");
@@ -122,6 +189,15 @@ void SystemController::begin() {
 void SystemController::update() {
 //  uint8_t itmKeyCode;
 
+  updateSecondTick();  // 秒の境界は時間のかかる処理より先に刻む（SQWから表示までの遅れを小さくする）
+
+  display.update();  // 積めなかったOLEDの送信を積み直す
+  uint32_t i2cBudgetUs = clockTicker.untilNextUs(micros());   // 次の秒の境界をまたいでI2Cの処理を始めない
+  if (i2cBudgetUs > I2CBusManager::I2C_UPDATE_BUDGET_US) {
+    i2cBudgetUs = I2CBusManager::I2C_UPDATE_BUDGET_US;
+  }
+  i2cBus.update(i2cBudgetUs);   // キューに積まれたI2Cの処理（OLED描画など）を実行
+  updateSecondTick();
   wiFiManager.update();
   webServerManager.update();
 
@@ -137,44 +213,184 @@ void SystemController::update() {
 
   irRemoteManager.update();   // IRリモートの更新処理
 
-  if (millis() - lastReadTime >= readInterval) {  // 一定間隔でセンサデータを読み取る
-/*
-    if (envSensor.readSensorData()) {
-      Serial.printf("Temp: %.1f, Hum: %.1f\n",
-                    envSensor.getTemperature(),
-                    envSensor.getHumidity());
+  updateSecondTick();
 
-      char logBuf[64];
-      snprintf(logBuf, sizeof(logBuf), "T:%.1f H:%.1f",
-               envSensor.getTemperature(), envSensor.getHumidity());
-      logManager.writeLog(logBuf);  // ログ書き込み
+  logManager.update();              // ログ書き込みキューの処理
+  eepromManager.update(millis());   // EEPROM書き戻しの更新処理
 
-    }
-*/
-//    if(rtcManager.isRunning()) {
-      updateClockDisplay();  // RTCがあれば時刻表示
-//      Serial.println("RTC running!");
-//    } else {
-//      Serial.println("RTC not running!");
-//    }
+  rtcManager.update(millis());      // RTCのキャッシュの再同期
+  updateSecondTick();               // 秒の境界で時刻表示を更新
+  // 環境センサは周期読み込みしていない（読み込みは EnvironmentSensor::readSensorData()）
+}
 
+/**
+ * @brief デバイスごとのSCL周波数を準備する
+ * EEPROMに保存した周波数の表を復元する。
+ * 未保存・破損、または調整していないデバイスが接続されている場合は、調整して保存する。
+ */
+void SystemController::beginI2CClocks() {
+  uint8_t record[I2CClockTable::RECORD_SIZE];
+  eepromManager.readMultipleBytes(I2C_CLOCK_TABLE_ADDR, record, sizeof(record));
+  if (i2cBus.restoreClockTable(record, sizeof(record))) {
+    return;
+  }
+  Serial.println("I2C clock calibration");
+  i2cBus.calibrateClocks();
+  if (i2cBus.saveClockTable(record, sizeof(record)) == sizeof(record)) {
+    eepromManager.writeBytes(I2C_CLOCK_TABLE_ADDR, record, sizeof(record));
+  }
+}
 
-    lastReadTime = millis();  // 最後の読み込み時間を更新
+/**
+ * @brief RTCの1Hz矩形波の割り込みを開始
+ * SQWを出せないRTC・配線していない基板では、SecondTickが同期しないためシステム時刻で刻む。
+ */
+void SystemController::beginSecondTick() {
+#if RTC_SQW_PIN >= 0
+  if (!rtcManager.enableSecondPulse()) {
+    Serial.println("RTC SQW not supported: software tick");
+    return;
   }
+  pinMode(RTC_SQW_PIN, INPUT_PULLUP);     // SQWはオープンドレイン
+  attachInterruptArg(digitalPinToInterrupt(RTC_SQW_PIN), &SystemController::onSqwEdge, &secondTick, FALLING);
+#endif
 }
 
-void SystemController::updateClockDisplay() {
-  struct tm timeinfo;
+/**
+ * @brief SQWの立ち下がり割り込み
+ * @param arg SecondTick
+ */
+void IRAM_ATTR SystemController::onSqwEdge(void* arg) {
+  static_cast<SecondTick*>(arg)->captureEdge(micros());
+}
 
-  timeinfo = timeManager.getLocalTimeStruct();
-  display.showTime(timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_sec, 20, "LOC");  // ローカル時刻を表示
+/**
+ * @brief 秒の刻みの更新
+ * SQWに同期している間はSQWの境界で、それ以外はシステム時刻の秒未満から求めた境界で時刻表示を進める。
+ * 境界でなければ比較だけで戻るため、update() の中で時間のかかる処理のあいだに何度か呼ぶ。
+ * SQWの立ち下がりから表示の切り替えまでの遅れを測り、LATENCY_REPORT_EDGES ごとに表示する。
+ */
+void SystemController::updateSecondTick() {
+  bool edge = secondTick.update(micros());
+  if (secondTick.getMode() != tickMode) {
+    tickMode = secondTick.getMode();
+    clockTicker.setExternalTick(tickMode == SecondTickMode::Sqw);
+    Serial.println(tickMode == SecondTickMode::Sqw ? "Second tick: RTC SQW" : "Second tick: software");
+  }
+  if (edge) {
+    clockTicker.tick(secondTick.getTickUs(), micros());
+    secondTick.recordFlip(micros());
+    lockSystemClock(secondTick.getTickUs());
+    if (secondTick.getEdges() % LATENCY_REPORT_EDGES == 0) {
+      Serial.printf("SQW to display: %u us (max %u us)\n",
+                    (unsigned)secondTick.getFlipLatencyUs(), (unsigned)secondTick.getMaxFlipLatencyUs());
+      secondTick.resetMaxFlipLatency();
+    }
+  }
+  clockTicker.update(micros());
+}
 
-  timeinfo = timeManager.getRtcTimeStruct();  // RTC時刻を取得
-  display.showTime(timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_sec, 30, "RTC");  // RTC時刻を表示
+/**
+ * @brief システム時刻の秒未満をSQWに合わせる
+ * @param edgeUs SQWの境界のmicros()
+ * SNTPで同期するまではRTCが時刻の基準のため、システム時刻の秒の境界をSQWにそろえる（少しずつ補正する）。
+ */
+void SystemController::lockSystemClock(uint32_t edgeUs) {
+  if (wiFiManager.sntpCompleted) {
+    return;     // SNTPが時刻の基準
+  }
+  time_t epoch;
+  uint32_t subUs;
+  if (!timeManager.readSystemTime(epoch, subUs)) {
+    return;
+  }
+  int32_t offsetUs = SecondTick::subSecondOffsetUs(subUs, micros(), edgeUs);
+  if ((offsetUs > SLEW_MIN_US) || (offsetUs < -SLEW_MIN_US)) {
+    timeManager.slewSystemTime(-offsetUs);
+  }
+}
 
-  time_t now = timeManager.getSystemTime();  // システム時刻を取得
-  DateTime dt(now);
-  display.showTime(dt.hour(), dt.minute(), dt.second(), 40, "SYS");  // システム時刻を表示
+/**
+ * @brief 時刻の再同期
+ * @param epoch システム時刻（UNIX時間）の格納先
+ * @param subUs 秒未満[us]の格納先
+ * @return true: 取得成功
+ * RTCの時刻（キャッシュから推定した値）とシステム時刻との差を、RTCの行の表示に使う。
+ */
+bool SystemController::readClockSource(time_t& epoch, uint32_t& subUs) {
+  if (!timeManager.readSystemTime(epoch, subUs)) {
+    return false;
+  }
+  int32_t offset = (int32_t)((int64_t)rtcManager.now().unixtime() - (int64_t)epoch);
+  rtcOffsetChanged = rtcOffsetChanged || (offset != rtcOffset);
+  rtcOffset = offset;
+  return true;
+}
 
-  return;   
-}
\ No newline at end of file
+/**
+ * @brief 秒が変わったときに時刻を表示
+ * @param local ローカル時刻
+ * @param changed 変わった欄（ClockTicker::FIELD_*）
+ * 変わった欄の数字だけを書き換える。
+ * システム時刻の行はUTCで、タイムゾーンの差は分単位のため、ローカル時刻の秒だけが変わったときは秒だけが変わる。
+ * RTCの行はシステム時刻との差が秒単位のため、RTCの時刻そのものから変わった欄を求める。
+ */
+void SystemController::updateClockDisplay(const struct tm& local, uint8_t changed) {
+  ClockTicker::formatHms(vfdClock + 1, local, changed);
+  vfdRenderer.setText(vfdClock);    // VFDにローカル時刻を表示
+  vfdRenderer.present();
+
+  bool ready = display.isReady();
+  if (!ready) {
+    oledClockShown = false;
+    return;
+  }
+  if (!oledClockShown) {
+    changed = ClockTicker::FIELD_ALL;   // 接続・初期化の直後は行全体を描く
+    rtcOffsetChanged = true;
+    oledClockShown = true;
+  }
+  showClockLine(CLOCK_LOC, local, changed);
+
+  uint8_t utcChanged = (changed == ClockTicker::FIELD_SEC) ? ClockTicker::FIELD_SEC : ClockTicker::FIELD_ALL;
+  struct tm utc = local;
+  time_t sys = clockTicker.getEpoch();
+  if (utcChanged != ClockTicker::FIELD_SEC) {
+    gmtime_r(&sys, &utc);
+  }
+  showClockLine(CLOCK_SYS, utc, utcChanged);
+
+  struct tm rtc;
+  time_t rtcEpoch = sys + rtcOffset;
+  gmtime_r(&rtcEpoch, &rtc);      // RTCの行は秒が違うこともあるため、毎秒RTCの時刻から変わった欄を求める
+  uint8_t rtcChanged = ClockTicker::FIELD_ALL;
+  if (!rtcOffsetChanged) {
+    rtcChanged = 0;
+    if (rtc.tm_sec != oledRtc.tm_sec) rtcChanged |= ClockTicker::FIELD_SEC;
+    if (rtc.tm_min != oledRtc.tm_min) rtcChanged |= ClockTicker::FIELD_MIN;
+    if (rtc.tm_hour != oledRtc.tm_hour) rtcChanged |= ClockTicker::FIELD_HOUR;
+  }
+  rtcOffsetChanged = false;
+  oledRtc = rtc;
+  if (rtcChanged != 0) {
+    showClockLine(CLOCK_RTC, rtc, rtcChanged);
+  }
+
+  return;
+}
+
+/**
+ * @brief OLEDの時刻の行の変わった欄を描く
+ * @param line 行
+ * @param t 時刻
+ * @param changed 変わった欄（ClockTicker::FIELD_*）
+ * 変わった欄から行末までを描く。時が変わったときは見出しを含めて行全体を描く。
+ */
+void SystemController::showClockLine(ClockLine line, const struct tm& t, uint8_t changed) {
+  char* text = oledClock[line];
+  ClockTicker::formatHms(text + CLOCK_HMS_POS, t, changed);
+  uint8_t from = (changed & ClockTicker::FIELD_HOUR) ? 0
+               : (changed & ClockTicker::FIELD_MIN) ? CLOCK_HMS_POS + 3
+               : CLOCK_HMS_POS + 6;
+  display.showText(from * OledFrameBuffer::CHAR_WIDTH, CLOCK_TOP + line * CLOCK_PITCH, text + from);
+}
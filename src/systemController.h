@@ -3,11 +3,13 @@
 #include "LittleFS.h"
 
 #include "I2CBusManager.h"
+#include "I2CWireTransport.h"   // I2C非同期転送
 #include "EepromManager.h"
 #include "ParameterManager.h"
 #include "LogManager.h"
 #include "EnvironmentSensor.h"
 #include "DisplayManager.h"       // OLED表示クラス
+#include "VfdDriver.h"            // VFD表示クラス
 #include "LedManager.h"           // LED管理クラス
 #include "RTCManager.h"
 #include "TimeManager.h"        // 時間管理クラス
@@ -20,6 +22,9 @@
 #include "SerialCommandProcessorRealDevice.h" // シリアルコマンド処理クラス
 #include "SerialCommandProcessor.h" // シリアルコマンド処理クラス
 #include "IrRemoteManager.h"        // IRリモート管理クラス
+#include "ClockTicker.h"            // 秒の境界にそろえた時刻の刻み
+#include "SecondTick.h"             // RTCの1Hz矩形波による秒の刻み
+#include "TimeZoneClock.h"          // 次の切り替えを覚えておくローカル時刻の変換
 
 // システム全体の管理クラス
 class SystemController {
@@ -34,11 +39,14 @@ public:
 
 private:
   I2CBusManager i2cBus;           // I2Cバス管理
+  I2CWireTransport i2cTransport;  // I2C非同期転送（i2cBusの後に初期化すること）
   EepromManager eepromManager;    // EEPROM管理
   ParameterManager paramManager;  // パラメータ管理
   LogManager logManager;          // ログ管理
   EnvironmentSensor envSensor;    // 環境センサ管理
   DisplayManager display;         // OLED表示管理
+  VfdRenderer vfdRenderer;        // VFD表示内容
+  VfdDriver vfdDriver;            // VFDのダイナミック点灯（vfdRendererの後に初期化すること）
   RTCManager rtcManager;          // RTC管理
   TimeManager timeManager;        // 時間管理
   WiFi_real wifiReal;             // WiFi接続管理（実機用） 
@@ -53,8 +61,31 @@ private:
 
   LedManager ledManager;        // LED管理クラス
 
-  unsigned long lastReadTime = 0;           // 最後の読み込み時間
-  const unsigned long readInterval = 100;   // 読み込み間隔（ミリ秒）
-  
-  void updateClockDisplay();                // OLEDに時刻表示
+  // 時刻表示（OLEDは LOC/RTC/SYS の3行、VFDはローカル時刻）
+  enum ClockLine : uint8_t { CLOCK_LOC = 0, CLOCK_RTC, CLOCK_SYS, CLOCK_LINES };
+  static constexpr uint8_t CLOCK_TOP = 20;        // OLEDの1行目のY座標
+  static constexpr uint8_t CLOCK_PITCH = 10;      // OLEDの行の間隔
+  static constexpr uint8_t CLOCK_HMS_POS = 4;     // 行の中の時刻の位置（"LOC:" の後）
+
+  ClockTicker clockTicker;                  // 秒の境界にそろえた時刻の刻み
+  TimeZoneClock zoneClock;                  // 表示の時刻の変換（夏時間の次の切り替えを覚えておく）
+  SecondTick secondTick;                    // RTCの1Hz矩形波（SQW）による秒の刻み
+  SecondTickMode tickMode = SecondTickMode::Software;   // 表示した刻みの出どころ
+  static constexpr int32_t SLEW_MIN_US = 200;   // システム時刻をSQWに合わせる最小の誤差[us]
+  static constexpr uint32_t LATENCY_REPORT_EDGES = 600;  // SQWから表示までの遅れを表示する間隔（立ち下がりの数。10分）
+  int32_t rtcOffset = 0;                    // RTC時刻 - システム時刻[s]（再同期のときだけRTCを読む）
+  bool rtcOffsetChanged = true;             // rtcOffsetが変わった（RTCの行を描き直す）
+  struct tm oledRtc = {};                   // OLEDのRTCの行に描いた時刻
+  bool oledClockShown = false;              // OLEDに時刻の行全体を描いた
+  char vfdClock[VfdRenderer::DIGITS + 1] = " 00-00-00";   // VFDの表示文字列
+  char oledClock[CLOCK_LINES][13] = {"LOC:00:00:00", "RTC:00:00:00", "SYS:00:00:00"};  // OLEDの行
+
+  void beginSecondTick();                                           // RTCの1Hz矩形波の割り込みを開始
+  void updateSecondTick();                                          // 秒の刻みの更新（SQWかシステム時刻か）
+  void lockSystemClock(uint32_t edgeUs);                            // システム時刻の秒未満をSQWに合わせる
+  static void onSqwEdge(void* arg);                                 // SQWの立ち下がり割り込み
+  bool readClockSource(time_t& epoch, uint32_t& subUs);             // 時刻の再同期（システム時刻とRTCを読む）
+  void updateClockDisplay(const struct tm& local, uint8_t changed); // 秒が変わったときに時刻を表示
+  void showClockLine(ClockLine line, const struct tm& t, uint8_t changed);   // OLEDの時刻の行の変わった欄を描く
+  void beginI2CClocks();                    // デバイスごとのSCL周波数を復元（なければ調整して保存）
 };
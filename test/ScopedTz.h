@@ -0,0 +1,30 @@
+#pragma once
+
+#include <stdlib.h>
+#include <time.h>
+#include <string>
+
+// テストのあいだだけ libc の TZ を切り替える
+class ScopedTz {
+public:
+  explicit ScopedTz(const std::string& tz) {
+    const char* old = getenv("TZ");
+    hadOld = (old != nullptr);
+    if (hadOld) oldTz = old;
+    setenv("TZ", tz.c_str(), 1);
+    tzset();
+  }
+  ~ScopedTz() {
+    if (hadOld) {
+      setenv("TZ", oldTz.c_str(), 1);
+    } else {
+      unsetenv("TZ");
+    }
+    tzset();
+  }
+  ScopedTz(const ScopedTz&) = delete;
+  ScopedTz& operator=(const ScopedTz&) = delete;
+private:
+  bool hadOld = false;
+  std::string oldTz;
+};
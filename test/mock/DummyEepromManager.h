@@ -55,7 +55,7 @@ public:
    * @return        true 成功、false 失敗
    */
   bool writeByte(uint16_t address, const uint8_t data) override {
-    if(address >= SIZE) {
+    if(address >= SIZE || failWrite()) {
       return false;  // 範囲外アクセスを防止
     }
     memory[address] = data;  // 単一バイトの書き込み
@@ -64,6 +64,21 @@ public:
 //    std::cout << "writeBytes: data=" << static_cast<int>(data) << std::endl;
     return true;
   }
+  /**
+   * @brief         複数バイトのデータを書き込む
+   * @param address 書き込み開始アドレス
+   * @param data    書き込むデータ
+   * @param len     書き込むデータの長さ
+   * @return        true 成功、false 失敗
+   */
+  bool writeBytes(uint16_t address, const uint8_t *data, uint16_t len) override {
+    if(address + len > SIZE || failWrite()) {
+      return false;  // 範囲外アクセスを防止
+    }
+    memcpy(&memory[address], data, len);
+    return true;
+  }
+
 /*
   bool readBytes(int address, void* data, size_t len) override {
     // モックの EEPROM 読み込み処理
@@ -83,18 +98,77 @@ public:
       return false;  // 範囲外アクセスを防止
     }
     *data = memory[address];  // 単一バイトの読み込み
+    readByteCount++;
     return true;
   }
 
   bool readMultipleBytes(int address, uint8_t *data, size_t len) override {
     // モックの EEPROM 複数バイト読み込み処理
     memcpy(data, &memory[address], len);  // memcpy を使用
+    readMultipleCount++;
     return true;
   }
 
+  /**
+   * @brief         トランザクションを開始する（開始時点のメモリを退避）
+   * @return        true 成功
+   */
+  bool beginTransaction() override {
+    if (transactionDepth++ == 0) {
+      memcpy(savedMemory, memory, SIZE);
+    }
+    return true;
+  }
+
+  /**
+   * @brief         トランザクションを確定する
+   * @return        true 成功、false トランザクション中でない
+   */
+  bool commitTransaction() override {
+    if (transactionDepth == 0) {
+      return false;
+    }
+    if (--transactionDepth == 0) {
+      commitCount++;
+    }
+    return true;
+  }
+
+  /**
+   * @brief         トランザクションを破棄し、開始時点のメモリに戻す
+   */
+  void abortTransaction() override {
+    if (transactionDepth > 0) {
+      memcpy(memory, savedMemory, SIZE);
+      transactionDepth = 0;
+    }
+  }
+
+  int readByteCount = 0;      // readByte()の呼び出し回数
+  int readMultipleCount = 0;  // readMultipleBytes()の呼び出し回数
+  int commitCount = 0;        // 確定したトランザクション数
+  int writesBeforeFailure = -1; // この回数の書き込みの後は失敗させる（-1で無効）
+
 private:
+  /**
+   * @brief         書き込みを失敗させるか（writesBeforeFailureを消費する）
+   * @return        true 失敗させる
+   */
+  bool failWrite() {
+    if (writesBeforeFailure < 0) {
+      return false;
+    }
+    if (writesBeforeFailure == 0) {
+      return true;
+    }
+    writesBeforeFailure--;
+    return false;
+  }
+
   static const int SIZE = 1024;     // モックEEPROMのサイズ
   uint8_t memory[SIZE];             // モックEEPROMのメモリ配列
+  uint8_t savedMemory[SIZE];        // トランザクション開始時点のメモリ
+  int transactionDepth = 0;         // トランザクションの入れ子の深さ
   std::recursive_mutex dummyMutex;  // モック用のミューテックス
 };
 
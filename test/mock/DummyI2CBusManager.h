@@ -12,7 +12,7 @@ class DummyI2CBusManager : public I2CBusManager {
     std::vector<uint8_t> scanI2CBus(uint8_t , uint8_t ) override {
       return {}; // モックなので空のリストを返す
     }
-    std::string getDeviceName(uint8_t ) override { return "DummyDevice"; }
+    const char* getDeviceName(uint8_t ) override { return "DummyDevice"; }
 
     bool isEepromConnected() override { return false; }
     bool isM5oledConnected() override { return false; }
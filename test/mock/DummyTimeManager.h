@@ -1,13 +1,12 @@
 #pragma once
 
 #include "../../src/TimeManager.h"
-#include <string>
 
 class DummyTimeManager : public AbstractTimeManager {
 public:
   DummyTimeManager() : AbstractTimeManager() {}
 
-  void updateTimeZone(const std::string& ) override {
+  void updateTimeZone(const TimeZoneRule* ) override {
     return;
   }
 };
\ No newline at end of file
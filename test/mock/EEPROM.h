@@ -3,7 +3,7 @@
 
 class EEPROMClassMock {
 public:
-  static const int SIZE = 1024;
+  static const int SIZE = 8192;   // 24LC64相当の最大サイズ
   uint8_t memory[SIZE];
 
   // コンストラクタ
@@ -16,7 +16,7 @@ public:
   void begin(size_t size) {
     // EEPROMのサイズ設定や初期化を行う
     // 引数は実際のEEPROMサイズと一致させる
-    memset(memory, 0, size);  // メモリを初期化
+    memset(memory, 0, (size < (size_t)SIZE) ? size : (size_t)SIZE);  // メモリを初期化
   }
 
   void get(int address, void* data, size_t size) {
@@ -0,0 +1,126 @@
+#include "Eeprom24LC.h"
+#include <cstring>
+
+Eeprom24LC::Eeprom24LC(EepromBusStats& busStats)
+  : stats(busStats)
+{
+  erase();
+}
+
+/**
+ * @brief 容量を設定する
+ * @param bytes 容量（24LC32: 4096, 24LC64: 8192）
+ *  アドレスの上位bitは無視されるため、範囲外のアドレスは容量で折り返す。
+ */
+void Eeprom24LC::setCapacity(size_t bytes) {
+  memSize = (bytes > CAPACITY_24LC32) ? CAPACITY_24LC64 : CAPACITY_24LC32;
+}
+
+void Eeprom24LC::erase(uint8_t fill) {
+  memset(memory, fill, sizeof(memory));
+  stats.writeCycleEndNs = 0;
+  failNext = 0;
+  trace.clear();
+}
+
+bool Eeprom24LC::busy() const {
+  return stats.nowNs < stats.writeCycleEndNs;
+}
+
+uint8_t Eeprom24LC::peek(uint16_t address) const {
+  return memory[address % memSize];
+}
+
+/**
+ * @brief 書き込みトランザクション
+ * @param address 書き込み開始アドレス
+ * @param data 書き込むデータ
+ * @param len データのバイト数（0ならアドレス設定のみ）
+ * @return true ACK、false 書き込みサイクル中のためNAK
+ *  データはページバッファへ入り、アドレスの下位5bitだけが進むため
+ *  ページ末尾を越えた分は同じページの先頭へ折り返して上書きされる。
+ *  STOPでページバッファの内容を書き込み、内部書き込みサイクルを開始する。
+ */
+bool Eeprom24LC::write(uint16_t address, const uint8_t *data, size_t len) {
+  if (busy() || (failNext > 0)) {
+    if (!busy()) failNext--;
+    stats.naks++;
+    record(EepromTransactionKind::Write, address, len, 1, false);
+    return false;
+  }
+
+  uint16_t busBytes = static_cast<uint16_t>(3 + len);   // 制御バイト + EEPROM内アドレス(2byte) + データ
+  record(EepromTransactionKind::Write, address, len, busBytes, true);
+  stats.transactions++;
+  if (len == 0) {
+    return true;
+  }
+
+  uint8_t pageBuffer[PAGE_SIZE];
+  bool loaded[PAGE_SIZE] = {false};
+  size_t pageBase = (address % memSize) & ~(PAGE_SIZE - 1);
+  size_t offset = address % PAGE_SIZE;
+  for (size_t i = 0; i < len; ++i) {
+    pageBuffer[offset] = data[i];
+    loaded[offset] = true;
+    offset = (offset + 1) % PAGE_SIZE;    // ページ内でロールオーバー
+  }
+  for (size_t i = 0; i < PAGE_SIZE; ++i) {
+    if (loaded[i]) {
+      memory[pageBase + i] = pageBuffer[i];
+      stats.programmedBytes++;
+    }
+  }
+  stats.pageWrites[(pageBase / PAGE_SIZE) % EepromBusStats::PAGE_COUNT]++;
+  stats.writeCycleEndNs = stats.nowNs + stats.writeCycleNs;
+  return true;
+}
+
+/**
+ * @brief 読み込みトランザクション
+ * @param address 読み込み開始アドレス
+ * @param data 読み込み先
+ * @param len 読み込むバイト数
+ * @return true ACK、false 書き込みサイクル中のためNAK
+ *  連続読み込みはメモリ末尾を越えると先頭へ折り返す。
+ */
+bool Eeprom24LC::read(uint16_t address, uint8_t *data, size_t len) {
+  if (busy() || (failNext > 0)) {
+    if (!busy()) failNext--;
+    stats.naks++;
+    record(EepromTransactionKind::Read, address, len, 1, false);
+    return false;
+  }
+
+  uint16_t busBytes = static_cast<uint16_t>(4 + len);   // アドレス設定(3byte) + リスタート後の制御バイト + データ
+  record(EepromTransactionKind::Read, address, len, busBytes, true);
+  stats.transactions++;
+  for (size_t i = 0; i < len; ++i) {
+    data[i] = memory[(address + i) % memSize];
+  }
+  return true;
+}
+
+/**
+ * @brief ACKポーリング（制御バイトのみ送信）
+ * @return true 書き込み完了（ACK）、false 書き込みサイクル中（NAK）
+ */
+bool Eeprom24LC::pollAck(void) {
+  bool acked = !busy();
+  stats.ackPolls++;
+  record(EepromTransactionKind::AckPoll, 0, 0, 1, acked);
+  return acked;
+}
+
+/**
+ * @brief バス転送時間を仮想時刻へ積算し、必要ならトランザクションを記録する
+ *  ACK/NAKの判定はバス転送前の時刻で行う。
+ */
+void Eeprom24LC::record(EepromTransactionKind kind, uint16_t address, size_t dataLen, uint16_t busBytes, bool acked) {
+  uint64_t startNs = stats.nowNs;
+  uint64_t durationNs = stats.transfer(busBytes);
+  if (traceEnabled) {
+    EepromTransaction t = {kind, address, static_cast<uint16_t>(dataLen), busBytes, acked, startNs, durationNs};
+    trace.push_back(t);
+  }
+}
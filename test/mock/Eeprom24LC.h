@@ -0,0 +1,73 @@
+/**
+ * @file      Eeprom24LC.h
+ * @brief     24LC32/24LC64 I2C EEPROMの動作モデル（ホストテスト用）
+ * @details   I2Cトランザクション単位でデバイスの振る舞いを模擬する。
+ *            - 32バイトのページバッファ（ページ内で下位5bitのみ進むロールオーバー）
+ *            - STOP後の内部書き込みサイクル中は制御バイトにNAKを返す
+ *            - 連続読み込みはメモリ末尾で先頭へ折り返す
+ *            時間とバス使用量はEepromBusStatsの仮想時刻・カウンタへ積算する。
+ * @version   0.1
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "EepromBusStats.h"
+
+/**
+ * @brief I2Cトランザクションの種類
+ */
+enum class EepromTransactionKind {
+  Write,    // アドレス設定 + データ書き込み
+  Read,     // ランダム読み込み（アドレス設定 + リスタート + 連続読み込み）
+  AckPoll   // 制御バイトのみ送信
+};
+
+/**
+ * @brief トランザクション1回分の記録
+ */
+struct EepromTransaction {
+  EepromTransactionKind kind;
+  uint16_t address;     // EEPROM内アドレス（ACKポーリングは0）
+  uint16_t dataLen;     // データのバイト数
+  uint16_t busBytes;    // バス上の転送バイト数
+  bool acked;           // デバイスが制御バイトにACKを返したか
+  uint64_t startNs;     // 開始時刻（仮想時刻）[ns]
+  uint64_t durationNs;  // バス占有時間[ns]
+};
+
+class Eeprom24LC {
+public:
+  static constexpr size_t PAGE_SIZE = EEPROM_PAGE_SIZE;
+  static constexpr size_t CAPACITY_24LC32 = 4096;
+  static constexpr size_t CAPACITY_24LC64 = 8192;
+
+  bool traceEnabled = false;              // trueでトランザクションをtraceへ記録する
+  uint32_t failNext = 0;                  // 次のこの回数の読み書きにNAKを返す（配線不良・未接続の模擬）
+  std::vector<EepromTransaction> trace;   // トランザクションの記録
+
+  explicit Eeprom24LC(EepromBusStats& busStats);
+
+  void setCapacity(size_t bytes);         // 容量を設定（24LC32: 4096, 24LC64: 8192）
+  size_t capacity() const { return memSize; }
+  void erase(uint8_t fill = 0xFF);        // 全領域を消去し、書き込みサイクルと記録をクリアする
+  bool busy() const;                      // 内部書き込みサイクル中か
+  uint8_t peek(uint16_t address) const;   // バスを使わずにメモリを参照する
+
+  bool write(uint16_t address, const uint8_t *data, size_t len);  // 書き込みトランザクション
+  bool read(uint16_t address, uint8_t *data, size_t len);         // 読み込みトランザクション
+  bool pollAck(void);                                             // ACKポーリング
+
+private:
+  EepromBusStats& stats;
+  size_t memSize = CAPACITY_24LC32;
+  uint8_t memory[CAPACITY_24LC64];
+
+  void record(EepromTransactionKind kind, uint16_t address, size_t dataLen, uint16_t busBytes, bool acked);
+};
+
+extern Eeprom24LC eeprom24lc;  // モックEepromRawAccessorが使うデバイスの実体
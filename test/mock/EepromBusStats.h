@@ -0,0 +1,65 @@
+/**
+ * @file      EepromBusStats.h
+ * @brief     EEPROMモックのバス使用量カウンタ
+ * @details   Eeprom24LC（デバイスモデル）が受け付けたI2Cトランザクション数と、
+ *            実機で掛かるバス占有時間・書き込みサイクル待ち時間の見積りを積算する。
+ *            時間は仮想時刻で管理する。
+ * @version   0.1
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include "../../src/Config.h"
+
+struct EepromBusStats {
+  static constexpr uint64_t BYTE_TIME_NS = 9ULL * 1000000000ULL / I2C_FREQ;  // 1バイト(8bit+ACK)の転送時間[ns]
+
+  uint64_t writeCycleNs = 5000000ULL; // 書き込みサイクル時間[ns]（24LC32のtWC最大値）
+  bool flashBackend = false;          // I2C EEPROM未接続（ESP32のEEPROMを使用）を模擬
+
+  uint32_t transactions = 0;  // 読み書きのI2Cトランザクション数（ACKポーリングを除く）
+  uint32_t ackPolls = 0;      // ACKポーリング回数
+  uint32_t naks = 0;          // 書き込みサイクル中に読み書きしようとしてNAKとなった回数
+  uint32_t bytes = 0;         // バス上の転送バイト数（デバイスアドレス・EEPROM内アドレスを含む）
+  uint64_t busyNs = 0;        // 呼び出し側がバス転送・書き込み完了待ちに費やした時間[ns]
+  uint64_t nowNs = 0;         // 仮想時刻[ns]
+  uint64_t writeCycleEndNs = 0; // 書き込みサイクル終了時刻[ns]
+  uint32_t flashCommits = 0;    // ESP32のEEPROMのcommit回数（フラッシュのセクタ書き換え回数）
+
+  static constexpr size_t PAGE_COUNT = (EEPROM_MAX_ADDRESS + EEPROM_PAGE_SIZE) / EEPROM_PAGE_SIZE;
+  uint32_t programmedBytes = 0;           // EEPROMに書き込んだデータのバイト数
+  uint32_t pageWrites[PAGE_COUNT] = {0};  // ページごとの書き込みサイクル回数（書き換え寿命の消費）
+
+  // 最も書き込みサイクルの多いページの回数
+  uint32_t maxPageWrites() const {
+    uint32_t maxWrites = 0;
+    for (size_t i = 0; i < PAGE_COUNT; ++i) {
+      if (pageWrites[i] > maxWrites) maxWrites = pageWrites[i];
+    }
+    return maxWrites;
+  }
+
+  void reset() { *this = EepromBusStats(); }
+
+  // 仮想時刻を進める（バス以外の処理時間の模擬）
+  void advance(uint64_t ns) { nowNs += ns; }
+
+  /**
+   * @brief バス転送を積算し、仮想時刻を進める
+   * @param busBytes バス上の転送バイト数
+   * @return 転送時間[ns]
+   */
+  uint64_t transfer(uint16_t busBytes) {
+    uint64_t t = (uint64_t)busBytes * BYTE_TIME_NS;
+    bytes += busBytes;
+    busyNs += t;
+    nowNs += t;
+    return t;
+  }
+};
+
+extern EepromBusStats eepromBusStats;  // モックEepromRawAccessorのカウンタ実体
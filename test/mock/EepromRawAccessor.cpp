@@ -1,6 +1,11 @@
 #include "../../src/EepromRawAccessor.h"
+#include "EepromBusStats.h"
+#include "Eeprom24LC.h"
 #include <cstring>  // 追加
 
+EepromBusStats eepromBusStats;          // バス使用量カウンタ
+Eeprom24LC eeprom24lc(eepromBusStats);  // I2C EEPROMのデバイスモデル
+
 EepromRawAccessor::EepromRawAccessor(I2CBusManager *busManager)
   : i2cBus(busManager)  // I2CBusManagerの参照を設定
 {
@@ -21,9 +26,108 @@ bool EepromRawAccessor::writeBytes(int address, const void* data, size_t len) {
 }
 */
 
+bool EepromRawAccessor::writeBytes(uint16_t address, const uint8_t *data, uint16_t len) {
+  if (data == nullptr || len == 0) return false;  // データなし
+  if (address + len > EEPROM_SIZE) return false;  // 範囲外アクセスを防止
+
+  if (eepromBusStats.flashBackend) {
+    if (eeprom) memcpy(eeprom + address, data, len);   // ESP32のEEPROMに書き込み
+    eepromBusStats.flashCommits++;
+    return true;
+  }
+  // 実機と同じくページ境界で分割し、ページごとに書き込み完了を待つ
+  while (len > 0) {
+    uint16_t chunk = pageChunkLength(address, len);
+    if (!i2cWritePage(address, data, chunk)) {
+      return false;
+    }
+    address += chunk;
+    data += chunk;
+    len -= chunk;
+  }
+  return true;
+}
+
 bool EepromRawAccessor::writeByte(unsigned short address, unsigned char data) {
-    // ダミー実装（必要に応じて本実装）
+  if (address >= EEPROM_SIZE) return false;       // 範囲外アクセスを防止
+  if (eepromBusStats.flashBackend) {
+    return writeBytes(address, &data, 1);
+  }
+  return i2cWriteByte(address, data);
+}
+
+bool EepromRawAccessor::i2cWriteByte(uint16_t address, uint8_t data) {
+  return i2cWritePage(address, &data, 1);
+}
+
+bool EepromRawAccessor::i2cWritePage(uint16_t address, const uint8_t *data, uint8_t len) {
+  if (!i2cStartPageWrite(address, data, len)) {
+    return false;
+  }
+  writeInProgress = true;
+  return waitWriteComplete();                     // 書き込み完了待ち
+}
+
+bool EepromRawAccessor::i2cStartPageWrite(uint16_t address, const uint8_t *data, uint8_t len) {
+  if (writeInProgress) waitWriteComplete();       // 前回の書き込みサイクル完了待ち
+  return eeprom24lc.write(address, data, len);
+}
+
+bool EepromRawAccessor::startPageWrite(uint16_t address, const uint8_t *data, uint8_t len) {
+  if (data == nullptr || len == 0) return false;          // データなし
+  if (address + len > EEPROM_SIZE) return false;          // 範囲外アクセスを防止
+  if (pageChunkLength(address, len) != len) return false; // ページ境界を跨ぐ書き込みは不可
+
+  if (eepromBusStats.flashBackend) {
+    if (eeprom) memcpy(eeprom + address, data, len);      // ESP32のEEPROMに書き込み
+    if (batchActive) {
+      batchDirty = true;
+    } else {
+      eepromBusStats.flashCommits++;
+    }
     return true;
+  }
+
+  if (!i2cStartPageWrite(address, data, len)) {
+    return false;
+  }
+  writeInProgress = true;
+  return true;
+}
+
+bool EepromRawAccessor::usesWriteCycle(void) {
+  return !eepromBusStats.flashBackend;
+}
+
+void EepromRawAccessor::beginBatch(void) {
+  batchActive = true;
+  batchDirty = false;
+}
+
+bool EepromRawAccessor::commitBatch(void) {
+  if (batchDirty) {
+    eepromBusStats.flashCommits++;
+  }
+  batchActive = false;
+  batchDirty = false;
+  return true;
+}
+
+WriteCycleState EepromRawAccessor::pollWriteComplete(void) {
+  if (!writeInProgress) {
+    return WriteCycleState::Complete;
+  }
+  if (eeprom24lc.pollAck()) {
+    writeInProgress = false;
+    return WriteCycleState::Complete;
+  }
+  return WriteCycleState::InProgress;
+}
+
+bool EepromRawAccessor::waitWriteComplete(void) {
+  while (pollWriteComplete() == WriteCycleState::InProgress) {
+  }
+  return true;
 }
 
 /*
@@ -35,12 +139,30 @@ bool EepromRawAccessor::readBytes(int address, void* data, size_t len) {
 */
 
 bool EepromRawAccessor::readByte(unsigned short address, unsigned char* data) {
-    // ダミー実装（必要に応じて本実装）
-    if (data) *data = 0;
-    return true;
+  if (data == nullptr) return false;
+  if (address >= EEPROM_SIZE) return false;       // 範囲外アクセスを防止
+  if (eepromBusStats.flashBackend) {
+    return sequentialRead(address, data, 1);
+  }
+  return i2cReadByte(address, data);
+}
+
+bool EepromRawAccessor::i2cReadByte(uint16_t address, uint8_t *data) {
+  return i2cSequentialRead(0, address, data, 1);
 }
 
 bool EepromRawAccessor::sequentialRead(uint16_t eeADR ,uint8_t *data,uint8_t dataNum){
-  uint8_t i=0;
-  return true;
+  if (data == nullptr) return false;
+  if (eeADR + dataNum > EEPROM_SIZE) return false;  // 範囲外アクセスを防止
+  if (eepromBusStats.flashBackend) {
+    if (eeprom) memcpy(data, eeprom + eeADR, dataNum);   // ESP32のEEPROMから読み込み
+    return true;
+  }
+  return i2cSequentialRead(0, eeADR, data, dataNum);
+}
+
+bool EepromRawAccessor::i2cSequentialRead(uint8_t i2cADR, uint16_t eeADR ,uint8_t *data,uint8_t dataNum){
+  (void)i2cADR;
+  if (writeInProgress) waitWriteComplete();       // 書き込みサイクル中はNAKとなるため完了を待つ
+  return eeprom24lc.read(eeADR, data, dataNum);
 }
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <deque>
+#include "../../src/I2CTransport.h"
+
+/**
+ * @brief 仮想時計で転送を完了させるI2CTransport（ホスト用）
+ * - 転送時間はビット数（アドレス・データ各9bit + スタート/ストップ）とSCL周波数から求める
+ * - 転送は受付順に1件ずつ行い、advance()で時計を進めると完了時刻を過ぎた転送の完了を通知する
+ * - デバイスの応答はsetDevice()で設定する（未設定なら常にACK、受信データは0）
+ */
+class FakeI2CTransport : public I2CTransport {
+public:
+  using Device = std::function<I2CTransferStatus(const I2CTransfer& transfer, uint8_t *rx)>;
+  static constexpr size_t MAX_IN_FLIGHT = 8;
+
+  explicit FakeI2CTransport(uint32_t clockHz = 400000) : clockHz(clockHz) {}
+
+  void setDevice(Device value) { device = value; }
+  uint32_t now() const { return nowUs; }
+
+  bool submit(const I2CTransfer& transfer, Complete complete) override {
+    if (queue.size() >= MAX_IN_FLIGHT) return false;
+    uint32_t startUs = (busFreeUs > nowUs) ? busFreeUs : nowUs;
+    busFreeUs = startUs + durationUs(transfer, clockHz);
+    queue.push_back(Pending{transfer, complete, busFreeUs});
+    return true;
+  }
+  size_t inFlight() const override { return queue.size(); }
+
+  // 時計を進め、完了した転送を通知する
+  void advance(uint32_t us) {
+    nowUs += us;
+    while (!queue.empty() && queue.front().doneUs <= nowUs) {
+      Pending done = queue.front();
+      queue.pop_front();
+      I2CTransferStatus status = I2CTransferStatus::Ok;
+      if (device) {
+        status = device(done.transfer, done.transfer.rx);
+      } else if (done.transfer.rx != nullptr) {
+        memset(done.transfer.rx, 0, done.transfer.rxLen);
+      }
+      if (done.complete) done.complete(status);
+    }
+  }
+
+  // 転送時間[us]（切り上げ）
+  static uint32_t durationUs(const I2CTransfer& transfer, uint32_t hz) {
+    uint32_t bits = 2;                                          // スタート・ストップ
+    if (transfer.txLen > 0 || transfer.rxLen == 0) bits += (1 + transfer.txLen) * 9;
+    if (transfer.rxLen > 0) bits += 1 + (1 + transfer.rxLen) * 9;   // リピーテッドスタート
+    return (uint32_t)(((uint64_t)bits * 1000000 + hz - 1) / hz);
+  }
+
+private:
+  struct Pending {
+    I2CTransfer transfer;
+    Complete complete;
+    uint32_t doneUs;
+  };
+  uint32_t clockHz;
+  uint32_t nowUs = 0;
+  uint32_t busFreeUs = 0;
+  std::deque<Pending> queue;
+  Device device;
+};
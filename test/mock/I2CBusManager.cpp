@@ -1,9 +1,23 @@
-//#include "../../src/I2CBusManager.h"
-//#include "../mock/I2CBusManager.h"
-#include "I2CBusManager.h"
+// src/I2CBusManager.hのホスト用実装（Wireを使わない）
+#include "../../src/I2CBusManager.h"
 
 void I2CBusManager::begin() {}
-std::recursive_mutex& I2CBusManager::getMutex() { static std::recursive_mutex m; return m; }
+std::recursive_mutex& I2CBusManager::getMutex() { return i2cMutex; }
 
 TwoWire& I2CBusManager::getWire() { static TwoWire w(0); return w; }
 std::vector<uint8_t> I2CBusManager::scanI2CBus(uint8_t, uint8_t) { return {}; }
+const char* I2CBusManager::getDeviceName(uint8_t address) { return I2CDeviceRegistry::nameOf(address); }
+bool I2CBusManager::isEepromConnected() { return presence.isPresent(I2CADR_EEPROM); }
+bool I2CBusManager::isM5oledConnected() { return presence.isPresent(I2CADR_M5OLED); }
+bool I2CBusManager::probeAddress(uint8_t) { return false; }
+void I2CBusManager::setBusClock(uint32_t) {}
+void I2CBusManager::calibrateClocks(void) {}
+void I2CBusManager::beginScan(void) {
+  std::vector<uint8_t> known;
+  for (size_t i = 0; i < I2CDeviceRegistry::COUNT; ++i) known.push_back(I2CDeviceRegistry::at(i).address);
+  scanner.onProgress([this](const I2CScanProgress& progress) {
+    if (scanProgressCallback) scanProgressCallback(progress);
+  });
+  std::lock_guard<std::recursive_mutex> lock(i2cMutex);
+  scanner.startCold(known.data(), known.size());
+}
@@ -12,8 +12,12 @@
 namespace
 {
   using ::testing::AtLeast;
+  using ::testing::DoAll;
+  using ::testing::HasSubstr;
   using ::testing::Return;
+  using ::testing::SaveArg;
   using ::testing::Test;
+  using ::testing::_;
 
   class SerialMonitorTest : public Test {
     protected:
@@ -65,4 +69,54 @@ namespace
     EXPECT_EQ(true, serialMonitor.exec()); // 期待値：true
   }
 
+  TEST_F(SerialMonitorTest, i2cstat)
+  {
+    uint32_t clockUs = 0;
+    i2cbusManager.setTimeSource([&]() { return clockUs; });
+    {
+      I2CTransaction transaction(i2cbusManager, I2CADR_EEPROM);
+      transaction.addBytes(32);
+      clockUs += 300;
+    }
+    {
+      I2CTransaction transaction(i2cbusManager, I2CADR_EEPROM);
+      transaction.setResult(I2CResult::Busy);
+      clockUs += 20;
+    }
+
+    std::string out;
+    EXPECT_CALL(mock, rsv()).WillOnce(Return("i2cstat"));
+    EXPECT_CALL(mock, send(_)).WillOnce(DoAll(SaveArg<0>(&out), Return(1)));
+    EXPECT_EQ(true, serialMonitor.exec());
+    // アドレス・件数・バイト数・NAK・BUSY・ERR・平均・最大
+    EXPECT_THAT(out, HasSubstr("0x50        2       32      0      1      0    160    300  DummyDevice\n"));
+    EXPECT_THAT(out, HasSubstr("lock: acquisitions 2, contended 0"));
+
+    EXPECT_CALL(mock, rsv()).WillOnce(Return("i2cstat reset"));
+    EXPECT_CALL(mock, send("I2C statistics reset.\n")).WillOnce(Return(1));
+    EXPECT_EQ(true, serialMonitor.exec());
+    I2CDeviceStats devices[I2CBusStats::MAX_DEVICES];
+    EXPECT_EQ(0u, i2cbusManager.getDeviceStats(devices, I2CBusStats::MAX_DEVICES));
+  }
+
+  TEST_F(SerialMonitorTest, eepromdumpSpreadsOverExecCalls)
+  {
+    const uint8_t text[] = {'H', 'e', 'l', 'l', 'o'};
+    eepromManager.writeBytes(0x0120, text, sizeof(text));
+
+    std::string out;
+    EXPECT_CALL(mock, rsv()).WillOnce(Return("eepromdump 0x100 0x60")).WillOnce(Return(""));   // ダンプ中は入力を読まない
+    EXPECT_CALL(mock, send(_)).WillRepeatedly(::testing::Invoke([&](std::string data) { out += data; return 1; }));
+
+    EXPECT_EQ(true, serialMonitor.exec());       // 0x100〜0x11F
+    EXPECT_EQ(std::string::npos, out.find("\n0120"));
+    EXPECT_EQ(true, serialMonitor.exec());       // 0x120〜0x13F
+    EXPECT_THAT(out, HasSubstr("\n0120  48 65 6c 6c 6f 00"));
+    EXPECT_EQ(std::string::npos, out.find("\n0140"));
+    EXPECT_EQ(true, serialMonitor.exec());       // 0x140〜0x15F（終了）
+    EXPECT_THAT(out, HasSubstr("\n0150 "));
+    EXPECT_EQ(out.find("ADDR"), out.rfind("ADDR"));  // ヘッダは先頭の1回のみ
+    EXPECT_EQ(true, serialMonitor.exec());       // ダンプが終わると入力の読み込みに戻る
+  }
+
 } // namespace
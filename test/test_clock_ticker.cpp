@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+
+#include "../src/ClockTicker.h"
+
+// 時刻の読み込みを模擬する（実時間[us]から UNIX時間と秒未満を返す）
+struct FakeClock {
+  int64_t realUs = 0;               // 実時間（0 のとき UNIX時間 baseEpoch ちょうど）
+  time_t baseEpoch = 0;
+  uint32_t microsOffset = 0xFFF00000UL;   // micros() の値（途中で桁あふれさせる）
+  bool available = true;
+  int reads = 0;
+
+  uint32_t micros(void) const { return static_cast<uint32_t>(microsOffset + realUs); }
+  ClockTicker::TimeSource source(void) {
+    return [this](time_t& epoch, uint32_t& subUs) {
+      reads++;
+      if (!available) return false;
+      epoch = baseEpoch + static_cast<time_t>(realUs / ClockTicker::SECOND_US);
+      subUs = static_cast<uint32_t>(realUs % ClockTicker::SECOND_US);
+      return true;
+    };
+  }
+};
+
+static time_t utc(int hour, int minute, int second) {
+  return 1700000000 - (1700000000 % 86400) + hour * 3600 + minute * 60 + second;   // 2023-11-14 のUTC
+}
+
+// 秒の境界から1ms以内に刻み、時刻は実時間の秒と一致する
+TEST(ClockTickerTest, FlipsWithinOneMillisecondOfTheSecond) {
+  FakeClock clock;
+  clock.baseEpoch = utc(12, 0, 0);
+  clock.realUs = 300000;
+  ClockTicker ticker;
+  std::vector<int64_t> tickAt;
+  ticker.onTick([&](const struct tm&, uint8_t) { tickAt.push_back(clock.realUs); });
+  ticker.begin(clock.source(), nullptr, clock.micros());
+  ASSERT_TRUE(ticker.isSynced());
+  ASSERT_EQ(1u, tickAt.size());
+  EXPECT_EQ(clock.baseEpoch, ticker.getEpoch());
+  EXPECT_EQ(700000u, ticker.untilNextUs(clock.micros()));
+
+  for (clock.realUs = 300000; clock.realUs < 200 * 1000000LL; clock.realUs += 250) {   // 250usごとに呼ぶ
+    ticker.update(clock.micros());
+    EXPECT_EQ(clock.baseEpoch + clock.realUs / 1000000, ticker.getEpoch()) << clock.realUs;
+  }
+  ASSERT_EQ(1u + 199, tickAt.size());
+  for (size_t i = 1; i < tickAt.size(); ++i) {
+    EXPECT_LT(tickAt[i] % 1000000, 1000) << i;
+  }
+}
+
+// 時刻を読むのは再同期の間隔ごとに1回（100msごとに読む場合の1/600）
+TEST(ClockTickerTest, ReadsSourceOncePerResyncInterval) {
+  FakeClock clock;
+  clock.baseEpoch = utc(8, 30, 0);
+  ClockTicker ticker;
+  int ticks = 0;
+  ticker.onTick([&](const struct tm&, uint8_t) { ticks++; });
+  ticker.begin(clock.source(), nullptr, clock.micros());
+  const int seconds = 10 * ClockTicker::RESYNC_INTERVAL_S;
+  for (clock.realUs = 0; clock.realUs <= seconds * 1000000LL; clock.realUs += 1000) {
+    ticker.update(clock.micros());
+  }
+  EXPECT_EQ(1 + seconds, ticks);
+  EXPECT_EQ(1 + seconds / ClockTicker::RESYNC_INTERVAL_S, clock.reads);
+  EXPECT_EQ(static_cast<uint32_t>(clock.reads), ticker.getSourceReads());
+}
+
+// 変わった欄だけを返す（桁上がり・日付の変わり目）
+TEST(ClockTickerTest, ReportsChangedFields) {
+  FakeClock clock;
+  clock.baseEpoch = utc(23, 58, 58);
+  ClockTicker ticker;
+  std::vector<uint8_t> changes;
+  ticker.onTick([&](const struct tm&, uint8_t changed) { changes.push_back(changed); });
+  ticker.begin(clock.source(), nullptr, clock.micros());
+  for (clock.realUs = 0; clock.realUs <= 3 * 1000000LL; clock.realUs += 1000) {
+    ticker.update(clock.micros());
+  }
+  ASSERT_EQ(4u, changes.size());
+  EXPECT_EQ(ClockTicker::FIELD_ALL, changes[0]);      // 23:58:58
+  EXPECT_EQ(ClockTicker::FIELD_SEC, changes[1]);      // 23:58:59
+  EXPECT_EQ(ClockTicker::FIELD_SEC | ClockTicker::FIELD_MIN, changes[2]);   // 23:59:00
+  EXPECT_EQ(ClockTicker::FIELD_SEC, changes[3]);      // 23:59:01
+
+  clock.baseEpoch = utc(23, 59, 59);
+  clock.realUs = 0;
+  ticker.begin(clock.source(), nullptr, clock.micros());
+  clock.realUs += 1000000;
+  ticker.update(clock.micros());
+  EXPECT_EQ(ClockTicker::FIELD_ALL, changes.back());  // 00:00:00（日付も変わる）
+  EXPECT_EQ(0, ticker.getLocal().tm_hour);
+}
+
+// 呼び出しが遅れたら遅れた秒数をまとめて進める
+TEST(ClockTickerTest, CatchesUpAfterLateUpdate) {
+  FakeClock clock;
+  clock.baseEpoch = utc(10, 0, 0);
+  ClockTicker ticker;
+  ticker.begin(clock.source(), nullptr, clock.micros());
+  clock.realUs = 3500000;
+  EXPECT_NE(0, ticker.update(clock.micros()));
+  EXPECT_EQ(clock.baseEpoch + 3, ticker.getEpoch());
+  EXPECT_EQ(3, ticker.getLocal().tm_sec);
+  EXPECT_EQ(500000u, ticker.untilNextUs(clock.micros()));
+}
+
+// 時刻が変わったら（SNTP同期など）次の境界で読み直す
+TEST(ClockTickerTest, ResyncFollowsSteppedTime) {
+  FakeClock clock;
+  clock.baseEpoch = utc(6, 0, 0);
+  ClockTicker ticker;
+  ticker.begin(clock.source(), nullptr, clock.micros());
+  for (clock.realUs = 0; clock.realUs < 5 * 1000000LL; clock.realUs += 1000) {
+    ticker.update(clock.micros());
+  }
+  clock.baseEpoch += 3600;            // 1時間進める
+  clock.realUs += 400000;             // 位相もずらす
+  ticker.requestResync();
+  ticker.update(clock.micros());
+  EXPECT_EQ(clock.baseEpoch + clock.realUs / 1000000, ticker.getEpoch());
+  EXPECT_EQ(1000000u - clock.realUs % 1000000, ticker.untilNextUs(clock.micros()));
+}
+
+// 最初の時刻が読めるまでは刻まず、読めたら始める
+TEST(ClockTickerTest, WaitsForFirstReading) {
+  FakeClock clock;
+  clock.baseEpoch = utc(0, 0, 0);
+  clock.available = false;
+  ClockTicker ticker;
+  int ticks = 0;
+  ticker.onTick([&](const struct tm&, uint8_t) { ticks++; });
+  ticker.begin(clock.source(), nullptr, clock.micros());
+  EXPECT_FALSE(ticker.isSynced());
+  clock.realUs = ClockTicker::RETRY_US / 2;
+  EXPECT_EQ(0, ticker.update(clock.micros()));
+  EXPECT_EQ(1, clock.reads);            // 読み直すのは RETRY_US 後
+  clock.available = true;
+  clock.realUs = ClockTicker::RETRY_US;
+  EXPECT_EQ(ClockTicker::FIELD_ALL, ticker.update(clock.micros()));
+  EXPECT_EQ(1, ticks);
+}
+
+// 変わった欄だけを書き換える
+TEST(ClockTickerTest, FormatsChangedFieldsOnly) {
+  char text[] = "LOC:xx:xx:xx";
+  struct tm t = {};
+  t.tm_hour = 9;
+  t.tm_min = 5;
+  t.tm_sec = 7;
+  ClockTicker::formatHms(text + 4, t, ClockTicker::FIELD_SEC);
+  EXPECT_STREQ("LOC:xx:xx:07", text);
+  ClockTicker::formatHms(text + 4, t, ClockTicker::FIELD_ALL);
+  EXPECT_STREQ("LOC:09:05:07", text);
+}
@@ -1,6 +1,12 @@
 #include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
 #include "../src/EepromManager.h"
 #include "mock/DummyI2CBusManager.h"  // 必要ならモックをインクルード
+#include "mock/EepromBusStats.h"      // モックEEPROMのバス使用量カウンタ
+#include "mock/Eeprom24LC.h"          // 24LC32/24LC64のデバイスモデル
 
 class DummyEepromRawAccess{
 };
@@ -23,6 +29,8 @@ protected:
   void SetUp() override {
     // 必要なら初期化
   //  eepromManager.begin();
+    eeprom24lc.erase();
+    eepromBusStats.reset();
   }
 
   void TearDown() override {
@@ -37,7 +45,420 @@ TEST_F(EepromManagerTest, WriteAndReadBytes) {
 
   EXPECT_TRUE(eepromManager.writeByte(0, 1));
   EXPECT_TRUE(eepromManager.readByte(0, &readData[0]));
-  EXPECT_EQ(0, readData[0]);
+  EXPECT_EQ(1, readData[0]);   // RAMシャドウから書き込んだ値が読める
 }
 
-// 他のテストケースもここに追加
\ No newline at end of file
+/**
+ * @brief ページ境界での分割長の確認
+ */
+TEST_F(EepromManagerTest, PageChunkLength) {
+  EXPECT_EQ(16, EepromRawAccessor::pageChunkLength(0x0010, 50));   // ページ途中から開始
+  EXPECT_EQ(32, EepromRawAccessor::pageChunkLength(0x0020, 50));   // ページ先頭から開始
+  EXPECT_EQ(2,  EepromRawAccessor::pageChunkLength(0x0040, 2));    // ページ内に収まる
+  EXPECT_EQ(1,  EepromRawAccessor::pageChunkLength(0x003F, 9));    // ページ末尾
+}
+
+/**
+ * @brief 範囲外の複数バイト書き込みは失敗する
+ */
+TEST_F(EepromManagerTest, WriteBytesOutOfRange) {
+  uint8_t data[4] = {1, 2, 3, 4};
+  EXPECT_FALSE(eepromManager.writeBytes(EEPROM_MAX_ADDRESS - 2, data, sizeof(data)));
+}
+
+/**
+ * @brief 1バイト書き込みとページ書き込みのバス使用量比較（ベンチマーク）
+ * - 輝度9桁保存（Pr.8-16: 0x0018-0x0020）と全パラメータ初期化（0x0010-0x0041）を想定
+ * - トランザクション数と、実機での見積りバス時間（書き込みサイクル待ち含む）を比較する
+ * - EepromManagerはRAMシャドウで書き込みを遅延させるため、EepromRawAccessorを直接使う
+ */
+TEST_F(EepromManagerTest, PageWriteBenchmark) {
+  EepromRawAccessor rawAccessor(&mockBusManager);
+  struct Scenario {
+    const char* name;
+    uint16_t address;
+    uint16_t len;
+    uint32_t expectedPages;
+  };
+  const Scenario scenarios[] = {
+    {"setParameterBrDig (9 bytes)",   0x0018,  9, 2},
+    {"clearAllParameters (50 bytes)", 0x0010, 50, 3},
+  };
+  uint8_t data[64];
+  for (size_t i = 0; i < sizeof(data); ++i) data[i] = static_cast<uint8_t>(i);
+
+  for (const auto& sc : scenarios) {
+    // 1バイトずつ書き込み
+    eepromBusStats.reset();
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint16_t i = 0; i < sc.len; ++i) {
+      ASSERT_TRUE(rawAccessor.writeByte(sc.address + i, data[i]));
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    EepromBusStats byteStats = eepromBusStats;
+
+    // ページ書き込み
+    eepromBusStats.reset();
+    auto t2 = std::chrono::steady_clock::now();
+    ASSERT_TRUE(rawAccessor.writeBytes(sc.address, data, sc.len));
+    auto t3 = std::chrono::steady_clock::now();
+    EepromBusStats pageStats = eepromBusStats;
+
+    std::cout << "[bench] " << sc.name << "\n"
+              << "  byte write : " << byteStats.transactions << " transactions, "
+              << byteStats.bytes << " bus bytes, " << byteStats.busyNs / 1000 << " us on bus, host "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count() << " ns\n"
+              << "  page write : " << pageStats.transactions << " transactions, "
+              << pageStats.bytes << " bus bytes, " << pageStats.busyNs / 1000 << " us on bus, host "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(t3 - t2).count() << " ns\n";
+
+    EXPECT_EQ(sc.len, byteStats.transactions);
+    EXPECT_EQ(sc.expectedPages, pageStats.transactions);
+    EXPECT_LT(pageStats.bytes, byteStats.bytes);
+    EXPECT_LT(pageStats.busyNs * 4, byteStats.busyNs);   // 少なくとも4倍以上短縮
+  }
+}
+
+/**
+ * @brief デバイスモデルのページバッファ折り返しと書き込みサイクル中のNAK
+ */
+TEST_F(EepromManagerTest, DeviceModelPageRolloverAndNak) {
+  uint8_t data[40];
+  for (size_t i = 0; i < sizeof(data); ++i) data[i] = static_cast<uint8_t>(0xA0 + i);
+
+  eeprom24lc.traceEnabled = true;
+  ASSERT_TRUE(eeprom24lc.write(0x0040, data, sizeof(data)));   // 1ページ(32byte)を超える書き込み
+  EXPECT_EQ(data[32], eeprom24lc.peek(0x0040));   // 33バイト目以降はページ先頭へ折り返して上書き
+  EXPECT_EQ(data[39], eeprom24lc.peek(0x0047));
+  EXPECT_EQ(data[8],  eeprom24lc.peek(0x0048));
+  EXPECT_EQ(0xFF,     eeprom24lc.peek(0x0060));   // 次のページには書き込まれない
+  EXPECT_EQ(32u, eepromBusStats.programmedBytes);
+
+  uint8_t value = 0;
+  EXPECT_TRUE(eeprom24lc.busy());
+  EXPECT_FALSE(eeprom24lc.read(0x0040, &value, 1));            // 書き込みサイクル中はNAK
+  EXPECT_FALSE(eeprom24lc.write(0x0080, data, 1));
+  EXPECT_EQ(2u, eepromBusStats.naks);
+  EXPECT_EQ(1u, eepromBusStats.transactions);                  // NAKはトランザクションに数えない
+
+  eepromBusStats.advance(eepromBusStats.writeCycleNs);
+  EXPECT_TRUE(eeprom24lc.pollAck());
+  EXPECT_TRUE(eeprom24lc.read(0x0041, &value, 1));
+  EXPECT_EQ(data[33], value);
+
+  // 連続読み込みはメモリ末尾で先頭へ折り返す
+  uint8_t wrap[2] = {0};
+  ASSERT_TRUE(eeprom24lc.read(static_cast<uint16_t>(eeprom24lc.capacity() - 1), wrap, sizeof(wrap)));
+  EXPECT_EQ(0xFF, wrap[0]);
+  EXPECT_EQ(eeprom24lc.peek(0x0000), wrap[1]);
+
+  // トランザクションごとのバイト数
+  ASSERT_EQ(6u, eeprom24lc.trace.size());
+  EXPECT_EQ(3u + 40u, eeprom24lc.trace[0].busBytes);
+  EXPECT_TRUE(eeprom24lc.trace[0].acked);
+  EXPECT_EQ(1u, eeprom24lc.trace[1].busBytes);
+  EXPECT_FALSE(eeprom24lc.trace[1].acked);
+  EXPECT_EQ(EepromTransactionKind::AckPoll, eeprom24lc.trace[3].kind);
+  EXPECT_EQ(4u + 1u, eeprom24lc.trace[4].busBytes);
+  eeprom24lc.traceEnabled = false;
+}
+
+/**
+ * @brief 書き戻した内容が再起動後に読み出せること、その際のバス時間
+ * - 書き戻しはページ2回で、各ページの書き込みサイクルを待つ
+ * - 起動時はEEPROM全体を128バイトずつ読み込む
+ */
+TEST_F(EepromManagerTest, WriteBackSurvivesReboot) {
+  eepromManager.setFlushDelay(0);
+  uint8_t data[40];
+  for (size_t i = 0; i < sizeof(data); ++i) data[i] = static_cast<uint8_t>(i * 3);
+  ASSERT_TRUE(eepromManager.writeBytes(0x0010, data, sizeof(data)));
+  ASSERT_TRUE(eepromManager.flush());
+
+  EXPECT_EQ(2u, eepromBusStats.transactions);
+  EXPECT_EQ(1u, eepromBusStats.pageWrites[0]);        // 0x0010-0x001F
+  EXPECT_EQ(1u, eepromBusStats.pageWrites[1]);        // 0x0020-0x0037
+  EXPECT_GE(eepromBusStats.nowNs, 2 * eepromBusStats.writeCycleNs);
+
+  eepromBusStats.reset();
+  EepromManager rebooted(&mockBusManager);
+  rebooted.begin();
+  uint8_t readData[40] = {0};
+  ASSERT_TRUE(rebooted.readMultipleBytes(0x0010, readData, sizeof(readData)));
+  EXPECT_EQ(0, memcmp(data, readData, sizeof(data)));
+
+  const uint32_t chunks = (EEPROM_MAX_ADDRESS + 127) / 128;
+  std::cout << "[boot] shadow load " << eepromBusStats.transactions << " transactions, "
+            << eepromBusStats.busyNs / 1000 << " us on bus\n";
+  EXPECT_EQ(chunks, eepromBusStats.transactions);
+  EXPECT_EQ((4u * chunks + EEPROM_MAX_ADDRESS) * EepromBusStats::BYTE_TIME_NS, eepromBusStats.busyNs);
+}
+
+/**
+ * @brief 起動時に読み込めなかったページは、シャドウの内容で読み書きしないこと
+ * - 読み込みは1チャンク（128バイト）あたりLOAD_RETRIES回まで試す
+ * - 読み込めたページは通常どおり読み書きできる
+ */
+TEST_F(EepromManagerTest, FailedBootLoadRefusesThosePages) {
+  eeprom24lc.erase(0x00);
+  eeprom24lc.failNext = 3;            // 先頭のチャンクだけ3回とも失敗する
+  EepromManager rebooted(&mockBusManager);
+  rebooted.begin();
+  EXPECT_FALSE(rebooted.isLoaded());
+
+  uint8_t value = 0xAA;
+  EXPECT_FALSE(rebooted.readByte(0x0010, &value));        // 読めなかったページ
+  EXPECT_FALSE(rebooted.writeByte(0x0010, 1));
+  uint8_t block[8];
+  EXPECT_FALSE(rebooted.readMultipleBytes(0x007C, block, sizeof(block)));   // 読めたページとまたがる
+  EXPECT_EQ(0u, rebooted.pendingWriteCount());
+  EXPECT_TRUE(rebooted.readByte(0x0080, &value));         // 次のチャンクは読めている
+  EXPECT_EQ(0x00, value);
+  EXPECT_TRUE(rebooted.writeByte(0x0080, 5));
+  EXPECT_TRUE(rebooted.flush());
+  EXPECT_EQ(0x00, eeprom24lc.peek(0x0010));               // 読めなかったページは上書きしない
+  EXPECT_EQ(5, eeprom24lc.peek(0x0080));
+
+  eeprom24lc.failNext = 2;            // 再試行で読めれば正常
+  EepromManager retried(&mockBusManager);
+  retried.begin();
+  EXPECT_TRUE(retried.isLoaded());
+  EXPECT_TRUE(retried.readByte(0x0010, &value));
+  EXPECT_EQ(0x00, value);
+}
+
+/**
+ * @brief ダンプが1行ずつ出力され、32バイトごとに他の処理へ譲ること
+ */
+TEST_F(EepromManagerTest, DumpStreamsLinesAndYieldsPerRow) {
+  const uint8_t text[] = {'H', 'e', 'l', 'l', 'o', 0x00, 0x7F, 0xA5};
+  ASSERT_TRUE(eepromManager.writeBytes(0x0120, text, sizeof(text)));
+
+  std::vector<std::string> lines;
+  int yields = 0;
+  auto sink = [&](const char *line, size_t len) { lines.emplace_back(line, len); };
+  ASSERT_TRUE(eepromManager.dumpEepromData(0x0100, 0x0140, sink, [&]() { yields++; }));
+
+  ASSERT_EQ(2u + 0x140 / 16, lines.size());                   // ヘッダ2回（0x100ごと）+ 20行
+  EXPECT_EQ("\nADDR  0  1  2  3  4  5  6  7  8  9  A  B  C  D  E  F  ASCII CHARACTER\n", lines[0]);
+  EXPECT_EQ("0120  48 65 6c 6c 6f 00 7f a5 ff ff ff ff ff ff ff ff Hello...........\n", lines[3]);
+  EXPECT_EQ(lines[0], lines[17]);
+  EXPECT_EQ(0x140 / 32 - 1, yields);                          // 最後の行の後は譲らない
+
+  // 末尾は読み込み可能な範囲で打ち切り、16バイトに満たない分は空白で埋める
+  lines.clear();
+  ASSERT_TRUE(eepromManager.dumpEepromData(EEPROM_MAX_ADDRESS - 0x0F, 0x10, sink));
+  ASSERT_EQ(2u, lines.size());
+  EXPECT_EQ("0ff0  ff ff ff ff ff ff ff ff ff ff ff ff ff ff ff    ............... \n", lines[1]);
+
+  EXPECT_FALSE(eepromManager.dumpEepromData(0x0000, 0x10, nullptr));
+}
+
+// 他のテストケースもここに追加
+
+/**
+ * @brief 書き戻しがupdate()のACKポーリングで完了すること
+ * - 輝度9桁を1バイトずつ書き込むと、同じページの分が2回のページ書き込みにまとまる
+ * - update()1回あたりのバス占有は1ms未満で、書き込みサイクルを固定時間待たない
+ */
+TEST_F(EepromManagerTest, FlushCompletesByAckPolling) {
+  const uint64_t LOOP_PERIOD_NS = 100000;   // メインループ周期（100us）を想定
+  eepromBusStats.reset();
+  eepromBusStats.writeCycleNs = 3000000;    // 実際の書き込みサイクル（tWC最大5msより短い）
+  eepromManager.setFlushDelay(0);
+
+  int completed = 0;
+  eepromManager.onWriteComplete([&](uint16_t, uint16_t, bool success) {
+    EXPECT_TRUE(success);
+    completed++;
+  });
+
+  for (uint16_t i = 0; i < 9; ++i) {
+    ASSERT_TRUE(eepromManager.writeByte(0x0018 + i, 0x40 + i));
+  }
+  EXPECT_EQ(0u, eepromBusStats.transactions);   // 書き込み時はバスアクセスなし
+  EXPECT_EQ(2u, eepromManager.pendingWriteCount());
+  EXPECT_EQ(EepromWriteStatus::Busy, eepromManager.getWriteStatus());
+
+  uint64_t maxTickNs = 0;
+  int ticks = 0;
+  while (eepromManager.getWriteStatus() == EepromWriteStatus::Busy && ticks < 1000) {
+    uint64_t before = eepromBusStats.busyNs;
+    eepromManager.update(eepromBusStats.nowNs / 1000000);
+    maxTickNs = std::max<uint64_t>(maxTickNs, eepromBusStats.busyNs - before);
+    eepromBusStats.advance(LOOP_PERIOD_NS);
+    ticks++;
+  }
+
+  std::cout << "[async] " << ticks << " ticks, " << eepromBusStats.ackPolls << " ACK polls, max "
+            << maxTickNs / 1000 << " us per tick, done at " << eepromBusStats.nowNs / 1000 << " us\n";
+
+  EXPECT_EQ(EepromWriteStatus::Idle, eepromManager.getWriteStatus());
+  EXPECT_EQ(2, completed);
+  EXPECT_EQ(2u, eepromBusStats.transactions);
+  EXPECT_LT(maxTickNs, 1000000u);                       // 1tickあたり1ms未満
+  EXPECT_LT(eepromBusStats.nowNs, 2 * 5000000u);       // 固定5ms待ち×2より早く完了
+}
+
+/**
+ * @brief 読み込みはRAMシャドウから行い、バスアクセスが発生しないこと
+ */
+TEST_F(EepromManagerTest, ReadServedFromShadow) {
+  eepromBusStats.reset();
+
+  uint8_t data[40];
+  for (size_t i = 0; i < sizeof(data); ++i) data[i] = static_cast<uint8_t>(i);
+  ASSERT_TRUE(eepromManager.writeBytes(0x0010, data, sizeof(data)));   // 2ページにまたがる
+  EXPECT_EQ(2u, eepromManager.pendingWriteCount());
+
+  uint8_t value = 0;
+  ASSERT_TRUE(eepromManager.readByte(0x0012, &value));
+  EXPECT_EQ(2, value);
+  uint8_t readData[40] = {0};
+  ASSERT_TRUE(eepromManager.readMultipleBytes(0x0010, readData, sizeof(readData)));
+  EXPECT_EQ(0, memcmp(data, readData, sizeof(data)));
+  EXPECT_EQ(0u, eepromBusStats.transactions);           // 読み書きともバスアクセスなし
+
+  EXPECT_TRUE(eepromManager.flush());                    // 明示的な書き戻し
+  EXPECT_EQ(0u, eepromManager.pendingWriteCount());
+  EXPECT_EQ(2u, eepromBusStats.transactions);
+  EXPECT_EQ(EepromWriteStatus::Idle, eepromManager.getWriteStatus());
+}
+
+/**
+ * @brief スライダー操作のような連続書き込みが、遅延後の1回の書き込みにまとまること
+ */
+TEST_F(EepromManagerTest, RepeatedWritesCollapseIntoOneFlush) {
+  eepromBusStats.reset();
+  eepromManager.setFlushDelay(500);
+
+  uint32_t nowMs = 0;
+  for (int i = 0; i < 20; ++i) {                       // 50ms周期で20回値を変更
+    ASSERT_TRUE(eepromManager.writeByte(0x0018, 10 + i));
+    eepromManager.update(nowMs);
+    nowMs += 50;
+  }
+  EXPECT_EQ(0u, eepromBusStats.transactions);         // 操作中は書き込まない
+
+  eepromManager.update(nowMs + 400);                   // 遅延時間前
+  EXPECT_EQ(0u, eepromBusStats.transactions);
+  eepromManager.update(nowMs + 500);                   // 遅延時間経過で書き込み開始
+  EXPECT_EQ(1u, eepromBusStats.transactions);
+  EXPECT_TRUE(eepromManager.flush());
+  EXPECT_EQ(1u, eepromBusStats.transactions);
+
+  ASSERT_TRUE(eepromManager.writeByte(0x0018, 29));    // 同じ値は書き込まない
+  EXPECT_EQ(0u, eepromManager.pendingWriteCount());
+}
+
+/**
+ * @brief トランザクションの破棄で開始時点の内容に戻り、確定までは書き戻さないこと
+ */
+TEST_F(EepromManagerTest, TransactionAbortRestoresShadow) {
+  eepromBusStats.reset();
+  eepromManager.setFlushDelay(0);
+  ASSERT_TRUE(eepromManager.writeByte(0x0018, 9));
+  ASSERT_TRUE(eepromManager.flush());
+  eepromBusStats.reset();
+
+  ASSERT_TRUE(eepromManager.beginTransaction());
+  ASSERT_TRUE(eepromManager.writeByte(0x0018, 3));
+  ASSERT_TRUE(eepromManager.writeByte(0x0030, 4));
+  eepromManager.update(1000);                          // トランザクション中は書き戻さない
+  EXPECT_FALSE(eepromManager.flush());
+  EXPECT_EQ(0u, eepromBusStats.transactions);
+  eepromManager.abortTransaction();
+
+  uint8_t value = 0;
+  ASSERT_TRUE(eepromManager.readByte(0x0018, &value));
+  EXPECT_EQ(9, value);
+  ASSERT_TRUE(eepromManager.readByte(0x0030, &value));
+  EXPECT_EQ(0xFF, value);
+  EXPECT_EQ(0u, eepromManager.pendingWriteCount());
+  EXPECT_FALSE(eepromManager.inTransaction());
+
+  // 退避できるページ数を超える書き込みは失敗する
+  uint8_t data[EEPROM_PAGE_SIZE * 17] = {0};
+  ASSERT_TRUE(eepromManager.beginTransaction());
+  EXPECT_FALSE(eepromManager.writeBytes(0x0100, data, sizeof(data)));
+  EXPECT_TRUE(eepromManager.commitTransaction());
+  EXPECT_EQ(0u, eepromManager.pendingWriteCount());
+}
+
+/**
+ * @brief 書き込みに失敗したページは未書き込みに戻り、間隔を空けて再試行されること
+ * - 失敗のたびに再試行の間隔が倍になる（10ms, 20ms, 40ms）
+ * - 他のページが書き込めても、失敗したページが書き込めるまで状態はErrorのまま
+ */
+TEST_F(EepromManagerTest, FailedWriteIsRetriedWithBackoff) {
+  eepromBusStats.reset();
+  eepromManager.setFlushDelay(0);
+  std::vector<uint32_t> attempts;
+  uint32_t nowMs = 0;
+  eepromManager.onWriteComplete([&](uint16_t, uint16_t, bool) { attempts.push_back(nowMs); });
+
+  const uint8_t data[4] = {1, 2, 3, 4};
+  ASSERT_TRUE(eepromManager.writeBytes(0x0010, data, sizeof(data)));
+  ASSERT_TRUE(eepromManager.writeByte(0x0040, 7));
+  eeprom24lc.failNext = 3;
+  for (nowMs = 0; nowMs < 200; ++nowMs) {
+    eepromManager.update(nowMs);
+    if ((attempts.size() >= 1) && (attempts.size() < 5)) {   // 0x0010のページが書き込めるまで
+      EXPECT_EQ(EepromWriteStatus::Error, eepromManager.getWriteStatus()) << nowMs;
+    }
+    eepromBusStats.advance(1000000);
+  }
+
+  ASSERT_EQ(5u, attempts.size());     // 失敗3回 + 2ページの書き込み
+  EXPECT_GE(attempts[1] - attempts[0], 10u);
+  EXPECT_GE(attempts[2] - attempts[1], 20u);
+  EXPECT_GE(attempts[3] - attempts[2], 40u);
+  EXPECT_LT(attempts[3] - attempts[2], 50u);      // 成功は書き込みサイクル（5ms）のあとに通知される
+  EXPECT_EQ(EepromWriteStatus::Idle, eepromManager.getWriteStatus());
+  EXPECT_EQ(0u, eepromManager.pendingWriteCount());
+  EXPECT_EQ(3, eeprom24lc.peek(0x0012));
+  EXPECT_EQ(7, eeprom24lc.peek(0x0040));
+
+  // 応答しないEEPROMへのflush()は1ページ1回で諦め、未書き込みのまま残す
+  ASSERT_TRUE(eepromManager.writeByte(0x0080, 9));
+  eeprom24lc.failNext = 100;
+  EXPECT_FALSE(eepromManager.flush());
+  EXPECT_EQ(1u, eepromManager.pendingWriteCount());
+  EXPECT_EQ(EepromWriteStatus::Error, eepromManager.getWriteStatus());
+  eeprom24lc.failNext = 0;
+  EXPECT_TRUE(eepromManager.flush());
+  EXPECT_EQ(EepromWriteStatus::Idle, eepromManager.getWriteStatus());
+}
+
+/**
+ * @brief ESP32のEEPROM（フラッシュ）では、全パラメータ初期化が1回のcommitになること
+ */
+TEST_F(EepromManagerTest, FlashBackendCommitsOncePerTransaction) {
+  eepromBusStats.reset();
+  eepromBusStats.flashBackend = true;
+  eepromManager.setFlushDelay(0);
+
+  // 1バイトごとに確定（従来のwriteByte相当）
+  EepromRawAccessor rawAccessor(&mockBusManager);
+  uint8_t value = 0x5A;
+  for (uint16_t i = 0; i < 50; ++i) {
+    rawAccessor.startPageWrite(0x0010 + i, &value, 1);
+  }
+  uint32_t perByteCommits = eepromBusStats.flashCommits;
+
+  // トランザクションでまとめて確定
+  eepromBusStats.flashCommits = 0;
+  ASSERT_TRUE(eepromManager.beginTransaction());
+  for (uint16_t i = 0; i < 50; ++i) {
+    ASSERT_TRUE(eepromManager.writeByte(0x0010 + i, i));
+  }
+  ASSERT_TRUE(eepromManager.commitTransaction());
+  eepromManager.update(0);
+
+  std::cout << "[flash] per-byte commits " << perByteCommits
+            << ", transaction commits " << eepromBusStats.flashCommits << "\n";
+  EXPECT_EQ(50u, perByteCommits);
+  EXPECT_EQ(1u, eepromBusStats.flashCommits);
+  EXPECT_EQ(0u, eepromManager.pendingWriteCount());
+  eepromBusStats.flashBackend = false;
+}
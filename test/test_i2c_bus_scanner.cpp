@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include <iostream>
+#include <set>
+#include <vector>
+#include "../src/I2CBusScanner.h"
+#include "../src/Config.h"
+
+// テストフィクスチャ
+// 接続されているアドレスを与えた仮想バスで、確認したアドレスとバス時間を記録する
+class I2CBusScannerTest : public ::testing::Test {
+protected:
+  static constexpr uint64_t PROBE_NS = 11ULL * 1000000000ULL / I2C_FREQ;   // START + アドレス(8bit+ACK) + STOP
+
+  std::set<uint8_t> devices = {0x3C, 0x50, 0x68};    // OLED, EEPROM, RTC
+  std::vector<uint8_t> probed;
+  uint64_t busNs = 0;
+  I2CPresenceMap presence;
+  I2CBusScanner scanner;
+  std::vector<I2CScanProgress> events;
+  const std::vector<uint8_t> known = {0x3C, 0x3D, 0x50, 0x51, 0x68, 0x70, 0x77};   // I2CDeviceRegistryのアドレス
+
+  I2CBusScannerTest()
+  : scanner(presence, [this](uint8_t address) {
+      probed.push_back(address);
+      busNs += PROBE_NS;
+      return devices.count(address) > 0;
+    })
+  {
+  }
+
+  void SetUp() override {
+    scanner.onProgress([this](const I2CScanProgress& progress) { events.push_back(progress); });
+  }
+
+  void runToCompletion() {
+    while (scanner.step()) {
+    }
+  }
+};
+
+/**
+ * @brief 既知のアドレスだけを先に確認し、残りは分割してスキャンすること
+ */
+TEST_F(I2CBusScannerTest, ColdScanProbesKnownAddressesFirst) {
+  scanner.startCold(known.data(), known.size());
+  EXPECT_EQ(known, probed);                          // 開始時は既知のアドレスのみ
+  EXPECT_TRUE(presence.isPresent(0x50));             // EEPROM・OLED・RTCの初期化を始められる
+  EXPECT_TRUE(presence.isPresent(0x3C));
+  EXPECT_TRUE(presence.isPresent(0x68));
+  EXPECT_EQ(I2CScanPhase::Sweep, scanner.getPhase());
+  ASSERT_EQ(1u, events.size());
+  EXPECT_EQ(I2CScanPhase::Known, events[0].phase);
+  EXPECT_EQ(3, events[0].found);
+
+  size_t before = probed.size();
+  EXPECT_TRUE(scanner.step());
+  EXPECT_EQ(before + I2CBusScanner::SLICE_SIZE, probed.size());   // 1回に確認する数は制限される
+
+  devices.insert(0x10);                              // スキャン中に見つかる未登録のデバイス
+  runToCompletion();
+  EXPECT_EQ(I2CScanPhase::Done, scanner.getPhase());
+  EXPECT_EQ(126u, probed.size());                    // 既知のアドレスは再確認しない
+  EXPECT_EQ(std::set<uint8_t>(probed.begin(), probed.end()).size(), probed.size());
+  EXPECT_TRUE(presence.isPresent(0x10));
+  EXPECT_EQ(I2CScanPhase::Done, events.back().phase);
+  EXPECT_EQ(126, events.back().probed);
+  EXPECT_EQ(4, events.back().found);
+}
+
+/**
+ * @brief ウォームブートでは前回の接続状態を確認するだけで完了すること
+ */
+TEST_F(I2CBusScannerTest, WarmBootOnlyVerifiesLastMap) {
+  uint32_t lastBits[I2CPresenceMap::WORD_COUNT] = {0};
+  for (uint8_t address : {0x3C, 0x50, 0x68, 0x20}) {
+    lastBits[address >> 5] |= 1u << (address & 31);
+  }
+  devices.insert(0x20);
+
+  scanner.startWarm(lastBits, known.data(), known.size());
+  EXPECT_EQ(I2CScanPhase::Done, scanner.getPhase());
+  EXPECT_EQ(known.size() + 1, probed.size());        // 既知のアドレス + 前回見つかった0x20
+  EXPECT_TRUE(presence.isPresent(0x20));
+  EXPECT_TRUE(events.back().warmBoot);
+  EXPECT_FALSE(scanner.step());
+}
+
+/**
+ * @brief ウォームブートで前回と異なれば、通常のスキャンに切り替えること
+ */
+TEST_F(I2CBusScannerTest, WarmBootFallsBackToSweepOnMismatch) {
+  uint32_t lastBits[I2CPresenceMap::WORD_COUNT] = {0};
+  for (uint8_t address : {0x3C, 0x50, 0x68}) {
+    lastBits[address >> 5] |= 1u << (address & 31);
+  }
+  devices.erase(0x3C);                               // OLEDが外された
+
+  scanner.startWarm(lastBits, known.data(), known.size());
+  EXPECT_FALSE(presence.isPresent(0x3C));
+  EXPECT_EQ(I2CScanPhase::Sweep, scanner.getPhase());
+  EXPECT_FALSE(events.back().warmBoot);
+  runToCompletion();
+  EXPECT_EQ(126u, probed.size());
+}
+
+/**
+ * @brief 起動時にバスを占有する時間の比較（ベンチマーク）
+ * - 従来: 126アドレスを続けてスキャンしてから初期化
+ * - 段階的: 既知の7アドレスだけ確認して初期化、残りはupdate()ごとに8アドレス
+ * - ウォームブート: 前回の接続状態の確認のみ
+ */
+TEST_F(I2CBusScannerTest, BootTimeBenchmark) {
+  const uint64_t fullScanNs = 126 * PROBE_NS;
+
+  scanner.startCold(known.data(), known.size());
+  uint64_t coldBlockingNs = busNs;
+  uint64_t maxSliceNs = 0;
+  int slices = 0;
+  while (true) {
+    uint64_t before = busNs;
+    bool active = scanner.step();
+    maxSliceNs = std::max(maxSliceNs, busNs - before);
+    slices++;
+    if (!active) break;
+  }
+
+  uint32_t lastBits[I2CPresenceMap::WORD_COUNT];
+  presence.snapshot(lastBits);
+  I2CPresenceMap warmPresence;
+  busNs = 0;
+  I2CBusScanner warm(warmPresence, [this](uint8_t address) {
+    busNs += PROBE_NS;
+    return devices.count(address) > 0;
+  });
+  warm.startWarm(lastBits, known.data(), known.size());
+  uint64_t warmNs = busNs;
+
+  std::cout << "[scan] blocking before init: full " << fullScanNs / 1000 << " us, incremental "
+            << coldBlockingNs / 1000 << " us, warm " << warmNs / 1000 << " us; "
+            << slices << " slices of at most " << maxSliceNs / 1000 << " us\n";
+
+  EXPECT_EQ(known.size() * PROBE_NS, coldBlockingNs);
+  EXPECT_LT(coldBlockingNs * 10, fullScanNs);
+  EXPECT_LE(warmNs, coldBlockingNs);
+  EXPECT_EQ(I2CBusScanner::SLICE_SIZE * PROBE_NS, maxSliceNs);
+}
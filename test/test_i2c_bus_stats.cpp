@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+
+#include "../src/I2CBusManager.h"
+
+// 占有時間の分布の区分（2のべき乗）
+TEST(I2CBusStatsTest, LatencyBuckets) {
+  EXPECT_EQ(0u, I2CBusStats::latencyBucket(0));
+  EXPECT_EQ(0u, I2CBusStats::latencyBucket(63));
+  EXPECT_EQ(1u, I2CBusStats::latencyBucket(64));
+  EXPECT_EQ(2u, I2CBusStats::latencyBucket(200));
+  EXPECT_EQ(6u, I2CBusStats::latencyBucket(4095));
+  EXPECT_EQ(7u, I2CBusStats::latencyBucket(4096));
+  EXPECT_EQ(7u, I2CBusStats::latencyBucket(1000000));
+  EXPECT_EQ(64u, I2CBusStats::bucketLimitUs(0));
+  EXPECT_EQ(4096u, I2CBusStats::bucketLimitUs(6));
+  EXPECT_EQ(0u, I2CBusStats::bucketLimitUs(7));
+}
+
+// アドレスごとの集計と、記録できるアドレス数を超えた場合
+TEST(I2CBusStatsTest, RecordsPerAddress) {
+  I2CBusStats stats;
+  stats.record(0x50, 100, 34, I2CResult::Ok);
+  stats.record(0x68, 500, 7, I2CResult::Ok);
+  stats.record(0x50, 10, 0, I2CResult::Busy);
+  stats.record(0x50, 5000, 0, I2CResult::Nak);
+  stats.record(0x68, 20, 0, I2CResult::Error);
+
+  I2CDeviceStats devices[I2CBusStats::MAX_DEVICES];
+  ASSERT_EQ(2u, stats.getDevices(devices, I2CBusStats::MAX_DEVICES));
+  EXPECT_EQ(0x50, devices[0].address);
+  EXPECT_EQ(3u, devices[0].transactions);
+  EXPECT_EQ(34u, devices[0].bytes);
+  EXPECT_EQ(1u, devices[0].busy);
+  EXPECT_EQ(1u, devices[0].naks);
+  EXPECT_EQ(0u, devices[0].errors);
+  EXPECT_EQ(5110u, devices[0].totalUs);
+  EXPECT_EQ(5000u, devices[0].maxUs);
+  EXPECT_EQ(1u, devices[0].histogram[0]);
+  EXPECT_EQ(1u, devices[0].histogram[1]);
+  EXPECT_EQ(1u, devices[0].histogram[7]);
+  EXPECT_EQ(0x68, devices[1].address);
+  EXPECT_EQ(1u, devices[1].errors);
+
+  for (uint8_t addr = 0x10; addr < 0x10 + I2CBusStats::MAX_DEVICES; ++addr) {
+    stats.record(addr, 1, 1, I2CResult::Ok);
+  }
+  EXPECT_EQ(2u, stats.getDropped());   // 空きは6件のため、残り2件は記録しない
+
+  stats.reset();
+  EXPECT_EQ(0u, stats.getDevices(devices, I2CBusStats::MAX_DEVICES));
+  EXPECT_EQ(0u, stats.getDropped());
+}
+
+// 他のスレッドがバスを使用中の場合だけ待ち時間を記録する
+TEST(I2CBusStatsTest, TransactionMeasuresLockWait) {
+  I2CBusManager bus;
+  std::atomic<uint32_t> clockUs(0);
+  std::atomic<int> clockReads(0);
+  bus.setTimeSource([&]() { clockReads++; return clockUs.load(); });
+
+  {
+    I2CTransaction transaction(bus, I2CADR_RTC);   // 空いている（時刻の取得は開始・終了の2回）
+    transaction.addBytes(7);
+    clockUs += 400;
+  }
+  EXPECT_EQ(2, clockReads.load());
+
+  std::atomic<bool> holding(false);
+  std::thread holder([&]() {
+    std::lock_guard<std::recursive_mutex> lock(bus.getMutex());
+    holding = true;
+    while (clockReads < 3) std::this_thread::yield();   // 待ち始めた時刻を取得するまで保持
+    clockUs += 1500;                                      // 解放するまでに1500us経過
+  });
+  while (!holding) std::this_thread::yield();
+  std::thread waiter([&]() {
+    I2CTransaction transaction(bus, I2CADR_M5OLED);
+    clockUs += 2000;
+  });
+  holder.join();
+  waiter.join();
+
+  I2CLockStats lock = bus.getLockStats();
+  EXPECT_EQ(2u, lock.acquisitions);
+  EXPECT_EQ(1u, lock.contended);
+  EXPECT_EQ(1500u, lock.totalWaitUs);
+  EXPECT_EQ(1500u, lock.maxWaitUs);
+
+  I2CDeviceStats devices[I2CBusStats::MAX_DEVICES];
+  ASSERT_EQ(2u, bus.getDeviceStats(devices, I2CBusStats::MAX_DEVICES));
+  EXPECT_EQ(I2CADR_RTC, devices[0].address);
+  EXPECT_EQ(400u, devices[0].maxUs);
+  EXPECT_EQ(7u, devices[0].bytes);
+  EXPECT_EQ(I2CADR_M5OLED, devices[1].address);
+  EXPECT_EQ(2000u, devices[1].maxUs);
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "../src/I2CBusManager.h"
+
+// limitHz以下なら常に読み返しが一致するデバイス
+static I2CClockTuner::Check deviceUpTo(uint32_t limitHz, std::vector<uint32_t>& tried) {
+  return [limitHz, &tried](uint32_t hz) {
+    tried.push_back(hz);
+    return hz <= limitHz;
+  };
+}
+
+// 仕様上の上限まで安定していれば上限を採用する
+TEST(I2CClockTunerTest, UsesDeviceMaximumWhenAllRatesPass) {
+  std::vector<uint32_t> tried;
+  EXPECT_EQ(1000000u, I2CClockTuner::tune(deviceUpTo(3400000, tried), 1000000));
+  EXPECT_EQ(I2CClockTuner::RATE_COUNT * I2CClockTuner::CHECK_REPEAT, tried.size());
+
+  tried.clear();
+  EXPECT_EQ(400000u, I2CClockTuner::tune(deviceUpTo(3400000, tried), 400000));   // EEPROMは400kHzまで
+  EXPECT_EQ(400000u, tried.back());
+}
+
+// 失敗した周波数があれば、成功した最高の周波数の1段下を採用する
+TEST(I2CClockTunerTest, BacksOffOneStepBelowFailure) {
+  std::vector<uint32_t> tried;
+  EXPECT_EQ(300000u, I2CClockTuner::tune(deviceUpTo(400000, tried), 1000000));   // 配線が長い
+  EXPECT_EQ(600000u, tried.back());                                              // 失敗した周波数で打ち切る
+
+  tried.clear();
+  EXPECT_EQ(100000u, I2CClockTuner::tune(deviceUpTo(100000, tried), 1000000));   // 最低の周波数は下げない
+  EXPECT_EQ(0u, I2CClockTuner::tune(deviceUpTo(50000, tried), 1000000));        // 最低の周波数でも失敗
+}
+
+// 間欠的な失敗も検出する（CHECK_REPEAT回すべて成功すること）
+TEST(I2CClockTunerTest, IntermittentFailureRejectsRate) {
+  int count = 0;
+  uint32_t hz = I2CClockTuner::tune([&](uint32_t candidateHz) {
+    if (candidateHz < 800000) return true;
+    return (++count % 10) != 0;         // 800kHz以上は10回に1回失敗
+  }, 1000000);
+  EXPECT_EQ(400000u, hz);
+}
+
+// 保存用レコードの変換と破損検出
+TEST(I2CClockTableTest, RecordRoundTripAndCorruption) {
+  I2CClockTable table;
+  EXPECT_TRUE(table.set(I2CADR_M5OLED, 1000000));
+  EXPECT_TRUE(table.set(I2CADR_EEPROM, 400000));
+  EXPECT_TRUE(table.set(I2CADR_RTC, 0));              // 調整できなかった
+  EXPECT_FALSE(table.set(0x10, 123456));              // 候補にない周波数
+  EXPECT_EQ(1000000u, table.clockFor(I2CADR_M5OLED, I2C_FREQ));
+  EXPECT_EQ(I2C_FREQ, table.clockFor(I2CADR_RTC, I2C_FREQ));
+  EXPECT_EQ(I2C_FREQ, table.clockFor(0x77, I2C_FREQ));
+  EXPECT_TRUE(table.contains(I2CADR_RTC));
+  EXPECT_FALSE(table.contains(0x77));
+
+  uint8_t record[I2CClockTable::RECORD_SIZE];
+  ASSERT_EQ(I2CClockTable::RECORD_SIZE, table.serialize(record, sizeof(record)));
+  I2CClockTable restored;
+  ASSERT_TRUE(restored.deserialize(record, sizeof(record)));
+  EXPECT_EQ(3u, restored.count());
+  EXPECT_EQ(400000u, restored.clockFor(I2CADR_EEPROM, I2C_FREQ));
+  EXPECT_TRUE(restored.contains(I2CADR_RTC));
+
+  record[5] ^= 0x01;                                  // 1ビット破損
+  EXPECT_FALSE(restored.deserialize(record, sizeof(record)));
+  EXPECT_EQ(3u, restored.count());                    // 破損したレコードでは表を変更しない
+
+  uint8_t erased[I2CClockTable::RECORD_SIZE];
+  memset(erased, 0xFF, sizeof(erased));               // 未保存のEEPROM
+  EXPECT_FALSE(restored.deserialize(erased, sizeof(erased)));
+}
+
+// 周波数の切り替えを記録するI2CBusManager
+class ClockRecordingBus : public I2CBusManager {
+public:
+  std::vector<uint32_t> clocks;
+  void markPresent(uint8_t address) { presence.set(address, true); }
+protected:
+  void setBusClock(uint32_t hz) override { clocks.push_back(hz); }
+};
+
+// トランザクションごとにデバイスの周波数へ切り替え、同じ周波数なら設定しない
+TEST(I2CClockTunerTest, TransactionSwitchesClockPerDevice) {
+  ClockRecordingBus bus;
+  bus.markPresent(I2CADR_M5OLED);
+  bus.markPresent(I2CADR_EEPROM);
+  bus.markPresent(I2CADR_QMP6988);
+
+  I2CClockTable table;
+  table.set(I2CADR_M5OLED, 1000000);
+  table.set(I2CADR_QMP6988, 1000000);
+  uint8_t record[I2CClockTable::RECORD_SIZE];
+  table.serialize(record, sizeof(record));
+  EXPECT_FALSE(bus.restoreClockTable(record, sizeof(record)));   // EEPROMを調整していない
+
+  table.set(I2CADR_EEPROM, 400000);
+  table.serialize(record, sizeof(record));
+  ASSERT_TRUE(bus.restoreClockTable(record, sizeof(record)));
+
+  { I2CTransaction transaction(bus, I2CADR_EEPROM); }   // 既定の周波数と同じ
+  { I2CTransaction transaction(bus, I2CADR_QMP6988); }
+  { I2CTransaction transaction(bus, I2CADR_QMP6988); }
+  { I2CTransaction transaction(bus, I2CADR_EEPROM); }
+  std::vector<uint32_t> expected = {1000000, 400000};
+  EXPECT_EQ(expected, bus.clocks);
+  EXPECT_EQ(1000000u, bus.getClock(I2CADR_M5OLED));
+
+  // OLEDはLovyanGFXのドライバがポートを設定するため、Wireの周波数は設定せず、次のトランザクションで設定し直す
+  { I2CTransaction transaction(bus, I2CADR_M5OLED); }
+  EXPECT_EQ(expected, bus.clocks);
+  { I2CTransaction transaction(bus, I2CADR_EEPROM); }
+  expected.push_back(400000);
+  EXPECT_EQ(expected, bus.clocks);
+
+  bus.invalidateClock();                                // 他のドライバがポートを設定し直した
+  { I2CTransaction transaction(bus, I2CADR_EEPROM); }
+  expected.push_back(400000);
+  EXPECT_EQ(expected, bus.clocks);
+
+  uint8_t saved[I2CClockTable::RECORD_SIZE];
+  ASSERT_EQ(sizeof(saved), bus.saveClockTable(saved, sizeof(saved)));
+  EXPECT_EQ(0, memcmp(saved, record, sizeof(saved)));
+}
@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+#include <string>
+
+#include "../src/I2CDeviceRegistry.h"
+#include "../src/Config.h"
+
+// コンパイル時に検索できる
+static_assert(I2CDeviceRegistry::find(I2CADR_RTC)->kind == I2CDriverKind::Rtc, "RTC lookup");
+static_assert(I2CDeviceRegistry::find(0x00) == nullptr, "unknown address");
+static_assert(EEPROM_PAGE_SIZE == 32, "24LC32/24LC64 page size");
+
+// 登録したすべてのアドレスが見つかり、それ以外は見つからない
+TEST(I2CDeviceRegistryTest, FindsEveryRegisteredAddressOnly) {
+  size_t found = 0;
+  for (uint16_t address = 0; address < 128; ++address) {
+    const I2CDeviceInfo* info = I2CDeviceRegistry::find((uint8_t)address);
+    if (info != nullptr) {
+      EXPECT_EQ(address, info->address);
+      found++;
+    }
+  }
+  EXPECT_EQ(I2CDeviceRegistry::COUNT, found);
+}
+
+// デバイスの仕様
+TEST(I2CDeviceRegistryTest, DeviceCapabilities) {
+  const I2CDeviceInfo* eeprom = I2CDeviceRegistry::find(I2CADR_EEPROM);
+  ASSERT_NE(nullptr, eeprom);
+  EXPECT_EQ(I2CDriverKind::Eeprom, eeprom->kind);
+  EXPECT_EQ(400000u, eeprom->maxClockHz);
+  EXPECT_EQ(32u, eeprom->pageSize);
+
+  const I2CDeviceInfo* oled = I2CDeviceRegistry::find(I2CADR_M5OLED);
+  ASSERT_NE(nullptr, oled);
+  EXPECT_EQ(1000000u, oled->maxClockHz);
+  EXPECT_EQ(0u, oled->pageSize);
+
+  EXPECT_STREQ("BME680", I2CDeviceRegistry::nameOf(I2CADR_BME680));
+  EXPECT_STREQ("Unknown Device", I2CDeviceRegistry::nameOf(0x42));
+  EXPECT_STREQ("eeprom", I2CDeviceRegistry::kindName(eeprom->kind));
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "../src/I2CPresenceMap.h"
+
+/**
+ * @brief 1アドレスの更新と参照、世代番号の変化
+ */
+TEST(I2CPresenceMapTest, SetUpdatesBitAndGeneration) {
+  I2CPresenceMap map;
+  EXPECT_FALSE(map.isPresent(0x50));
+  EXPECT_EQ(0u, map.generation());
+
+  EXPECT_TRUE(map.set(0x50, true));
+  EXPECT_TRUE(map.isPresent(0x50));
+  EXPECT_FALSE(map.isPresent(0x51));
+  uint32_t generation = map.generation();
+  EXPECT_NE(0u, generation);
+  EXPECT_EQ(0u, generation & 1u);                 // 更新完了後は偶数
+
+  EXPECT_FALSE(map.set(0x50, true));              // 変化なしなら世代番号は進まない
+  EXPECT_EQ(generation, map.generation());
+
+  EXPECT_TRUE(map.set(0x7E, true));               // 最後のワード
+  EXPECT_TRUE(map.set(0x50, false));
+  EXPECT_FALSE(map.isPresent(0x50));
+  EXPECT_TRUE(map.isPresent(0x7E));
+  EXPECT_FALSE(map.set(200, true));               // 範囲外
+  EXPECT_FALSE(map.isPresent(200));
+}
+
+/**
+ * @brief 範囲指定の再スキャンは範囲外の接続状態を変えないこと
+ */
+TEST(I2CPresenceMapTest, ReplaceOnlyTouchesScannedRange) {
+  I2CPresenceMap map;
+  map.set(0x3C, true);    // OLED
+  map.set(0x68, true);    // RTC
+
+  uint32_t bits[I2CPresenceMap::WORD_COUNT] = {0};
+  bits[0x50 >> 5] |= 1u << (0x50 & 31);          // EEPROMを新たに検出
+  EXPECT_TRUE(map.replace(bits, 0x50, 8));       // 0x50-0x57だけ再スキャン
+  EXPECT_TRUE(map.isPresent(0x3C));
+  EXPECT_TRUE(map.isPresent(0x50));
+  EXPECT_TRUE(map.isPresent(0x68));
+  EXPECT_FALSE(map.replace(bits, 0x50, 8));      // 同じ結果なら変化なし
+
+  EXPECT_TRUE(map.replace(bits));                // 全体スキャン
+  EXPECT_FALSE(map.isPresent(0x3C));
+  EXPECT_TRUE(map.isPresent(0x50));
+  EXPECT_FALSE(map.isPresent(0x68));
+}
+
+/**
+ * @brief 更新中に読み出しても、更新前後どちらかの状態が読めること
+ */
+TEST(I2CPresenceMapTest, SnapshotIsNeverTorn) {
+  I2CPresenceMap map;
+  const uint32_t a[I2CPresenceMap::WORD_COUNT] = {0x00000000u, 0x10000000u, 0x00010000u, 0x00000001u};
+  const uint32_t b[I2CPresenceMap::WORD_COUNT] = {0xFFFFFFFEu, 0xEFFFFFFFu, 0xFFFEFFFFu, 0x7FFFFFFEu};
+  map.replace(a);
+
+  std::atomic<bool> done(false);
+  std::atomic<int> torn(0);
+  std::atomic<int> reads(0);
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 3; ++r) {
+    readers.emplace_back([&]() {
+      uint32_t bits[I2CPresenceMap::WORD_COUNT];
+      while (!done.load()) {
+        uint32_t generation = map.snapshot(bits);
+        bool isA = true;
+        bool isB = true;
+        for (size_t i = 0; i < I2CPresenceMap::WORD_COUNT; ++i) {
+          isA = isA && bits[i] == a[i];
+          isB = isB && bits[i] == b[i];
+        }
+        if ((!isA && !isB) || (generation & 1u)) torn++;
+        reads++;
+      }
+    });
+  }
+  for (int i = 0; i < 20000; ++i) {
+    map.replace((i & 1) ? a : b);
+  }
+  done.store(true);
+  for (auto& t : readers) {
+    t.join();
+  }
+
+  EXPECT_EQ(0, torn.load());
+  EXPECT_GT(reads.load(), 0);
+  EXPECT_EQ(2u + 40000u, map.generation());      // 1回の更新で2進む
+}
@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "../src/I2CScheduler.h"
+
+// テストフィクスチャ
+class I2CSchedulerTest : public ::testing::Test {
+protected:
+  std::recursive_mutex busMutex;
+  I2CScheduler scheduler;
+  uint32_t nowUs = 0;           // 仮想時刻[us]
+  std::vector<int> order;       // 実行順
+
+  I2CSchedulerTest()
+  : scheduler(busMutex)
+  {
+  }
+
+  void SetUp() override {
+    scheduler.setTimeSource([this]() { return nowUs; });
+  }
+
+  // バスをlatencyUs占有する処理
+  I2CScheduler::Job job(int id, uint32_t latencyUs = 0) {
+    return [this, id, latencyUs]() {
+      order.push_back(id);
+      nowUs += latencyUs;
+      return true;
+    };
+  }
+};
+
+/**
+ * @brief 優先度の高い順、同じ優先度では受付順に実行されること
+ */
+TEST_F(I2CSchedulerTest, RunsByPriorityThenFifo) {
+  ASSERT_TRUE(scheduler.submit(I2CPriority::Bulk, job(1)));
+  ASSERT_TRUE(scheduler.submit(I2CPriority::Normal, job(2)));
+  ASSERT_TRUE(scheduler.submit(I2CPriority::Bulk, job(3)));
+  ASSERT_TRUE(scheduler.submit(I2CPriority::Critical, job(4)));
+  ASSERT_TRUE(scheduler.submit(I2CPriority::High, job(5)));
+  EXPECT_EQ(5u, scheduler.pending());
+
+  EXPECT_EQ(5u, scheduler.runPending(1000));
+  EXPECT_EQ((std::vector<int>{4, 5, 2, 1, 3}), order);
+  EXPECT_FALSE(scheduler.runNext());
+}
+
+/**
+ * @brief 期限を過ぎた処理は優先度の高い処理より先に実行されること
+ */
+TEST_F(I2CSchedulerTest, OverdueJobRunsFirst) {
+  ASSERT_TRUE(scheduler.submit(I2CPriority::Bulk, job(1), 500));    // 500us以内に開始したい描画
+  ASSERT_TRUE(scheduler.submit(I2CPriority::High, job(2)));
+  nowUs = 600;
+  ASSERT_TRUE(scheduler.submit(I2CPriority::Critical, job(3)));
+  scheduler.runPending(1000);
+  EXPECT_EQ((std::vector<int>{1, 3, 2}), order);
+
+  I2CSchedulerStats stats = scheduler.getStats();
+  EXPECT_EQ(3u, stats.completed);
+  EXPECT_EQ(1u, stats.deadlineMissed);
+  EXPECT_EQ(600u, stats.maxWaitUs[static_cast<size_t>(I2CPriority::Bulk)]);
+}
+
+/**
+ * @brief キューが満杯なら受け付けず、execute()は直接実行すること
+ */
+TEST_F(I2CSchedulerTest, FullQueueRejectsSubmitButExecuteStillRuns) {
+  for (size_t i = 0; i < I2CScheduler::MAX_JOBS; ++i) {
+    ASSERT_TRUE(scheduler.submit(I2CPriority::Bulk, job(static_cast<int>(i))));
+  }
+  EXPECT_FALSE(scheduler.submit(I2CPriority::Bulk, job(99)));
+  EXPECT_EQ(1u, scheduler.getStats().rejected);
+
+  EXPECT_TRUE(scheduler.execute(I2CPriority::Critical, job(100)));
+  EXPECT_EQ(100, order.back());
+  EXPECT_EQ(I2CScheduler::MAX_JOBS, scheduler.pending());
+}
+
+/**
+ * @brief 所有者以外のスレッドのexecute()は、キューの処理を自分で実行せずに所有者の実行を待つこと
+ */
+TEST_F(I2CSchedulerTest, NonOwnerExecuteWaitsForOwnerLoop) {
+  scheduler.setOwner(std::this_thread::get_id());
+  std::thread::id bulkRanOn;
+  ASSERT_TRUE(scheduler.submit(I2CPriority::Bulk, [&]() { bulkRanOn = std::this_thread::get_id(); return true; }));
+
+  std::atomic<bool> done(false);
+  std::thread::id rtcRanOn;
+  std::thread reader([&]() {
+    EXPECT_TRUE(scheduler.execute(I2CPriority::Critical, [&]() { rtcRanOn = std::this_thread::get_id(); return true; }));
+    done.store(true);
+  });
+  while (scheduler.pending() < 2) {
+    std::this_thread::yield();
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  EXPECT_FALSE(done.load());                  // 所有者が実行するまで待っている
+  EXPECT_EQ(2u, scheduler.pending());         // 積まれた描画も実行していない
+
+  EXPECT_TRUE(scheduler.runNext());           // 所有者のループが優先度の高い方から実行する
+  reader.join();
+  EXPECT_TRUE(done.load());
+  EXPECT_EQ(std::this_thread::get_id(), rtcRanOn);
+  EXPECT_EQ(1u, scheduler.pending());
+  EXPECT_TRUE(scheduler.runNext());
+  EXPECT_EQ(std::this_thread::get_id(), bulkRanOn);
+}
+
+/**
+ * @brief 所有者がキューを処理しないとき、他のスレッドのexecute()は期限で取り消してfalseを返すこと
+ */
+TEST_F(I2CSchedulerTest, NonOwnerExecuteGivesUpAtDeadline) {
+  std::thread owner([]() {});               // 所有者のループは一度も実行しない
+  scheduler.setOwner(owner.get_id());
+  owner.join();
+
+  bool ran = false;
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(scheduler.execute(I2CPriority::Critical, [&]() { ran = true; return true; }, 5000));
+  auto waitedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+  EXPECT_FALSE(ran);
+  EXPECT_GE(waitedMs, 5);
+  EXPECT_LT(waitedMs, 1000);
+  EXPECT_EQ(0u, scheduler.pending());       // 取り消した処理はあとから実行されない
+  I2CSchedulerStats stats = scheduler.getStats();
+  EXPECT_EQ(1u, stats.abandoned);
+  EXPECT_EQ(0u, stats.completed);
+}
+
+/**
+ * @brief OLED描画中に届いたRTC読み込みの最悪待ち時間（ベンチマーク）
+ * - OLED: 128x64の全画面転送（1024byte + コマンド、400kHzで約23ms）を100msごと
+ * - EEPROM: 32byteのページ書き込み（約0.9ms）を37msごと
+ * - RTC: 7byteの時刻読み込み（約0.3ms）を50msごと（描画の途中に届くようにずらす）
+ * 従来: 全体を1回のミューテックス取得で実行し、受付順
+ * 今回: OLEDを8ページに分けてBulkで積み、RTCはCriticalで積む
+ */
+TEST_F(I2CSchedulerTest, RtcLatencyUnderOledTraffic) {
+  const uint32_t OLED_PAGE_US = 2900;
+  const uint32_t OLED_PAGES = 8;
+  const uint32_t EEPROM_WRITE_US = 900;
+  const uint32_t RTC_READ_US = 300;
+  const uint32_t SIM_US = 2000000;
+
+  struct Arrival {
+    uint32_t atUs;
+    int kind;     // 0: OLED, 1: EEPROM, 2: RTC
+  };
+  std::vector<Arrival> arrivals;
+  for (uint32_t t = 0; t < SIM_US; t += 100000) arrivals.push_back({t, 0});
+  for (uint32_t t = 1000; t < SIM_US; t += 37000) arrivals.push_back({t, 1});
+  for (uint32_t t = 700; t < SIM_US; t += 50000) arrivals.push_back({t, 2});
+  std::stable_sort(arrivals.begin(), arrivals.end(), [](const Arrival& a, const Arrival& b) { return a.atUs < b.atUs; });
+
+  auto simulate = [&](bool prioritized) {
+    std::recursive_mutex mutex;
+    I2CScheduler sched(mutex);
+    uint32_t clock = 0;
+    uint32_t worstRtcUs = 0;
+    sched.setTimeSource([&clock]() { return clock; });
+
+    size_t next = 0;
+    while (next < arrivals.size() || sched.pending() > 0) {
+      while (next < arrivals.size() && arrivals[next].atUs <= clock) {
+        const Arrival a = arrivals[next++];
+        if (a.kind == 0) {
+          if (prioritized) {
+            for (uint32_t p = 0; p < OLED_PAGES; ++p) {
+              EXPECT_TRUE(sched.submit(I2CPriority::Bulk, [&]() { clock += OLED_PAGE_US; return true; }));
+            }
+          } else {
+            EXPECT_TRUE(sched.submit(I2CPriority::Normal, [&]() { clock += OLED_PAGE_US * OLED_PAGES; return true; }));
+          }
+        } else if (a.kind == 1) {
+          EXPECT_TRUE(sched.submit(prioritized ? I2CPriority::High : I2CPriority::Normal,
+                                   [&]() { clock += EEPROM_WRITE_US; return true; }));
+        } else {
+          uint32_t arrivedUs = a.atUs;
+          EXPECT_TRUE(sched.submit(prioritized ? I2CPriority::Critical : I2CPriority::Normal,
+                                   [&]() { clock += RTC_READ_US; return true; },
+                                   prioritized ? 1000 : I2CScheduler::NO_DEADLINE,
+                                   [&clock, &worstRtcUs, arrivedUs](bool) {
+                                     worstRtcUs = std::max(worstRtcUs, clock - arrivedUs);
+                                   }));
+        }
+      }
+      if (!sched.runNext() && next < arrivals.size()) {
+        clock = arrivals[next].atUs;    // バスが空いている間は次の要求まで進める
+      }
+    }
+    return worstRtcUs;
+  };
+
+  uint32_t fifoWorstUs = simulate(false);
+  uint32_t scheduledWorstUs = simulate(true);
+  std::cout << "[i2c] worst RTC read latency: single mutex " << fifoWorstUs
+            << " us, scheduler " << scheduledWorstUs << " us\n";
+
+  EXPECT_GT(fifoWorstUs, OLED_PAGE_US * OLED_PAGES);                // 全画面転送の完了を待つ
+  EXPECT_LE(scheduledWorstUs, OLED_PAGE_US + EEPROM_WRITE_US + RTC_READ_US);  // 実行中の1件を待つだけ
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <vector>
+
+#include "../src/I2CBusManager.h"
+#include "mock/FakeI2CTransport.h"
+
+namespace {
+
+// EEPROMへの1ページ書き込み（アドレス2バイト + 32バイト）
+I2CTransfer pageWrite(uint16_t address, uint8_t fill) {
+  I2CTransfer request;
+  uint8_t head[2] = {(uint8_t)(address >> 8), (uint8_t)(address & 0xFF)};
+  uint8_t data[32];
+  memset(data, fill, sizeof(data));
+  request.address = I2CADR_EEPROM;
+  request.setTx(head, sizeof(head), data, sizeof(data));
+  return request;
+}
+
+class I2CTransportTest : public ::testing::Test {
+protected:
+  I2CBusManager bus;
+  FakeI2CTransport transport;
+  void SetUp() override { bus.setTransport(&transport); }
+};
+
+// submit()は転送の完了を待たずに戻り、完了は仮想時計の転送時間後に通知される
+TEST_F(I2CTransportTest, CompletesAfterTransferTime) {
+  I2CTransfer request = pageWrite(0x0040, 0xA5);
+  uint32_t expectedUs = FakeI2CTransport::durationUs(request, 400000);
+  EXPECT_EQ(793u, expectedUs);    // (1 + 34) × 9 + 2 = 317bit @400kHz
+
+  std::vector<I2CTransferStatus> results;
+  ASSERT_TRUE(bus.transfer(request, [&](I2CTransferStatus status) { results.push_back(status); }));
+  EXPECT_EQ(1u, transport.inFlight());
+  EXPECT_TRUE(results.empty());
+
+  transport.advance(expectedUs - 1);
+  EXPECT_TRUE(results.empty());
+  transport.advance(1);
+  ASSERT_EQ(1u, results.size());
+  EXPECT_EQ(I2CTransferStatus::Ok, results[0]);
+  EXPECT_EQ(0u, transport.inFlight());
+}
+
+// 送信データは受付時にコピーされ、転送は受付順に1件ずつ行われる
+TEST_F(I2CTransportTest, QueuedTransfersRunInOrderWithCopiedData) {
+  std::vector<uint8_t> seen;
+  transport.setDevice([&](const I2CTransfer& transfer, uint8_t *) {
+    seen.push_back(transfer.tx[2]);
+    return transfer.tx[2] == 0x03 ? I2CTransferStatus::Nak : I2CTransferStatus::Ok;   // 3件目は書き込みサイクル中
+  });
+
+  std::vector<uint32_t> doneAt;
+  std::vector<I2CTransferStatus> results;
+  for (uint8_t i = 1; i <= 4; ++i) {
+    I2CTransfer request = pageWrite(i * 32, i);
+    ASSERT_TRUE(bus.transfer(request, [&](I2CTransferStatus status) {
+      doneAt.push_back(transport.now());
+      results.push_back(status);
+    }));
+    memset(request.tx, 0, sizeof(request.tx));   // 呼び出し元のバッファはすぐ再利用できる
+  }
+  EXPECT_EQ(4u, transport.inFlight());
+
+  for (int step = 0; step < 4000 && transport.inFlight() > 0; ++step) {
+    transport.advance(1);
+  }
+  std::vector<uint8_t> expectedSeen = {1, 2, 3, 4};
+  EXPECT_EQ(expectedSeen, seen);
+  std::vector<uint32_t> expectedDone = {793, 1586, 2379, 3172};
+  EXPECT_EQ(expectedDone, doneAt);
+  EXPECT_EQ(I2CTransferStatus::Nak, results[2]);
+}
+
+// futureで完了を受け取る（書き込み後にリピーテッドスタートで読み込み）
+TEST_F(I2CTransportTest, FutureResolvesWithReceivedData) {
+  transport.setDevice([](const I2CTransfer& transfer, uint8_t *rx) {
+    for (uint8_t i = 0; i < transfer.rxLen; ++i) rx[i] = (uint8_t)(transfer.tx[0] + i);
+    return I2CTransferStatus::Ok;
+  });
+
+  uint8_t rx[7] = {0};
+  I2CTransfer request;
+  uint8_t reg = 0x10;
+  request.address = I2CADR_RTC;
+  request.setTx(&reg, 1, nullptr, 0);
+  request.rx = rx;
+  request.rxLen = sizeof(rx);
+
+  std::future<I2CTransferStatus> result = bus.transfer(request);
+  EXPECT_EQ(std::future_status::timeout, result.wait_for(std::chrono::seconds(0)));
+  transport.advance(FakeI2CTransport::durationUs(request, 400000));
+  ASSERT_EQ(std::future_status::ready, result.wait_for(std::chrono::seconds(0)));
+  EXPECT_EQ(I2CTransferStatus::Ok, result.get());
+  EXPECT_EQ(0x10, rx[0]);
+  EXPECT_EQ(0x16, rx[6]);
+}
+
+// トランスポートがない・満杯の場合は受け付けない
+TEST(I2CTransportRejectTest, NoTransportOrFullQueue) {
+  I2CBusManager bus;
+  EXPECT_FALSE(bus.hasTransport());
+  EXPECT_FALSE(bus.transfer(pageWrite(0, 0), nullptr));
+  EXPECT_EQ(I2CTransferStatus::Error, bus.transfer(pageWrite(0, 0)).get());
+
+  FakeI2CTransport transport;
+  bus.setTransport(&transport);
+  for (size_t i = 0; i < FakeI2CTransport::MAX_IN_FLIGHT; ++i) {
+    EXPECT_TRUE(bus.transfer(pageWrite(0, 0), nullptr));
+  }
+  EXPECT_FALSE(bus.transfer(pageWrite(0, 0), nullptr));
+
+  I2CTransfer tooLong;
+  uint8_t data[I2CTransfer::MAX_TX] = {0};
+  uint8_t head[1] = {0};
+  EXPECT_FALSE(tooLong.setTx(head, sizeof(head), data, sizeof(data)));
+}
+
+}  // namespace
@@ -0,0 +1,219 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "../src/LocalTime.h"
+#include "../src/TimeZoneTable.h"
+#include "ScopedTz.h"
+
+static_assert(LocalTime::daysFromCivil(1970, 1, 1) == 0, "UNIX時間の起点");
+static_assert(LocalTime::daysFromCivil(2000, 3, 1) == 11017, "閏年の2月の翌日");
+static_assert(LocalTime::daysFromCivil(1969, 12, 31) == -1, "起点より前");
+static_assert(LocalTime::weekdayFromDays(0) == 4, "1970-01-01 は木曜");
+
+// UTCからの差[s]を POSIX の TZ にする（符号が逆）
+static std::string posixTz(int32_t offsetS) {
+  int32_t minutes = -offsetS / 60;
+  char buf[24];
+  snprintf(buf, sizeof(buf), "XXX%c%d:%02d", minutes < 0 ? '-' : '+', std::abs(minutes) / 60, std::abs(minutes) % 60);
+  return buf;
+}
+
+// 試す時刻（1902年～2106年を擬似乱数で散らす）
+struct TimeSamples {
+  uint64_t seed = 88172645463325252ULL;
+  int64_t next(void) {
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    return static_cast<int64_t>(seed % (0x100000000LL + 0x80000000LL)) - 0x80000000LL;
+  }
+};
+
+static void expectSameTm(const struct tm& expected, const struct tm& actual, int64_t t) {
+  EXPECT_EQ(expected.tm_year, actual.tm_year) << t;
+  EXPECT_EQ(expected.tm_mon, actual.tm_mon) << t;
+  EXPECT_EQ(expected.tm_mday, actual.tm_mday) << t;
+  EXPECT_EQ(expected.tm_hour, actual.tm_hour) << t;
+  EXPECT_EQ(expected.tm_min, actual.tm_min) << t;
+  EXPECT_EQ(expected.tm_sec, actual.tm_sec) << t;
+  EXPECT_EQ(expected.tm_wday, actual.tm_wday) << t;
+  EXPECT_EQ(expected.tm_yday, actual.tm_yday) << t;
+  EXPECT_EQ(expected.tm_isdst, actual.tm_isdst) << t;
+}
+
+// 日数と年月日の変換は往復で一致し、1日ずつ進む
+TEST(LocalTimeTest, CivilDaysRoundTrip) {
+  int32_t py = 0;
+  uint32_t pm = 0, pd = 0;
+  LocalTime::civilFromDays(-1000001, py, pm, pd);
+  for (int64_t days = -1000000; days <= 1000000; ++days) {
+    int32_t y;
+    uint32_t m, d;
+    LocalTime::civilFromDays(days, y, m, d);
+    ASSERT_EQ(days, LocalTime::daysFromCivil(y, m, d)) << y << "-" << m << "-" << d;
+    bool nextDay = (y == py) && (m == pm) && (d == pd + 1);
+    bool nextMonth = (y == py) && (m == pm + 1) && (d == 1);
+    bool nextYear = (y == py + 1) && (m == 1) && (pm == 12) && (d == 1);
+    ASSERT_TRUE(nextDay || nextMonth || nextYear) << days;
+    py = y;
+    pm = m;
+    pd = d;
+  }
+}
+
+// UTCの変換は gmtime_r() / timegm() と一致する
+TEST(LocalTimeTest, MatchesGmtime) {
+  TimeSamples samples;
+  for (int i = 0; i < 200000; ++i) {
+    int64_t t = samples.next();
+    time_t tt = static_cast<time_t>(t);
+    struct tm expected = {};
+    struct tm actual = {};
+    gmtime_r(&tt, &expected);
+    LocalTime::toUtc(t, actual);
+    expectSameTm(expected, actual, t);
+    EXPECT_EQ(static_cast<int64_t>(timegm(&expected)), LocalTime::fromUtc(actual)) << t;
+  }
+  struct tm overflow = {};        // 範囲外の欄は繰り上げる
+  overflow.tm_year = 123;
+  overflow.tm_mon = 13;
+  overflow.tm_mday = 0;
+  overflow.tm_hour = 25;
+  overflow.tm_min = -1;
+  struct tm copy = overflow;
+  EXPECT_EQ(static_cast<int64_t>(timegm(&copy)), LocalTime::fromUtc(overflow));
+}
+
+// Pr.35 の選択肢はすべて localtime_r() / mktime() と一致する
+TEST(LocalTimeTest, MatchesLocaltimeInEveryGmtZone) {
+  for (uint8_t index = 0; index < TimeZoneTable::GMT_COUNT; ++index) {
+    const TimeZoneRule* zone = TimeZoneTable::fromGmtIndex(index);
+    ASSERT_NE(nullptr, zone);
+    ScopedTz tz(posixTz(zone->stdOffsetS));
+    TimeSamples samples;
+    for (int i = 0; i < 5000; ++i) {
+      int64_t t = samples.next() & 0x7FFFFFFFLL;
+      time_t tt = static_cast<time_t>(t);
+      struct tm expected = {};
+      struct tm actual = {};
+      localtime_r(&tt, &expected);
+      LocalTime::toLocal(*zone, t, actual);
+      expectSameTm(expected, actual, t);
+      expected.tm_isdst = -1;
+      EXPECT_EQ(static_cast<int64_t>(mktime(&expected)), LocalTime::fromLocal(*zone, actual)) << t;
+    }
+  }
+}
+
+// Pr.33/34 の表は Web画面（timezone.json）と同じ並び
+TEST(LocalTimeTest, ZoneTableFollowsWebUi) {
+  const uint8_t counts[TimeZoneTable::AREA_COUNT] = {53, 170, 10, 2, 95, 15, 17, 105, 11, 39, 39};
+  for (uint8_t area = 0; area < TimeZoneTable::AREA_COUNT; ++area) {
+    EXPECT_EQ(counts[area], TimeZoneTable::zoneCount(area)) << TimeZoneTable::areaName(area);
+    EXPECT_EQ(nullptr, TimeZoneTable::fromZoneId(area, 0));           // 未選択
+    EXPECT_EQ(nullptr, TimeZoneTable::fromZoneId(area, counts[area] + 1));
+  }
+  EXPECT_EQ(nullptr, TimeZoneTable::fromZoneId(TimeZoneTable::AREA_COUNT, 1));
+  EXPECT_EQ(nullptr, TimeZoneTable::fromGmtIndex(TimeZoneTable::GMT_COUNT));
+
+  EXPECT_STREQ("Asia", TimeZoneTable::areaName(4));
+  EXPECT_EQ(9 * 3600, TimeZoneTable::fromZoneId(4, 80)->stdOffsetS);        // Pr.33/34 の初期値（Tokyo）
+  EXPECT_EQ(TimeZoneTable::fromGmtIndex(30), TimeZoneTable::fromZoneId(4, 80));  // Pr.35 の初期値と同じ規則
+  EXPECT_EQ(-4 * 3600, TimeZoneTable::fromZoneId(1, 99)->stdOffsetS);   // Caracas（tzdata。Web画面の -4:30 は2016年まで）
+  EXPECT_EQ(11 * 3600, TimeZoneTable::fromZoneId(9, 26)->stdOffsetS);    // Norfolk（tzdata。Web画面の +11:30 は2015年まで）
+  EXPECT_TRUE(TimeZoneTable::fromZoneId(9, 26)->hasDst());
+  for (uint8_t id = 1; id <= TimeZoneTable::GMT_COUNT; ++id) {
+    EXPECT_EQ(TimeZoneTable::fromGmtIndex(id - 1), TimeZoneTable::fromZoneId(10, id));   // AreaGMT は Pr.35 と同じ並び
+  }
+}
+
+// 夏時間の規則は POSIX の TZ と同じ時刻に切り替わる
+TEST(LocalTimeTest, DstRulesMatchLibc) {
+  struct Case {
+    const char* tz;
+    TimeZoneRule rule;
+  };
+  const Case cases[] = {
+    {"EST5EDT,M3.2.0,M11.1.0", {-5 * 3600, -4 * 3600, {3, 2, 0, 7200}, {11, 1, 0, 7200}}},
+    {"CET-1CEST,M3.5.0,M10.5.0/3", {3600, 7200, {3, 5, 0, 7200}, {10, 5, 0, 10800}}},
+    {"AEST-10AEDT,M10.1.0,M4.1.0/3", {10 * 3600, 11 * 3600, {10, 1, 0, 7200}, {4, 1, 0, 10800}}},
+    {"<+1030>-10:30<+11>-11,M10.1.0,M4.1.0", {10 * 3600 + 1800, 11 * 3600, {10, 1, 0, 7200}, {4, 1, 0, 7200}}},
+    {"<-03>3<-02>,M3.5.0/-2,M10.5.0/-1", {-3 * 3600, -2 * 3600, {3, 5, 0, -7200}, {10, 5, 0, -3600}}},
+  };
+  for (const Case& c : cases) {
+    ScopedTz tz(c.tz);
+    int64_t from = LocalTime::daysFromCivil(2000, 1, 1) * LocalTime::DAY_S;
+    int64_t to = LocalTime::daysFromCivil(2040, 1, 1) * LocalTime::DAY_S;
+    int transitions = 0;
+    bool prevDst = false;
+    for (int64_t t = from; t < to; t += 1800) {
+      time_t tt = static_cast<time_t>(t);
+      struct tm expected = {};
+      struct tm actual = {};
+      localtime_r(&tt, &expected);
+      LocalTime::toLocal(c.rule, t, actual);
+      expectSameTm(expected, actual, t);
+      if ((t != from) && (actual.tm_isdst != 0) != prevDst) {
+        transitions++;
+        for (int64_t s = t - 1800; s < t; ++s) {      // 切り替わりの秒まで一致する
+          tt = static_cast<time_t>(s);
+          localtime_r(&tt, &expected);
+          LocalTime::toLocal(c.rule, s, actual);
+          ASSERT_EQ(expected.tm_isdst, actual.tm_isdst) << c.tz << " " << s;
+          ASSERT_EQ(expected.tm_hour, actual.tm_hour) << c.tz << " " << s;
+        }
+        LocalTime::toLocal(c.rule, t, actual);
+      }
+      prevDst = (actual.tm_isdst != 0);
+      struct tm back = {};
+      LocalTime::toLocal(c.rule, LocalTime::fromLocal(c.rule, actual), back);
+      EXPECT_EQ(actual.tm_hour, back.tm_hour) << c.tz << " " << t;   // 往復で同じローカル時刻
+    }
+    EXPECT_EQ(80, transitions) << c.tz;
+  }
+}
+
+// ローカル時刻への変換は localtime_r() より速い
+TEST(LocalTimeTest, FasterThanLocaltime) {
+  struct Case {
+    const char* tz;
+    TimeZoneRule rule;
+  };
+  const Case cases[] = {
+    {"JST-9", *TimeZoneTable::fromZoneId(4, 80)},
+    {"CET-1CEST,M3.5.0,M10.5.0/3", {3600, 7200, {3, 5, 0, 7200}, {10, 5, 0, 10800}}},
+  };
+  const int calls = 1000000;
+  const int64_t base = 1700000000;
+  for (const Case& c : cases) {
+    ScopedTz tz(c.tz);
+    int64_t sum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < calls; ++i) {
+      struct tm out;
+      LocalTime::toLocal(c.rule, base + i * 37, out);
+      sum += out.tm_hour;
+    }
+    double oursNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / calls;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < calls; ++i) {
+      struct tm out;
+      time_t t = static_cast<time_t>(base + i * 37);
+      localtime_r(&t, &out);
+      sum -= out.tm_hour;
+    }
+    double libcNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / calls;
+
+    std::printf("  %s: toLocal() %.1f ns/call, localtime_r() %.1f ns/call\n", c.tz, oursNs, libcNs);
+    EXPECT_EQ(0, sum) << c.tz;
+    EXPECT_LT(oursNs, 1000.0) << c.tz;
+    if (!c.rule.hasDst()) {
+      EXPECT_LT(oursNs, libcNs) << c.tz;
+    }
+  }
+}
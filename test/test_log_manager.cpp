@@ -0,0 +1,361 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../src/LockFreeQueue.h"
+#include "../src/LogManager.h"
+#include "mock/DummyI2CBusManager.h"
+#include "mock/Eeprom24LC.h"
+
+static uint32_t monotonicMs = 0;   // 単調増加の時刻[ms]（テストで進める）
+
+// テストフィクスチャ
+class LogManagerTest : public ::testing::Test {
+protected:
+  DummyI2CBusManager mockBusManager;
+  EepromManager eepromManager;
+  LogManager logManager;
+  uint32_t now = 1700000000;    // 記録時刻（UNIX時間）
+
+  // 記録時刻と単調増加の時刻を一緒に進める
+  void advance(uint32_t seconds) {
+    now += seconds;
+    monotonicMs += seconds * 1000;
+  }
+
+  LogManagerTest()
+  : mockBusManager(),
+    eepromManager(&mockBusManager)
+  {
+  }
+
+  void SetUp() override {
+    eeprom24lc.erase();
+    logManager.begin(eepromManager);
+    logManager.setTimeSource([this]() { return now; });
+    logManager.setMonotonicSource([]() { return monotonicMs; });
+  }
+
+  // n件のログを10秒間隔で書き込む
+  void writeLogs(LogManager& logger, int n) {
+    for (int i = 0; i < n; ++i) {
+      std::string message = "event " + std::to_string(i);
+      logger.writeLog(message.c_str());
+      logger.update();
+      advance(10);
+    }
+  }
+};
+
+/**
+ * @brief 新しい順に読み出せること、ページングで続きを読めること
+ */
+TEST_F(LogManagerTest, ReadLatestPagesBackwards) {
+  writeLogs(logManager, 5);
+  EXPECT_EQ(5u, logManager.getLogCount());
+
+  LogRecord records[3];
+  ASSERT_EQ(3u, logManager.readLatest(records, 3));
+  EXPECT_STREQ("event 4", records[0].message);
+  EXPECT_STREQ("event 2", records[2].message);
+  EXPECT_EQ(1700000040u, records[0].timestamp);
+
+  ASSERT_EQ(2u, logManager.readLatest(records, 3, records[2].seq));   // 続きのページ
+  EXPECT_STREQ("event 1", records[0].message);
+  EXPECT_STREQ("event 0", records[1].message);
+
+  char buffer[32];
+  ASSERT_TRUE(logManager.readFirstLog(buffer, sizeof(buffer)));
+  EXPECT_STREQ("event 0", buffer);
+}
+
+/**
+ * @brief 再起動後も続きから書き込み、領域を一周したら古いログを上書きすること
+ */
+TEST_F(LogManagerTest, RecoversHeadAfterReboot) {
+  const int slots = LogManager::SLOT_COUNT;
+  writeLogs(logManager, slots + 3);     // 領域を一周以上
+
+  for (int written = slots + 3; written < 3 * slots; ++written) {
+    LogManager rebooted;                // 再起動を模擬（EEPROMの内容はそのまま）
+    rebooted.begin(eepromManager);
+    rebooted.setTimeSource([this]() { return now; });
+    EXPECT_EQ(static_cast<size_t>(slots), rebooted.getLogCount());
+
+    LogRecord latest;
+    ASSERT_EQ(1u, rebooted.readLatest(&latest, 1));
+    EXPECT_EQ(static_cast<uint32_t>(written), latest.seq);
+    EXPECT_EQ(written == slots + 3 ? "event " + std::to_string(slots + 2) : "after reboot", std::string(latest.message));
+
+    rebooted.writeLog("after reboot");  // 続きから追記
+    rebooted.update();
+    ASSERT_EQ(1u, rebooted.readLatest(&latest, 1));
+    EXPECT_EQ(static_cast<uint32_t>(written + 1), latest.seq);
+    advance(10);
+  }
+}
+
+/**
+ * @brief 期間を指定して古い順に読み出せること
+ */
+TEST_F(LogManagerTest, ReadRangeByTime) {
+  writeLogs(logManager, LogManager::SLOT_COUNT + 4);   // 古い4件は上書き済み（event 4以降が残る）
+
+  LogRecord records[8];
+  size_t n = logManager.readRange(1700000055, 1700000090, records, 8);
+  ASSERT_EQ(4u, n);                     // 60, 70, 80, 90
+  EXPECT_STREQ("event 6", records[0].message);
+  EXPECT_STREQ("event 9", records[3].message);
+
+  n = logManager.readRange(1700000055, 1700000090, records, 2);          // 1ページ目
+  ASSERT_EQ(2u, n);
+  n = logManager.readRange(1700000055, 1700000090, records, 8, records[1].seq);  // 続き
+  ASSERT_EQ(2u, n);
+  EXPECT_STREQ("event 8", records[0].message);
+
+  EXPECT_EQ(0u, logManager.readRange(0, 1699999999, records, 8));
+}
+
+/**
+ * @brief 時刻が戻った・時刻が決まる前（0）のログも、期間で漏れなく読み出せること
+ */
+TEST_F(LogManagerTest, ReadRangeWithNonMonotonicTime) {
+  uint32_t stepped = now;
+  logManager.setTimeSource([]() { return static_cast<uint32_t>(0); });   // 時刻が決まる前
+  writeLogs(logManager, 3);             // event 0～2：時刻0
+  logManager.setTimeSource([this]() { return now; });
+  now = stepped;
+  writeLogs(logManager, 5);             // event 0～4：1700000000～1700000040
+  now = stepped - 3600;                 // 時刻を1時間戻した
+  writeLogs(logManager, 4);             // event 0～3：1699996400～1699996430
+
+  LogRecord records[8];
+  size_t n = logManager.readRange(stepped - 3600, stepped - 3600 + 20, records, 8);
+  ASSERT_EQ(3u, n);
+  EXPECT_EQ(stepped - 3600, records[0].timestamp);
+  EXPECT_EQ(stepped - 3600 + 20, records[2].timestamp);
+
+  n = logManager.readRange(0, 0, records, 8);
+  ASSERT_EQ(3u, n);
+  EXPECT_EQ(1u, records[0].seq);
+
+  n = logManager.readRange(stepped - 3600, stepped + 40, records, 8);   // 記録順に並ぶ
+  ASSERT_EQ(8u, n);
+  EXPECT_EQ(stepped, records[0].timestamp);
+  EXPECT_EQ(stepped - 3600, records[5].timestamp);
+  n = logManager.readRange(stepped - 3600, stepped + 40, records, 8, records[4].seq);   // 続き
+  ASSERT_EQ(4u, n);
+  EXPECT_EQ(stepped - 3600, records[0].timestamp);
+}
+
+/**
+ * @brief 長いメッセージは切り捨てて保存すること
+ */
+TEST_F(LogManagerTest, LongMessageIsTruncated) {
+  // 既存のメッセージは切り捨てずに保存できる
+  logManager.writeLog("Param 44 load fail or out of range, set to default");
+  logManager.update();
+  LogRecord record;
+  ASSERT_EQ(1u, logManager.readLatest(&record, 1));
+  EXPECT_STREQ("Param 44 load fail or out of range, set to default", record.message);
+
+  logManager.writeLog("0123456789012345678901234567890123456789012345678901234567890123");
+  logManager.update();
+  ASSERT_EQ(1u, logManager.readLatest(&record, 1));
+  EXPECT_EQ(static_cast<size_t>(LogRecord::MESSAGE_LENGTH), strlen(record.message));
+  EXPECT_STREQ("012345678901234567890123456789012345678901234567890123", record.message);
+}
+
+/**
+ * @brief 破損したスロット（先頭を含む）を読み飛ばして書き込み位置を復元すること
+ */
+TEST_F(LogManagerTest, RecoversHeadPastCorruptSlots) {
+  const uint8_t garbage[LogManager::RECORD_SIZE] = {0x55};
+  for (int newest : {5, static_cast<int>(LogManager::SLOT_COUNT) + 5}) {
+    eeprom24lc.erase();
+    eepromManager.begin();
+    LogManager logger;
+    logger.begin(eepromManager);
+    writeLogs(logger, newest);
+
+    // スロット0と最新の1つ前のスロットを破損させる
+    eepromManager.writeBytes(LogManager::LOG_START_ADDR, garbage, sizeof(garbage));
+    eepromManager.writeBytes(LogManager::LOG_START_ADDR + ((newest - 2) % LogManager::SLOT_COUNT) * LogManager::RECORD_SIZE,
+                             garbage, sizeof(garbage));
+
+    LogManager rebooted;
+    rebooted.begin(eepromManager);
+    LogRecord latest;
+    ASSERT_EQ(1u, rebooted.readLatest(&latest, 1));
+    EXPECT_EQ(static_cast<uint32_t>(newest), latest.seq);
+    EXPECT_EQ("event " + std::to_string(newest - 1), std::string(latest.message));
+
+    rebooted.writeLog("after reboot");  // 最新の次のスロットへ追記
+    rebooted.update();
+    ASSERT_EQ(1u, rebooted.readLatest(&latest, 1));
+    EXPECT_EQ(static_cast<uint32_t>(newest + 1), latest.seq);
+    EXPECT_STREQ("after reboot", latest.message);
+  }
+}
+
+/**
+ * @brief writeLog()はキューへ積むだけで、update()でまとめて書き込まれること
+ */
+TEST_F(LogManagerTest, WriteLogIsQueuedUntilUpdate) {
+  for (size_t i = 0; i < LogManager::LOG_QUEUE_SIZE + 4; ++i) {
+    logManager.writeLog("queued");
+  }
+  LogQueueStats stats = logManager.getQueueStats();
+  EXPECT_EQ(LogManager::LOG_QUEUE_SIZE, stats.depth);
+  EXPECT_EQ(LogManager::LOG_QUEUE_SIZE, stats.highWater);
+  EXPECT_EQ(4u, stats.dropped);                        // 満杯分は破棄
+  EXPECT_EQ(0u, logManager.getLogCount());             // まだEEPROMへは書き込まない
+
+  EXPECT_EQ(LogManager::LOG_DRAIN_BATCH, logManager.update());   // 1回の書き込み件数は制限される
+  EXPECT_EQ(LogManager::LOG_QUEUE_SIZE - LogManager::LOG_DRAIN_BATCH, logManager.update());
+  stats = logManager.getQueueStats();
+  EXPECT_EQ(0u, stats.depth);
+  EXPECT_EQ(LogManager::LOG_QUEUE_SIZE, stats.written);
+}
+
+/**
+ * @brief 記録時刻はwriteLog()の時点で、キューを一度に書き込んでも前のログが残ること
+ */
+TEST_F(LogManagerTest, QueuedLogKeepsEventTimeAndHistory) {
+  writeLogs(logManager, 3);                            // 以前のログ
+  const uint32_t eventTime = now;
+  for (size_t i = 0; i < LogManager::LOG_QUEUE_SIZE; ++i) {
+    logManager.writeLog("burst");
+  }
+  advance(60);                                         // 書き込みが遅れる
+  while (logManager.update() > 0) {
+  }
+
+  LogRecord latest;
+  ASSERT_EQ(1u, logManager.readLatest(&latest, 1));
+  EXPECT_EQ(eventTime, latest.timestamp);
+  EXPECT_EQ(3u + LogManager::LOG_QUEUE_SIZE, logManager.getLogCount());
+  char buffer[32];
+  ASSERT_TRUE(logManager.readFirstLog(buffer, sizeof(buffer)));
+  EXPECT_STREQ("event 0", buffer);                     // 以前のログは上書きされない
+}
+
+/**
+ * @brief 時刻未設定のうちに積んだログも、書き込み時に積んだ時点の時刻へ変換されること
+ */
+TEST(LogManagerIsrTest, QueuesWithoutTimeSource) {
+  DummyI2CBusManager busManager;
+  EepromManager eeprom(&busManager);
+  eeprom24lc.erase();
+  LogManager logger;
+  logger.begin(eeprom);
+  logger.setMonotonicSource([]() { return monotonicMs; });
+
+  monotonicMs = 1000;
+  EXPECT_TRUE(logger.writeLogFromISR("edge"));         // 割り込みから（時刻の取得関数なし）
+  logger.writeLog("boot");
+  monotonicMs += 5000;
+  logger.setTimeSource([]() { return (uint32_t)1700000100; });   // SNTPで時刻が決まった
+  ASSERT_EQ(2u, logger.update());
+
+  LogRecord records[2];
+  ASSERT_EQ(2u, logger.readLatest(records, 2));
+  EXPECT_STREQ("edge", records[1].message);
+  EXPECT_EQ(1700000095u, records[1].timestamp);        // 5秒前の事象
+  EXPECT_EQ(1700000095u, records[0].timestamp);
+
+  // 時刻がないまま書き込んだログは0
+  LogManager noClock;
+  noClock.begin(eeprom);
+  noClock.setMonotonicSource([]() { return monotonicMs; });
+  noClock.writeLogFromISR("no clock");
+  ASSERT_EQ(1u, noClock.update());
+  ASSERT_EQ(1u, noClock.readLatest(records, 1));
+  EXPECT_EQ(0u, records[0].timestamp);
+}
+
+/**
+ * @brief 複数スレッドから積んだ要素が、スレッドごとの順序を保って取り出されること
+ */
+TEST(LockFreeQueueTest, PreservesPerProducerOrder) {
+  const int PRODUCERS = 4;
+  const int ITEMS = 20000;
+  struct Item {
+    int producer;
+    int index;
+  };
+  LockFreeQueue<Item, 64> queue;
+
+  std::vector<std::thread> producers;
+  for (int p = 0; p < PRODUCERS; ++p) {
+    producers.emplace_back([&queue, p]() {
+      for (int i = 0; i < ITEMS; ++i) {
+        Item item = {p, i};
+        while (!queue.push(item)) {
+          std::this_thread::yield();     // 満杯なら消費を待つ
+        }
+      }
+    });
+  }
+
+  int next[PRODUCERS] = {0};
+  int received = 0;
+  bool ordered = true;
+  while (received < PRODUCERS * ITEMS) {
+    Item item;
+    if (!queue.pop(item)) {
+      std::this_thread::yield();
+      continue;
+    }
+    ordered = ordered && (item.index == next[item.producer]);
+    next[item.producer] = item.index + 1;
+    received++;
+  }
+  for (auto& t : producers) {
+    t.join();
+  }
+
+  EXPECT_TRUE(ordered);
+  for (int p = 0; p < PRODUCERS; ++p) {
+    EXPECT_EQ(ITEMS, next[p]);
+  }
+  Item item;
+  EXPECT_FALSE(queue.pop(item));
+}
+
+/**
+ * @brief 複数スレッドからのwriteLog()と並行してupdate()で書き込んでも、件数の取りこぼしがないこと
+ */
+TEST_F(LogManagerTest, ConcurrentWritersAreCountedExactly) {
+  const int PRODUCERS = 4;
+  const int ITEMS = 500;
+  std::atomic<bool> done(false);
+
+  std::thread drainer([&]() {
+    while (!done.load()) {
+      logManager.update();
+    }
+  });
+  std::vector<std::thread> producers;
+  for (int p = 0; p < PRODUCERS; ++p) {
+    producers.emplace_back([&]() {
+      for (int i = 0; i < ITEMS; ++i) {
+        logManager.writeLog("concurrent");
+      }
+    });
+  }
+  for (auto& t : producers) {
+    t.join();
+  }
+  done.store(true);
+  drainer.join();
+  while (logManager.update() > 0) {
+  }
+
+  LogQueueStats stats = logManager.getQueueStats();
+  EXPECT_EQ(static_cast<uint32_t>(PRODUCERS * ITEMS), stats.written + stats.dropped);
+  EXPECT_EQ(0u, stats.depth);
+  LogRecord latest;
+  ASSERT_EQ(1u, logManager.readLatest(&latest, 1));
+  EXPECT_EQ(stats.written, latest.seq);
+}
@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "../src/OledFrameBuffer.h"
+
+// すべてのページの変わった範囲を集める
+static std::vector<OledSpan> dirtySpans(const OledFrameBuffer& frame) {
+  std::vector<OledSpan> all;
+  OledSpan spans[OledFrameBuffer::MAX_SPANS];
+  for (uint8_t page = 0; page < OledFrameBuffer::PAGES; ++page) {
+    size_t count = frame.collectDirty(page, spans, OledFrameBuffer::MAX_SPANS);
+    all.insert(all.end(), spans, spans + count);
+  }
+  return all;
+}
+
+// 変わった範囲を送ったことにして、送ったバイト数を返す
+static uint32_t flush(OledFrameBuffer& frame) {
+  uint32_t bytes = 0;
+  for (const OledSpan& span : dirtySpans(frame)) {
+    bytes += OledFrameBuffer::spanBytes(span);
+    frame.markShown(span);
+  }
+  return bytes;
+}
+
+// 字形をページ境界にそろった位置・またがる位置に描ける
+TEST(OledFrameBufferTest, BlitsGlyphAtAnyRow) {
+  OledFrameBuffer frame;
+  frame.drawGlyph(0, 0, 'I');         // 0x00,0x41,0x7F,0x41,0x00
+  EXPECT_FALSE(frame.getPixel(0, 0));
+  EXPECT_TRUE(frame.getPixel(1, 0));
+  EXPECT_TRUE(frame.getPixel(2, 3));
+  EXPECT_FALSE(frame.getPixel(1, 3));
+  EXPECT_TRUE(frame.getPixel(1, 6));
+  EXPECT_FALSE(frame.getPixel(1, 7));
+
+  frame.drawGlyph(10, 13, 'I');       // 2ページにまたがる（行13～20）
+  EXPECT_TRUE(frame.getPixel(11, 13));
+  EXPECT_TRUE(frame.getPixel(12, 16));
+  EXPECT_TRUE(frame.getPixel(11, 19));
+  EXPECT_FALSE(frame.getPixel(11, 20));
+  EXPECT_FALSE(frame.getPixel(11, 12));
+}
+
+// 背景も書くため、前の文字は残らない。枠の外は書き換えない
+TEST(OledFrameBufferTest, GlyphOverwritesItsCellOnly) {
+  OledFrameBuffer frame;
+  frame.drawGlyph(6, 4, '8');
+  frame.drawGlyph(6, 4, '1');
+  OledFrameBuffer expected;
+  expected.drawGlyph(6, 4, '1');
+  for (uint8_t y = 0; y < OledFrameBuffer::HEIGHT; ++y) {
+    for (uint8_t x = 0; x < OledFrameBuffer::WIDTH; ++x) {
+      EXPECT_EQ(expected.getPixel(x, y), frame.getPixel(x, y)) << (int)x << "," << (int)y;
+    }
+  }
+
+  frame.drawGlyph(0, 0, '8');         // 行0～7
+  frame.drawGlyph(0, 8, ' ');         // 行8～15（上の文字を消さない）
+  EXPECT_TRUE(frame.getPixel(1, 6));
+  EXPECT_EQ(3, frame.drawText(OledFrameBuffer::WIDTH - 20, 0, "ABCD"));   // はみ出す文字は描かない
+}
+
+// 変わった列だけが送る範囲になり、送ったあとは何も残らない
+TEST(OledFrameBufferTest, CollectsChangedColumnsOnly) {
+  OledFrameBuffer frame;
+  EXPECT_TRUE(dirtySpans(frame).empty());
+
+  frame.drawText(0, 16, "LOC:12:34:56");
+  std::vector<OledSpan> spans = dirtySpans(frame);
+  ASSERT_FALSE(spans.empty());
+  for (const OledSpan& span : spans) {
+    EXPECT_EQ(2, span.page);          // 行16～23はページ2だけ
+  }
+  flush(frame);
+  EXPECT_TRUE(dirtySpans(frame).empty());
+
+  frame.drawText(0, 16, "LOC:12:34:56");    // 同じ内容は送らない
+  EXPECT_TRUE(dirtySpans(frame).empty());
+
+  frame.drawText(0, 16, "LOC:12:34:57");    // 最後の文字だけ
+  spans = dirtySpans(frame);
+  ASSERT_EQ(1u, spans.size());
+  EXPECT_GE(spans[0].x0, 11 * OledFrameBuffer::CHAR_WIDTH);
+  EXPECT_LE(spans[0].x1, 12 * OledFrameBuffer::CHAR_WIDTH - 1);
+}
+
+// 近い範囲はまとめ、離れた範囲は分ける
+TEST(OledFrameBufferTest, MergesSmallGaps) {
+  OledFrameBuffer frame;
+  frame.drawText(0, 0, "8 8");        // 列0～4と列12～16（隙間7列）
+  std::vector<OledSpan> spans = dirtySpans(frame);
+  ASSERT_EQ(2u, spans.size());
+  flush(frame);
+
+  frame.drawText(0, 0, "1");
+  frame.drawText(OledFrameBuffer::CHAR_WIDTH, 0, "|");    // 列0～4と列6～10
+  spans = dirtySpans(frame);
+  ASSERT_EQ(1u, spans.size());
+}
+
+// 全体を送り直す
+TEST(OledFrameBufferTest, InvalidateResendsEverything) {
+  OledFrameBuffer frame;
+  frame.invalidate();
+  std::vector<OledSpan> spans = dirtySpans(frame);
+  ASSERT_EQ(OledFrameBuffer::PAGES, spans.size());
+  for (const OledSpan& span : spans) {
+    EXPECT_EQ(0, span.x0);
+    EXPECT_EQ(OledFrameBuffer::WIDTH - 1, span.x1);
+  }
+}
+
+// 受け取った内容は送る前の内容で、送っている間に描いた分は次に送る
+TEST(OledFrameBufferTest, TakeDirtySnapshotsBeforeSending) {
+  OledFrameBuffer frame;
+  frame.drawText(0, 0, "12");
+  OledSpan spans[OledFrameBuffer::MAX_SPANS];
+  uint8_t sent[OledFrameBuffer::WIDTH];
+  ASSERT_EQ(1u, frame.takeDirty(0, spans, OledFrameBuffer::MAX_SPANS, sent));
+  uint8_t expected[OledFrameBuffer::WIDTH];
+  memcpy(expected, frame.pageData(0), sizeof(expected));
+
+  frame.drawText(0, 0, "34");         // 送っている間に描く
+  EXPECT_EQ(0, memcmp(&expected[spans[0].x0], &sent[spans[0].x0], spans[0].width()));
+  std::vector<OledSpan> pending = dirtySpans(frame);
+  ASSERT_EQ(1u, pending.size());      // 描いた分は残っている
+  EXPECT_EQ(0u, frame.takeDirty(1, spans, OledFrameBuffer::MAX_SPANS, sent));
+}
+
+// 状態画面（時刻3行を100msごとに描く）の1秒あたりのI2Cのバイト数が1桁以上減る
+TEST(OledFrameBufferTest, StatusScreenTrafficDropsTenfold) {
+  OledFrameBuffer frame;
+  const uint8_t rows[] = {20, 30, 40};
+  const char* headers[] = {"LOC", "RTC", "SYS"};
+  char text[16];
+
+  // 文字列全体を描くたびに送る場合（従来）：文字列の枠が重なるページ×列
+  uint32_t perLine = 0;
+  {
+    snprintf(text, sizeof(text), "%s:%02d:%02d:%02d", "LOC", 12, 34, 56);
+    uint32_t width = (uint32_t)strlen(text) * OledFrameBuffer::CHAR_WIDTH;
+    perLine = 2 * (width + OledFrameBuffer::SPAN_OVERHEAD);    // 8の倍数でない行は2ページにまたがる
+  }
+  const uint32_t fullRedrawBytesPerSecond = perLine * 3 * 10;
+
+  // 差分だけを送る場合：最初の描画のあと、10秒分を計測する
+  for (int r = 0; r < 3; ++r) {
+    snprintf(text, sizeof(text), "%s:%02d:%02d:%02d", headers[r], 12, 34, 0);
+    frame.drawText(0, rows[r], text);
+  }
+  flush(frame);
+  uint32_t bytes = 0;
+  for (int tick = 0; tick < 100; ++tick) {      // 100ms × 100
+    int second = 1 + tick / 10;
+    for (int r = 0; r < 3; ++r) {
+      snprintf(text, sizeof(text), "%s:%02d:%02d:%02d", headers[r], 12, 34, second);
+      frame.drawText(0, rows[r], text);
+    }
+    bytes += flush(frame);
+  }
+  const uint32_t diffBytesPerSecond = bytes / 10;
+  std::printf("  full redraw %u B/s, dirty spans %u B/s\n", fullRedrawBytesPerSecond, diffBytesPerSecond);
+  EXPECT_GT(diffBytesPerSecond, 0u);
+  EXPECT_LE(diffBytesPerSecond * 10, fullRedrawBytesPerSecond);
+}
@@ -0,0 +1,219 @@
+#include <gtest/gtest.h>
+#include <iostream>
+#include <random>
+#include "../src/ParameterJournal.h"
+#include "../src/ParameterStorage.h"
+#include "mock/DummyI2CBusManager.h"
+#include "mock/EepromBusStats.h"      // モックEEPROMのバス使用量カウンタ
+#include "mock/Eeprom24LC.h"
+
+// テストフィクスチャ
+class ParameterJournalTest : public ::testing::Test {
+protected:
+  DummyI2CBusManager mockBusManager;
+  EepromManager eepromManager;
+
+  static constexpr uint16_t JOURNAL_START = PARAM_JOURNAL_START;
+  static constexpr uint16_t JOURNAL_END = PARAM_JOURNAL_END;
+
+  ParameterJournalTest()
+  : mockBusManager(),
+    eepromManager(&mockBusManager)
+  {
+  }
+
+  void SetUp() override {
+    eeprom24lc.erase();
+    eepromBusStats.reset();
+    eepromBusStats.writeCycleNs = 0;    // 寿命の集計のみ行うため書き込み待ちは省略
+  }
+};
+
+/**
+ * @brief 追記した値が再起動後の走査で復元されること
+ */
+TEST_F(ParameterJournalTest, RebuildsLatestValuesAtBoot) {
+  ParameterJournal journal(&eepromManager);
+  ASSERT_TRUE(journal.begin(JOURNAL_START, JOURNAL_END, 50));
+
+  uint8_t value = 0;
+  EXPECT_FALSE(journal.lookup(8, &value));           // 記録なし
+  ASSERT_TRUE(journal.append(8, 5));
+  ASSERT_TRUE(journal.append(9, 6));
+  ASSERT_TRUE(journal.append(8, 7));
+  EXPECT_FALSE(journal.append(50, 1));               // 範囲外
+
+  ParameterJournal rebooted(&eepromManager);          // 再起動を模擬（EEPROMの内容はそのまま）
+  ASSERT_TRUE(rebooted.begin(JOURNAL_START, JOURNAL_END, 50));
+  ASSERT_TRUE(rebooted.lookup(8, &value));
+  EXPECT_EQ(7, value);
+  ASSERT_TRUE(rebooted.lookup(9, &value));
+  EXPECT_EQ(6, value);
+  EXPECT_EQ(3u, rebooted.getSequence());
+}
+
+/**
+ * @brief 領域を何周しても、ページ再利用で全パラメータの最新値が残ること
+ */
+TEST_F(ParameterJournalTest, CompactionKeepsLiveRecordsAcrossWraps) {
+  ParameterJournal journal(&eepromManager);
+  ASSERT_TRUE(journal.begin(JOURNAL_START, JOURNAL_END, 50));
+
+  uint8_t expected[50];
+  for (uint8_t i = 0; i < 50; ++i) {                 // 全パラメータを一度記録
+    expected[i] = i;
+    ASSERT_TRUE(journal.append(i, i));
+  }
+  std::mt19937 rng(1);
+  for (int n = 0; n < 5000; ++n) {                   // 一部のパラメータだけ頻繁に変更
+    uint8_t index = 8 + rng() % 9;
+    expected[index] = rng() % 15 + 1;
+    ASSERT_TRUE(journal.append(index, expected[index]));
+  }
+  EXPECT_GT(journal.getRelocateCount(), 0u);
+
+  ParameterJournal rebooted(&eepromManager);
+  ASSERT_TRUE(rebooted.begin(JOURNAL_START, JOURNAL_END, 50));
+  for (uint8_t i = 0; i < 50; ++i) {
+    uint8_t value = 0;
+    ASSERT_TRUE(rebooted.lookup(i, &value));
+    EXPECT_EQ(expected[i], value) << "index " << static_cast<int>(i);
+  }
+  ASSERT_TRUE(rebooted.append(8, 1));                // 再起動後も続きから追記できる
+  EXPECT_EQ(journal.getSequence() + 1, rebooted.getSequence());
+}
+
+/**
+ * @brief CRCの合わないレコード（書き込み途中の電源断）は無視されること
+ */
+TEST_F(ParameterJournalTest, CorruptRecordIsIgnored) {
+  ParameterJournal journal(&eepromManager);
+  ASSERT_TRUE(journal.begin(JOURNAL_START, JOURNAL_END, 50));
+  ASSERT_TRUE(journal.append(8, 5));
+  ASSERT_TRUE(journal.append(8, 9));
+  ASSERT_TRUE(eepromManager.writeByte(JOURNAL_START + ParameterJournal::RECORD_SIZE + 1, 0x0C));  // 2件目の値を破損
+
+  ParameterJournal rebooted(&eepromManager);
+  ASSERT_TRUE(rebooted.begin(JOURNAL_START, JOURNAL_END, 50));
+  uint8_t value = 0;
+  ASSERT_TRUE(rebooted.lookup(8, &value));
+  EXPECT_EQ(5, value);
+}
+
+/**
+ * @brief 領域が小さすぎる・ページ境界に揃っていない場合は開始できないこと
+ */
+TEST_F(ParameterJournalTest, RejectsInvalidRegion) {
+  ParameterJournal journal(&eepromManager);
+  EXPECT_FALSE(journal.begin(0x0410, 0x0800, 50));   // ページ境界でない
+  EXPECT_FALSE(journal.begin(0x0400, 0x0500, 50));   // 32レコード < 50 + 8
+  EXPECT_FALSE(journal.append(0, 1));
+}
+
+/**
+ * @brief ジャーナル形式では固定アドレスへ書き込まず、未記録のパラメータは固定アドレスから読むこと
+ */
+TEST_F(ParameterJournalTest, StorageFallsBackToInPlaceValues) {
+  ASSERT_TRUE(eepromManager.writeByte(0x0010 + 33, 4));   // 従来形式で保存済みのPr.33
+  ParameterStorage storage(&eepromManager);
+  ASSERT_TRUE(storage.useJournal(JOURNAL_START, JOURNAL_END));
+  EXPECT_EQ(ParameterStorageMode::Journal, storage.getMode());
+
+  uint8_t value = 0;
+  ASSERT_TRUE(storage.load(33, &value));
+  EXPECT_EQ(4, value);
+
+  storage.save(33, 7);
+  ASSERT_TRUE(storage.load(33, &value));
+  EXPECT_EQ(7, value);
+  ASSERT_TRUE(eepromManager.readByte(0x0010 + 33, &value));
+  EXPECT_EQ(4, value);                                      // 固定アドレスは変更しない
+}
+
+/**
+ * @brief 輝度スライダー操作を数年分模擬し、書き込み増幅と書き換え寿命を比較する
+ * - 1日8回、1回あたり20ステップ（100ms間隔）で輝度Pr.8-16のいずれかを変更
+ * - 書き戻し遅延なし（即時書き込み）と、既定の書き戻し遅延（500ms）の2条件
+ * - 24LC32の書き換え寿命 1,000,000回/ページ を基準に寿命年数を見積もる
+ */
+TEST_F(ParameterJournalTest, SliderWearSimulation) {
+  const int YEARS = 3;
+  const int SESSIONS_PER_DAY = 8;
+  const int STEPS_PER_SESSION = 20;
+  const double ENDURANCE = 1000000.0;
+
+  struct Result {
+    uint32_t logicalWrites;
+    uint32_t pageCycles;
+    uint32_t programmedBytes;
+    uint32_t maxPageCycles;
+  };
+
+  auto simulate = [&](ParameterStorageMode mode, uint32_t flushDelayMs) {
+    EepromManager eeprom(&mockBusManager);
+    eeprom.setFlushDelay(flushDelayMs);
+    ParameterStorage storage(&eeprom);
+    if (mode == ParameterStorageMode::Journal) {
+      EXPECT_TRUE(storage.useJournal(JOURNAL_START, JOURNAL_END));
+    }
+    eepromBusStats.reset();
+    eepromBusStats.writeCycleNs = 0;
+
+    std::mt19937 rng(42);
+    uint8_t last[9] = {0};
+    uint32_t nowMs = 0;
+    uint32_t logicalWrites = 0;
+    for (int day = 0; day < 365 * YEARS; ++day) {
+      for (int session = 0; session < SESSIONS_PER_DAY; ++session) {
+        uint8_t digit = rng() % 9;
+        for (int step = 0; step < STEPS_PER_SESSION; ++step) {
+          uint8_t value = 1 + (last[digit] + step) % 15;
+          storage.save(8 + digit, value);
+          logicalWrites++;
+          eeprom.update(nowMs);
+          while (eeprom.getWriteStatus() == EepromWriteStatus::Busy && flushDelayMs == 0) {
+            eeprom.update(nowMs);         // 即時書き込み：書き込み完了まで進める
+          }
+          nowMs += 100;
+        }
+        last[digit] = (last[digit] + STEPS_PER_SESSION - 1) % 15;
+        nowMs += flushDelayMs;            // 操作終了後、書き戻し遅延が経過
+        while (eeprom.getWriteStatus() == EepromWriteStatus::Busy) {
+          eeprom.update(nowMs);
+        }
+      }
+    }
+    Result r = {logicalWrites, eepromBusStats.transactions, eepromBusStats.programmedBytes, eepromBusStats.maxPageWrites()};
+    return r;
+  };
+
+  struct Case {
+    const char* name;
+    ParameterStorageMode mode;
+    uint32_t flushDelayMs;
+  };
+  const Case cases[] = {
+    {"in-place, no delay ", ParameterStorageMode::InPlace, 0},
+    {"journal,  no delay ", ParameterStorageMode::Journal, 0},
+    {"in-place, 500ms    ", ParameterStorageMode::InPlace, EEPROM_FLUSH_DELAY_MS},
+    {"journal,  500ms    ", ParameterStorageMode::Journal, EEPROM_FLUSH_DELAY_MS},
+  };
+  Result results[4];
+
+  std::cout << "[wear] " << YEARS << " years, " << SESSIONS_PER_DAY << " sessions/day, "
+            << STEPS_PER_SESSION << " steps/session\n";
+  for (int i = 0; i < 4; ++i) {
+    results[i] = simulate(cases[i].mode, cases[i].flushDelayMs);
+    const Result& r = results[i];
+    double cyclesPerYear = static_cast<double>(r.maxPageCycles) / YEARS;
+    std::cout << "  " << cases[i].name << ": " << r.logicalWrites << " writes, "
+              << r.pageCycles << " page cycles ("
+              << static_cast<double>(r.pageCycles) / r.logicalWrites << "/write), "
+              << static_cast<double>(r.programmedBytes) / r.logicalWrites << " bytes/write, hottest page "
+              << r.maxPageCycles << " cycles -> " << ENDURANCE / cyclesPerYear << " years\n";
+  }
+
+  // ジャーナルは書き込みをページ全体に分散するため、最も消耗するページの寿命が延びる
+  EXPECT_LT(results[1].maxPageCycles * 8, results[0].maxPageCycles);
+  EXPECT_LT(results[3].maxPageCycles * 4, results[2].maxPageCycles);
+}
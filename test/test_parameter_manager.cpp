@@ -6,7 +6,9 @@
 #include "./mock/DummySystemManager.h"  // モックのSystemManagerをインクルード
 #include "./mock/DummyTimeManager.h"    // モックのTimeManagerをインクルード
 #include "./mock/DummyTerminalInputManager.h" // モックのTerminalInputManagerをインクルード
+#include "./mock/EepromBusStats.h"     // モックEEPROMのバス使用量カウンタ
 #include "../src/ParameterManager.h"    // テスト対象のParameterManagerをインクルード
+#include <chrono>
 
 // テスト用のモッククラスを使用してParameterManagerのテストを行う
 class ParameterManagerTest : public ::testing::Test {
@@ -105,6 +107,99 @@ TEST_F(ParameterManagerTest, SetupParameter_LoadSucceeds_WithinRange) {
   EXPECT_EQ(paramManager.getParameter(1), 55);              // MockEEPROMから読み込んだ値が使用されることを確認
 }
 
+/**
+* @brief 起動時のパラメータ読み込みが1回の一括読み込みで行われることを確認する
+*/
+TEST_F(ParameterManagerTest, BeginLoadsParameterBlockOnce) {
+  static constexpr int PARAM_START_ADDR = 0x0010;  // パラメータの開始アドレス
+  dummyEepromManager.writeByte(PARAM_START_ADDR + 8, 5);      // Pr.8 輝度0桁
+  dummyEepromManager.readByteCount = 0;
+  dummyEepromManager.readMultipleCount = 0;
+
+  auto t0 = std::chrono::steady_clock::now();
+  paramManager.begin();
+  auto t1 = std::chrono::steady_clock::now();
+
+  EXPECT_EQ(1, dummyEepromManager.readMultipleCount);         // 一括読み込み1回
+  EXPECT_EQ(0, dummyEepromManager.readByteCount);             // 個別読み込みなし
+  EXPECT_EQ(5, paramManager.getParameter(8));
+
+  // 一括読み込み後に書き込まれた値は個別に読み込む
+  dummyEepromManager.writeByte(PARAM_START_ADDR + 1, 7);
+  ASSERT_TRUE(paramManager.setupParameter(1, 3, 1, 10));
+  EXPECT_EQ(7, paramManager.getParameter(1));
+
+  // 実機での起動時バス時間の見積り（setupParameter 25個分の個別読み込み vs 50バイト一括読み込み）
+  EepromRawAccessor rawAccessor(&dummyBusManager);
+  uint8_t block[ParameterStorage::PARAM_COUNT];
+  eepromBusStats.reset();
+  for (int i = 0; i < 25; ++i) {
+    rawAccessor.readByte(PARAM_START_ADDR + i, &block[i]);
+  }
+  EepromBusStats byteStats = eepromBusStats;
+  eepromBusStats.reset();
+  rawAccessor.sequentialRead(PARAM_START_ADDR, block, sizeof(block));
+  EepromBusStats blockStats = eepromBusStats;
+
+  std::cout << "[boot] begin() host " << std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count() << " us\n"
+            << "  per-parameter read : " << byteStats.transactions << " transactions, " << byteStats.busyNs / 1000 << " us on bus\n"
+            << "  block read         : " << blockStats.transactions << " transactions, " << blockStats.busyNs / 1000 << " us on bus\n";
+  EXPECT_EQ(25u, byteStats.transactions);
+  EXPECT_EQ(1u, blockStats.transactions);
+  EXPECT_EQ(25u * (4u + 1u) * EepromBusStats::BYTE_TIME_NS, byteStats.busyNs);       // 1回あたりアドレス設定4byte + データ1byte
+  EXPECT_EQ((4u + sizeof(block)) * EepromBusStats::BYTE_TIME_NS, blockStats.busyNs);
+  EXPECT_LT(blockStats.busyNs, byteStats.busyNs);
+}
+
+/**
+* @brief 複数パラメータの更新が1回のトランザクションで書き込まれることを確認する
+*/
+TEST_F(ParameterManagerTest, MultiParameterPathsUseOneTransaction) {
+  dummyEepromManager.commitCount = 0;
+  paramManager.clearAllParameters();
+  EXPECT_EQ(1, dummyEepromManager.commitCount);
+
+  const uint8_t brightness[9] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+  ASSERT_TRUE(paramManager.setParameters(8, brightness, 9));  // Pr.8-16 輝度
+  EXPECT_EQ(2, dummyEepromManager.commitCount);
+  EXPECT_EQ(5, paramManager.getParameter(12));
+
+  // 1つでも範囲外ならどのパラメータも変更しない
+  const uint8_t invalid[3] = {10, 11, 0};
+  EXPECT_FALSE(paramManager.setParameters(8, invalid, 3));
+  EXPECT_EQ(1, paramManager.getParameter(8));
+  EXPECT_EQ(2, dummyEepromManager.commitCount);
+}
+
+/**
+* @brief 保存に失敗したとき、トランザクションを破棄してどのパラメータも変更しないことを確認する
+*/
+TEST_F(ParameterManagerTest, SaveFailureAbortsTransaction) {
+  ASSERT_TRUE(paramManager.clearAllParameters());
+  dummyEepromManager.commitCount = 0;
+
+  // 3個目の書き込みで失敗させる
+  const uint8_t brightness[9] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+  dummyEepromManager.writesBeforeFailure = 2;
+  EXPECT_FALSE(paramManager.setParameters(8, brightness, 9));
+  EXPECT_EQ(0, dummyEepromManager.commitCount);
+  for (uint8_t i = 8; i <= 16; ++i) {
+    EXPECT_EQ(BR_DEF, paramManager.getParameter(i));
+  }
+
+  // 単独の設定も失敗を返し、値を変更しない
+  dummyEepromManager.writesBeforeFailure = 0;
+  EXPECT_FALSE(paramManager.setParameter(8, 1));
+  EXPECT_EQ(BR_DEF, paramManager.getParameter(8));
+
+  // EEPROMも開始時点の内容のまま
+  dummyEepromManager.writesBeforeFailure = -1;
+  paramManager.begin();
+  for (uint8_t i = 8; i <= 16; ++i) {
+    EXPECT_EQ(BR_DEF, paramManager.getParameter(i));
+  }
+}
+
 /**
 * @brief setParameterで正常な範囲の値を設定できることを確認する
 */
@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+
+#include "../src/RtcTimeCache.h"
+
+// CPUの時計に対して ppm だけ進むRTCを模擬する
+struct FakeRtc {
+  uint32_t baseSec = 1700000000;
+  double phaseMs = 370.0;     // millis()=0 のときの秒未満の位相
+  double ppm = 0.0;
+  bool available = true;
+  int reads = 0;
+
+  uint32_t at(uint32_t cpuMs) const {
+    double rtcMs = phaseMs + static_cast<double>(cpuMs) * (1.0 + ppm * 1e-6);
+    return baseSec + static_cast<uint32_t>(std::floor(rtcMs / 1000.0));
+  }
+  RtcTimeCache::Reader reader(const uint32_t& nowMs) {
+    return [this, &nowMs](uint32_t& unixtime) {
+      reads++;
+      if (!available) return false;
+      unixtime = at(nowMs);
+      return true;
+    };
+  }
+};
+
+// 最初の読み込みで時刻を返せるようになり、秒の境界を見つけたらあとは読まずに延長する
+TEST(RtcTimeCacheTest, ExtrapolatesWithoutReading) {
+  FakeRtc rtc;
+  uint32_t nowMs = 1000;
+  RtcTimeCache cache;
+  cache.begin(rtc.reader(nowMs), nowMs);
+  uint32_t t = 0;
+  ASSERT_TRUE(cache.now(nowMs, t));
+  EXPECT_EQ(rtc.at(nowMs), t);
+  EXPECT_TRUE(cache.isSearching());
+
+  for (; cache.isSearching() && nowMs < 3000; ++nowMs) {
+    cache.update(nowMs);
+  }
+  ASSERT_FALSE(cache.isSearching());
+  EXPECT_LE(rtc.reads, 1 + 1000 / static_cast<int>(RtcTimeCache::EDGE_POLL_MS) + 1);
+
+  int readsAfterSync = rtc.reads;
+  int mismatches = 0;
+  for (uint32_t ms = nowMs; ms < nowMs + 60000; ++ms) {
+    cache.update(ms);
+    ASSERT_TRUE(cache.now(ms, t));
+    if (t != rtc.at(ms)) mismatches++;
+  }
+  EXPECT_EQ(readsAfterSync, rtc.reads);
+  EXPECT_LE(mismatches, 60 * static_cast<int>(RtcTimeCache::EDGE_POLL_MS / 2));   // 境界の前後だけ
+}
+
+// 再同期の間隔ごとに読み直し、位相の誤差を報告する
+TEST(RtcTimeCacheTest, ResyncsOnSchedule) {
+  FakeRtc rtc;
+  uint32_t nowMs = 0;
+  RtcTimeCache cache;
+  int syncs = 0;
+  RtcSyncReport last = {};
+  cache.onResync([&](const RtcSyncReport& report) { syncs++; last = report; });
+  cache.begin(rtc.reader(nowMs), nowMs);
+  const uint32_t hour = 3600000UL;
+  for (nowMs = 0; nowMs < hour; nowMs += 2) {
+    cache.update(nowMs);
+  }
+  EXPECT_EQ(static_cast<int>(hour / RtcTimeCache::RESYNC_INTERVAL_MS), syncs);
+  EXPECT_LE(std::abs(last.phaseErrorMs), static_cast<int32_t>(RtcTimeCache::EDGE_POLL_MS));
+  // 1時間で読んだ回数（100msごとに読む場合は36000回）
+  std::printf("  RTC reads per hour: %d\n", rtc.reads);
+  EXPECT_LT(rtc.reads, syncs * (1000 / static_cast<int>(RtcTimeCache::EDGE_POLL_MS) + 2) + 1);
+}
+
+// 連続した再同期からRTCの進みを推定する
+TEST(RtcTimeCacheTest, EstimatesDrift) {
+  for (double ppm : {-35.0, 0.0, 52.0}) {
+    FakeRtc rtc;
+    rtc.ppm = ppm;
+    uint32_t nowMs = 0;
+    RtcTimeCache cache;
+    cache.begin(rtc.reader(nowMs), nowMs);
+    for (nowMs = 0; nowMs < 3 * 3600000UL; ++nowMs) {
+      cache.update(nowMs);
+    }
+    ASSERT_TRUE(cache.isDriftValid()) << ppm;
+    EXPECT_NEAR(ppm * 1000.0, cache.getDriftPpb(), 1500.0) << ppm;    // ±1.5ppm
+    EXPECT_GE(cache.getBaselineS(), 3 * 3600u - 2 * RtcTimeCache::RESYNC_INTERVAL_MS / 1000);
+
+    uint32_t t = 0;
+    ASSERT_TRUE(cache.now(nowMs, t));
+    EXPECT_LE(std::abs(static_cast<int64_t>(rtc.at(nowMs)) - static_cast<int64_t>(t)), 1);    // 10分の延長では1秒以上ずれない
+  }
+}
+
+// 時刻を設定したら設定値から延長し、進みの基準を取り直す
+TEST(RtcTimeCacheTest, SetRebasesAndReanchors) {
+  FakeRtc rtc;
+  rtc.ppm = 20.0;
+  uint32_t nowMs = 0;
+  RtcTimeCache cache;
+  cache.begin(rtc.reader(nowMs), nowMs);
+  for (; nowMs < 2 * RtcTimeCache::RESYNC_INTERVAL_MS + 5000; ++nowMs) {
+    cache.update(nowMs);
+  }
+  ASSERT_TRUE(cache.isDriftValid());
+  int32_t drift = cache.getDriftPpb();
+
+  rtc.baseSec += 3600;
+  rtc.phaseMs -= static_cast<double>(nowMs % 1000);
+  cache.set(rtc.at(nowMs), nowMs);
+  uint32_t t = 0;
+  ASSERT_TRUE(cache.now(nowMs, t));
+  EXPECT_EQ(rtc.at(nowMs), t);
+  EXPECT_EQ(0u, cache.getBaselineS());
+  EXPECT_TRUE(cache.isSearching());
+  EXPECT_EQ(drift, cache.getDriftPpb());    // 推定値は残す
+}
+
+// 別のタスクから預けた時刻は、ループの update() で反映する
+TEST(RtcTimeCacheTest, PostAppliesOnUpdate) {
+  FakeRtc rtc;
+  uint32_t nowMs = 0;
+  RtcTimeCache cache;
+  cache.begin(rtc.reader(nowMs), nowMs);
+  for (; nowMs < 5000; ++nowMs) {
+    cache.update(nowMs);
+  }
+  ASSERT_FALSE(cache.isSearching());
+
+  uint32_t posted = rtc.at(nowMs) + 3600;
+  std::thread sntp([&]() { cache.post(posted, nowMs); });
+  sntp.join();
+  uint32_t t = 0;
+  ASSERT_TRUE(cache.now(nowMs, t));
+  EXPECT_EQ(rtc.at(nowMs), t);            // update() までは変えない
+  cache.update(nowMs);
+  ASSERT_TRUE(cache.now(nowMs, t));
+  EXPECT_EQ(posted, t);
+  EXPECT_TRUE(cache.isSearching());       // 境界を探し直す
+}
+
+// 読めないうちは推定しない
+TEST(RtcTimeCacheTest, InvalidUntilFirstRead) {
+  FakeRtc rtc;
+  rtc.available = false;
+  uint32_t nowMs = 0;
+  RtcTimeCache cache;
+  cache.begin(rtc.reader(nowMs), nowMs);
+  uint32_t t = 0;
+  EXPECT_FALSE(cache.now(nowMs, t));
+  for (; nowMs < RtcTimeCache::EDGE_TIMEOUT_MS + 100; ++nowMs) {
+    cache.update(nowMs);
+  }
+  EXPECT_FALSE(cache.isSearching());      // あきらめて次の再同期を待つ
+  EXPECT_FALSE(cache.isValid());
+  rtc.available = true;
+  cache.requestResync();
+  cache.update(nowMs);
+  EXPECT_TRUE(cache.now(nowMs, t));
+}
+
+// now() は数ナノ秒（I2Cの読み込みは数百us）
+TEST(RtcTimeCacheTest, NowCostsNanoseconds) {
+  FakeRtc rtc;
+  uint32_t nowMs = 0;
+  RtcTimeCache cache;
+  cache.begin(rtc.reader(nowMs), nowMs);
+  const uint32_t calls = 1000000;
+  uint32_t sum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < calls; ++i) {
+    uint32_t t = 0;
+    cache.now(i, t);
+    sum += t;
+  }
+  auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+  double perCall = static_cast<double>(elapsed) / calls;
+  std::printf("  now(): %.1f ns/call (checksum %u)\n", perCall, sum);
+  EXPECT_LT(perCall, 1000.0);
+}
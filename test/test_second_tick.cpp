@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "../src/SecondTick.h"
+#include "../src/ClockTicker.h"
+
+// 割り込みの遅れなどを乗せたSQWの立ち下がりを模擬する
+struct FakeSqw {
+  double periodUs = 1000000.0;    // 実際の周期（RTCの進み遅れを含む）
+  double firstEdgeUs = 123456.0;  // 最初の立ち下がり
+  uint32_t maxLatencyUs = 0;      // 割り込みの入りの遅れ（0～maxLatencyUs）
+  uint32_t seed = 12345;
+  bool wired = true;
+
+  uint32_t random(void) {
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 8;
+  }
+  uint32_t edge(uint32_t n) const { return static_cast<uint32_t>(firstEdgeUs + periodUs * n); }
+};
+
+// シミュレーションを進め、刻んだときの「本当の境界との差」を集める
+struct Simulation {
+  SecondTick tick;
+  FakeSqw sqw;
+  uint32_t nowUs = 0;
+  uint32_t nextEdge = 0;          // 次の立ち下がりの番号
+  uint32_t pendingUs = 0;         // 割り込みが入る時刻
+  bool pending = false;
+  std::vector<int32_t> errors;    // 刻んだ境界 - 本当の境界[us]
+  int ticks = 0;
+
+  void run(uint32_t untilUs, uint32_t stepUs = 100) {
+    for (; nowUs < untilUs; nowUs += stepUs) {
+      if (sqw.wired && !pending && nowUs >= sqw.edge(nextEdge)) {
+        pendingUs = sqw.edge(nextEdge) + (sqw.maxLatencyUs ? sqw.random() % (sqw.maxLatencyUs + 1) : 0);
+        pending = true;
+      }
+      if (pending && nowUs >= pendingUs) {
+        tick.captureEdge(pendingUs);
+        pending = false;
+        nextEdge++;
+      }
+      if (tick.update(nowUs)) {
+        ticks++;
+        errors.push_back(nearestError(tick.getTickUs()));
+      }
+    }
+  }
+  int32_t nearestError(uint32_t tickUs) const {
+    double best = 1e12;
+    for (uint32_t n = (nextEdge > 2 ? nextEdge - 2 : 0); n < nextEdge + 2; ++n) {
+      double d = static_cast<double>(tickUs) - (sqw.firstEdgeUs + sqw.periodUs * n);
+      if (std::abs(d) < std::abs(best)) best = d;
+    }
+    return static_cast<int32_t>(best);
+  }
+  int32_t maxAbsError(size_t from = 0) const {
+    int32_t worst = 0;
+    for (size_t i = from; i < errors.size(); ++i) {
+      worst = std::max(worst, std::abs(errors[i]));
+    }
+    return worst;
+  }
+};
+
+// 割り込みの遅れがばらついても、同期した境界の誤差は1ms未満
+TEST(SecondTickTest, LocksWithinOneMillisecondUnderJitter) {
+  for (double ppm : {-80.0, 0.0, 45.0}) {
+    Simulation sim;
+    sim.sqw.periodUs = 1000000.0 * (1.0 + ppm * 1e-6);
+    sim.sqw.maxLatencyUs = 800;     // 0～0.8ms の遅れ
+    sim.run(120 * 1000000UL);
+    ASSERT_TRUE(sim.tick.isLocked()) << ppm;
+    EXPECT_EQ(SecondTickMode::Sqw, sim.tick.getMode());
+    EXPECT_GE(sim.ticks, 120 - SecondTick::LOCK_EDGES - 1);
+    EXPECT_LT(sim.maxAbsError(), 1000) << ppm;
+    EXPECT_NEAR(sim.sqw.periodUs, sim.tick.getPeriodUs(), 30.0) << ppm;
+    std::printf("  %+.0f ppm: max phase error %d us, period %u us\n", ppm, sim.maxAbsError(), sim.tick.getPeriodUs());
+  }
+}
+
+// ノイズによる余分な立ち下がりは捨て、刻みは乱れない
+TEST(SecondTickTest, IgnoresGlitchEdges) {
+  Simulation sim;
+  sim.sqw.maxLatencyUs = 300;
+  sim.run(10 * 1000000UL);
+  ASSERT_TRUE(sim.tick.isLocked());
+  int ticksBefore = sim.ticks;
+  for (int i = 0; i < 5; ++i) {
+    sim.run(sim.nowUs + 400000);
+    sim.tick.captureEdge(sim.nowUs);        // 秒の途中のノイズ
+    sim.run(sim.nowUs + 600000);
+  }
+  EXPECT_TRUE(sim.tick.isLocked());
+  EXPECT_EQ(5u, sim.tick.getGlitches());
+  EXPECT_EQ(ticksBefore + 5, sim.ticks);
+  EXPECT_LT(sim.maxAbsError(), 1000);
+}
+
+// 立ち下がりで刻んだときだけ、割り込みの時刻から表示の切り替えまでの遅れを記録する
+TEST(SecondTickTest, RecordsEdgeToFlipLatency) {
+  Simulation sim;
+  sim.run(10 * 1000000UL);
+  ASSERT_TRUE(sim.tick.isLocked());
+
+  uint32_t edgeUs = sim.sqw.edge(sim.nextEdge) + 100;
+  sim.tick.captureEdge(edgeUs);
+  ASSERT_TRUE(sim.tick.update(edgeUs + 300));
+  sim.tick.recordFlip(edgeUs + 450);
+  EXPECT_EQ(450u, sim.tick.getFlipLatencyUs());
+  sim.tick.recordFlip(edgeUs + 9000);         // 同じ境界の2回目は記録しない
+  EXPECT_EQ(450u, sim.tick.getFlipLatencyUs());
+
+  edgeUs += 1000000;
+  sim.tick.captureEdge(edgeUs);
+  ASSERT_TRUE(sim.tick.update(edgeUs + 100));
+  sim.tick.recordFlip(edgeUs + 200);
+  EXPECT_EQ(200u, sim.tick.getFlipLatencyUs());
+  EXPECT_EQ(450u, sim.tick.getMaxFlipLatencyUs());
+  sim.tick.resetMaxFlipLatency();
+  EXPECT_EQ(0u, sim.tick.getMaxFlipLatencyUs());
+
+  ASSERT_TRUE(sim.tick.update(edgeUs + 1000000 + SecondTick::MISS_GRACE_US));   // 欠けた境界を予測で刻む
+  sim.tick.recordFlip(edgeUs + 1000000 + SecondTick::MISS_GRACE_US + 50);
+  EXPECT_EQ(200u, sim.tick.getFlipLatencyUs());
+}
+
+// SQWが途切れたら予測した境界で刻み、続けば Software に戻る
+TEST(SecondTickTest, FallsBackWhenEdgesStop) {
+  Simulation sim;
+  sim.sqw.periodUs = 1000000.0 * (1.0 + 30e-6);
+  sim.sqw.maxLatencyUs = 200;
+  sim.run(60 * 1000000UL);
+  ASSERT_TRUE(sim.tick.isLocked());
+  size_t before = sim.errors.size();
+
+  sim.sqw.wired = false;
+  sim.run(sim.nowUs + 10 * 1000000UL);
+  EXPECT_FALSE(sim.tick.isLocked());
+  EXPECT_EQ(SecondTickMode::Software, sim.tick.getMode());
+  EXPECT_EQ(static_cast<size_t>(SecondTick::MISS_LIMIT - 1), sim.errors.size() - before);   // 予測で刻んだ数
+  EXPECT_LT(sim.maxAbsError(before), 1000);
+  EXPECT_EQ(SecondTick::MISS_LIMIT, sim.tick.getMissed());
+}
+
+// SQWを配線していなければ刻まない（呼び出し側がシステム時刻で刻む）
+TEST(SecondTickTest, NeverLocksWithoutWiring) {
+  Simulation sim;
+  sim.sqw.wired = false;
+  sim.run(5 * 1000000UL);
+  EXPECT_FALSE(sim.tick.isLocked());
+  EXPECT_EQ(0, sim.ticks);
+  EXPECT_EQ(0u, sim.tick.getEdges());
+}
+
+// RTCの時刻を設定して位相が変わったら、取り直して同期し直す
+TEST(SecondTickTest, RelocksAfterPhaseJump) {
+  Simulation sim;
+  sim.sqw.maxLatencyUs = 300;
+  sim.run(10 * 1000000UL);
+  ASSERT_TRUE(sim.tick.isLocked());
+  sim.sqw.firstEdgeUs += 400000;      // 0.4秒ずれる
+  sim.nextEdge = static_cast<uint32_t>((sim.nowUs - sim.sqw.firstEdgeUs) / sim.sqw.periodUs) + 1;
+  size_t before = sim.errors.size();
+  sim.run(sim.nowUs + 15 * 1000000UL);
+  EXPECT_TRUE(sim.tick.isLocked());
+  ASSERT_GT(sim.errors.size(), before);
+  EXPECT_LT(std::abs(sim.errors.back()), 1000);
+}
+
+// 境界でのシステム時刻の秒未満を±0.5秒で求める
+TEST(SecondTickTest, SubSecondOffset) {
+  EXPECT_EQ(0, SecondTick::subSecondOffsetUs(2000, 5000, 3000));
+  EXPECT_EQ(250, SecondTick::subSecondOffsetUs(1250, 1000, 0));
+  EXPECT_EQ(-1000, SecondTick::subSecondOffsetUs(999000, 0, 0));
+  EXPECT_EQ(-300000, SecondTick::subSecondOffsetUs(100000, 0xFFFFFFF0u + 400000u, 0xFFFFFFF0u));   // micros()の桁あふれ
+}
+
+// SQWの境界で時計を刻むと、表示は境界に最も近いシステム時刻の秒になり、二重に進まない
+TEST(SecondTickTest, DrivesClockTickerAtEdges) {
+  int64_t sysUs = 1700000000LL * 1000000 + 300000;    // システム時刻（SQWより0.3秒進んでいる）
+  uint32_t nowUs = 0;
+  ClockTicker ticker;
+  std::vector<time_t> shown;
+  ticker.onTick([&](const struct tm&, uint8_t) { shown.push_back(ticker.getEpoch()); });
+  ticker.begin([&](time_t& epoch, uint32_t& subUs) {
+    int64_t t = sysUs + nowUs;
+    epoch = static_cast<time_t>(t / 1000000);
+    subUs = static_cast<uint32_t>(t % 1000000);
+    return true;
+  }, nullptr, nowUs);
+  ticker.setExternalTick(true);
+  for (uint32_t edge = 700000; edge < 10 * 1000000UL; edge += 1000000) {    // システム時刻の x.000 に当たる
+    for (; nowUs < edge; nowUs += 1000) {
+      EXPECT_EQ(0, ticker.update(nowUs));     // 外部の境界で刻んでいるときは進まない
+    }
+    nowUs = edge + 150;
+    ticker.tick(edge, nowUs);
+  }
+  ASSERT_EQ(11u, shown.size());
+  for (size_t i = 1; i < shown.size(); ++i) {
+    EXPECT_EQ(shown[i - 1] + 1, shown[i]) << i;
+    EXPECT_EQ(1700000001 + static_cast<time_t>(i - 1), shown[i]);
+  }
+}
@@ -0,0 +1,217 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdlib>
+#include <set>
+#include <string>
+
+#include "../src/ClockTicker.h"
+#include "../src/LocalTime.h"
+#include "../src/TimeZoneClock.h"
+#include "../src/TimeZoneTable.h"
+#include "ScopedTz.h"
+
+static int64_t utc(int32_t year, uint32_t month, uint32_t day, int hour, int minute, int second) {
+  return LocalTime::daysFromCivil(year, month, day) * LocalTime::DAY_S + hour * 3600 + minute * 60 + second;
+}
+
+static void expectSameTm(const struct tm& expected, const struct tm& actual, int64_t t) {
+  EXPECT_EQ(expected.tm_year, actual.tm_year) << t;
+  EXPECT_EQ(expected.tm_mon, actual.tm_mon) << t;
+  EXPECT_EQ(expected.tm_mday, actual.tm_mday) << t;
+  EXPECT_EQ(expected.tm_hour, actual.tm_hour) << t;
+  EXPECT_EQ(expected.tm_min, actual.tm_min) << t;
+  EXPECT_EQ(expected.tm_sec, actual.tm_sec) << t;
+  EXPECT_EQ(expected.tm_wday, actual.tm_wday) << t;
+  EXPECT_EQ(expected.tm_yday, actual.tm_yday) << t;
+  EXPECT_EQ(expected.tm_isdst, actual.tm_isdst) << t;
+}
+
+// 表の規則（重複なし）
+static std::set<const TimeZoneRule*> allRules(void) {
+  std::set<const TimeZoneRule*> rules;
+  for (uint8_t area = 0; area < TimeZoneTable::AREA_COUNT; ++area) {
+    for (uint8_t id = 1; id <= TimeZoneTable::zoneCount(area); ++id) {
+      rules.insert(TimeZoneTable::fromZoneId(area, id));
+    }
+  }
+  for (uint8_t index = 0; index < TimeZoneTable::GMT_COUNT; ++index) {
+    rules.insert(TimeZoneTable::fromGmtIndex(index));
+  }
+  return rules;
+}
+
+// 表のすべての規則が、その POSIX TZ を使った libc と同じ時刻になり、切り替えの前後1秒も一致する
+TEST(TimeZoneClockTest, EveryRuleMatchesLibc) {
+  const std::set<const TimeZoneRule*> rules = allRules();
+  ASSERT_EQ(0u, rules.count(nullptr));
+  const int64_t from = utc(2020, 1, 1, 0, 0, 0);
+  const int64_t to = utc(2036, 1, 1, 0, 0, 0);
+  int withDst = 0;
+  for (const TimeZoneRule* rule : rules) {
+    const char* tz = TimeZoneTable::posixTz(rule);
+    ASSERT_NE(nullptr, tz);
+    SCOPED_TRACE(tz);
+    ScopedTz scoped(tz);
+    TimeZoneClock clock;
+    int transitions = 0;
+    for (int64_t t = from; t < to; t += 3600) {
+      time_t tt = static_cast<time_t>(t);
+      struct tm expected = {};
+      struct tm actual = {};
+      localtime_r(&tt, &expected);
+      clock.toLocal(rule, t, actual);
+      expectSameTm(expected, actual, t);
+
+      const int64_t next = clock.getNextTransition();
+      if ((next != TimeZoneClock::NEVER) && (next <= t + 3600)) {   // 次の時刻までに切り替わる
+        transitions++;
+        for (int64_t s = next - 1; s <= next; ++s) {
+          time_t st = static_cast<time_t>(s);
+          localtime_r(&st, &expected);
+          TimeZoneClock edge;
+          edge.toLocal(rule, s, actual);
+          expectSameTm(expected, actual, s);
+        }
+        const int32_t nextOffset = clock.getNextOffset();
+        EXPECT_EQ(nextOffset, clock.utcOffset(rule, next));
+      }
+    }
+    EXPECT_EQ(rule->hasDst() ? 32 : 0, transitions);
+    EXPECT_EQ(static_cast<uint32_t>(transitions + 1), clock.getRefreshes());   // 切り替えごとに1回だけ求め直す
+    if (rule->hasDst()) withDst++;
+  }
+  EXPECT_GT(withDst, 10);
+}
+
+// 夏時間のエントリー（〇〇Summer）は同じ地域の規則になり、夏時間は自動で切り替わる
+TEST(TimeZoneClockTest, SummerEntriesFollowTzdata) {
+  const TimeZoneRule* newYork = TimeZoneTable::fromZoneId(1, 86);
+  ASSERT_NE(nullptr, newYork);
+  EXPECT_EQ(newYork, TimeZoneTable::fromZoneId(1, 87));   // New_YorkSummer
+  EXPECT_TRUE(newYork->hasDst());
+  EXPECT_EQ(-5 * 3600, newYork->stdOffsetS);
+  EXPECT_EQ(-4 * 3600, newYork->dstOffsetS);
+  EXPECT_STREQ("EST5EDT,M3.2.0,M11.1.0", TimeZoneTable::posixTz(newYork));
+
+  const TimeZoneRule* berlin = TimeZoneTable::fromZoneId(7, 14);
+  EXPECT_EQ(berlin, TimeZoneTable::fromZoneId(7, 15));    // BerlinSummer
+  EXPECT_STREQ("CET-1CEST,M3.5.0,M10.5.0/3", TimeZoneTable::posixTz(berlin));
+  const TimeZoneRule* sydney = TimeZoneTable::fromZoneId(6, 14);
+  EXPECT_EQ(sydney, TimeZoneTable::fromZoneId(6, 15));    // SydneySummer
+  EXPECT_TRUE(sydney->hasDst());
+
+  EXPECT_EQ(9 * 3600, TimeZoneTable::fromZoneId(4, 80)->stdOffsetS);   // Tokyo
+  EXPECT_FALSE(TimeZoneTable::fromZoneId(4, 80)->hasDst());
+  EXPECT_FALSE(TimeZoneTable::fromGmtIndex(8)->hasDst());   // Pr.35 はUTCからの差だけ
+  EXPECT_STREQ("", TimeZoneTable::posixTz(nullptr));
+}
+
+// Web画面が Pr.33/34 と一緒に送る Pr.35 の値
+TEST(TimeZoneClockTest, GmtIndexFollowsWebUi) {
+  EXPECT_EQ(30, TimeZoneTable::gmtIndexOf(4, 80));    // Tokyo
+  EXPECT_EQ(8, TimeZoneTable::gmtIndexOf(1, 86));     // New_York
+  EXPECT_EQ(9, TimeZoneTable::gmtIndexOf(1, 87));     // New_YorkSummer
+  EXPECT_EQ(15, TimeZoneTable::gmtIndexOf(7, 14));    // Berlin
+  EXPECT_EQ(16, TimeZoneTable::gmtIndexOf(7, 15));    // BerlinSummer
+  EXPECT_EQ(TimeZoneTable::NO_GMT, TimeZoneTable::gmtIndexOf(1, 99));   // Caracas（Pr.35 にない差）
+  EXPECT_EQ(TimeZoneTable::NO_GMT, TimeZoneTable::gmtIndexOf(4, 0));    // 未選択
+  EXPECT_EQ(TimeZoneTable::NO_GMT, TimeZoneTable::gmtIndexOf(TimeZoneTable::AREA_COUNT, 1));
+  for (uint8_t id = 1; id <= TimeZoneTable::GMT_COUNT; ++id) {
+    EXPECT_EQ(id - 1, TimeZoneTable::gmtIndexOf(10, id));
+  }
+}
+
+// 次の切り替えの時刻と、そのあとの差を覚えている（南半球は年をまたぐ期間になる）
+TEST(TimeZoneClockTest, KnowsNextTransition) {
+  const TimeZoneRule* berlin = TimeZoneTable::fromZoneId(7, 14);
+  TimeZoneClock clock;
+  EXPECT_EQ(3600, clock.utcOffset(berlin, utc(2025, 1, 15, 12, 0, 0)));
+  EXPECT_FALSE(clock.isDst());
+  EXPECT_EQ(utc(2025, 3, 30, 1, 0, 0), clock.getNextTransition());
+  EXPECT_EQ(7200, clock.getNextOffset());
+  EXPECT_EQ(7200, clock.utcOffset(berlin, utc(2025, 3, 30, 1, 0, 0)));
+  EXPECT_TRUE(clock.isDst());
+  EXPECT_EQ(utc(2025, 10, 26, 1, 0, 0), clock.getNextTransition());
+  EXPECT_EQ(3600, clock.getNextOffset());
+
+  const TimeZoneRule* sydney = TimeZoneTable::fromZoneId(6, 14);
+  EXPECT_EQ(11 * 3600, clock.utcOffset(sydney, utc(2025, 12, 31, 23, 0, 0)));   // 夏時間のまま年をまたぐ
+  EXPECT_TRUE(clock.isDst());
+  EXPECT_EQ(utc(2026, 4, 4, 16, 0, 0), clock.getNextTransition());   // 2026-04-05 03:00 AEDT
+  EXPECT_EQ(10 * 3600, clock.getNextOffset());
+
+  const TimeZoneRule* tokyo = TimeZoneTable::fromZoneId(4, 80);
+  EXPECT_EQ(9 * 3600, clock.utcOffset(tokyo, 0));
+  EXPECT_EQ(TimeZoneClock::NEVER, clock.getNextTransition());
+  EXPECT_EQ(0, clock.utcOffset(nullptr, 0));   // 規則がなければUTC
+  EXPECT_EQ(TimeZoneClock::NEVER, clock.getNextTransition());
+}
+
+// 表示の刻みは切り替えの秒ちょうどで時刻が飛ぶ（01:59:59 の次は 03:00:00）
+TEST(TimeZoneClockTest, TickerSwitchesAtTheTransitionSecond) {
+  const TimeZoneRule* berlin = TimeZoneTable::fromZoneId(7, 14);
+  const int64_t transition = utc(2025, 3, 30, 1, 0, 0);
+  int64_t realUs = 0;
+  const time_t baseEpoch = static_cast<time_t>(transition - 90);
+  TimeZoneClock zoneClock;
+  ClockTicker ticker;
+  int hourChanges = 0;
+  ticker.onTick([&](const struct tm& local, uint8_t changed) {
+    const int64_t epoch = baseEpoch + realUs / ClockTicker::SECOND_US;
+    if (epoch == transition - 1) {
+      EXPECT_EQ(1, local.tm_hour);
+      EXPECT_EQ(59, local.tm_min);
+      EXPECT_EQ(59, local.tm_sec);
+    }
+    if (epoch == transition) {
+      EXPECT_EQ(3, local.tm_hour);
+      EXPECT_EQ(0, local.tm_min);
+      EXPECT_EQ(0, local.tm_sec);
+      EXPECT_TRUE((changed & ClockTicker::FIELD_HOUR) != 0);
+    }
+    if ((changed & ClockTicker::FIELD_HOUR) && (epoch != baseEpoch)) hourChanges++;
+  });
+  ticker.begin([&](time_t& epoch, uint32_t& subUs) {
+    epoch = baseEpoch + static_cast<time_t>(realUs / ClockTicker::SECOND_US);
+    subUs = static_cast<uint32_t>(realUs % ClockTicker::SECOND_US);
+    return true;
+  }, [&](time_t t, struct tm& out) { zoneClock.toLocal(berlin, t, out); }, 0);
+  for (realUs = 0; realUs < 180 * 1000000LL; realUs += 1000) {
+    ticker.update(static_cast<uint32_t>(realUs));
+  }
+  EXPECT_EQ(transition + 89, ticker.getEpoch());
+  EXPECT_EQ(1, hourChanges);
+  EXPECT_EQ(2u, zoneClock.getRefreshes());   // 最初と切り替えの1回だけ
+}
+
+// 覚えた期間の中なら、夏時間のある地域でも libc の localtime_r より速い
+TEST(TimeZoneClockTest, FasterThanLocaltime) {
+  const TimeZoneRule* berlin = TimeZoneTable::fromZoneId(7, 14);
+  ScopedTz scoped(TimeZoneTable::posixTz(berlin));
+  const int64_t from = utc(2025, 4, 1, 0, 0, 0);
+  const int count = 2000000;
+  using Clock = std::chrono::steady_clock;
+  volatile int sink = 0;
+
+  auto start = Clock::now();
+  for (int i = 0; i < count; ++i) {
+    time_t t = static_cast<time_t>(from + i);
+    struct tm out;
+    localtime_r(&t, &out);
+    sink += out.tm_sec;
+  }
+  const double libcNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / count;
+
+  TimeZoneClock clock;
+  start = Clock::now();
+  for (int i = 0; i < count; ++i) {
+    struct tm out;
+    clock.toLocal(berlin, from + i, out);
+    sink += out.tm_sec;
+  }
+  const double cachedNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / count;
+
+  printf("localtime_r: %.1f ns, TimeZoneClock: %.1f ns (refreshes %u)\n", libcNs, cachedNs, clock.getRefreshes());
+  EXPECT_EQ(1u, clock.getRefreshes());
+  EXPECT_LT(cachedNs, libcNs);
+}
@@ -0,0 +1,340 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "../src/VfdRenderer.h"
+
+// 割り込みの出力を時刻つきで記録する
+struct VfdEvent {
+  uint32_t atUs;    // 出力した時刻[us]
+  VfdDrive drive;
+};
+
+// タイマの代わりに step() を呼び、戻り値の時間だけ時刻を進める
+static std::vector<VfdEvent> runFrames(VfdRenderer& vfd, uint32_t frames, uint32_t& nowUs) {
+  std::vector<VfdEvent> events;
+  for (uint32_t i = 0; i < frames * VfdRenderer::DIGITS * 2; ++i) {
+    VfdEvent event;
+    event.atUs = nowUs;
+    nowUs += vfd.step(event.drive);
+    events.push_back(event);
+  }
+  return events;
+}
+
+static uint8_t digitOf(uint32_t word) {
+  for (uint8_t d = 0; d < VfdRenderer::DIGITS; ++d) {
+    if (word & VfdRenderer::gridBit(d)) return d;
+  }
+  return 0xFF;
+}
+
+// 字形表
+TEST(VfdRendererTest, GlyphTable) {
+  EXPECT_EQ(0x3F, VfdGlyph::of('0'));
+  EXPECT_EQ(0x06, VfdGlyph::of('1'));
+  EXPECT_EQ(0x77, VfdGlyph::of('A'));
+  EXPECT_EQ(0x40, VfdGlyph::of('-'));
+  EXPECT_EQ(0x00, VfdGlyph::of(' '));
+  EXPECT_EQ(0x00, VfdGlyph::of('\n'));
+  EXPECT_EQ(0x00, VfdGlyph::of(static_cast<char>(0xB0)));
+  for (uint8_t n = 0; n < 10; ++n) {
+    EXPECT_EQ(VfdGlyph::of(static_cast<char>('0' + n)), VfdGlyph::digit(n));
+  }
+  EXPECT_EQ(0x00, VfdGlyph::digit(10));
+}
+
+// 文字列の '.' は直前の桁のドットになる
+TEST(VfdRendererTest, SetTextMergesDecimalPoint) {
+  VfdRenderer vfd;
+  EXPECT_EQ(4, vfd.setText("12.3.4"));
+  EXPECT_EQ(VfdGlyph::of('1'), vfd.getSegments(0));
+  EXPECT_EQ(VfdGlyph::of('2') | VfdGlyph::SEG_DP, vfd.getSegments(1));
+  EXPECT_EQ(VfdGlyph::of('3') | VfdGlyph::SEG_DP, vfd.getSegments(2));
+  EXPECT_EQ(VfdGlyph::of('4'), vfd.getSegments(3));
+
+  vfd.clear();
+  EXPECT_EQ(2, vfd.setText("..", 7));     // 連続した '.' は1桁ずつ使う
+  EXPECT_EQ(VfdGlyph::SEG_DP, vfd.getSegments(7));
+  EXPECT_EQ(VfdGlyph::SEG_DP, vfd.getSegments(8));
+
+  vfd.clear();
+  EXPECT_EQ(9, vfd.setText("0123456789"));  // はみ出した文字は捨てる
+  EXPECT_EQ(VfdGlyph::of('8'), vfd.getSegments(8));
+}
+
+// 点灯の時刻は輝度によらずスロット周期ちょうど（揺れがない）で、リフレッシュは1kHz以上
+TEST(VfdRendererTest, RefreshIsJitterFree) {
+  VfdRenderer vfd;
+  uint8_t brDig[VfdRenderer::DIGITS] = {1, 15, 3, 9, 12, 2, 7, 15, 1};
+  vfd.setBrightness(brDig, 85);
+  vfd.setText("123456789");
+  vfd.present();
+
+  uint32_t nowUs = 0;
+  std::vector<VfdEvent> events = runFrames(vfd, 10, nowUs);
+  EXPECT_EQ(10 * VfdRenderer::FRAME_US, nowUs);
+  EXPECT_GE(VfdRenderer::refreshHz(), 1000u);
+
+  // 最初の割り込みは先頭の桁を送るだけ。以降 Show と Blank が交互に並ぶ
+  ASSERT_EQ(VfdPhase::Blank, events[0].drive.phase);
+  uint32_t shows = 0;
+  for (size_t i = 1; i < events.size(); ++i) {
+    const VfdEvent& e = events[i];
+    if (e.drive.phase != VfdPhase::Show) continue;
+    uint8_t digit = digitOf(e.drive.word);
+    EXPECT_EQ(shows % VfdRenderer::DIGITS, digit);
+    // 点灯の時刻 = 最初の消灯時間 + スロット周期の整数倍
+    EXPECT_EQ(events[1].atUs + shows * VfdRenderer::SLOT_US, e.atUs) << "show #" << shows;
+    // 点灯する桁は直前の消灯中に送った桁
+    EXPECT_EQ(events[i - 1].drive.preload, e.drive.word);
+    EXPECT_TRUE(events[i - 1].drive.shift);
+    EXPECT_EQ(VfdPhase::Blank, events[i - 1].drive.phase);
+    shows++;
+  }
+  EXPECT_GE(shows, 9u * 9u);
+}
+
+// 桁ごとの点灯時間（デューティ）が輝度の表どおり
+TEST(VfdRendererTest, DutyFollowsBrightnessTable) {
+  VfdRenderer vfd;
+  uint8_t brDig[VfdRenderer::DIGITS] = {1, 2, 4, 6, 8, 10, 12, 14, 15};
+  vfd.setBrightness(brDig, 100);
+  vfd.setText("888888888");
+  vfd.present();
+
+  uint32_t nowUs = 0;
+  std::vector<VfdEvent> events = runFrames(vfd, 4, nowUs);
+  uint32_t onUs[VfdRenderer::DIGITS] = {};
+  for (size_t i = 1; i + 1 < events.size(); ++i) {
+    uint32_t atUs = events[i].atUs;
+    if (events[i].drive.phase == VfdPhase::Show && atUs >= VfdRenderer::FRAME_US && atUs < 3 * VfdRenderer::FRAME_US) {
+      onUs[digitOf(events[i].drive.word)] += events[i + 1].atUs - events[i].atUs;
+    }
+  }
+  uint32_t previous = 0;
+  for (uint8_t d = 0; d < VfdRenderer::DIGITS; ++d) {
+    uint32_t expected = VfdRenderer::onTimeUs(brDig[d], 100);
+    EXPECT_EQ(expected, vfd.getOnTimeUs(d));
+    EXPECT_EQ(expected, onUs[d] / 2) << "digit " << (int)d;   // 2フレーム分
+    EXPECT_GT(expected, previous);      // 輝度が上がれば点灯時間も長い
+    previous = expected;
+  }
+  EXPECT_EQ(VfdRenderer::MAX_ON_US, VfdRenderer::onTimeUs(15, 100));
+}
+
+// 点灯時間の範囲と全体輝度
+TEST(VfdRendererTest, OnTimeLimits) {
+  EXPECT_EQ(VfdRenderer::MIN_ON_US, VfdRenderer::onTimeUs(0, 50));     // 範囲外の輝度は丸める
+  EXPECT_EQ(VfdRenderer::MIN_ON_US, VfdRenderer::onTimeUs(1, 50));
+  EXPECT_EQ(VfdRenderer::MAX_ON_US, VfdRenderer::onTimeUs(20, 200));
+  EXPECT_LT(VfdRenderer::onTimeUs(15, 50), VfdRenderer::onTimeUs(15, 85));
+  for (uint8_t level = 1; level <= 15; ++level) {
+    for (uint8_t glow = 50; glow <= 100; glow += 5) {
+      uint32_t onUs = VfdRenderer::onTimeUs(level, glow);
+      EXPECT_GE(onUs, VfdRenderer::MIN_ON_US);
+      EXPECT_LE(onUs + VfdRenderer::MIN_BLANK_US, VfdRenderer::SLOT_US);
+    }
+  }
+}
+
+// present() した内容はフレームの切れ目から表示され、フレームの途中では混ざらない
+TEST(VfdRendererTest, PresentSwapsAtFrameBoundary) {
+  VfdRenderer vfd;
+  vfd.setText("111111111");
+  vfd.present();
+
+  uint32_t nowUs = 0;
+  runFrames(vfd, 1, nowUs);      // 最後の桁を点灯したところまで進める（1フレーム＝18回）
+  VfdDrive drive;
+  for (int i = 0; i < 7; ++i) {  // フレームの途中まで進める
+    vfd.step(drive);
+  }
+  vfd.setText("222222222");
+  vfd.present();
+  vfd.setText("333333333");       // present() していない描画は表示されない
+
+  std::vector<uint8_t> shown;
+  for (int i = 0; i < VfdRenderer::DIGITS * 2 * 2; ++i) {
+    vfd.step(drive);
+    if (drive.phase == VfdPhase::Show) {
+      shown.push_back(static_cast<uint8_t>(drive.word & 0xFF));
+    }
+  }
+  size_t firstNew = 0;
+  while (firstNew < shown.size() && shown[firstNew] == VfdGlyph::of('1')) firstNew++;
+  EXPECT_EQ(VfdRenderer::DIGITS - 3u, firstNew);     // 表示中のフレームは最後まで元の内容
+  for (size_t i = firstNew; i < shown.size(); ++i) {
+    EXPECT_EQ(VfdGlyph::of('2'), shown[i]);
+  }
+}
+
+// 桁の Show を1フレーム分集める（1回目と2回目の点灯時間も記録する）
+struct VfdSlot {
+  uint8_t first = 0;
+  uint8_t second = 0;
+  uint32_t firstUs = 0;
+  uint32_t secondUs = 0;
+};
+
+static void collectFrame(VfdRenderer& vfd, VfdSlot (&slots)[VfdRenderer::DIGITS]) {
+  VfdDrive drive;
+  uint8_t digit = 0;
+  bool second = false;
+  uint32_t events = 0;
+  uint32_t totalUs = 0;
+  for (uint8_t shown = 0; shown < VfdRenderer::DIGITS || drive.phase == VfdPhase::Show; ) {
+    uint32_t us = vfd.step(drive);
+    totalUs += us;
+    events++;
+    if (drive.phase == VfdPhase::Blank) {
+      second = false;
+      continue;
+    }
+    digit = digitOf(drive.word);
+    if (!second) {
+      slots[digit].first = static_cast<uint8_t>(drive.word);
+      slots[digit].firstUs = us;
+      slots[digit].second = 0;
+      slots[digit].secondUs = 0;
+      second = true;
+      shown++;
+    } else {
+      slots[digit].second = static_cast<uint8_t>(drive.word);
+      slots[digit].secondUs = us;
+    }
+  }
+  EXPECT_LE(events, VfdRenderer::DIGITS * 3u);
+}
+
+// 最初の割り込み（先頭の桁を送る）を済ませる。以降 collectFrame() はフレームの先頭から集める
+static void startFrames(VfdRenderer& vfd) {
+  VfdDrive drive;
+  vfd.step(drive);
+  ASSERT_EQ(VfdPhase::Blank, drive.phase);
+}
+
+// 切り替え時間から1フレームの増分を求める
+TEST(VfdRendererTest, FadeStep) {
+  EXPECT_EQ(VfdRenderer::PROGRESS_FULL, VfdRenderer::fadeStep(0));
+  for (uint8_t fade = 1; fade <= VfdRenderer::FADE_TIME_MAX; ++fade) {
+    uint32_t step = VfdRenderer::fadeStep(fade);
+    uint32_t frames = (VfdRenderer::PROGRESS_FULL + step - 1) / step;
+    uint32_t expected = fade * VfdRenderer::FADE_UNIT_MS * 1000 / VfdRenderer::FRAME_US;
+    EXPECT_NEAR(expected, frames, expected / 100 + 1) << "fade " << (int)fade;   // 増分の丸めで1%以内
+  }
+  EXPECT_EQ(VfdRenderer::fadeStep(VfdRenderer::FADE_TIME_MAX), VfdRenderer::fadeStep(200));
+}
+
+// クロスフェード：変わった桁だけ、点灯時間を前後の表示で分け合い、合計は変わらない
+TEST(VfdRendererTest, CrossFadeSharesOnTime) {
+  VfdRenderer vfd;
+  uint8_t brDig[VfdRenderer::DIGITS] = {15, 15, 15, 15, 15, 15, 15, 15, 15};
+  vfd.setBrightness(brDig, 100);
+  vfd.setText("12-34-56");
+  vfd.present();
+  startFrames(vfd);
+  VfdSlot slots[VfdRenderer::DIGITS];
+  collectFrame(vfd, slots);
+
+  vfd.setEffect(static_cast<uint8_t>(VfdEffect::CrossFade), 1);
+
+  vfd.setText("12-34-57");
+  vfd.present();
+  uint32_t frames = 0;
+  uint32_t previousNewUs = 0;
+  bool sawSplit = false;
+  for (; frames < 200; ++frames) {
+    collectFrame(vfd, slots);
+    EXPECT_EQ(VfdGlyph::of('1'), slots[0].first);      // 変わっていない桁はそのまま
+    EXPECT_EQ(0u, slots[0].secondUs);
+    const VfdSlot& s = slots[7];
+    EXPECT_EQ(VfdRenderer::MAX_ON_US, s.firstUs + s.secondUs);
+    uint32_t newUs = (s.first == VfdGlyph::of('7')) ? s.firstUs : s.secondUs;
+    if (s.secondUs != 0) {
+      sawSplit = true;
+      EXPECT_EQ(VfdGlyph::of('6'), s.first);
+      EXPECT_EQ(VfdGlyph::of('7'), s.second);
+      EXPECT_GE(s.firstUs, VfdRenderer::MIN_ON_US);
+      EXPECT_GE(s.secondUs, VfdRenderer::MIN_ON_US);
+    }
+    EXPECT_GE(newUs, previousNewUs);                    // 新しい表示は徐々に明るくなる
+    previousNewUs = newUs;
+    if (newUs == VfdRenderer::MAX_ON_US) break;
+  }
+  EXPECT_TRUE(sawSplit);
+  // 前の表示が MIN_ON_US を切った時点で新しい表示だけになるため、100ms より少し早く終わる
+  const uint32_t fadeFrames = VfdRenderer::FADE_UNIT_MS * 1000 / VfdRenderer::FRAME_US;
+  EXPECT_LE(frames, fadeFrames);
+  EXPECT_GE(frames, fadeFrames * 8 / 10);
+
+  // 内容が同じなら present() しても切り替えはやり直さない
+  vfd.present();
+  collectFrame(vfd, slots);
+  EXPECT_EQ(VfdGlyph::of('7'), slots[7].first);
+  EXPECT_EQ(0u, slots[7].secondUs);
+}
+
+// 転がす：前の字形→途中の2段階→新しい字形
+TEST(VfdRendererTest, RollStages) {
+  const uint8_t from = VfdGlyph::of('8');
+  const uint8_t to = VfdGlyph::of('1');
+  EXPECT_EQ(from, VfdRenderer::rollFrame(from, to, 0));
+  EXPECT_EQ(VfdGlyph::SEG_A | VfdGlyph::SEG_F | VfdGlyph::SEG_B | VfdGlyph::SEG_G,
+            VfdRenderer::rollFrame(from, to, 1));       // '1' の上端（a）はない
+  EXPECT_EQ(VfdGlyph::SEG_A | VfdGlyph::SEG_C,
+            VfdRenderer::rollFrame(from, to, 2));       // 前の下端と '1' の右上（b→c）
+  EXPECT_EQ(to, VfdRenderer::rollFrame(from, to, VfdRenderer::ROLL_STAGES));
+
+  VfdRenderer vfd;
+  vfd.setText("8");
+  vfd.present();
+  startFrames(vfd);
+  VfdSlot slots[VfdRenderer::DIGITS];
+  collectFrame(vfd, slots);
+
+  vfd.setEffect(static_cast<uint8_t>(VfdEffect::Roll), 1);
+  vfd.setText("1");
+  vfd.present();
+  std::vector<uint8_t> sequence;
+  for (int frame = 0; frame < 200; ++frame) {
+    collectFrame(vfd, slots);
+    EXPECT_EQ(0u, slots[1].first);      // 空白の桁は変わらない
+    if (sequence.empty() || sequence.back() != slots[0].first) {
+      sequence.push_back(slots[0].first);
+    }
+  }
+  ASSERT_EQ(4u, sequence.size());
+  EXPECT_EQ(from, sequence[0]);
+  EXPECT_EQ(VfdRenderer::rollFrame(from, to, 1), sequence[1]);
+  EXPECT_EQ(VfdRenderer::rollFrame(from, to, 2), sequence[2]);
+  EXPECT_EQ(to, sequence[3]);
+}
+
+// 流す：前の表示が左へ抜け、新しい表示が右から入る
+TEST(VfdRendererTest, ScrollShiftsWholeLine) {
+  VfdRenderer vfd;
+  vfd.setText("AAAAAAAAA");
+  vfd.present();
+  startFrames(vfd);
+  VfdSlot slots[VfdRenderer::DIGITS];
+  collectFrame(vfd, slots);
+
+  vfd.setEffect(static_cast<uint8_t>(VfdEffect::Scroll), 2);
+  vfd.setText("123456789");
+  vfd.present();
+
+  uint8_t previousShift = 0;
+  for (int frame = 0; frame < 300; ++frame) {
+    collectFrame(vfd, slots);
+    // 左端から何桁ぶん新しい表示が入ってきたか
+    uint8_t shift = 0;
+    while (shift < VfdRenderer::DIGITS && slots[shift].first == VfdGlyph::of('A')) shift++;
+    shift = static_cast<uint8_t>(VfdRenderer::DIGITS - shift);
+    EXPECT_GE(shift, previousShift);
+    for (uint8_t d = VfdRenderer::DIGITS - shift; d < VfdRenderer::DIGITS; ++d) {
+      EXPECT_EQ(VfdGlyph::digit(1 + d - (VfdRenderer::DIGITS - shift)), slots[d].first);
+    }
+    previousShift = shift;
+  }
+  EXPECT_EQ(VfdRenderer::DIGITS, previousShift);
+}
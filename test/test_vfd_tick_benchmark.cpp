@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../src/VfdRenderer.h"
+
+// 割り込み1回（step()）の処理時間を効果ごとに測る
+//
+// 最も割り込みが多いのはクロスフェード中で、1桁につき3回（Show×2、Blank）。
+// 1.1kHz のリフレッシュでは 3 × 9桁 × 1111 ≒ 3万回/秒。
+// 割り込みに使うCPU時間を5%以下に収めるには、実機で1回あたり約1.7us以内。
+// 実機（ESP32-S3 240MHz、IRAM）はこのホストのデバッグビルドの7倍程度までの遅さと見て、
+// ホストでの予算を1回あたり TICK_BUDGET_NS とする。
+//
+// 実時間はホストの負荷で変わるため、通常の ctest では測って表示するだけにする。
+// 予算の判定は環境変数 VFD_TICK_BUDGET=1 のときだけ行う（例：VFD_TICK_BUDGET=1 ctest -R VfdTickBenchmark）。
+static constexpr uint32_t TICKS = 2000000;
+static constexpr double TICK_BUDGET_NS = 250.0;
+
+static double measureNsPerTick(VfdEffect effect) {
+  VfdRenderer vfd;
+  uint8_t brDig[VfdRenderer::DIGITS] = {15, 12, 9, 6, 3, 6, 9, 12, 15};
+  vfd.setBrightness(brDig, 100);
+  vfd.setEffect(static_cast<uint8_t>(effect), VfdRenderer::FADE_TIME_MAX);
+  vfd.setText("12-34-56");
+  vfd.present();
+
+  VfdDrive drive;
+  uint32_t sink = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < TICKS; ++i) {
+    if ((i % 20000) == 0) {       // 切り替え中の状態を保つため、時々表示を変える
+      vfd.setText((i / 20000) % 2 ? "98-76-54" : "12-34-56");
+      vfd.present();
+    }
+    sink += vfd.step(drive);
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_NE(0u, sink);
+  return std::chrono::duration<double, std::nano>(elapsed).count() / TICKS;
+}
+
+static bool budgetCheckEnabled(void) {
+  const char* value = std::getenv("VFD_TICK_BUDGET");
+  return value != nullptr && value[0] != '\0' && value[0] != '0';
+}
+
+TEST(VfdTickBenchmark, PerTickCostWithinBudget) {
+  const VfdEffect effects[] = {VfdEffect::None, VfdEffect::CrossFade, VfdEffect::Roll, VfdEffect::Scroll};
+  const char* names[] = {"none", "crossfade", "roll", "scroll"};
+  const bool checkBudget = budgetCheckEnabled();
+  double worst = 0;
+  for (size_t i = 0; i < sizeof(effects) / sizeof(effects[0]); ++i) {
+    double ns = measureNsPerTick(effects[i]);
+    std::printf("  %-9s %6.1f ns/tick\n", names[i], ns);
+    if (checkBudget) {
+      EXPECT_LT(ns, TICK_BUDGET_NS) << names[i];
+    }
+    if (ns > worst) worst = ns;
+  }
+  const double ticksPerSecond = 3.0 * VfdRenderer::DIGITS * VfdRenderer::refreshHz();
+  std::printf("  worst %.1f ns/tick x %.0f ticks/s = %.2f%% of one host core\n",
+              worst, ticksPerSecond, worst * ticksPerSecond / 1e7);
+  if (!checkBudget) {
+    std::printf("  budget %.0f ns/tick not checked (set VFD_TICK_BUDGET=1)\n", TICK_BUDGET_NS);
+  }
+}